@@ -0,0 +1,350 @@
+/**********************************************************************************/
+/* This file is part of spla project                                              */
+/* https://github.com/SparseLinearAlgebra/spla                                    */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2023 SparseLinearAlgebra                                         */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#ifndef SPLA_BENCH_COMMON_HPP
+#define SPLA_BENCH_COMMON_HPP
+
+#include <spla.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#define SPLA_BENCH_SCHEMA "spla-bench-v1"
+
+/**
+ * @class BenchCase
+ * @brief Single measured kernel on fixed input
+ *
+ * Prepare is called before each run and is not timed, so runs which
+ * mutate inputs (conversions, in-place updates) start from same state.
+ */
+struct BenchCase {
+    std::string           kernel;
+    std::function<void()> prepare;
+    std::function<void()> run;
+    double                bytes = 0;// approximate bytes moved by single run
+    double                edges = 0;// traversed edges by single run, zero if not graph kernel
+};
+
+/**
+ * @class BenchResult
+ * @brief Measured time of single case with derived throughput metrics
+ */
+struct BenchResult {
+    std::string key;
+    std::string kernel;
+    std::string backend;
+    std::string dist;
+    spla::uint  n          = 0;
+    spla::uint  avg_degree = 0;
+    std::size_t nnz        = 0;
+    int         iters      = 0;
+    double      min_ms     = 0;
+    double      median_ms  = 0;
+    double      mean_ms    = 0;
+    double      gbps       = 0;
+    double      eps        = 0;
+};
+
+/**
+ * @class BenchGraph
+ * @brief Generated adjacency structure of square matrix in coordinate format
+ */
+struct BenchGraph {
+    std::string             dist;
+    spla::uint              n          = 0;
+    spla::uint              avg_degree = 0;
+    std::vector<spla::uint> Ai;
+    std::vector<spla::uint> Aj;
+};
+
+/**
+ * Generate graph with given number of vertices and average out degree.
+ *
+ * `uniform` draws each row degree close to average with uniformly distributed columns,
+ * `powerlaw` draws row degrees from Pareto distribution (alpha = 2) with same mean, which
+ * gives few heavy rows and many light ones, and skews columns towards low indices.
+ * `rmat` is undirected Graph500 Kronecker graph with n rounded up to power of two,
+ * `grid` is undirected 2D grid with n rounded down to square (degree is ignored).
+ */
+inline BenchGraph bench_make_graph(const std::string& dist, spla::uint n, spla::uint avg_degree, unsigned int seed) {
+    BenchGraph graph;
+    graph.dist       = dist;
+    graph.n          = n;
+    graph.avg_degree = avg_degree;
+
+    if (dist == "rmat" || dist == "grid") {
+        spla::GraphGenerator generator(seed);
+
+        if (dist == "rmat") {
+            spla::uint scale = 1;
+            while ((spla::uint(1) << scale) < n) scale += 1;
+            generator.generate_rmat(scale, std::max(1u, avg_degree / 2));
+        } else {
+            const auto side = static_cast<spla::uint>(std::sqrt(static_cast<double>(n)));
+            generator.generate_grid(side, side);
+        }
+
+        graph.n  = generator.get_n_rows();
+        graph.Ai = generator.get_Ai();
+        graph.Aj = generator.get_Aj();
+        return graph;
+    }
+
+    std::mt19937                           engine(seed);
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    std::vector<spla::uint>                row;
+
+    const bool powerlaw = dist == "powerlaw";
+
+    for (spla::uint i = 0; i < n; i++) {
+        const double u      = std::max(uniform(engine), 1e-9);
+        const double degree = powerlaw ? 0.5 * avg_degree / std::sqrt(u) : avg_degree;
+        const auto   count  = static_cast<spla::uint>(std::min<double>(n, std::floor(degree + uniform(engine))));
+
+        row.clear();
+        for (spla::uint k = 0; k < count; k++) {
+            const double x = uniform(engine);
+            row.push_back(std::min(n - 1, static_cast<spla::uint>((powerlaw ? x * x : x) * n)));
+        }
+
+        std::sort(row.begin(), row.end());
+        row.erase(std::unique(row.begin(), row.end()), row.end());
+
+        for (spla::uint j : row) {
+            graph.Ai.push_back(i);
+            graph.Aj.push_back(j);
+        }
+    }
+
+    return graph;
+}
+
+inline spla::ref_ptr<spla::Matrix> bench_make_matrix(const BenchGraph& graph) {
+    auto M = spla::Matrix::make(graph.n, graph.n, spla::INT);
+
+    for (std::size_t k = 0; k < graph.Ai.size(); k++) {
+        M->set_int(graph.Ai[k], graph.Aj[k], 1);
+    }
+
+    return M;
+}
+
+inline spla::ref_ptr<spla::Vector> bench_make_vector(spla::uint n, double density, unsigned int seed) {
+    auto v = spla::Vector::make(n, spla::INT);
+
+    std::mt19937                           engine(seed);
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+
+    for (spla::uint i = 0; i < n; i++) {
+        if (uniform(engine) < density) {
+            v->set_int(i, 1 + static_cast<int>(i % 7));
+        }
+    }
+
+    return v;
+}
+
+inline std::string bench_make_key(const std::string& kernel, const std::string& backend, const BenchGraph& graph) {
+    std::stringstream key;
+    key << kernel << "/" << backend << "/" << graph.dist << "/n=" << graph.n << "/d=" << graph.avg_degree;
+    return key.str();
+}
+
+inline BenchResult bench_run(const BenchCase& bench_case, const std::string& backend, const BenchGraph& graph, int warmup, int iters) {
+    using clock = std::chrono::steady_clock;
+
+    for (int i = 0; i < warmup; i++) {
+        if (bench_case.prepare) bench_case.prepare();
+        bench_case.run();
+    }
+
+    std::vector<double> times;
+    times.reserve(iters);
+
+    for (int i = 0; i < iters; i++) {
+        if (bench_case.prepare) bench_case.prepare();
+        auto start = clock::now();
+        bench_case.run();
+        spla::Library::get()->wait();
+        auto end = clock::now();
+        times.push_back(std::chrono::duration<double, std::milli>(end - start).count());
+    }
+
+    std::sort(times.begin(), times.end());
+
+    BenchResult result;
+    result.key        = bench_make_key(bench_case.kernel, backend, graph);
+    result.kernel     = bench_case.kernel;
+    result.backend    = backend;
+    result.dist       = graph.dist;
+    result.n          = graph.n;
+    result.avg_degree = graph.avg_degree;
+    result.nnz        = graph.Ai.size();
+    result.iters      = iters;
+    result.min_ms     = times.front();
+    result.median_ms  = times[times.size() / 2];
+    result.mean_ms    = std::accumulate(times.begin(), times.end(), 0.0) / static_cast<double>(times.size());
+
+    const double seconds = result.median_ms * 1e-3;
+    result.gbps          = seconds > 0 ? bench_case.bytes / seconds * 1e-9 : 0.0;
+    result.eps           = seconds > 0 ? bench_case.edges / seconds : 0.0;
+
+    return result;
+}
+
+/**
+ * Write results in stable JSON schema. Each result is written on a separate line,
+ * so files can be diffed and read back without full JSON parser.
+ */
+inline void bench_write_json(std::ostream& out, const std::string& accelerator, const std::vector<BenchResult>& results) {
+    out << "{\n"
+        << "\"schema\": \"" << SPLA_BENCH_SCHEMA << "\",\n"
+        << "\"accelerator\": \"" << accelerator << "\",\n"
+        << "\"results\": [\n";
+
+    for (std::size_t i = 0; i < results.size(); i++) {
+        const BenchResult& r = results[i];
+
+        out << "{\"key\":\"" << r.key << "\""
+            << ",\"kernel\":\"" << r.kernel << "\""
+            << ",\"backend\":\"" << r.backend << "\""
+            << ",\"dist\":\"" << r.dist << "\""
+            << ",\"n\":" << r.n
+            << ",\"avg_degree\":" << r.avg_degree
+            << ",\"nnz\":" << r.nnz
+            << ",\"iters\":" << r.iters
+            << ",\"time_ms\":{\"min\":" << r.min_ms << ",\"median\":" << r.median_ms << ",\"mean\":" << r.mean_ms << "}"
+            << ",\"gb_per_sec\":" << r.gbps
+            << ",\"edges_per_sec\":" << r.eps << "}"
+            << (i + 1 < results.size() ? ",\n" : "\n");
+    }
+
+    out << "]\n}\n";
+}
+
+/**
+ * Read median times of results from file previously written by `bench_write_json`.
+ *
+ * @return True if file exists and has expected schema
+ */
+inline bool bench_read_baseline(const std::string& path, std::map<std::string, double>& medians) {
+    std::ifstream file(path);
+    std::string   line;
+    bool          schema = false;
+
+    if (!file.is_open()) {
+        return false;
+    }
+
+    auto find_value = [](const std::string& s, const std::string& name, std::size_t& pos) {
+        pos = s.find("\"" + name + "\":");
+        if (pos == std::string::npos) return false;
+        pos += name.size() + 3;
+        return true;
+    };
+
+    while (std::getline(file, line)) {
+        std::size_t pos;
+
+        if (line.find(SPLA_BENCH_SCHEMA) != std::string::npos) {
+            schema = true;
+        }
+        if (!find_value(line, "key", pos)) {
+            continue;
+        }
+
+        const std::size_t key_begin = pos + 1;
+        const std::size_t key_end   = line.find('"', key_begin);
+
+        if (key_end != std::string::npos && find_value(line, "median", pos)) {
+            medians[line.substr(key_begin, key_end - key_begin)] = std::stod(line.substr(pos));
+        }
+    }
+
+    return schema;
+}
+
+/**
+ * Compare results against baseline medians and print report.
+ *
+ * Case is regressed if its median is slower than baseline by more than `threshold`
+ * relative and `noise_ms` absolute, so sub-microsecond kernels do not flap.
+ *
+ * @return Number of regressed cases
+ */
+inline int bench_compare(std::ostream&                        out,
+                         const std::vector<BenchResult>&      results,
+                         const std::map<std::string, double>& baseline,
+                         double                               threshold,
+                         double                               noise_ms) {
+    int regressions = 0;
+    int missing     = 0;
+
+    out << std::left << std::setw(56) << "case" << std::right
+        << std::setw(12) << "base(ms)" << std::setw(12) << "curr(ms)" << std::setw(10) << "ratio" << "\n";
+
+    for (const BenchResult& r : results) {
+        auto entry = baseline.find(r.key);
+
+        if (entry == baseline.end()) {
+            missing += 1;
+            continue;
+        }
+
+        const double base      = entry->second;
+        const double ratio     = base > 0 ? r.median_ms / base : 1.0;
+        const bool   regressed = ratio > 1.0 + threshold && r.median_ms - base > noise_ms;
+
+        regressions += regressed ? 1 : 0;
+
+        out << std::left << std::setw(56) << r.key << std::right << std::fixed << std::setprecision(4)
+            << " " << std::setw(11) << base << " " << std::setw(11) << r.median_ms
+            << " " << std::setprecision(3) << std::setw(9) << ratio
+            << (regressed ? "  REGRESSION" : (ratio < 1.0 - threshold ? "  improved" : "")) << "\n";
+        out.unsetf(std::ios::floatfield);
+    }
+
+    out << "compared: " << results.size() - missing << " missing in baseline: " << missing << " regressions: " << regressions << std::endl;
+
+    return regressions;
+}
+
+#endif//SPLA_BENCH_COMMON_HPP
@@ -0,0 +1,321 @@
+/**********************************************************************************/
+/* This file is part of spla project                                              */
+/* https://github.com/SparseLinearAlgebra/spla                                    */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2023 SparseLinearAlgebra                                         */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#include "bench_common.hpp"
+
+#include <cxxopts.hpp>
+
+#include <core/tmatrix.hpp>
+#include <core/tvector.hpp>
+
+static const char* FORMAT_MATRIX_NAMES[] = {"CpuLil", "CpuDok", "CpuCoo", "CpuCsr", "CpuCsc", "AccCoo", "AccCsr", "AccCsc"};
+static const char* FORMAT_VECTOR_NAMES[] = {"CpuDok", "CpuDense", "CpuCoo", "AccDense", "AccCoo", "CpuBitmap"};
+
+static bool is_acc(spla::FormatMatrix format) { return format >= spla::FormatMatrix::AccCoo; }
+static bool is_acc(spla::FormatVector format) { return format == spla::FormatVector::AccDense || format == spla::FormatVector::AccCoo; }
+
+/**
+ * Objects shared by all kernel cases of single generated graph.
+ */
+struct BenchInputs {
+    spla::ref_ptr<spla::Matrix> M;
+    spla::ref_ptr<spla::Matrix> R;
+    spla::ref_ptr<spla::Vector> dense;
+    spla::ref_ptr<spla::Vector> sparse;
+    spla::ref_ptr<spla::Vector> r;
+    spla::ref_ptr<spla::Scalar> r_scalar;
+    spla::ref_ptr<spla::Scalar> zero;
+    spla::ref_ptr<spla::OpUnary> op_inc;
+    double                       frontier = 0;
+};
+
+static std::vector<BenchCase> make_kernel_cases(const BenchGraph& graph, BenchInputs& in, spla::uint max_mxmT_n) {
+    const double n       = graph.n;
+    const double nnz     = static_cast<double>(graph.Ai.size());
+    const double f       = in.frontier * n;
+    const double nnz_f   = nnz * in.frontier;
+    const double idx_val = sizeof(spla::uint) + sizeof(int);
+
+    std::vector<BenchCase> cases;
+
+    cases.push_back({"mxv", nullptr, [&in]() {
+                         spla::exec_mxv_masked(in.r, spla::ref_ptr<spla::Vector>(), in.M, in.dense, spla::MULT_INT, spla::PLUS_INT, spla::ALWAYS_INT, in.zero);
+                     },
+                     nnz * idx_val + (n + 1) * sizeof(spla::uint) + 2 * n * sizeof(int), nnz});
+    cases.push_back({"vxm", nullptr, [&in]() {
+                         spla::exec_vxm_masked(in.r, spla::ref_ptr<spla::Vector>(), in.sparse, in.M, spla::MULT_INT, spla::PLUS_INT, spla::ALWAYS_INT, in.zero);
+                     },
+                     nnz_f * idx_val + f * idx_val + n * sizeof(int), nnz_f});
+
+    if (graph.n <= max_mxmT_n) {
+        const double pairs = nnz * 2.0 * graph.avg_degree;
+        cases.push_back({"mxmT_masked", nullptr, [&in]() {
+                             spla::exec_mxmT_masked(in.R, in.M, in.M, in.M, spla::MULT_INT, spla::PLUS_INT, spla::ALWAYS_INT, in.zero);
+                         },
+                         pairs * idx_val, pairs});
+    }
+
+    cases.push_back({"m_reduce_by_row", nullptr, [&in]() {
+                         spla::exec_m_reduce_by_row(in.r, in.M, spla::PLUS_INT, in.zero);
+                     },
+                     nnz * idx_val + n * 2 * sizeof(int), 0});
+    cases.push_back({"m_reduce", nullptr, [&in]() {
+                         spla::exec_m_reduce(in.r_scalar, in.zero, in.M, spla::PLUS_INT);
+                     },
+                     nnz * sizeof(int), 0});
+    cases.push_back({"v_eadd", nullptr, [&in]() {
+                         spla::exec_v_eadd(in.r, in.dense, in.dense, spla::PLUS_INT);
+                     },
+                     3 * n * sizeof(int), 0});
+    cases.push_back({"v_eadd_fdb", nullptr, [&in]() {
+                         spla::exec_v_eadd_fdb(in.r, in.sparse, in.dense, spla::PLUS_INT);
+                     },
+                     f * idx_val + 2 * n * sizeof(int), 0});
+    cases.push_back({"v_assign_masked", nullptr, [&in]() {
+                         spla::exec_v_assign_masked(in.r, in.sparse, in.zero, spla::SECOND_INT, spla::NQZERO_INT);
+                     },
+                     f * idx_val + n * sizeof(int), 0});
+    cases.push_back({"v_map", nullptr, [&in]() {
+                         spla::exec_v_map(in.r, in.dense, in.op_inc);
+                     },
+                     2 * n * sizeof(int), 0});
+    cases.push_back({"v_reduce", nullptr, [&in]() {
+                         spla::exec_v_reduce(in.r_scalar, in.zero, in.dense, spla::PLUS_INT);
+                     },
+                     n * sizeof(int), 0});
+    cases.push_back({"v_eadd_reduce", nullptr, [&in]() {
+                         spla::exec_v_eadd_reduce(in.r_scalar, in.zero, in.dense, in.dense, spla::MINUS_POW2_INT, spla::PLUS_INT);
+                     },
+                     2 * n * sizeof(int), 0});
+    cases.push_back({"v_count_mf", nullptr, [&in]() {
+                         spla::exec_v_count_mf(in.r_scalar, in.sparse);
+                     },
+                     f * idx_val, 0});
+
+    return cases;
+}
+
+/**
+ * Cases for every registered storage conversion. Conversion is measured from state
+ * where only source format is valid, so storage manager applies exactly that converter.
+ * Each case converts its own fresh copy of inputs: dropping other formats is lossy for some
+ * sources (bitmap keeps structure only), so shared inputs of kernel cases must stay intact.
+ */
+static std::vector<BenchCase> make_conversion_cases(const BenchGraph& graph, const BenchInputs& in, unsigned int seed, bool acc) {
+    using TMatrix = spla::TMatrix<spla::T_INT>;
+    using TVector = spla::TVector<spla::T_INT>;
+
+    // Copy of the case being run; single slot, so only one copy is alive at a time
+    struct Copy {
+        int                         owner = -1;
+        spla::ref_ptr<spla::Matrix> M;
+        spla::ref_ptr<spla::Vector> v;
+    };
+
+    std::vector<BenchCase> cases;
+
+    auto         copy     = std::make_shared<Copy>();
+    const double nnz      = static_cast<double>(graph.Ai.size());
+    const double f        = in.frontier * graph.n;
+    const double idx_val  = sizeof(spla::uint) + sizeof(int);
+    const double frontier = in.frontier;
+    const auto*  p_graph  = &graph;
+
+    auto acquire_matrix = [copy, p_graph](int owner) {
+        if (copy->owner != owner) {
+            copy->v.reset();
+            copy->M     = bench_make_matrix(*p_graph);
+            copy->owner = owner;
+        }
+        return dynamic_cast<TMatrix*>(copy->M.get());
+    };
+    auto acquire_vector = [copy, p_graph, frontier, seed](int owner) {
+        if (copy->owner != owner) {
+            copy->M.reset();
+            copy->v     = bench_make_vector(p_graph->n, frontier, seed);
+            copy->owner = owner;
+        }
+        return dynamic_cast<TVector*>(copy->v.get());
+    };
+
+    for (auto conversion : TMatrix::get_storage_manager()->get_conversions()) {
+        const auto from  = conversion.first;
+        const auto to    = conversion.second;
+        const int  owner = static_cast<int>(cases.size());
+
+        if ((is_acc(from) || is_acc(to)) != acc) continue;
+
+        cases.push_back({std::string("convert_m_") + FORMAT_MATRIX_NAMES[static_cast<int>(from)] + "_" + FORMAT_MATRIX_NAMES[static_cast<int>(to)],
+                         [acquire_matrix, owner, from]() { acquire_matrix(owner)->validate_rwd(from); },
+                         [acquire_matrix, owner, to]() { acquire_matrix(owner)->validate_rw(to); },
+                         2 * nnz * idx_val, 0});
+    }
+
+    for (auto conversion : TVector::get_storage_manager()->get_conversions()) {
+        const auto from  = conversion.first;
+        const auto to    = conversion.second;
+        const int  owner = static_cast<int>(cases.size());
+
+        if ((is_acc(from) || is_acc(to)) != acc) continue;
+
+        cases.push_back({std::string("convert_v_") + FORMAT_VECTOR_NAMES[static_cast<int>(from)] + "_" + FORMAT_VECTOR_NAMES[static_cast<int>(to)],
+                         [acquire_vector, owner, from]() { acquire_vector(owner)->validate_rwd(from); },
+                         [acquire_vector, owner, to]() { acquire_vector(owner)->validate_rw(to); },
+                         2 * f * idx_val, 0});
+    }
+
+    return cases;
+}
+
+int main(int argc, const char* const* argv) {
+    cxxopts::Options options("spla_bench", "micro-benchmarks of library kernels and storage conversions");
+    options.add_option("", cxxopts::Option("h,help", "display help info", cxxopts::value<bool>()->default_value("false")));
+    options.add_option("", cxxopts::Option("sizes", "number of vertices of generated graphs", cxxopts::value<std::vector<spla::uint>>()->default_value("1024,16384,131072")));
+    options.add_option("", cxxopts::Option("degrees", "average out degree of generated graphs", cxxopts::value<std::vector<spla::uint>>()->default_value("4,16")));
+    options.add_option("", cxxopts::Option("dists", "degree distributions (uniform, powerlaw, rmat, grid)", cxxopts::value<std::vector<std::string>>()->default_value("uniform,powerlaw")));
+    options.add_option("", cxxopts::Option("frontier", "density of sparse input vectors", cxxopts::value<double>()->default_value("0.05")));
+    options.add_option("", cxxopts::Option("max-mxmT-size", "max number of vertices to run mxmT_masked", cxxopts::value<spla::uint>()->default_value("16384")));
+    options.add_option("", cxxopts::Option("filter", "run only cases which key contains substring", cxxopts::value<std::string>()->default_value("")));
+    options.add_option("", cxxopts::Option("warmup", "number of untimed runs per case", cxxopts::value<int>()->default_value("1")));
+    options.add_option("", cxxopts::Option("niters", "number of timed runs per case", cxxopts::value<int>()->default_value("5")));
+    options.add_option("", cxxopts::Option("seed", "seed of graphs generator", cxxopts::value<unsigned int>()->default_value("1")));
+    options.add_option("", cxxopts::Option("run-cpu", "run cases with cpu backend", cxxopts::value<bool>()->default_value("true")));
+    options.add_option("", cxxopts::Option("run-gpu", "run cases with gpu (acc) backend if available", cxxopts::value<bool>()->default_value("true")));
+    options.add_option("", cxxopts::Option("platform", "id of platform to run", cxxopts::value<int>()->default_value("0")));
+    options.add_option("", cxxopts::Option("device", "id of device to run", cxxopts::value<int>()->default_value("0")));
+    options.add_option("", cxxopts::Option("out", "path to save results json", cxxopts::value<std::string>()->default_value("")));
+    options.add_option("", cxxopts::Option("baseline", "path to baseline results json to compare with", cxxopts::value<std::string>()->default_value("")));
+    options.add_option("", cxxopts::Option("threshold", "relative slowdown of median to flag regression", cxxopts::value<double>()->default_value("0.1")));
+    options.add_option("", cxxopts::Option("noise-ms", "absolute slowdown of median below which case is not flagged", cxxopts::value<double>()->default_value("0.02")));
+
+    cxxopts::ParseResult args;
+
+    try {
+        args = options.parse(argc, argv);
+    } catch (const std::exception& e) {
+        std::cerr << "failed parse input arguments: " << e.what() << std::endl;
+        return 1;
+    }
+
+    if (args["help"].as<bool>()) {
+        std::cout << options.help();
+        return 0;
+    }
+
+    const auto        sizes    = args["sizes"].as<std::vector<spla::uint>>();
+    const auto        degrees  = args["degrees"].as<std::vector<spla::uint>>();
+    const auto        dists    = args["dists"].as<std::vector<std::string>>();
+    const std::string filter   = args["filter"].as<std::string>();
+    const int         warmup   = args["warmup"].as<int>();
+    const int         niters   = std::max(1, args["niters"].as<int>());
+    const unsigned    seed     = args["seed"].as<unsigned int>();
+    const double      frontier = args["frontier"].as<double>();
+
+    std::string    acc_info;
+    spla::Library* library = spla::Library::get();
+    library->set_platform(args["platform"].as<int>());
+    library->set_device(args["device"].as<int>());
+    library->set_queues_count(1);
+
+    const bool has_acc = library->get_accelerator_info(acc_info) == spla::Status::Ok;
+    std::cout << "env: " << (has_acc ? acc_info : "no acceleration") << std::endl;
+
+    std::vector<std::string> backends;
+    if (args["run-cpu"].as<bool>()) backends.emplace_back("cpu");
+    if (args["run-gpu"].as<bool>() && has_acc) backends.emplace_back("acc");
+
+    std::vector<BenchResult> results;
+
+    for (const std::string& dist : dists) {
+        for (spla::uint n : sizes) {
+            for (spla::uint degree : degrees) {
+                BenchGraph  graph = bench_make_graph(dist, n, degree, seed);
+                BenchInputs in;
+
+                in.M        = bench_make_matrix(graph);
+                in.R        = spla::Matrix::make(n, n, spla::INT);
+                in.dense    = spla::Vector::make(n, spla::INT);
+                in.sparse   = bench_make_vector(n, frontier, seed + 1);
+                in.r        = spla::Vector::make(n, spla::INT);
+                in.r_scalar = spla::Scalar::make_int(0);
+                in.zero     = spla::Scalar::make_int(0);
+                in.op_inc   = spla::OpUnary::make_int("inc", "(int x) { return x + 1; }", [](int x) { return x + 1; });
+                in.frontier = frontier;
+                in.dense->fill_with(spla::Scalar::make_int(1));
+
+                std::cout << "graph " << dist << " n=" << n << " d=" << degree << " nnz=" << graph.Ai.size() << std::endl;
+
+                for (const std::string& backend : backends) {
+                    library->set_force_no_acceleration(backend == "cpu");
+
+                    std::vector<BenchCase> cases      = make_kernel_cases(graph, in, args["max-mxmT-size"].as<spla::uint>());
+                    std::vector<BenchCase> conversion = make_conversion_cases(graph, in, seed + 1, backend == "acc");
+                    cases.insert(cases.end(), conversion.begin(), conversion.end());
+
+                    for (const BenchCase& bench_case : cases) {
+                        if (!filter.empty() && bench_make_key(bench_case.kernel, backend, graph).find(filter) == std::string::npos) {
+                            continue;
+                        }
+
+                        BenchResult result = bench_run(bench_case, backend, graph, warmup, niters);
+                        std::cout << " - " << result.key << " median: " << result.median_ms << " ms"
+                                  << " GB/s: " << result.gbps;
+                        if (result.eps > 0) std::cout << " MTEPS: " << result.eps * 1e-6;
+                        std::cout << std::endl;
+                        results.push_back(std::move(result));
+                    }
+                }
+            }
+        }
+    }
+
+    const std::string out_path = args["out"].as<std::string>();
+    if (!out_path.empty()) {
+        std::ofstream file(out_path);
+        if (!file.is_open()) {
+            std::cerr << "failed to open " << out_path << std::endl;
+            return 1;
+        }
+        bench_write_json(file, has_acc ? acc_info : "none", results);
+        std::cout << "saved results to " << out_path << std::endl;
+    }
+
+    const std::string baseline_path = args["baseline"].as<std::string>();
+    if (!baseline_path.empty()) {
+        std::map<std::string, double> baseline;
+
+        if (!bench_read_baseline(baseline_path, baseline)) {
+            std::cerr << "failed to read baseline " << baseline_path << std::endl;
+            return 1;
+        }
+
+        const int regressions = bench_compare(std::cout, results, baseline, args["threshold"].as<double>(), args["noise-ms"].as<double>());
+        return regressions > 0 ? 2 : 0;
+    }
+
+    return 0;
+}
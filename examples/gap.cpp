@@ -0,0 +1,450 @@
+/**********************************************************************************/
+/* This file is part of spla project                                              */
+/* https://github.com/SparseLinearAlgebra/spla                                    */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2023 SparseLinearAlgebra                                         */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#include "common.hpp"
+#include "options.hpp"
+
+#include <spla.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <limits>
+#include <random>
+#include <sstream>
+#include <unordered_set>
+
+#define OPT_ALGO        "algo"
+#define OPT_GEN         "gen"
+#define OPT_SCALE       "scale"
+#define OPT_EDGE_FACTOR "edge-factor"
+#define OPT_SEED        "seed"
+#define OPT_WARMUP      "warmup"
+#define OPT_OUT         "out"
+
+/**
+ * Single timed trial of kernel from fixed source.
+ */
+struct GapTrial {
+    spla::uint source    = 0;
+    double     prep_ms   = 0;// graph preprocessing done by algorithm before kernel (tc orientation)
+    double     kernel_ms = 0;
+    double     edges     = 0;
+    double     gteps     = 0;
+    int        valid     = -1;// -1 not verified, 0 failed, 1 passed
+};
+
+/**
+ * Trials of kernel on single backend.
+ */
+struct GapRun {
+    std::string           backend;
+    double                conversion_ms = 0;
+    std::vector<GapTrial> trials;
+};
+
+static double gap_elapsed_ms(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+static double gap_median(std::vector<double> values) {
+    if (values.empty()) return 0.0;
+    std::sort(values.begin(), values.end());
+    return values[values.size() / 2];
+}
+
+/** Sum time of storage conversions recorded by dispatch trace since last drain */
+static double gap_drain_conversions_ms() {
+    const std::string field = "\"conversions_ns\":";
+    std::string       json;
+    double            total = 0.0;
+
+    spla::Library::get()->dispatch_trace_drain_json(json);
+
+    for (std::size_t pos = json.find(field); pos != std::string::npos; pos = json.find(field, pos)) {
+        pos += field.size();
+        total += std::stod(json.substr(pos, 32));
+    }
+
+    return total * 1e-6;
+}
+
+/** Deterministic edge weight in [1, 255], symmetric for undirected graphs */
+static float gap_weight(spla::uint i, spla::uint j) {
+    std::uint64_t h = (std::uint64_t(std::min(i, j)) << 32u) | std::max(i, j);
+    h ^= h >> 33u;
+    h *= 0xff51afd7ed558ccdull;
+    h ^= h >> 33u;
+    return static_cast<float>(1 + h % 255);
+}
+
+int main(int argc, const char* const* argv) {
+    std::shared_ptr<cxxopts::Options> options = make_options("gap", "end-to-end algorithms benchmark following GAP methodology");
+    options->add_option("", cxxopts::Option(OPT_ALGO, "algorithm to run (bfs, ms_bfs, sssp, pr, tc)", cxxopts::value<std::string>()->default_value("bfs")));
+    options->add_option("", cxxopts::Option(OPT_GEN, "generate graph instead of loading (rmat, uniform, grid2d, grid3d)", cxxopts::value<std::string>()->default_value("")));
+    options->add_option("", cxxopts::Option(OPT_SCALE, "log2 of number of vertices of generated graph", cxxopts::value<int>()->default_value("16")));
+    options->add_option("", cxxopts::Option(OPT_EDGE_FACTOR, "edges per vertex of generated graph", cxxopts::value<int>()->default_value("16")));
+    options->add_option("", cxxopts::Option(OPT_SEED, "seed of generator and trials sources", cxxopts::value<unsigned int>()->default_value("1")));
+    options->add_option("", cxxopts::Option(OPT_WARMUP, "run untimed trial to measure format conversions", cxxopts::value<bool>()->default_value("true")));
+    options->add_option("", cxxopts::Option(OPT_OUT, "path to save results json", cxxopts::value<std::string>()->default_value("")));
+    cxxopts::ParseResult args;
+    int                  ret;
+
+    if (parse_options(argc, argv, options, args, ret)) {
+        std::cerr << "failed to parse options";
+        return ret;
+    }
+
+    const std::string algo    = args[OPT_ALGO].as<std::string>();
+    const std::string gen     = args[OPT_GEN].as<std::string>();
+    const unsigned    seed    = args[OPT_SEED].as<unsigned int>();
+    const int         n_iters = args[OPT_NITERS].as<int>();
+    const bool        run_ref = args[OPT_RUN_REF].as<bool>();
+    const float       alpha   = args[OPT_ALPHA].as<float>();
+    const float       eps     = args[OPT_EPS].as<float>();
+    const float       delta   = args[OPT_DELTA].as<float>();
+
+    if (algo != "bfs" && algo != "ms_bfs" && algo != "sssp" && algo != "pr" && algo != "tc") {
+        std::cerr << "unknown algorithm " << algo << std::endl;
+        return 1;
+    }
+
+    // Load: read or generate graph edges
+
+    spla::MtxLoader      loader;
+    spla::GraphGenerator generator(seed);
+    std::string          graph_name;
+    bool                 loaded = false;
+
+    auto load_start = std::chrono::steady_clock::now();
+
+    if (gen.empty()) {
+        graph_name = args[OPT_MTXPATH].as<std::string>();
+        loaded     = loader.load(graph_name);
+    } else {
+        const auto scale = static_cast<spla::uint>(args[OPT_SCALE].as<int>());
+        const auto ef    = static_cast<spla::uint>(args[OPT_EDGE_FACTOR].as<int>());
+
+        if (gen == "rmat") loaded = generator.generate_rmat(scale, ef);
+        if (gen == "uniform") loaded = generator.generate_uniform(spla::uint(1) << scale, std::size_t(ef) << scale);
+        if (gen == "grid2d") loaded = generator.generate_grid(spla::uint(1) << (scale / 2), spla::uint(1) << (scale - scale / 2));
+        if (gen == "grid3d") loaded = generator.generate_grid(spla::uint(1) << (scale / 3), spla::uint(1) << (scale / 3), spla::uint(1) << (scale - 2 * (scale / 3)));
+
+        graph_name = gen + "-s" + std::to_string(scale) + "-ef" + std::to_string(ef);
+    }
+
+    const double load_ms = gap_elapsed_ms(load_start);
+
+    if (!loaded) {
+        std::cerr << "failed to load graph";
+        return 1;
+    }
+
+    const auto&       Ai  = gen.empty() ? loader.get_Ai() : generator.get_Ai();
+    const auto&       Aj  = gen.empty() ? loader.get_Aj() : generator.get_Aj();
+    const spla::uint  N   = gen.empty() ? loader.get_n_rows() : generator.get_n_rows();
+    const std::size_t nnz = Ai.size();
+
+    std::string    acc_info;
+    spla::Library* library = spla::Library::get();
+    library->set_platform(args[OPT_PLATFORM].as<int>());
+    library->set_device(args[OPT_DEVICE].as<int>());
+    library->set_queues_count(1);
+    const bool has_acc = library->get_accelerator_info(acc_info) == spla::Status::Ok;
+    std::cout << "env: " << (has_acc ? acc_info : "no acceleration") << std::endl;
+
+    // Build: fill library matrix with values required by algorithm
+
+    std::vector<float> degrees(N, 0.0f);
+    for (std::size_t k = 0; k < nnz; ++k) {
+        degrees[Ai[k]] += 1.0f;
+    }
+
+    const bool                      is_float = algo == "sssp" || algo == "pr";
+    spla::ref_ptr<spla::Matrix>     A        = spla::Matrix::make(N, N, is_float ? spla::FLOAT : spla::INT);
+    spla::ref_ptr<spla::Matrix>     B        = spla::Matrix::make(N, N, spla::INT);
+    spla::ref_ptr<spla::Matrix>     L        = spla::Matrix::make(N, N, spla::INT);
+    spla::ref_ptr<spla::Vector>     v        = spla::Vector::make(N, is_float ? spla::FLOAT : spla::INT);
+    spla::ref_ptr<spla::Descriptor> desc     = spla::Descriptor::make();
+
+    desc->set_traversal_mode(static_cast<spla::Descriptor::TraversalMode>(args[OPT_PUSH_PULL].as<int>() - 1));
+    desc->set_push_pull_alpha(args[OPT_PP_ALPHA].as<float>());
+    desc->set_push_pull_beta(args[OPT_PP_BETA].as<float>());
+
+    auto build_start = std::chrono::steady_clock::now();
+
+    for (std::size_t k = 0; k < nnz; ++k) {
+        if (algo == "bfs" || algo == "ms_bfs") A->set_int(Ai[k], Aj[k], 1);
+        if (algo == "sssp") A->set_float(Ai[k], Aj[k], gap_weight(Ai[k], Aj[k]));
+        if (algo == "pr") A->set_float(Ai[k], Aj[k], alpha / degrees[Ai[k]]);
+        if (algo == "tc" && Ai[k] != Aj[k]) A->set_int(Ai[k], Aj[k], 1);
+    }
+
+    const double build_ms = gap_elapsed_ms(build_start);
+
+    // Sources: fixed pseudo-random vertices with non-zero degree, same for all backends
+
+    std::vector<spla::uint> sources;
+    {
+        std::mt19937_64                           engine(seed);
+        std::uniform_int_distribution<spla::uint> dist(0, N - 1);
+
+        for (int i = 0; i < n_iters && nnz > 0; ++i) {
+            spla::uint s;
+            do { s = dist(engine); } while (degrees[s] == 0.0f);
+            sources.push_back(s);
+        }
+    }
+
+    // Reference adjacency lists for validation, not timed
+
+    std::vector<std::vector<spla::uint>> ref_Ai(run_ref ? N : 0);
+    std::vector<std::vector<float>>      ref_Ax(run_ref ? N : 0);
+    int                                  ref_ntrins = -1;
+    std::vector<float>                   ref_pr;
+
+    if (run_ref) {
+        for (std::size_t k = 0; k < nnz; ++k) {
+            if (algo == "tc" && Ai[k] <= Aj[k]) continue;
+            ref_Ai[Ai[k]].push_back(Aj[k]);
+            if (algo == "sssp") ref_Ax[Ai[k]].push_back(gap_weight(Ai[k], Aj[k]));
+            if (algo == "pr") ref_Ax[Ai[k]].push_back(alpha / degrees[Ai[k]]);
+        }
+        if (algo == "tc") {
+            for (auto& row : ref_Ai) {
+                std::sort(row.begin(), row.end());
+                row.erase(std::unique(row.begin(), row.end()), row.end());
+            }
+            spla::tc_naive(ref_ntrins, ref_Ai, desc);
+        }
+        if (algo == "pr") {
+            ref_pr.resize(N);
+            spla::pr_naive(ref_pr, ref_Ai, ref_Ax, alpha, eps, desc);
+        }
+    }
+
+    // Trials
+
+    // Multi-source bfs explores all sources within single trial
+    std::vector<spla::ref_ptr<spla::Vector>> ms_levels(algo == "ms_bfs" ? sources.size() : 0);
+    for (auto& levels : ms_levels) levels = spla::Vector::make(N, spla::INT);
+
+    auto run_trial = [&](spla::uint s, GapTrial& trial) {
+        int ntrins = -1;
+
+        v->clear();
+        B->clear();
+        L->clear();
+        for (auto& levels : ms_levels) levels->clear();
+
+        // Full symmetric graph is oriented by degree, timed apart from counting itself
+        if (algo == "tc") {
+            auto prep_start = std::chrono::steady_clock::now();
+            spla::tc_orient(L, A, desc);
+            library->wait();
+            trial.prep_ms = gap_elapsed_ms(prep_start);
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        if (algo == "bfs") spla::bfs(v, A, s, desc);
+        if (algo == "ms_bfs") spla::ms_bfs(ms_levels, A, sources, desc);
+        if (algo == "sssp" && delta > 0.0f) spla::sssp_delta(v, A, s, delta, desc);
+        if (algo == "sssp" && delta <= 0.0f) spla::sssp(v, A, s, desc);
+        if (algo == "pr") spla::pr(v, A, alpha, eps, desc);
+        if (algo == "tc") spla::tc(ntrins, L, B, desc);
+        library->wait();
+        trial.kernel_ms = gap_elapsed_ms(start);
+        trial.source    = s;
+
+        // Traversed edges: out edges of all reached vertices
+        if (algo == "bfs" || algo == "sssp") {
+            for (spla::uint i = 0; i < N; ++i) {
+                int   level    = 0;
+                float distance = std::numeric_limits<float>::max();
+                if (algo == "bfs") v->get_int(i, level);
+                if (algo == "sssp") v->get_float(i, distance);
+                if (level > 0 || distance < std::numeric_limits<float>::max()) trial.edges += degrees[i];
+            }
+            trial.gteps = trial.edges / (trial.kernel_ms * 1e6);
+        }
+        if (algo == "ms_bfs") {
+            for (const auto& levels : ms_levels) {
+                for (spla::uint i = 0; i < N; ++i) {
+                    int level = 0;
+                    levels->get_int(i, level);
+                    if (level > 0) trial.edges += degrees[i];
+                }
+            }
+            trial.gteps = trial.edges / (trial.kernel_ms * 1e6);
+        }
+
+        if (!run_ref) return;
+
+        bool valid = true;
+
+        if (algo == "bfs") {
+            std::vector<int> ref_v(N);
+            spla::bfs_naive(ref_v, ref_Ai, s, desc);
+            for (spla::uint i = 0; i < N && valid; ++i) {
+                int value;
+                v->get_int(i, value);
+                valid = value == ref_v[i];
+            }
+        }
+        if (algo == "ms_bfs") {
+            std::vector<int> ref_v(N);
+            for (std::size_t k = 0; k < sources.size() && valid; ++k) {
+                spla::bfs_naive(ref_v, ref_Ai, sources[k], desc);
+                for (spla::uint i = 0; i < N && valid; ++i) {
+                    int value;
+                    ms_levels[k]->get_int(i, value);
+                    valid = value == ref_v[i];
+                }
+            }
+        }
+        if (algo == "sssp" || algo == "pr") {
+            std::vector<float> ref_v(N);
+            if (algo == "sssp") spla::sssp_naive(ref_v, ref_Ai, ref_Ax, s, desc);
+            if (algo == "pr") ref_v = ref_pr;
+            for (spla::uint i = 0; i < N && valid; ++i) {
+                float value;
+                v->get_float(i, value);
+                valid = std::abs(value - ref_v[i]) <= 0.005f * std::max(1.0f, std::abs(ref_v[i]));
+            }
+        }
+        if (algo == "tc") {
+            valid = ntrins == ref_ntrins;
+        }
+
+        trial.valid = valid ? 1 : 0;
+    };
+
+    std::vector<std::string> backends;
+    if (args[OPT_RUN_CPU].as<bool>()) backends.emplace_back("cpu");
+    if (args[OPT_RUN_GPU].as<bool>() && has_acc) backends.emplace_back("acc");
+
+    std::vector<GapRun> runs;
+    bool                all_valid  = true;
+    const bool          has_source = algo == "bfs" || algo == "sssp";
+
+    std::vector<spla::uint> trial_sources = sources;
+    if (algo == "ms_bfs" && !sources.empty()) trial_sources.assign(1, sources.front());
+
+    std::cout << "gap " << algo << " graph: " << graph_name << " n: " << N << " nnz: " << nnz << std::endl;
+    std::cout << "load(ms): " << load_ms << " build(ms): " << build_ms << std::endl;
+
+    for (const std::string& backend : backends) {
+        GapRun run;
+        run.backend = backend;
+        library->set_force_no_acceleration(backend == "cpu");
+
+        // Conversions of graph into formats used by kernels happen once, on first run
+        if (args[OPT_WARMUP].as<bool>() && !sources.empty()) {
+            GapTrial warmup;
+            library->dispatch_trace_enable(true);
+            gap_drain_conversions_ms();
+            run_trial(sources.front(), warmup);
+            run.conversion_ms = gap_drain_conversions_ms();
+            library->dispatch_trace_enable(false);
+        }
+
+        std::cout << "[" << backend << "] conversion(ms): " << run.conversion_ms << std::endl;
+
+        for (spla::uint s : trial_sources) {
+            GapTrial trial;
+            run_trial(s, trial);
+            all_valid = all_valid && trial.valid != 0;
+            run.trials.push_back(trial);
+
+            std::cout << "[" << backend << "] trial";
+            if (has_source) std::cout << " source: " << s;
+            if (algo == "tc") std::cout << " prep(ms): " << trial.prep_ms;
+            std::cout << " kernel(ms): " << trial.kernel_ms;
+            if (trial.edges > 0) std::cout << " edges: " << trial.edges << " GTEPS: " << trial.gteps;
+            if (trial.valid >= 0) std::cout << (trial.valid ? " valid" : " INVALID");
+            std::cout << std::endl;
+        }
+
+        std::vector<double> prep_ms, kernel_ms, gteps;
+        for (const auto& trial : run.trials) {
+            prep_ms.push_back(trial.prep_ms);
+            kernel_ms.push_back(trial.kernel_ms);
+            gteps.push_back(trial.gteps);
+        }
+
+        std::cout << "[" << backend << "]";
+        if (algo == "tc") std::cout << " median prep(ms): " << gap_median(prep_ms);
+        std::cout << " median kernel(ms): " << gap_median(kernel_ms)
+                  << " median GTEPS: " << gap_median(gteps) << std::endl;
+
+        runs.push_back(std::move(run));
+    }
+
+    const std::string out_path = args[OPT_OUT].as<std::string>();
+
+    if (!out_path.empty()) {
+        std::ofstream out(out_path);
+
+        out << "{\n"
+            << "\"algo\": \"" << algo << "\",\n"
+            << "\"graph\": {\"name\": \"" << graph_name << "\", \"n\": " << N << ", \"nnz\": " << nnz << "},\n"
+            << "\"load_ms\": " << load_ms << ",\n"
+            << "\"build_ms\": " << build_ms << ",\n"
+            << "\"runs\": [\n";
+
+        for (std::size_t r = 0; r < runs.size(); ++r) {
+            const GapRun&       run = runs[r];
+            std::vector<double> prep_ms, kernel_ms, gteps;
+
+            out << "{\"backend\": \"" << run.backend << "\", \"conversion_ms\": " << run.conversion_ms << ", \"trials\": [\n";
+            for (std::size_t t = 0; t < run.trials.size(); ++t) {
+                const GapTrial& trial = run.trials[t];
+                prep_ms.push_back(trial.prep_ms);
+                kernel_ms.push_back(trial.kernel_ms);
+                gteps.push_back(trial.gteps);
+                out << "{\"source\": " << trial.source
+                    << ", \"prep_ms\": " << trial.prep_ms
+                    << ", \"kernel_ms\": " << trial.kernel_ms
+                    << ", \"edges\": " << trial.edges
+                    << ", \"gteps\": " << trial.gteps
+                    << ", \"valid\": " << (trial.valid < 0 ? "null" : (trial.valid ? "true" : "false")) << "}"
+                    << (t + 1 < run.trials.size() ? ",\n" : "\n");
+            }
+            out << "], \"median_prep_ms\": " << gap_median(prep_ms)
+                << ", \"median_kernel_ms\": " << gap_median(kernel_ms)
+                << ", \"median_gteps\": " << gap_median(gteps) << "}"
+                << (r + 1 < runs.size() ? ",\n" : "\n");
+        }
+
+        out << "]\n}\n";
+        std::cout << "saved results to " << out_path << std::endl;
+    }
+
+    spla::Library::get()->finalize();
+
+    return all_valid ? 0 : 1;
+}
@@ -39,9 +39,11 @@
 #define OPT_PLATFORM     "platform"
 #define OPT_DEVICE       "device"
 #define OPT_PUSH_PULL    "push-pull"
-#define OPT_FRONT_FACTOR "front-factor"
+#define OPT_PP_ALPHA     "push-pull-alpha"
+#define OPT_PP_BETA      "push-pull-beta"
 #define OPT_ALPHA        "alpha"
 #define OPT_EPS          "eps"
+#define OPT_DELTA        "delta"
 
 std::shared_ptr<cxxopts::Options> make_options(const std::string& name, const std::string& desc) {
     std::shared_ptr<cxxopts::Options> options = std::make_shared<cxxopts::Options>(name, desc);
@@ -58,9 +60,11 @@ std::shared_ptr<cxxopts::Options> make_options(const std::string& name, const st
     options->add_option("", cxxopts::Option("verbose", "verbose std output", cxxopts::value<bool>()->default_value("true")));
     options->add_option("", cxxopts::Option("debug-timing", "timing for each iteration of algorithm", cxxopts::value<bool>()->default_value("false")));
     options->add_option("", cxxopts::Option(OPT_PUSH_PULL, "traversal run mode (push-only 1, pull-only 2, push-pull 3)", cxxopts::value<int>()->default_value("3")));
-    options->add_option("", cxxopts::Option(OPT_FRONT_FACTOR, "adaptive push-pull front sparsity factor", cxxopts::value<float>()->default_value("0.05")));
+    options->add_option("", cxxopts::Option(OPT_PP_ALPHA, "adaptive push-pull switch to pull when frontier edges exceed unvisited edges / alpha", cxxopts::value<float>()->default_value("15")));
+    options->add_option("", cxxopts::Option(OPT_PP_BETA, "adaptive push-pull switch to push when frontier size is less than vertices / beta", cxxopts::value<float>()->default_value("18")));
     options->add_option("", cxxopts::Option(OPT_ALPHA, "alpha parameter for page rank algorithm", cxxopts::value<float>()->default_value("0.85")));
     options->add_option("", cxxopts::Option(OPT_EPS, "eps error for page rank algorithm", cxxopts::value<float>()->default_value("1e-6")));
+    options->add_option("", cxxopts::Option(OPT_DELTA, "bucket width for delta-stepping sssp (0 runs bellman-ford sssp)", cxxopts::value<float>()->default_value("0")));
     return options;
 }
 
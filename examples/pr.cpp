@@ -73,7 +73,8 @@ int main(int argc, const char* const* argv) {
     spla::ref_ptr<spla::Descriptor> desc  = spla::Descriptor::make();
 
     desc->set_traversal_mode(static_cast<spla::Descriptor::TraversalMode>(args[OPT_PUSH_PULL].as<int>() - 1));
-    desc->set_front_factor(args[OPT_FRONT_FACTOR].as<float>());
+    desc->set_push_pull_alpha(args[OPT_PP_ALPHA].as<float>());
+    desc->set_push_pull_beta(args[OPT_PP_BETA].as<float>());
 
     const auto& Ai = loader.get_Ai();
     const auto& Aj = loader.get_Aj();
@@ -71,7 +71,8 @@ int main(int argc, const char* const* argv) {
     spla::ref_ptr<spla::Descriptor> desc  = spla::Descriptor::make();
 
     desc->set_traversal_mode(static_cast<spla::Descriptor::TraversalMode>(args[OPT_PUSH_PULL].as<int>() - 1));
-    desc->set_front_factor(args[OPT_FRONT_FACTOR].as<float>());
+    desc->set_push_pull_alpha(args[OPT_PP_ALPHA].as<float>());
+    desc->set_push_pull_beta(args[OPT_PP_BETA].as<float>());
 
     const spla::uint w  = 1.0f;
     const auto&      Ai = loader.get_Ai();
@@ -81,7 +82,8 @@ int main(int argc, const char* const* argv) {
         A->set_float(Ai[k], Aj[k], w);
     }
 
-    const int n_iters = args[OPT_NITERS].as<int>();
+    const int   n_iters = args[OPT_NITERS].as<int>();
+    const float delta   = args[OPT_DELTA].as<float>();
 
     if (args[OPT_RUN_CPU].as<bool>()) {
         library->set_force_no_acceleration(true);
@@ -90,7 +92,8 @@ int main(int argc, const char* const* argv) {
             v_cpu->clear();
 
             timer_cpu.lap_begin();
-            spla::sssp(v_cpu, A, s, desc);
+            if (delta > 0.0f) spla::sssp_delta(v_cpu, A, s, delta, desc);
+            else spla::sssp(v_cpu, A, s, desc);
             timer_cpu.lap_end();
         }
     }
@@ -102,7 +105,8 @@ int main(int argc, const char* const* argv) {
             v_acc->clear();
 
             timer_gpu.lap_begin();
-            spla::sssp(v_acc, A, s, desc);
+            if (delta > 0.0f) spla::sssp_delta(v_acc, A, s, delta, desc);
+            else spla::sssp(v_acc, A, s, desc);
             timer_gpu.lap_end();
         }
     }
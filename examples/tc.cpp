@@ -46,6 +46,8 @@ int main(int argc, const char* const* argv) {
     spla::Timer     timer;
     spla::Timer     timer_cpu;
     spla::Timer     timer_gpu;
+    spla::Timer     timer_cpu_prep;
+    spla::Timer     timer_gpu_prep;
     spla::Timer     timer_ref;
     spla::MtxLoader loader;
 
@@ -70,17 +72,21 @@ int main(int argc, const char* const* argv) {
     int                             ntrins_acc = -1;
     spla::ref_ptr<spla::Matrix>     B_cpu      = spla::Matrix::make(N, N, spla::INT);
     spla::ref_ptr<spla::Matrix>     B_acc      = spla::Matrix::make(N, N, spla::INT);
+    spla::ref_ptr<spla::Matrix>     L_cpu      = spla::Matrix::make(N, N, spla::INT);
+    spla::ref_ptr<spla::Matrix>     L_acc      = spla::Matrix::make(N, N, spla::INT);
     spla::ref_ptr<spla::Matrix>     A          = spla::Matrix::make(N, N, spla::INT);
     spla::ref_ptr<spla::Descriptor> desc       = spla::Descriptor::make();
 
     desc->set_traversal_mode(static_cast<spla::Descriptor::TraversalMode>(args[OPT_PUSH_PULL].as<int>() - 1));
-    desc->set_front_factor(args[OPT_FRONT_FACTOR].as<float>());
+    desc->set_push_pull_alpha(args[OPT_PP_ALPHA].as<float>());
+    desc->set_push_pull_beta(args[OPT_PP_BETA].as<float>());
 
     const auto& Ai = loader.get_Ai();
     const auto& Aj = loader.get_Aj();
 
+    // full symmetric graph, oriented by degree before counting
     for (std::size_t k = 0; k < loader.get_n_values(); ++k) {
-        if (Ai[k] > Aj[k]) {
+        if (Ai[k] != Aj[k]) {
             A->set_int(Ai[k], Aj[k], 1);
         }
     }
@@ -92,9 +98,15 @@ int main(int argc, const char* const* argv) {
 
         for (int i = 0; i < n_iters; ++i) {
             B_cpu->clear();
+            L_cpu->clear();
+
+            timer_cpu_prep.lap_begin();
+            spla::tc_orient(L_cpu, A, desc);
+            library->wait();
+            timer_cpu_prep.lap_end();
 
             timer_cpu.lap_begin();
-            spla::tc(ntrins_cpu, A, B_cpu, desc);
+            spla::tc(ntrins_cpu, L_cpu, B_cpu, desc);
             timer_cpu.lap_end();
         }
     }
@@ -104,9 +116,15 @@ int main(int argc, const char* const* argv) {
 
         for (int i = 0; i < n_iters; ++i) {
             B_acc->clear();
+            L_acc->clear();
+
+            timer_gpu_prep.lap_begin();
+            spla::tc_orient(L_acc, A, desc);
+            library->wait();
+            timer_gpu_prep.lap_end();
 
             timer_gpu.lap_begin();
-            spla::tc(ntrins_acc, A, B_acc, desc);
+            spla::tc(ntrins_acc, L_acc, B_acc, desc);
             timer_gpu.lap_end();
         }
     }
@@ -153,6 +171,12 @@ int main(int argc, const char* const* argv) {
     std::cout << "gpu(ms): ";
     timer_gpu.print();
     std::cout << std::endl;
+    std::cout << "cpu-prep(ms): ";
+    timer_cpu_prep.print();
+    std::cout << std::endl;
+    std::cout << "gpu-prep(ms): ";
+    timer_gpu_prep.print();
+    std::cout << std::endl;
     std::cout << "ref(ms): ";
     timer_ref.print();
     std::cout << std::endl;
@@ -73,6 +73,26 @@ namespace spla {
             uint                                  s,
             const ref_ptr<Descriptor>&            descriptor = spla::Descriptor::make());
 
+    /**
+     * @brief Multi-source breadth-first search algorithm
+     *
+     * Explores sources in batches of 32 (bits of int): each vertex holds a word where bit k
+     * is set if vertex is reached from k-th source of batch, so graph is traversed once
+     * per level for whole batch rather than once per level per source (see MS-BFS).
+     *
+     * @param levels int vectors to store reached distances, one per source (created if null)
+     * @param A int matrix filled with 1 where exist edge from i to j
+     * @param sources start vertices ids to search
+     * @param descriptor optional descriptor for algorithm
+     *
+     * @return ok on success
+     */
+    SPLA_API Status ms_bfs(
+            std::vector<ref_ptr<Vector>>& levels,
+            const ref_ptr<Matrix>&        A,
+            const std::vector<uint>&      sources,
+            const ref_ptr<Descriptor>&    descriptor = spla::Descriptor::make());
+
     /**
      * @brief Single-source shortest path algorithm
      *
@@ -89,6 +109,28 @@ namespace spla {
             uint                       s,
             const ref_ptr<Descriptor>& descriptor = ref_ptr<Descriptor>());
 
+    /**
+     * @brief Delta-stepping single-source shortest path algorithm
+     *
+     * Splits edges into light (w <= delta) and heavy (w > delta) ones and settles vertices
+     * bucket by bucket, where bucket holds tentative distances in [lo, lo + delta).
+     * Small delta approaches Dijkstra, large delta approaches Bellman-Ford (see sssp).
+     *
+     * @param v float vector to store reached distances
+     * @param A float matrix filled with >0.0f distances where exist edge from i to j otherwise 0.0f
+     * @param s start vertex id to search
+     * @param delta bucket width, must be >0.0f
+     * @param descriptor optional descriptor for algorithm
+     *
+     * @return ok on success, invalid argument if delta is not positive
+     */
+    SPLA_API Status sssp_delta(
+            const ref_ptr<Vector>&     v,
+            const ref_ptr<Matrix>&     A,
+            uint                       s,
+            float                      delta,
+            const ref_ptr<Descriptor>& descriptor = ref_ptr<Descriptor>());
+
     /**
      * @brief Naive single-source shortest path algorithm (reference cpu implementation)
      *
@@ -148,7 +190,7 @@ namespace spla {
      * @brief Triangles counting algorithm
      *
      * @param ntrins Number of triangles counted
-     * @param A Lower trilingual int matrix with 1 where has edge in a graph
+     * @param A Lower trilingual (or oriented by `tc_orient`) int matrix with 1 where has edge in a graph
      * @param B Buffer int matrix to store result
      * @param descriptor optional descriptor for algorithm
      *
@@ -160,6 +202,24 @@ namespace spla {
             const ref_ptr<Matrix>&     B,
             const ref_ptr<Descriptor>& descriptor = spla::Descriptor::make());
 
+    /**
+     * @brief Orient symmetric graph for triangles counting by degree order
+     *
+     * Keeps for each vertex only neighbours with higher degree (ties broken by index),
+     * so each triangle is counted once, while high degree vertices get short rows and
+     * mxmT work in `tc` is bounded by O(m * sqrt(m)) rather than by squared max degree.
+     *
+     * @param L Int matrix to store oriented graph; must differ from A
+     * @param A Full symmetric int matrix with 1 where has edge in a graph
+     * @param descriptor optional descriptor for algorithm
+     *
+     * @return ok on success
+     */
+    SPLA_API Status tc_orient(
+            const ref_ptr<Matrix>&     L,
+            const ref_ptr<Matrix>&     A,
+            const ref_ptr<Descriptor>& descriptor = spla::Descriptor::make());
+
     /**
      * @brief Naive triangles counting algorithm (reference cpu implementation)
      *
@@ -136,8 +136,10 @@ namespace spla {
         AccDense = 3,
         /** Vector acceleration structured coo format */
         AccCoo = 4,
+        /** Vector bit-set of non-fill entries (64-bit words) */
+        CpuBitmap = 5,
         /** Total number of supported vector formats */
-        Count = 5
+        Count = 6
     };
 
     /**
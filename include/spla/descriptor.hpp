@@ -52,16 +52,22 @@ namespace spla {
         ~Descriptor() override = default;
 
         void set_traversal_mode(TraversalMode value) { mode = value; }
-        void set_front_factor(float value) { front_factor = value; }
+        void set_push_pull_alpha(float value) { push_pull_alpha = value; }
+        void set_push_pull_beta(float value) { push_pull_beta = value; }
         void set_early_exit(bool value) { early_exit = value; }
         void set_struct_only(bool value) { struct_only = value; }
+        void set_mask_structure(bool value) { mask_structure = value; }
+        void set_mask_complement(bool value) { mask_complement = value; }
 
         bool  get_push_only() const { return mode == TraversalMode::Push; }
         bool  get_pull_only() const { return mode == TraversalMode::Pull; }
         bool  get_push_pull() const { return mode == TraversalMode::PushPull; }
-        float get_front_factor() const { return front_factor; }
+        float get_push_pull_alpha() const { return push_pull_alpha; }
+        float get_push_pull_beta() const { return push_pull_beta; }
         bool  get_early_exit() const { return early_exit; }
         bool  get_struct_only() const { return struct_only; }
+        bool  get_mask_structure() const { return mask_structure; }
+        bool  get_mask_complement() const { return mask_complement; }
 
         void               set_label(std::string label) override;
         const std::string& get_label() const override;
@@ -76,10 +82,19 @@ namespace spla {
     private:
         std::string m_label;
 
-        TraversalMode mode         = TraversalMode::PushPull;
-        float         front_factor = 0.1f;
-        bool          early_exit   = false;
-        bool          struct_only  = false;
+        TraversalMode mode        = TraversalMode::PushPull;
+        bool          early_exit  = false;
+        bool          struct_only = false;
+
+        /** Switch push to pull when edges of frontier exceed edges of unvisited vertices divided by alpha */
+        float push_pull_alpha = 15.0f;
+        /** Switch pull to push when shrinking frontier size falls below number of vertices divided by beta */
+        float push_pull_beta = 18.0f;
+
+        /** Select by mask structure (stored non-fill entries) instead of select op on mask values */
+        bool mask_structure = false;
+        /** Invert mask selection */
+        bool mask_complement = false;
     };
 
     /**
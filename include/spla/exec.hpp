@@ -87,17 +87,18 @@ namespace spla {
             ref_ptr<ScheduleTask>* task_hnd = nullptr);
 
     /**
-     * @brief Execute (schedule) dense-masked sparse matrix by dense vector product
+     * @brief Execute (schedule) masked sparse matrix by dense vector product
      *
      * @note Pass valid `task_hnd` to store as a task, rather then execute immediately.
+     * @note Mask may be dense or sparse; use descriptor to select it by structure or to complement it.
      *
      * @param r Vector to store operation result
-     * @param mask Vector to select for which values to compute product
+     * @param mask Optional vector to select for which values to compute product; null means no mask
      * @param M Matrix for product
      * @param v Vector for product
      * @param op_multiply Element-wise binary operator for matrix vector elements product
      * @param op_add Element-wise binary operator for matrix vector products sum
-     * @param op_select Selection op to filter mask
+     * @param op_select Selection op to filter mask; null means structural mask
      * @param init Init of matrix row and vector product
      * @param desc Scheduled task descriptor; default is null
      * @param task_hnd Optional task hnd; pass not-null pointer to store task
@@ -117,17 +118,18 @@ namespace spla {
             ref_ptr<ScheduleTask>* task_hnd = nullptr);
 
     /**
-     * @brief Execute (schedule) dense-masked sparse vector by sparse matrix product
+     * @brief Execute (schedule) masked sparse vector by sparse matrix product
      *
      * @note Pass valid `task_hnd` to store as a task, rather then execute immediately.
+     * @note Mask may be dense or sparse; use descriptor to select it by structure or to complement it.
      *
      * @param r Vector to store operation result
-     * @param mask Vector to select for which values to compute product
+     * @param mask Optional vector to select for which values to compute product; null means no mask
      * @param v Vector for product
      * @param M Matrix for product
      * @param op_multiply Element-wise binary operator for matrix vector elements product
      * @param op_add Element-wise binary operator for matrix vector products sum
-     * @param op_select Selection op to filter mask
+     * @param op_select Selection op to filter mask; null means structural mask
      * @param init Init of matrix row and vector product
      * @param desc Scheduled task descriptor; default is null
      * @param task_hnd Optional task hnd; pass not-null pointer to store task
@@ -146,11 +148,89 @@ namespace spla {
             ref_ptr<Descriptor>    desc     = ref_ptr<Descriptor>(),
             ref_ptr<ScheduleTask>* task_hnd = nullptr);
 
+    /**
+     * @brief Execute (schedule) masked sparse matrix by dense vector product with result accumulation
+     *
+     * Computes `r<mask> accum= M*v`: for each selected entry `i` with at least one product term
+     * `r[i] = op_accum(r[i], init + sum(M[i,k] * v[k]))`, where `+` is `op_add` and `*` is `op_multiply`.
+     * Entries without product terms or not selected by mask are kept unchanged.
+     *
+     * @note Pass valid `task_hnd` to store as a task, rather then execute immediately.
+     *
+     * @param r Vector to accumulate operation result
+     * @param mask Optional vector to select for which values to compute product; null means no mask
+     * @param M Matrix for product
+     * @param v Vector for product
+     * @param op_multiply Element-wise binary operator for matrix vector elements product
+     * @param op_add Element-wise binary operator for matrix vector products sum
+     * @param op_select Selection op to filter mask; null means structural mask
+     * @param init Init of matrix row and vector product
+     * @param op_accum Element-wise binary operator to merge product into `r`
+     * @param changed Optional vector to store entries of `r` changed by accumulation
+     * @param desc Scheduled task descriptor; default is null
+     * @param task_hnd Optional task hnd; pass not-null pointer to store task
+     *
+     * @return Status on task execution or status on hnd creation
+     */
+    SPLA_API Status exec_mxv_masked_accum(
+            ref_ptr<Vector>        r,
+            ref_ptr<Vector>        mask,
+            ref_ptr<Matrix>        M,
+            ref_ptr<Vector>        v,
+            ref_ptr<OpBinary>      op_multiply,
+            ref_ptr<OpBinary>      op_add,
+            ref_ptr<OpSelect>      op_select,
+            ref_ptr<Scalar>        init,
+            ref_ptr<OpBinary>      op_accum,
+            ref_ptr<Vector>        changed  = ref_ptr<Vector>(),
+            ref_ptr<Descriptor>    desc     = ref_ptr<Descriptor>(),
+            ref_ptr<ScheduleTask>* task_hnd = nullptr);
+
+    /**
+     * @brief Execute (schedule) masked sparse vector by sparse matrix product with result accumulation
+     *
+     * Computes `r<mask> accum= v*M`: for each selected entry `j` with at least one product term
+     * `r[j] = op_accum(r[j], init + sum(v[k] * M[k,j]))`, where `+` is `op_add` and `*` is `op_multiply`.
+     * Entries without product terms or not selected by mask are kept unchanged.
+     *
+     * @note Pass valid `task_hnd` to store as a task, rather then execute immediately.
+     *
+     * @param r Vector to accumulate operation result
+     * @param mask Optional vector to select for which values to compute product; null means no mask
+     * @param v Vector for product
+     * @param M Matrix for product
+     * @param op_multiply Element-wise binary operator for matrix vector elements product
+     * @param op_add Element-wise binary operator for matrix vector products sum
+     * @param op_select Selection op to filter mask; null means structural mask
+     * @param init Init of matrix row and vector product
+     * @param op_accum Element-wise binary operator to merge product into `r`
+     * @param changed Optional vector to store entries of `r` changed by accumulation
+     * @param desc Scheduled task descriptor; default is null
+     * @param task_hnd Optional task hnd; pass not-null pointer to store task
+     *
+     * @return Status on task execution or status on hnd creation
+     */
+    SPLA_API Status exec_vxm_masked_accum(
+            ref_ptr<Vector>        r,
+            ref_ptr<Vector>        mask,
+            ref_ptr<Vector>        v,
+            ref_ptr<Matrix>        M,
+            ref_ptr<OpBinary>      op_multiply,
+            ref_ptr<OpBinary>      op_add,
+            ref_ptr<OpSelect>      op_select,
+            ref_ptr<Scalar>        init,
+            ref_ptr<OpBinary>      op_accum,
+            ref_ptr<Vector>        changed  = ref_ptr<Vector>(),
+            ref_ptr<Descriptor>    desc     = ref_ptr<Descriptor>(),
+            ref_ptr<ScheduleTask>* task_hnd = nullptr);
+
     /**
      * @brief Execute (schedule) matrix by row reduction to single vector column
      *
      * @note Pass valid `task_hnd` to store as a task, rather then execute immediately.
      *
+     * @note Set `struct_only` in descriptor to reduce stored entries as `1`, so plus gives degree of each row.
+     *
      * @param r Vector to store reduction of row
      * @param M Matrix to reduce rows
      * @param op_reduce Binary op to sum elements of single row
@@ -168,6 +248,55 @@ namespace spla {
             ref_ptr<Descriptor>    desc     = ref_ptr<Descriptor>(),
             ref_ptr<ScheduleTask>* task_hnd = nullptr);
 
+    /**
+     * @brief Execute (schedule) matrix select of entries satisfying select op into other matrix
+     *
+     * Stores into `R` entries `M[i][j]` for which `op_select(M[i][j])` is true, other entries are dropped.
+     * Use this function to split matrix by values, for example edges of a graph to light and heavy ones.
+     *
+     * @note Pass valid `task_hnd` to store as a task, rather then execute immediately.
+     * @note Matrix `R` must be a different object than `M`.
+     *
+     * @param R Matrix to store selected entries
+     * @param M Matrix to select entries from
+     * @param op_select Select op to test entries values
+     * @param desc Scheduled task descriptor; default is null
+     * @param task_hnd Optional task hnd; pass not-null pointer to store task
+     *
+     * @return Status on task execution or status on hnd creation
+     */
+    SPLA_API Status exec_m_select(
+            ref_ptr<Matrix>        R,
+            ref_ptr<Matrix>        M,
+            ref_ptr<OpSelect>      op_select,
+            ref_ptr<Descriptor>    desc     = ref_ptr<Descriptor>(),
+            ref_ptr<ScheduleTask>* task_hnd = nullptr);
+
+    /**
+     * @brief Execute (schedule) matrix strictly lower triangle extraction in order given by keys
+     *
+     * Stores into `R` entries `M[i][j]` for which `(key[j], j) < (key[i], i)` in lexicographical order,
+     * other entries are dropped. If `key` is null, plain `j < i` order is used, what gives common tril.
+     * Pass vertex degrees (or negated degrees) as keys to orient edges of a symmetric graph by degree.
+     *
+     * @note Pass valid `task_hnd` to store as a task, rather then execute immediately.
+     * @note Matrix `R` must be a different object than `M`.
+     *
+     * @param R Matrix to store lower triangle entries
+     * @param M Square matrix to take entries from
+     * @param key Optional vector of size of M rows with keys to order rows; may be null
+     * @param desc Scheduled task descriptor; default is null
+     * @param task_hnd Optional task hnd; pass not-null pointer to store task
+     *
+     * @return Status on task execution or status on hnd creation
+     */
+    SPLA_API Status exec_m_tril(
+            ref_ptr<Matrix>        R,
+            ref_ptr<Matrix>        M,
+            ref_ptr<Vector>        key,
+            ref_ptr<Descriptor>    desc     = ref_ptr<Descriptor>(),
+            ref_ptr<ScheduleTask>* task_hnd = nullptr);
+
     /**
      * @brief Execute (schedule) matrix by structure reduction to a single scalar value
      *
@@ -210,6 +339,30 @@ namespace spla {
             ref_ptr<Descriptor>    desc     = ref_ptr<Descriptor>(),
             ref_ptr<ScheduleTask>* task_hnd = nullptr);
 
+    /**
+     * @brief Execute (schedule) element-wise multiplication by structure of first vector
+     *
+     * Computes r[i] = op(u[i], v[i]) for each stored value of u, where v is read with fill value
+     * in place of missing entries. Results equal to fill value of r are not stored, so
+     * op(a, b) = a & ~b masks out bits without growing sparse vector u.
+     *
+     * @param r Vector to store result of operation
+     * @param u Vector which structure defines result structure
+     * @param v Vector input to multiply
+     * @param op Element-wise binary operator to multiply elements of vectors
+     * @param desc Scheduled task descriptor; default is null
+     * @param task_hnd Optional task hnd; pass not-null pointer to store task
+     *
+     * @return Status on task execution or status on hnd creation
+     */
+    SPLA_API Status exec_v_emult(
+            ref_ptr<Vector>        r,
+            ref_ptr<Vector>        u,
+            ref_ptr<Vector>        v,
+            ref_ptr<OpBinary>      op,
+            ref_ptr<Descriptor>    desc     = ref_ptr<Descriptor>(),
+            ref_ptr<ScheduleTask>* task_hnd = nullptr);
+
     /**
      * @brief Execute (schedule) element-wise addition by structure of two vectors with feedback
      *
@@ -276,6 +429,32 @@ namespace spla {
             ref_ptr<Descriptor>    desc     = ref_ptr<Descriptor>(),
             ref_ptr<ScheduleTask>* task_hnd = nullptr);
 
+    /**
+     * @brief Execute (schedule) vector select of meaningful entries by values range
+     *
+     * Stores into `r` entries `v[i]` not equal to fill value of `v` such that `lo <= v[i] < hi`,
+     * other entries of `r` are set to its fill value. Result is stored sparse, so
+     * use this function to extract buckets of entries, for example in delta-stepping.
+     *
+     * @note Pass valid `task_hnd` to store as a task, rather then execute immediately.
+     *
+     * @param r Vector to store selected entries
+     * @param v Vector to select entries from
+     * @param lo Scalar inclusive lower bound of range
+     * @param hi Scalar exclusive upper bound of range
+     * @param desc Scheduled task descriptor; default is null
+     * @param task_hnd Optional task hnd; pass not-null pointer to store task
+     *
+     * @return Status on task execution or status on hnd creation
+     */
+    SPLA_API Status exec_v_select_range(
+            ref_ptr<Vector>        r,
+            ref_ptr<Vector>        v,
+            ref_ptr<Scalar>        lo,
+            ref_ptr<Scalar>        hi,
+            ref_ptr<Descriptor>    desc     = ref_ptr<Descriptor>(),
+            ref_ptr<ScheduleTask>* task_hnd = nullptr);
+
     /**
      * @brief Execute (schedule) vector by structure reduction to a single scalar value
      *
@@ -298,6 +477,36 @@ namespace spla {
             ref_ptr<Descriptor>    desc     = ref_ptr<Descriptor>(),
             ref_ptr<ScheduleTask>* task_hnd = nullptr);
 
+    /**
+     * @brief Execute (schedule) element-wise operation of two vectors with reduction to a single scalar
+     *
+     * Computes `r = s op_reduce op_elem(u[0], v[0]) op_reduce ... op_elem(u[n-1], v[n-1])`
+     * in a single pass, without storing element-wise result into a temporary vector.
+     * Use this function for convergence checks, such as norm of difference of two vectors.
+     *
+     * @note Pass valid `task_hnd` to store as a task, rather then execute immediately.
+     *
+     * @param r Scalar to store reduction result
+     * @param s Scalar neutral init value for reduction
+     * @param u Vector first input of element-wise op
+     * @param v Vector second input of element-wise op
+     * @param op_elem Element-wise binary operator applied to vectors elements
+     * @param op_reduce Binary op to reduce element-wise results
+     * @param desc Scheduled task descriptor; default is null
+     * @param task_hnd Optional task hnd; pass not-null pointer to store task
+     *
+     * @return Status on task execution or status on hnd creation
+     */
+    SPLA_API Status exec_v_eadd_reduce(
+            ref_ptr<Scalar>        r,
+            ref_ptr<Scalar>        s,
+            ref_ptr<Vector>        u,
+            ref_ptr<Vector>        v,
+            ref_ptr<OpBinary>      op_elem,
+            ref_ptr<OpBinary>      op_reduce,
+            ref_ptr<Descriptor>    desc     = ref_ptr<Descriptor>(),
+            ref_ptr<ScheduleTask>* task_hnd = nullptr);
+
     /**
      * @brief Execute (schedule) count number of meaningful values by vector structure
      *
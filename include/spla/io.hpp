@@ -29,7 +29,9 @@
 #define SPLA_IO_HPP
 
 #include "config.hpp"
+#include "matrix.hpp"
 
+#include <cstdint>
 #include <filesystem>
 #include <vector>
 
@@ -101,6 +103,115 @@ namespace spla {
         std::vector<uint>     m_deg_ranges;
     };
 
+    /**
+     * @class GraphGenerator
+     * @brief Deterministic generator of synthetic graphs for benchmarking and scaling tests
+     *
+     * Generated edges are stored in coordinate format sorted by (row, column) without
+     * duplicates, same as data of MtxLoader. Output depends only on seed and parameters,
+     * it does not depend on number of threads used to generate edges: each edge is drawn
+     * from its own counter-based random stream.
+     */
+    class GraphGenerator {
+    public:
+        SPLA_API explicit GraphGenerator(std::uint64_t seed = 1);
+        SPLA_API ~GraphGenerator() = default;
+
+        /**
+         * @brief Generate R-MAT (Graph500 Kronecker) graph
+         *
+         * Graph has 2^scale vertices and edge_factor * 2^scale generated edges before
+         * symmetrization and removal of duplicates. Each edge is placed by recursive
+         * descent into quadrants of adjacency matrix with probabilities a, b, c and 1-a-b-c.
+         *
+         * @param scale Log2 of number of vertices, must be in [1, 31]
+         * @param edge_factor Number of generated edges per vertex
+         * @param a Probability of top left quadrant
+         * @param b Probability of top right quadrant
+         * @param c Probability of bottom left quadrant
+         * @param make_undirected True if for each directed edge reverse edge must be added
+         * @param remove_loops True if self-loops must be removed
+         * @param permute True to randomly relabel vertices, so high degree vertices are not clustered at low ids
+         *
+         * @return True if successfully generated
+         */
+        SPLA_API bool generate_rmat(uint  scale,
+                                    uint  edge_factor,
+                                    float a               = 0.57f,
+                                    float b               = 0.19f,
+                                    float c               = 0.19f,
+                                    bool  make_undirected = true,
+                                    bool  remove_loops    = true,
+                                    bool  permute         = true);
+
+        /**
+         * @brief Generate uniform random (Erdos-Renyi G(n, m)) graph
+         *
+         * @param n_vertices Number of vertices
+         * @param n_edges Number of generated edges before symmetrization and removal of duplicates
+         * @param make_undirected True if for each directed edge reverse edge must be added
+         * @param remove_loops True if self-loops must be removed
+         *
+         * @return True if successfully generated
+         */
+        SPLA_API bool generate_uniform(uint        n_vertices,
+                                       std::size_t n_edges,
+                                       bool        make_undirected = true,
+                                       bool        remove_loops    = true);
+
+        /**
+         * @brief Generate undirected 2D or 3D grid graph
+         *
+         * Each vertex is connected to its neighbours along each axis (4-point stencil for 2D, 6-point for 3D).
+         * Vertex (x, y, z) has id x + dim_x * (y + dim_y * z).
+         *
+         * @param dim_x Number of vertices along x axis
+         * @param dim_y Number of vertices along y axis
+         * @param dim_z Number of vertices along z axis, 1 for 2D grid
+         *
+         * @return True if successfully generated
+         */
+        SPLA_API bool generate_grid(uint dim_x,
+                                    uint dim_y,
+                                    uint dim_z = 1);
+
+        /**
+         * @brief Fill matrix with generated graph, previous content of matrix is discarded
+         *
+         * Matrix is built directly in compressed sparse rows format without per-element insertions.
+         * Weights are derived from seed and edge end points, so weights of undirected graph are symmetric.
+         *
+         * @param M Square matrix of size of generated graph of INT, UINT or FLOAT type
+         * @param weighted False to set all values to 1, true to set random weights:
+         *                 integers in [1, 255] or floats in (0, 1]
+         *
+         * @return Ok on success
+         */
+        SPLA_API Status fill(const ref_ptr<Matrix>& M, bool weighted = false) const;
+
+        /**
+         * @brief Set max number of threads to generate, sort and fill edges, 0 to use all hardware threads
+         *
+         * @param n_threads Number of threads
+         */
+        SPLA_API void set_n_threads(uint n_threads);
+
+        [[nodiscard]] SPLA_API const std::vector<uint>& get_Ai() const;
+        [[nodiscard]] SPLA_API const std::vector<uint>& get_Aj() const;
+        [[nodiscard]] SPLA_API uint                     get_n_rows() const;
+        [[nodiscard]] SPLA_API uint                     get_n_cols() const;
+        [[nodiscard]] SPLA_API std::size_t get_n_values() const;
+
+    private:
+        void finalize(std::vector<std::uint64_t>& edges, uint n_vertices, bool make_undirected, bool remove_loops);
+
+        std::uint64_t     m_seed;
+        std::vector<uint> m_Ai;
+        std::vector<uint> m_Aj;
+        uint              m_n_vertices = 0;
+        uint              m_n_threads  = 0;
+    };
+
     /**
      * @}
      */
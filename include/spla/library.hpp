@@ -30,6 +30,7 @@
 
 #include "config.hpp"
 
+#include <cstddef>
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -99,12 +100,71 @@ namespace spla {
         /**
          * @brief Set number of GPU queues for parallel ops execution
          *
+         * Independent tasks of a single schedule step are distributed among queues and
+         * may execute concurrently; tasks sharing any argument are still ordered. Host and
+         * device transfers always go on a separate copy queue, so those overlap computations.
+         *
          * @param count Number of queues to set
          *
          * @return Function call status
          */
         SPLA_API Status set_queues_count(int count);
 
+        /**
+         * @brief Set directory for persistent cache of compiled accelerator programs
+         *
+         * Compiled binaries of accelerator programs are stored in the directory and loaded
+         * on next runs instead of building programs from sources, what removes compilation
+         * cost on start of each new process. Entries of other devices or drivers are never
+         * loaded; least recently used entries are removed once cache exceeds `max_size`.
+         * By default cache is set from `SPLA_CL_CACHE_DIR` environment variable, if present.
+         *
+         * @param dir Directory to store cache; pass empty string to disable cache
+         * @param max_size Max size in bytes of all cache entries
+         *
+         * @return Ok on success
+         */
+        SPLA_API Status set_program_cache(const std::string& dir, std::size_t max_size = 256 * 1024 * 1024);
+
+        /**
+         * @brief Enable background precompilation of built-in accelerator programs
+         *
+         * Programs of built-in algorithms for standard types (int, uint, float) are compiled
+         * on a background thread, so first calls of algorithms do not pay for compilation.
+         * Operation which needs a program still being compiled waits for it. Programs of
+         * custom ops are compiled on first use as before.
+         * By default enabled if `SPLA_CL_PRECOMPILE` environment variable is set to 1.
+         *
+         * @param value True to start precompilation, false to stop it
+         *
+         * @return Ok on success
+         */
+        SPLA_API Status set_precompile(bool value);
+
+        /**
+         * @brief Set limit of device memory kept cached by accelerator allocator
+         *
+         * Released device buffers are kept in a pool and reused by next allocations
+         * of the same size class. Once size of cached buffers exceeds the limit,
+         * largest ones are returned to the driver.
+         *
+         * @param bytes Max size in bytes of cached buffers; pass 0 to disable caching
+         *
+         * @return Ok on success
+         */
+        SPLA_API Status set_mem_cache_limit(std::size_t bytes);
+
+        /**
+         * @brief Get statistics of accelerator device memory allocator
+         *
+         * @param[out] bytes_live Size in bytes of buffers in use
+         * @param[out] bytes_cached Size in bytes of released buffers kept for reuse
+         * @param[out] hit_rate Fraction of allocations served from cached buffers
+         *
+         * @return Ok on success
+         */
+        SPLA_API Status get_mem_stats(std::size_t& bytes_live, std::size_t& bytes_cached, double& hit_rate);
+
         /**
          * @brief Set callback function called on library message event
          *
@@ -131,6 +191,32 @@ namespace spla {
         SPLA_API Status set_force_no_acceleration(bool value);
         SPLA_API bool   is_set_force_no_acceleration();
 
+        /**
+         * @brief Sets non-blocking (lazy) execution mode of operations
+         *
+         * In lazy mode `exec_*` calls without task hnd do not run immediately.
+         * Operations are stored as pending and executed only when result of
+         * some object is observed (values get or set, format change, etc.).
+         * Only operations the object depends on are executed. Before execution
+         * adjacent operations are fused where possible and operations producing
+         * temporaries, not referenced by user, are dropped.
+         *
+         * @note Errors of pending operations are reported by the call observing the result
+         *
+         * @param value True to enable lazy execution; false executes all pending operations
+         *
+         * @return Function call status
+         */
+        SPLA_API Status set_lazy_execution(bool value);
+        SPLA_API bool   is_set_lazy_execution();
+
+        /**
+         * @brief Executes all pending operations of lazy execution mode
+         *
+         * @return Status of pending operations execution
+         */
+        SPLA_API Status wait();
+
         /**
          * @brief Get acc info in a form of a string
          * @param[out] info String to store info
@@ -138,6 +224,36 @@ namespace spla {
          */
         SPLA_API Status get_accelerator_info(std::string& info);
 
+        /**
+         * @brief Enables or disables time profile recording at runtime
+         *
+         * Profile is enabled by default in debug builds and disabled in release builds.
+         * When enabled, each profiled scope records call count, total, min, max
+         * and histogram of durations, as well as a trace event for timeline export.
+         *
+         * @param value True to record time profile
+         *
+         * @return Function call status
+         */
+        SPLA_API Status time_profile_enable(bool value);
+        SPLA_API bool   is_set_time_profile();
+
+        /**
+         * @brief Enables or disables sampling of hardware counters per profiled scope
+         *
+         * When enabled (and time profile is enabled), each thread opens group of
+         * cycles, instructions, LLC misses, dTLB misses and branch misses counters
+         * using perf_event_open, and scopes record counters deltas. Dump shows IPC and
+         * counters per processed nnz for kernels which report it.
+         * If counters are not available on host, only durations are recorded.
+         *
+         * @param value True to sample hardware counters
+         *
+         * @return Function call status
+         */
+        SPLA_API Status time_profile_enable_counters(bool value);
+        SPLA_API bool   is_set_time_profile_counters();
+
         /**
          * @brief Dumps to default output current time profile
          * @return Function call status
@@ -148,6 +264,50 @@ namespace spla {
          * @return Function call status
          */
         SPLA_API Status time_profile_reset();
+        /**
+         * @brief Exports recorded time profile scopes as Chrome trace-event JSON
+         *
+         * Resulting file can be opened in chrome://tracing or Perfetto UI.
+         *
+         * @param file_path Path to file to write trace
+         *
+         * @return Function call status
+         */
+        SPLA_API Status time_profile_export_trace(const std::string& file_path);
+
+        /**
+         * @brief Enables or disables recording of per-dispatch trace events
+         *
+         * When enabled, each dispatched task records selected algorithm and backend,
+         * number of stored values of inputs and output, storage format conversions
+         * triggered during execution with their byte sizes and times, and wall time.
+         * Events are kept in a fixed-size ring buffer; oldest events are overwritten.
+         *
+         * @param value True to record dispatch trace events
+         *
+         * @return Function call status
+         */
+        SPLA_API Status dispatch_trace_enable(bool value);
+
+        /**
+         * @brief Drains recorded dispatch trace events as JSON array
+         *
+         * Each event includes derived `gteps` metric (traversed edges per ns) for mxv and vxm.
+         *
+         * @param[out] json String to store events
+         *
+         * @return Function call status
+         */
+        SPLA_API Status dispatch_trace_drain_json(std::string& json);
+
+        /**
+         * @brief Drains recorded dispatch trace events as CSV table with header
+         *
+         * @param[out] csv String to store events
+         *
+         * @return Function call status
+         */
+        SPLA_API Status dispatch_trace_drain_csv(std::string& csv);
 
         /**
          * @warning Internal usage only!
@@ -179,6 +339,18 @@ namespace spla {
          */
         class TimeProfiler* get_time_profiler();
 
+        /**
+         * @warning Internal usage only!
+         * @return Library dispatch trace recorder
+         */
+        class DispatchTracer* get_dispatch_tracer();
+
+        /**
+         * @warning Internal usage only!
+         * @return Library lazy execution planner
+         */
+        class LazyPlanner* get_lazy_planner();
+
         /**
          * @brief Access global library instance
          *
@@ -198,7 +370,10 @@ namespace spla {
         std::unique_ptr<class Dispatcher>            m_dispatcher;
         std::unique_ptr<class Logger>                m_logger;
         std::unique_ptr<class TimeProfiler>          m_time_profiler;
+        std::unique_ptr<class DispatchTracer>        m_dispatch_tracer;
+        std::unique_ptr<class LazyPlanner>           m_lazy_planner;
         bool                                         m_force_no_acc = false;
+        bool                                         m_lazy         = false;
     };
 
     /**
@@ -34,9 +34,13 @@
 #include <algorithm>
 #include <cassert>
 #include <cmath>
+#include <cstring>
+#include <iomanip>
 #include <iostream>
 #include <limits>
 #include <queue>
+#include <sstream>
+#include <unordered_map>
 
 namespace spla {
 
@@ -53,6 +57,7 @@ namespace spla {
 
         ref_ptr<Vector> frontier_prev  = Vector::make(N, INT);
         ref_ptr<Vector> frontier_new   = Vector::make(N, INT);
+        ref_ptr<Vector> visited        = Vector::make(N, INT);
         ref_ptr<Scalar> frontier_size  = Scalar::make_int(1);
         ref_ptr<Scalar> depth          = Scalar::make_int(1);
         ref_ptr<Scalar> zero           = Scalar::make_int(0);
@@ -65,17 +70,40 @@ namespace spla {
         desc->set_struct_only(true);
 
         frontier_prev->set_int(s, 1);
+        frontier_prev->set_format(FormatVector::CpuBitmap);
+        visited->set_format(FormatVector::CpuBitmap);
 
-        bool  push         = descriptor->get_push_only();
-        bool  pull         = descriptor->get_pull_only();
-        bool  push_pull    = descriptor->get_push_pull();
-        float front_factor = descriptor->get_front_factor();
+        bool  push      = descriptor->get_push_only();
+        bool  pull      = descriptor->get_pull_only();
+        bool  push_pull = descriptor->get_push_pull();
+        float alpha     = descriptor->get_push_pull_alpha();
+        float beta      = descriptor->get_push_pull_beta();
 
         if (!(push || pull || push_pull)) push = true;
 
+        // Direction-optimizing traversal (Beamer et al.): push while edges out of frontier m_f are
+        // small relative to edges out of unvisited vertices m_u, pull while frontier is large
+        ref_ptr<Vector> degrees        = Vector::make(N, INT);
+        ref_ptr<Scalar> frontier_edges = Scalar::make_int(0);
+        bool            is_push        = !pull;
+        int             prev_size      = 0;
+        double          m_f            = 0;
+        double          m_u            = 0;
+
+        if (push_pull) {
+            ref_ptr<Scalar> total_edges = Scalar::make_int(0);
+
+            exec_m_reduce_by_row(degrees, A, PLUS_INT, zero, desc);
+            exec_v_reduce(total_edges, zero, degrees, PLUS_INT);
+            exec_v_eadd_reduce(frontier_edges, zero, frontier_prev, degrees, MULT_INT, PLUS_INT);
+
+            m_f = double(frontier_edges->as_int());
+            m_u = double(total_edges->as_int()) - m_f;
+        }
+
 #ifndef SPLA_RELEASE
         std::string mode;
-        if (push_pull) mode = "(push_pull " + std::to_string(front_factor * 100.0f) + "%)";
+        if (push_pull) mode = "(push_pull alpha " + std::to_string(alpha) + " beta " + std::to_string(beta) + ")";
         if (pull) mode = "(pull)";
         if (push) mode = "(push)";
 
@@ -89,23 +117,37 @@ namespace spla {
 #endif
             depth->set_int(current_level);
             exec_v_assign_masked(v, frontier_prev, depth, SECOND_INT, NQZERO_INT);
+            exec_v_assign_masked(visited, frontier_prev, depth, SECOND_INT, NQZERO_INT);
 
-            float front_density  = float(frontier_size->as_int()) / float(N);
-            bool  is_push_better = (front_density <= front_factor);
+            if (push_pull) {
+                const int n_f = frontier_size->as_int();
 
-            if (push || (push_pull && is_push_better)) {
-                exec_vxm_masked(frontier_new, v, frontier_prev, A, BAND_INT, BOR_INT, EQZERO_INT, zero, desc);
+                if (is_push && m_f > m_u / alpha) is_push = false;
+                else if (!is_push && n_f < prev_size && float(n_f) < float(N) / beta) is_push = true;
+
+                prev_size = n_f;
+            }
+
+            if (is_push) {
+                exec_vxm_masked(frontier_new, visited, frontier_prev, A, BAND_INT, BOR_INT, EQZERO_INT, zero, desc);
             } else {
-                exec_mxv_masked(frontier_new, v, A, frontier_prev, BAND_INT, BOR_INT, EQZERO_INT, zero, desc);
+                exec_mxv_masked(frontier_new, visited, A, frontier_prev, BAND_INT, BOR_INT, EQZERO_INT, zero, desc);
             }
 
             exec_v_count_mf(frontier_size, frontier_new);
 
+            if (push_pull) {
+                // New frontier vertices become visited, so their edges move from m_u to m_f
+                exec_v_eadd_reduce(frontier_edges, zero, frontier_new, degrees, MULT_INT, PLUS_INT);
+                m_f = double(frontier_edges->as_int());
+                m_u -= m_f;
+            }
+
 #ifndef SPLA_RELEASE
             tight.stop();
             std::cout << " - iter " << current_level
-                      << " front " << frontier_size->as_int() << " discovered " << discovered << " "
-                      << tight.get_elapsed_ms() << " ms" << std::endl;
+                      << " front " << frontier_size->as_int() << " discovered " << discovered
+                      << (is_push ? " push " : " pull ") << tight.get_elapsed_ms() << " ms" << std::endl;
             Library::get()->time_profile_dump();
             Library::get()->time_profile_reset();
 #endif
@@ -153,8 +195,127 @@ namespace spla {
 
 #pragma endregion Bfs
 
+#pragma region MsBfs
+
+    Status ms_bfs(std::vector<ref_ptr<Vector>>& levels,
+                  const ref_ptr<Matrix>&        A,
+                  const std::vector<uint>&      sources,
+                  const ref_ptr<Descriptor>&    descriptor) {
+        assert(A);
+
+        const uint N          = A->get_n_rows();
+        const uint BATCH_SIZE = uint(sizeof(T_INT) * 8);
+
+        levels.resize(sources.size());
+        for (auto& level : levels) {
+            if (!level) level = Vector::make(N, INT);
+        }
+
+        bool  push      = descriptor->get_push_only();
+        bool  pull      = descriptor->get_pull_only();
+        bool  push_pull = descriptor->get_push_pull();
+        float beta      = descriptor->get_push_pull_beta();
+
+        if (!(push || pull || push_pull)) push = true;
+
+        // Bit k of vertex word is set if vertex is in frontier (seen) of k-th source of batch
+        ref_ptr<OpBinary> op_and_not = OpBinary::make_int(
+                "band_not",
+                "(int a, int b) { return a & ~b; }",
+                [](T_INT a, T_INT b) { return a & ~b; });
+
+        std::vector<ref_ptr<OpSelect>> op_bits(BATCH_SIZE);
+        for (uint k = 0; k < BATCH_SIZE; k++) {
+            op_bits[k] = OpSelect::make_int(
+                    "bit_" + std::to_string(k),
+                    "(int a) { return (a >> " + std::to_string(k) + ") & 1; }",
+                    [k](T_INT a) { return ((a >> k) & 1) != 0; });
+        }
+
+        ref_ptr<Vector> frontier      = Vector::make(N, INT);
+        ref_ptr<Vector> frontier_new  = Vector::make(N, INT);
+        ref_ptr<Vector> seen          = Vector::make(N, INT);
+        ref_ptr<Vector> seen_fdb      = Vector::make(N, INT);
+        ref_ptr<Scalar> frontier_size = Scalar::make_int(0);
+        ref_ptr<Scalar> depth         = Scalar::make_int(1);
+        ref_ptr<Scalar> active        = Scalar::make_int(0);
+        ref_ptr<Scalar> zero          = Scalar::make_int(0);
+
+        for (std::size_t batch = 0; batch < sources.size(); batch += BATCH_SIZE) {
+            const uint batch_size = uint(std::min<std::size_t>(BATCH_SIZE, sources.size() - batch));
+
+            std::unordered_map<uint, T_INT> initial;
+            for (uint k = 0; k < batch_size; k++) {
+                initial[sources[batch + k]] |= T_INT(1u << k);
+            }
+
+            frontier->clear();
+            seen->clear();
+            for (const auto& e : initial) {
+                frontier->set_int(e.first, e.second);
+                seen->set_int(e.first, e.second);
+            }
+
+            // Vertices already reached from every source of batch are skipped by traversal
+            const T_INT       full_word    = batch_size == BATCH_SIZE ? T_INT(~0u) : T_INT((1u << batch_size) - 1u);
+            ref_ptr<OpSelect> op_not_full  = OpSelect::make_int(
+                    "not_full_" + std::to_string(batch_size),
+                    "(int a) { return a != " + std::to_string(full_word) + "; }",
+                    [full_word](T_INT a) { return a != full_word; });
+
+            int  current_level  = 1;
+            bool frontier_empty = false;
+
+            exec_v_count_mf(frontier_size, frontier);
+
+            // Graph is traversed once per level for whole batch, bits are propagated by or of words
+            while (!frontier_empty) {
+                // Levels are assigned only for sources which frontier is not exhausted yet
+                depth->set_int(current_level);
+                exec_v_reduce(active, zero, frontier, BOR_INT);
+                const T_INT active_bits = active->as_int();
+
+                for (uint k = 0; k < batch_size; k++) {
+                    if ((active_bits >> k) & 1) exec_v_assign_masked(levels[batch + k], frontier, depth, SECOND_INT, op_bits[k]);
+                }
+
+                const bool is_push = push || (push_pull && float(frontier_size->as_int()) < float(N) / beta);
+
+                if (is_push) {
+                    exec_vxm_masked(frontier_new, seen, frontier, A, FIRST_INT, BOR_INT, op_not_full, zero);
+                } else {
+                    exec_mxv_masked(frontier_new, seen, A, frontier, SECOND_INT, BOR_INT, op_not_full, zero);
+                }
+
+                exec_v_emult(frontier, frontier_new, seen, op_and_not);
+                exec_v_count_mf(frontier_size, frontier);
+
+                frontier_empty = frontier_size->as_int() == 0;
+
+                // Seen is updated in place only at new frontier entries
+                if (!frontier_empty) exec_v_eadd_fdb(seen, frontier, seen_fdb, BOR_INT);
+
+                current_level += 1;
+            }
+        }
+
+        return Status::Ok;
+    }
+
+#pragma endregion MsBfs
+
+
 #pragma region Sssp
 
+    /**
+     * Accum into v is cpu only: acc vxm and mxv refuse op_accum, so there relax goes
+     * as product and separate eadd_fdb instead of falling back to cpu on each iteration
+     */
+    static bool is_relax_accum_native() {
+        Library* g_lib = Library::get();
+        return !g_lib->get_accelerator() || g_lib->is_set_force_no_acceleration();
+    }
+
     Status sssp(const ref_ptr<Vector>&     v,
                 const ref_ptr<Matrix>&     A,
                 uint                       s,
@@ -168,28 +329,31 @@ namespace spla {
         ref_ptr<Vector> dummy_mask     = Vector::make(N, FLOAT);
         ref_ptr<Vector> frontier       = Vector::make(N, FLOAT);
         ref_ptr<Vector> feedback       = Vector::make(N, FLOAT);
+        ref_ptr<Vector> feedback_new   = Vector::make(N, FLOAT);
         ref_ptr<Scalar> feedback_size  = Scalar::make_int(0);
         ref_ptr<Scalar> inf_init       = Scalar::make_float(inf);
         int             current_level  = 1;
         bool            feedback_empty = false;
+        const bool      use_accum      = is_relax_accum_native();
 
         v->set_fill_value(inf_init);
-        feedback->set_fill_value(inf_init);
         frontier->set_fill_value(inf_init);
+        feedback->set_fill_value(inf_init);
+        feedback_new->set_fill_value(inf_init);
 
         v->set_float(s, 0.0f);
         feedback->set_float(s, 0.0f);
 
-        bool  push         = descriptor->get_push_only();
-        bool  pull         = descriptor->get_pull_only();
-        bool  push_pull    = descriptor->get_push_pull();
-        float front_factor = descriptor->get_front_factor();
+        bool  push      = descriptor->get_push_only();
+        bool  pull      = descriptor->get_pull_only();
+        bool  push_pull = descriptor->get_push_pull();
+        float beta      = descriptor->get_push_pull_beta();
 
         if (!(push || pull || push_pull)) push = true;
 
 #ifndef SPLA_RELEASE
         std::string mode;
-        if (push_pull) mode = "(push_pull " + std::to_string(front_factor * 100.0f) + "%)";
+        if (push_pull) mode = "(push_pull beta " + std::to_string(beta) + ")";
         if (pull) mode = "(pull)";
         if (push) mode = "(push)";
 
@@ -201,16 +365,29 @@ namespace spla {
 #ifndef SPLA_RELEASE
             tight.start();
 #endif
-            float front_density  = float(feedback_size->as_int()) / float(N);
-            bool  is_push_better = (front_density <= front_factor);
+            bool is_push_better = float(feedback_size->as_int()) < float(N) / beta;
 
+            // v min= feedback * A, updated distances become new feedback
             if (push || (push_pull && is_push_better)) {
-                exec_vxm_masked(frontier, dummy_mask, feedback, A, PLUS_FLOAT, MIN_FLOAT, ALWAYS_FLOAT, inf_init);
+                if (use_accum) {
+                    exec_vxm_masked_accum(v, ref_ptr<Vector>(), feedback, A, PLUS_FLOAT, MIN_FLOAT, ref_ptr<OpSelect>(), inf_init, MIN_FLOAT, feedback_new);
+                } else {
+                    exec_vxm_masked(frontier, dummy_mask, feedback, A, PLUS_FLOAT, MIN_FLOAT, ALWAYS_FLOAT, inf_init);
+                }
             } else {
-                exec_mxv_masked(frontier, dummy_mask, A, feedback, PLUS_FLOAT, MIN_FLOAT, ALWAYS_FLOAT, inf_init);
+                if (use_accum) {
+                    exec_mxv_masked_accum(v, ref_ptr<Vector>(), A, feedback, PLUS_FLOAT, MIN_FLOAT, ref_ptr<OpSelect>(), inf_init, MIN_FLOAT, feedback_new);
+                } else {
+                    exec_mxv_masked(frontier, dummy_mask, A, feedback, PLUS_FLOAT, MIN_FLOAT, ALWAYS_FLOAT, inf_init);
+                }
+            }
+
+            if (use_accum) {
+                std::swap(feedback, feedback_new);
+            } else {
+                exec_v_eadd_fdb(v, frontier, feedback, MIN_FLOAT);
             }
 
-            exec_v_eadd_fdb(v, frontier, feedback, MIN_FLOAT);
             exec_v_count_mf(feedback_size, feedback);
 
 #ifndef SPLA_RELEASE
@@ -228,6 +405,161 @@ namespace spla {
         return Status::Ok;
     }
 
+    Status sssp_delta(const ref_ptr<Vector>&     v,
+                      const ref_ptr<Matrix>&     A,
+                      uint                       s,
+                      float                      delta,
+                      const ref_ptr<Descriptor>& descriptor) {
+        assert(v);
+        assert(A);
+
+        if (!(delta > 0.0f)) return Status::InvalidArgument;
+
+        const auto N   = v->get_n_rows();
+        const auto inf = std::numeric_limits<float>::max();
+
+        // Split edges once into light (w <= delta) and heavy (w > delta) parts; ops are keyed by delta bits
+        std::uint32_t delta_bits;
+        std::memcpy(&delta_bits, &delta, sizeof(delta));
+
+        std::stringstream delta_literal;
+        delta_literal << std::showpoint << std::setprecision(9) << delta << "f";
+
+        ref_ptr<OpSelect> op_light = OpSelect::make_float(
+                "delta_light_" + std::to_string(delta_bits),
+                "(float a) { return a <= " + delta_literal.str() + "; }",
+                [delta](float a) { return a <= delta; });
+        ref_ptr<OpSelect> op_heavy = OpSelect::make_float(
+                "delta_heavy_" + std::to_string(delta_bits),
+                "(float a) { return a > " + delta_literal.str() + "; }",
+                [delta](float a) { return a > delta; });
+
+        ref_ptr<Matrix> A_light = Matrix::make(A->get_n_rows(), A->get_n_cols(), FLOAT);
+        ref_ptr<Matrix> A_heavy = Matrix::make(A->get_n_rows(), A->get_n_cols(), FLOAT);
+
+        exec_m_select(A_light, A, op_light);
+        exec_m_select(A_heavy, A, op_heavy);
+
+        ref_ptr<Vector> pending     = Vector::make(N, FLOAT);
+        ref_ptr<Vector> pending_new = Vector::make(N, FLOAT);
+        ref_ptr<Vector> frontier    = Vector::make(N, FLOAT);
+        ref_ptr<Vector> settled     = Vector::make(N, FLOAT);
+        ref_ptr<Vector> settled_new = Vector::make(N, FLOAT);
+        ref_ptr<Vector> changed     = Vector::make(N, FLOAT);
+        ref_ptr<Vector> product     = Vector::make(N, FLOAT);
+        ref_ptr<Vector> dummy_mask  = Vector::make(N, FLOAT);
+        ref_ptr<Scalar> inf_init    = Scalar::make_float(inf);
+        ref_ptr<Scalar> lo          = Scalar::make_float(0.0f);
+        ref_ptr<Scalar> hi          = Scalar::make_float(delta);
+        ref_ptr<Scalar> next        = Scalar::make_float(inf);
+        ref_ptr<Scalar> count       = Scalar::make_int(0);
+        int             current_bucket = 0;
+
+        for (const auto& w : {v, pending, pending_new, frontier, settled, settled_new, changed, product}) {
+            w->set_fill_value(inf_init);
+        }
+
+        v->set_float(s, 0.0f);
+        pending->set_float(s, 0.0f);
+
+        const ref_ptr<Descriptor> desc = descriptor ? descriptor : Descriptor::make();
+
+        bool  push      = desc->get_push_only();
+        bool  pull      = desc->get_pull_only();
+        bool  push_pull = desc->get_push_pull();
+        float beta      = desc->get_push_pull_beta();
+
+        if (!(push || pull || push_pull)) push = true;
+
+        const bool use_accum = is_relax_accum_native();
+
+        // v min= from * A_part, same push or pull choice as in sssp; updated distances go to changed
+        auto relax = [&](const ref_ptr<Matrix>& A_part, const ref_ptr<Vector>& from) {
+            bool is_push_better = true;
+
+            if (push_pull) {
+                exec_v_count_mf(count, from);
+                is_push_better = float(count->as_int()) < float(N) / beta;
+            }
+
+            if (push || (push_pull && is_push_better)) {
+                if (use_accum) {
+                    exec_vxm_masked_accum(v, ref_ptr<Vector>(), from, A_part, PLUS_FLOAT, MIN_FLOAT, ref_ptr<OpSelect>(), inf_init, MIN_FLOAT, changed);
+                } else {
+                    exec_vxm_masked(product, dummy_mask, from, A_part, PLUS_FLOAT, MIN_FLOAT, ALWAYS_FLOAT, inf_init);
+                }
+            } else {
+                if (use_accum) {
+                    exec_mxv_masked_accum(v, ref_ptr<Vector>(), A_part, from, PLUS_FLOAT, MIN_FLOAT, ref_ptr<OpSelect>(), inf_init, MIN_FLOAT, changed);
+                } else {
+                    exec_mxv_masked(product, dummy_mask, A_part, from, PLUS_FLOAT, MIN_FLOAT, ALWAYS_FLOAT, inf_init);
+                }
+            }
+
+            if (!use_accum) {
+                exec_v_eadd_fdb(v, product, changed, MIN_FLOAT);
+            }
+        };
+
+#ifndef SPLA_RELEASE
+        std::cout << "start sssp_delta from " << s << " (delta " << delta << ")" << std::endl;
+
+        Timer tight;
+#endif
+        // Pending holds tentative distances of reached but not settled vertices, so each
+        // bucket costs proportionally to its fringe rather than to the number of vertices
+        while (true) {
+            exec_v_reduce(next, inf_init, pending, MIN_FLOAT);
+            if (next->as_float() == inf) break;
+
+#ifndef SPLA_RELEASE
+            tight.start();
+#endif
+            // Bucket [lo, lo + delta) starts at the smallest pending distance, so empty buckets are skipped
+            lo->set_float(next->as_float());
+            hi->set_float(next->as_float() + delta);
+
+            exec_v_select_range(frontier, pending, lo, hi);
+            exec_v_select_range(settled, pending, lo, hi);
+
+            // Relax light edges until bucket is stable, reinserted vertices are relaxed again
+            while (true) {
+                relax(A_light, frontier);
+
+                exec_v_eadd(pending_new, pending, changed, MIN_FLOAT);
+                std::swap(pending, pending_new);
+
+                exec_v_select_range(frontier, changed, lo, hi);
+                exec_v_count_mf(count, frontier);
+                if (count->as_int() == 0) break;
+
+                exec_v_eadd(settled_new, settled, frontier, MIN_FLOAT);
+                std::swap(settled, settled_new);
+            }
+
+            // Distances in bucket are final, heavy edges always land past it, so relax them once
+            exec_v_select_range(pending_new, pending, hi, inf_init);
+            std::swap(pending, pending_new);
+            relax(A_heavy, settled);
+            exec_v_eadd(pending_new, pending, changed, MIN_FLOAT);
+            std::swap(pending, pending_new);
+
+#ifndef SPLA_RELEASE
+            tight.stop();
+            exec_v_count_mf(count, settled);
+            std::cout << " - bucket " << current_bucket
+                      << " lo " << lo->as_float()
+                      << " settled " << count->as_int()
+                      << " " << tight.get_elapsed_ms() << " ms" << std::endl;
+            Library::get()->time_profile_dump();
+            Library::get()->time_profile_reset();
+#endif
+            current_bucket += 1;
+        }
+
+        return Status::Ok;
+    }
+
     Status sssp_naive(std::vector<float>&              v,
                       std::vector<std::vector<uint>>&  Ai,
                       std::vector<std::vector<float>>& Ax,
@@ -285,13 +617,11 @@ namespace spla {
 
         const auto N = p->get_n_rows();
 
-        ref_ptr<Vector> dummy_mask = Vector::make(N, FLOAT);
-        ref_ptr<Vector> p_prev     = Vector::make(N, FLOAT);
-        ref_ptr<Vector> p_tmp      = Vector::make(N, FLOAT);
-        ref_ptr<Vector> addition   = Vector::make(N, FLOAT);
-        ref_ptr<Vector> errors     = Vector::make(N, FLOAT);
-        ref_ptr<Scalar> error2     = Scalar::make(FLOAT);
-        ref_ptr<Scalar> zero       = Scalar::make_float(0.0f);
+        ref_ptr<Vector> p_prev   = Vector::make(N, FLOAT);
+        ref_ptr<Vector> p_tmp    = Vector::make(N, FLOAT);
+        ref_ptr<Vector> addition = Vector::make(N, FLOAT);
+        ref_ptr<Scalar> error2   = Scalar::make(FLOAT);
+        ref_ptr<Scalar> zero     = Scalar::make_float(0.0f);
 
         addition->fill_with(Scalar::make_float((1.0f - alpha) / float(N)));
         p_prev->fill_with(Scalar::make_float(1.0f / float(N)));
@@ -309,12 +639,11 @@ namespace spla {
             tight.start();
 #endif
             // p = A*p + (1-alpha)/N
-            exec_mxv_masked(p_tmp, dummy_mask, A, p_prev, MULT_FLOAT, PLUS_FLOAT, ALWAYS_FLOAT, zero);
+            exec_mxv_masked(p_tmp, ref_ptr<Vector>(), A, p_prev, MULT_FLOAT, PLUS_FLOAT, ref_ptr<OpSelect>(), zero);
             exec_v_eadd(p, p_tmp, addition, PLUS_FLOAT);
 
-            // error = sqrt((p[01]-prev[0])^2 + ... + p[N-1]-prev[N-1])^2)
-            exec_v_eadd(errors, p, p_prev, MINUS_POW2_FLOAT);
-            exec_v_reduce(error2, zero, errors, PLUS_FLOAT);
+            // error = sqrt((p[01]-prev[0])^2 + ... + p[N-1]-prev[N-1])^2), fused in a single pass
+            exec_v_eadd_reduce(error2, zero, p, p_prev, MINUS_POW2_FLOAT, PLUS_FLOAT);
 
             error = std::sqrt(error2->as_float());
 
@@ -413,6 +742,33 @@ namespace spla {
         return Status::Ok;
     }
 
+    Status tc_orient(
+            const ref_ptr<Matrix>&     L,
+            const ref_ptr<Matrix>&     A,
+            const ref_ptr<Descriptor>& descriptor) {
+        assert(L);
+        assert(A);
+        assert(L.get() != A.get());
+
+        const uint N = A->get_n_rows();
+
+        ref_ptr<Scalar>  zero    = Scalar::make_int(0);
+        ref_ptr<Vector>  degrees = Vector::make(N, INT);
+        ref_ptr<Vector>  key     = Vector::make(N, INT);
+        ref_ptr<OpUnary> op_neg  = OpUnary::make_int(
+                 "neg",
+                 "(int a) { return -a; }",
+                 [](T_INT a) { return -a; });
+
+        // Order by decreasing degree: row of vertex keeps neighbours of higher degree only,
+        // so orientation is given by comparison of keys and no explicit relabeling is required
+        exec_m_reduce_by_row(degrees, A, PLUS_INT, zero, descriptor);
+        exec_v_map(key, degrees, op_neg, descriptor);
+        exec_m_tril(L, A, key, descriptor);
+
+        return Status::Ok;
+    }
+
     Status tc_naive(
             int&                                  ntrins,
             std::vector<std::vector<spla::uint>>& Ai,
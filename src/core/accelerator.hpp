@@ -29,7 +29,9 @@
 #define SPLA_ACCELERATOR_HPP
 
 #include <spla/config.hpp>
+#include <spla/schedule.hpp>
 
+#include <cstddef>
 #include <string>
 
 namespace spla {
@@ -54,18 +56,30 @@ namespace spla {
      * Typical accelerator implementation is a GPUs utilization by usage of
      * OpenCL or CUDA API. In this case additional device resident data stored
      * with host data and kernels dispatched in order to perform computations.
+     *
+     * Accelerated tasks are bracketed by begin and end task calls, so accelerator
+     * may run independent tasks of a schedule step concurrently; join tasks is
+     * called at the end of each step, after which all tasks of step are ordered
+     * before any further work.
      */
     class Accelerator {
     public:
         virtual ~Accelerator() = default;
 
-        virtual Status             init()                      = 0;
-        virtual Status             set_platform(int index)     = 0;
-        virtual Status             set_device(int index)       = 0;
-        virtual Status             set_queues_count(int count) = 0;
-        virtual const std::string& get_name()                  = 0;
-        virtual const std::string& get_description()           = 0;
-        virtual const std::string& get_suffix()                = 0;
+        virtual Status             init()                                                                              = 0;
+        virtual Status             set_platform(int index)                                                             = 0;
+        virtual Status             set_device(int index)                                                               = 0;
+        virtual Status             set_queues_count(int count)                                                         = 0;
+        virtual Status             set_program_cache(const std::string& dir, std::size_t max_size)                     = 0;
+        virtual Status             set_precompile(bool value)                                                          = 0;
+        virtual Status             set_mem_cache_limit(std::size_t bytes)                                              = 0;
+        virtual Status             get_mem_stats(std::size_t& bytes_live, std::size_t& bytes_cached, double& hit_rate) = 0;
+        virtual void               begin_task(const ref_ptr<ScheduleTask>& task, int queue_id)                         = 0;
+        virtual void               end_task(const ref_ptr<ScheduleTask>& task)                                         = 0;
+        virtual void               join_tasks()                                                                        = 0;
+        virtual const std::string& get_name()                                                                          = 0;
+        virtual const std::string& get_description()                                                                   = 0;
+        virtual const std::string& get_suffix()                                                                        = 0;
     };
 
     /**
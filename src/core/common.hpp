@@ -31,6 +31,11 @@
 #include <spla/config.hpp>
 
 #include <cmath>
+#include <cstdint>
+
+#if defined(SPLA_MSVC)
+    #include <intrin.h>
+#endif
 
 namespace spla {
 
@@ -68,6 +73,24 @@ namespace spla {
         return r / 2;
     }
 
+    static inline uint popcount64(std::uint64_t x) {
+#if defined(SPLA_MSVC)
+        return static_cast<uint>(__popcnt64(x));
+#else
+        return static_cast<uint>(__builtin_popcountll(x));
+#endif
+    }
+
+    static inline uint ctz64(std::uint64_t x) {
+#if defined(SPLA_MSVC)
+        unsigned long index;
+        _BitScanForward64(&index, x);
+        return static_cast<uint>(index);
+#else
+        return static_cast<uint>(__builtin_ctzll(x));
+#endif
+    }
+
 }// namespace spla
 
 #endif//SPLA_COMMON_HPP
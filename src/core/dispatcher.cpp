@@ -30,6 +30,7 @@
 #include <core/accelerator.hpp>
 #include <core/logger.hpp>
 #include <core/registry.hpp>
+#include <profiling/dispatch_tracer.hpp>
 
 #include <cstdlib>
 
@@ -40,6 +41,20 @@
 namespace spla {
 
     Status Dispatcher::dispatch(const DispatchContext& ctx) {
+        DispatchTracer* g_tracer = Library::get()->get_dispatch_tracer();
+
+        if (g_tracer->is_enabled()) {
+            DispatchTraceEvent event;
+            g_tracer->begin(event, ctx.task);
+            Status status = dispatch_algo(ctx);
+            g_tracer->end(event, ctx.task, status);
+            return status;
+        }
+
+        return dispatch_algo(ctx);
+    }
+
+    Status Dispatcher::dispatch_algo(const DispatchContext& ctx) {
         Library*     g_lib        = Library::get();
         Registry*    g_reg        = g_lib->get_registry();
         Accelerator* g_acc        = g_lib->get_accelerator();
@@ -53,35 +68,58 @@ namespace spla {
             algo                = g_reg->find(key_acc);
         }
 
-        if (!algo) {
-            std::string key_cpu = key + CPU_SUFFIX;
-            algo                = g_reg->find(key_cpu);
+        if (algo) {
+            if (DispatchTracer::is_active()) {
+                DispatchTracer::set_algo(algo->get_name(), g_acc->get_suffix());
+            }
+
+            g_acc->begin_task(ctx.task, ctx.task_id);
+            Status status = execute_algo(algo, ctx);
+            g_acc->end_task(ctx.task);
+
+            // Accelerated algo may reject task params it does not support
+            if (status != Status::NotImplemented) {
+                return status;
+            }
+
+            LOG_MSG(Status::Ok, "fallback to cpu for key " << key);
         }
 
+        std::string key_cpu = key + CPU_SUFFIX;
+        algo                = g_reg->find(key_cpu);
+
         if (algo) {
-            try {
-                return algo->execute(ctx);
+            if (DispatchTracer::is_active()) {
+                DispatchTracer::set_algo(algo->get_name(), CPU_SUFFIX);
             }
+
+            return execute_algo(algo, ctx);
+        }
+
+        LOG_MSG(Status::NotImplemented, "failed to find suitable algo for key " << key);
+        return Status::NotImplemented;
+    }
+
+    Status Dispatcher::execute_algo(const std::shared_ptr<RegistryAlgo>& algo, const DispatchContext& ctx) {
+        try {
+            return algo->execute(ctx);
+        }
 #if defined(SPLA_BUILD_OPENCL) && defined(CL_HPP_ENABLE_EXCEPTIONS)
-            catch (const cl::BuildError& cl_ex) {
-                LOG_MSG(Status::Error, "not handled cl exception thrown: " << cl_ex.getBuildLog().front().second);
+        catch (const cl::BuildError& cl_ex) {
+            LOG_MSG(Status::Error, "not handled cl exception thrown: " << cl_ex.getBuildLog().front().second);
     #ifndef SPLA_RELEASE
-                std::abort();
+            std::abort();
     #endif
-                return Status::Error;
-            }
+            return Status::Error;
+        }
 #endif
-            catch (const std::exception& ex) {
-                LOG_MSG(Status::Error, "not handled exception thrown: " << ex.what());
+        catch (const std::exception& ex) {
+            LOG_MSG(Status::Error, "not handled exception thrown: " << ex.what());
 #ifndef SPLA_RELEASE
-                std::abort();
+            std::abort();
 #endif
-                return Status::Error;
-            }
+            return Status::Error;
         }
-
-        LOG_MSG(Status::NotImplemented, "failed to find suitable algo for key " << key);
-        return Status::NotImplemented;
     }
 
 }// namespace spla
\ No newline at end of file
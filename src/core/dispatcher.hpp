@@ -59,6 +59,10 @@ namespace spla {
     public:
         virtual ~Dispatcher() = default;
         virtual Status dispatch(const DispatchContext& ctx);
+
+    protected:
+        static Status dispatch_algo(const DispatchContext& ctx);
+        static Status execute_algo(const std::shared_ptr<RegistryAlgo>& algo, const DispatchContext& ctx);
     };
 
     /**
@@ -0,0 +1,369 @@
+/**********************************************************************************/
+/* This file is part of spla project                                              */
+/* https://github.com/SparseLinearAlgebra/spla                                    */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2023 SparseLinearAlgebra                                         */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#include "lazy_planner.hpp"
+
+#include <spla/matrix.hpp>
+#include <spla/scalar.hpp>
+#include <spla/vector.hpp>
+
+#include <core/dispatcher.hpp>
+#include <core/logger.hpp>
+#include <schedule/schedule_tasks.hpp>
+
+#include <algorithm>
+#include <unordered_set>
+#include <utility>
+
+namespace spla {
+
+    static const Object* as_data_object(const ref_ptr<Object>& arg) {
+        const Object* object = arg.get();
+
+        if (dynamic_cast<const Vector*>(object) ||
+            dynamic_cast<const Matrix*>(object) ||
+            dynamic_cast<const Scalar*>(object)) {
+            return object;
+        }
+
+        return nullptr;
+    }
+
+    static std::vector<const Object*> get_data_args(const ref_ptr<ScheduleTask>& task) {
+        std::vector<const Object*> data_args;
+
+        for (const auto& arg : task->get_args()) {
+            if (const Object* object = as_data_object(arg)) {
+                data_args.push_back(object);
+            }
+        }
+
+        return data_args;
+    }
+
+    static bool is_pure_task(const std::string& name) {
+        return name == "v_eadd" ||
+               name == "v_eadd_reduce" ||
+               name == "v_ewise_chain" ||
+               name == "v_emult" ||
+               name == "v_map" ||
+               name == "v_select_range" ||
+               name == "v_reduce" ||
+               name == "v_count_mf" ||
+               name == "m_reduce" ||
+               name == "m_reduce_by_row" ||
+               name == "m_select" ||
+               name == "m_tril";
+    }
+
+    Status LazyPlanner::submit(ref_ptr<ScheduleTask> task) {
+        if (m_running) {
+            return dispatch(task);
+        }
+
+        // Callback can access any object, so it is a barrier for pending tasks
+        if (task->get_name() == "callback") {
+            Status status = sync_all();
+            if (status != Status::Ok) {
+                return status;
+            }
+            return dispatch(task);
+        }
+
+        track(task, 1);
+        m_pending.push_back(std::move(task));
+
+        if (m_pending.size() >= MAX_PENDING) {
+            return sync_all();
+        }
+
+        return Status::Ok;
+    }
+
+    Status LazyPlanner::sync(const Object* object) {
+        if (m_running || m_pending.empty() || m_uses.find(object) == m_uses.end()) {
+            return Status::Ok;
+        }
+
+        // Walk backwards collecting tasks which object transitively depends on
+        std::unordered_set<const Object*> needed{object};
+        std::vector<bool>                 selected(m_pending.size(), false);
+
+        for (std::size_t i = m_pending.size(); i > 0; i--) {
+            const auto data_args = get_data_args(m_pending[i - 1]);
+            const bool touches   = std::any_of(data_args.begin(), data_args.end(), [&](const Object* arg) { return needed.count(arg) > 0; });
+
+            if (touches) {
+                selected[i - 1] = true;
+                needed.insert(data_args.begin(), data_args.end());
+            }
+        }
+
+        task_list batch;
+        task_list rest;
+
+        for (std::size_t i = 0; i < m_pending.size(); i++) {
+            (selected[i] ? batch : rest).push_back(std::move(m_pending[i]));
+        }
+
+        m_pending = std::move(rest);
+
+        return run(std::move(batch));
+    }
+
+    Status LazyPlanner::sync_all() {
+        if (m_running || m_pending.empty()) {
+            return Status::Ok;
+        }
+
+        task_list batch = std::move(m_pending);
+        m_pending.clear();
+
+        return run(std::move(batch));
+    }
+
+    Status LazyPlanner::run(task_list batch) {
+        m_running = true;
+
+        fuse(batch);
+        drop_dead(batch);
+
+        Status status = Status::Ok;
+
+        for (auto& task : batch) {
+            Status task_status = dispatch(task);
+            track(task, -1);
+
+            if (task_status != Status::Ok && status == Status::Ok) {
+                LOG_MSG(task_status, "failed to execute lazy task " << task->get_key());
+                status = task_status;
+            }
+        }
+
+        m_running = false;
+
+        return status;
+    }
+
+    void LazyPlanner::fuse(task_list& batch) {
+        std::size_t i = 0;
+
+        while (i < batch.size()) {
+            const std::size_t     consumer = find_consumer(batch, i);
+            ref_ptr<ScheduleTask> fused    = consumer < batch.size() ? make_fused(batch[i], batch[consumer]) : ref_ptr<ScheduleTask>();
+
+            if (!fused) {
+                i += 1;
+                continue;
+            }
+
+            track(batch[i], -1);
+            track(batch[consumer], -1);
+            track(fused, 1);
+
+            // Fused task stays at consumer position and may be fused again as a producer
+            batch[consumer] = std::move(fused);
+            batch.erase(batch.begin() + static_cast<std::ptrdiff_t>(i));
+        }
+    }
+
+    std::size_t LazyPlanner::find_consumer(const task_list& batch, std::size_t producer) const {
+        const std::string name = batch[producer]->get_name();
+
+        if (name != "v_eadd" && name != "v_map" && name != "v_ewise_chain") {
+            return batch.size();
+        }
+
+        const auto    inputs = get_data_args(batch[producer]);
+        const Object* t      = inputs.front();
+
+        // Temporary vector must be written by producer and read by exactly one consumer
+        if (!dynamic_cast<const Vector*>(t) ||
+            std::count(inputs.begin(), inputs.end(), t) != 1 ||
+            !is_dead(t, 2)) {
+            return batch.size();
+        }
+
+        for (std::size_t j = producer + 1; j < batch.size(); j++) {
+            const auto data_args = get_data_args(batch[j]);
+            const bool touches_t = std::find(data_args.begin(), data_args.end(), t) != data_args.end();
+
+            if (touches_t) {
+                return j;
+            }
+
+            // Fused task runs at consumer position, so producer inputs must stay intact until then
+            const bool touches_inputs = std::any_of(data_args.begin(), data_args.end(), [&](const Object* arg) {
+                return std::find(inputs.begin() + 1, inputs.end(), arg) != inputs.end();
+            });
+
+            if (touches_inputs) {
+                return batch.size();
+            }
+        }
+
+        return batch.size();
+    }
+
+    ref_ptr<ScheduleTask> LazyPlanner::make_fused(const ref_ptr<ScheduleTask>& producer, const ref_ptr<ScheduleTask>& consumer) {
+        const std::string producer_name = producer->get_name();
+        const std::string consumer_name = consumer->get_name();
+        const Object*     t             = as_data_object(producer->get_args().front());
+
+        ref_ptr<Vector> consumer_v;
+        ref_ptr<Type>   consumer_type;
+
+        if (consumer_name == "v_reduce") {
+            auto reduce   = consumer.cast_safe<ScheduleTask_v_reduce>();
+            consumer_v    = reduce->v;
+            consumer_type = reduce->r->get_type();
+        } else if (consumer_name == "v_map") {
+            auto map = consumer.cast_safe<ScheduleTask_v_map>();
+            if (map->r.get() == t) return ref_ptr<ScheduleTask>();
+            consumer_v    = map->v;
+            consumer_type = map->r->get_type();
+        } else {
+            return ref_ptr<ScheduleTask>();
+        }
+
+        auto temp = producer->get_args().front().cast_safe<Vector>();
+
+        if (consumer_v.get() != t || consumer_type.get() != temp->get_type().get()) {
+            return ref_ptr<ScheduleTask>();
+        }
+
+        // Eadd with reduce has dedicated kernels on all backends
+        if (producer_name == "v_eadd" && consumer_name == "v_reduce") {
+            auto eadd   = producer.cast_safe<ScheduleTask_v_eadd>();
+            auto reduce = consumer.cast_safe<ScheduleTask_v_reduce>();
+
+            auto fused       = make_ref<ScheduleTask_v_eadd_reduce>();
+            fused->r         = reduce->r;
+            fused->s         = reduce->s;
+            fused->u         = eadd->u;
+            fused->v         = eadd->v;
+            fused->op_elem   = eadd->op;
+            fused->op_reduce = reduce->op_reduce;
+            fused->desc      = reduce->desc;
+
+            return fused.as<ScheduleTask>();
+        }
+
+        // Longer chains have cpu kernel only, so fusing them must not move work off accelerator
+        Library* g_lib = Library::get();
+        if (g_lib->get_accelerator() && !g_lib->is_set_force_no_acceleration()) {
+            return ref_ptr<ScheduleTask>();
+        }
+
+        auto chain = make_ref<ScheduleTask_v_ewise_chain>();
+
+        if (producer_name == "v_eadd") {
+            auto eadd      = producer.cast_safe<ScheduleTask_v_eadd>();
+            chain->u       = eadd->u;
+            chain->v       = eadd->v;
+            chain->op_elem = eadd->op;
+        } else if (producer_name == "v_map") {
+            auto map = producer.cast_safe<ScheduleTask_v_map>();
+            chain->u = map->v;
+            chain->ops_map.push_back(map->op);
+        } else {
+            auto prev      = producer.cast_safe<ScheduleTask_v_ewise_chain>();
+            chain->u       = prev->u;
+            chain->v       = prev->v;
+            chain->op_elem = prev->op_elem;
+            chain->ops_map = prev->ops_map;
+            chain->temps   = prev->temps;
+        }
+
+        chain->temps.push_back(temp);
+
+        if (consumer_name == "v_reduce") {
+            auto reduce      = consumer.cast_safe<ScheduleTask_v_reduce>();
+            chain->reduced   = reduce->r;
+            chain->s         = reduce->s;
+            chain->op_reduce = reduce->op_reduce;
+            chain->desc      = reduce->desc;
+        } else {
+            auto map    = consumer.cast_safe<ScheduleTask_v_map>();
+            chain->r    = map->r;
+            chain->desc = map->desc;
+            chain->ops_map.push_back(map->op);
+        }
+
+        return chain.as<ScheduleTask>();
+    }
+
+    void LazyPlanner::drop_dead(task_list& batch) {
+        for (std::size_t i = batch.size(); i > 0; i--) {
+            auto& task = batch[i - 1];
+
+            if (!is_pure_task(task->get_name())) {
+                continue;
+            }
+
+            const Object* result = as_data_object(task->get_args().front());
+
+            if (result && is_dead(result, 1)) {
+                track(task, -1);
+                batch.erase(batch.begin() + static_cast<std::ptrdiff_t>(i - 1));
+            }
+        }
+    }
+
+    void LazyPlanner::track(const ref_ptr<ScheduleTask>& task, int delta) {
+        for (const Object* object : get_data_args(task)) {
+            auto& uses = m_uses[object];
+            uses += delta;
+
+            if (uses <= 0) {
+                m_uses.erase(object);
+            }
+        }
+    }
+
+    bool LazyPlanner::is_dead(const Object* object, int uses) const {
+        return get_uses(object) == uses && object->get_refs() == uses;
+    }
+
+    int LazyPlanner::get_uses(const Object* object) const {
+        auto query = m_uses.find(object);
+        return query != m_uses.end() ? query->second : 0;
+    }
+
+    Status LazyPlanner::dispatch(const ref_ptr<ScheduleTask>& task) {
+        Dispatcher*     g_dispatcher = Library::get()->get_dispatcher();
+        DispatchContext ctx{};
+        ctx.task = task;
+        return g_dispatcher->dispatch(ctx);
+    }
+
+    Status lazy_sync(const Object* object) {
+        LazyPlanner* g_planner = Library::get()->get_lazy_planner();
+        return g_planner->has_pending() ? g_planner->sync(object) : Status::Ok;
+    }
+
+}// namespace spla
@@ -0,0 +1,113 @@
+/**********************************************************************************/
+/* This file is part of spla project                                              */
+/* https://github.com/SparseLinearAlgebra/spla                                    */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2023 SparseLinearAlgebra                                         */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#ifndef SPLA_LAZY_PLANNER_HPP
+#define SPLA_LAZY_PLANNER_HPP
+
+#include <spla/library.hpp>
+#include <spla/schedule.hpp>
+
+#include <cstddef>
+#include <unordered_map>
+#include <vector>
+
+namespace spla {
+
+    /**
+     * @addtogroup internal
+     * @{
+     */
+
+    /**
+     * @class LazyPlanner
+     * @brief Collects tasks in non-blocking execution mode and runs them on demand
+     *
+     * Tasks submitted in lazy mode are stored in submission order. When a result
+     * of some object is observed, only pending tasks this object depends on are
+     * executed. Dependencies are tracked conservatively: two tasks depend on each
+     * other if they share any vector, matrix or scalar argument.
+     *
+     * Before execution planner fuses chains of element-wise, map and reduce tasks
+     * connected through temporaries into a single task, and drops tasks computing
+     * temporaries, which are not referenced by any one except pending tasks.
+     * Element-wise op followed by reduction becomes v_eadd_reduce, available on all
+     * backends; longer chains become v_ewise_chain, fused only when tasks run on cpu.
+     */
+    class LazyPlanner {
+    public:
+        Status submit(ref_ptr<ScheduleTask> task);
+        Status sync(const Object* object);
+        Status sync_all();
+        bool   has_pending() const { return !m_pending.empty(); }
+        bool   is_running() const { return m_running; }
+
+    private:
+        using task_list = std::vector<ref_ptr<ScheduleTask>>;
+
+        Status      run(task_list batch);
+        void        fuse(task_list& batch);
+        std::size_t find_consumer(const task_list& batch, std::size_t producer) const;
+        void        drop_dead(task_list& batch);
+        void        track(const ref_ptr<ScheduleTask>& task, int delta);
+        bool        is_dead(const Object* object, int uses) const;
+        int         get_uses(const Object* object) const;
+
+        static ref_ptr<ScheduleTask> make_fused(const ref_ptr<ScheduleTask>& producer, const ref_ptr<ScheduleTask>& consumer);
+
+        static Status dispatch(const ref_ptr<ScheduleTask>& task);
+
+        static constexpr std::size_t MAX_PENDING = 512;
+
+        task_list                              m_pending;
+        std::unordered_map<const Object*, int> m_uses;
+        bool                                   m_running = false;
+    };
+
+    /**
+     * @brief Execute pending lazy tasks required to observe object state
+     *
+     * @param object Object to be read or modified by user
+     *
+     * @return Status of pending tasks execution
+     */
+    Status lazy_sync(const Object* object);
+
+#define LAZY_SYNC(object)                         \
+    do {                                          \
+        Status __lazy_status = lazy_sync(object); \
+        if (__lazy_status != Status::Ok) {        \
+            return __lazy_status;                 \
+        }                                         \
+    } while (false)
+
+    /**
+     * @}
+     */
+
+}// namespace spla
+
+#endif//SPLA_LAZY_PLANNER_HPP
@@ -32,6 +32,7 @@
 
 #include <array>
 #include <bitset>
+#include <cstddef>
 
 namespace spla {
 
@@ -54,6 +55,9 @@ namespace spla {
         /** @return Number of value in decoration */
         [[nodiscard]] virtual uint get_n_values() const { return values; }
 
+        /** @return Approximate size in bytes of decoration data */
+        [[nodiscard]] virtual std::size_t get_mem_size() const { return 0; }
+
     public:
         uint values = 0;
     };
@@ -31,6 +31,7 @@
 #include <spla/config.hpp>
 #include <spla/matrix.hpp>
 
+#include <core/lazy_planner.hpp>
 #include <core/logger.hpp>
 #include <core/tdecoration.hpp>
 #include <core/top.hpp>
@@ -39,6 +40,8 @@
 #include <storage/storage_manager.hpp>
 #include <storage/storage_manager_matrix.hpp>
 
+#include <algorithm>
+
 namespace spla {
 
     /**
@@ -81,6 +84,7 @@ namespace spla {
         void validate_wd(FormatMatrix format);
         void validate_ctor(FormatMatrix format);
         bool is_valid(FormatMatrix format) const;
+        uint get_n_values();
 
         static StorageManagerMatrix<T>* get_storage_manager();
 
@@ -118,11 +122,13 @@ namespace spla {
 
     template<typename T>
     Status TMatrix<T>::set_format(FormatMatrix format) {
+        LAZY_SYNC(this);
         validate_rw(format);
         return Status::Ok;
     }
     template<typename T>
     Status TMatrix<T>::set_fill_value(const ref_ptr<Scalar>& value) {
+        LAZY_SYNC(this);
         if (value) {
             m_storage.invalidate();
 
@@ -137,6 +143,7 @@ namespace spla {
     }
     template<typename T>
     Status TMatrix<T>::set_reduce(ref_ptr<OpBinary> resolve_duplicates) {
+        LAZY_SYNC(this);
         auto reduce = resolve_duplicates.template cast_safe<TOpBinary<T, T, T>>();
 
         if (reduce) {
@@ -151,18 +158,21 @@ namespace spla {
 
     template<typename T>
     Status TMatrix<T>::set_int(uint row_id, uint col_id, std::int32_t value) {
+        LAZY_SYNC(this);
         validate_rw(FormatMatrix::CpuLil);
         cpu_lil_add_element(row_id, col_id, static_cast<T>(value), *get<CpuLil<T>>());
         return Status::Ok;
     }
     template<typename T>
     Status TMatrix<T>::set_uint(uint row_id, uint col_id, std::uint32_t value) {
+        LAZY_SYNC(this);
         validate_rw(FormatMatrix::CpuLil);
         cpu_lil_add_element(row_id, col_id, static_cast<T>(value), *get<CpuLil<T>>());
         return Status::Ok;
     }
     template<typename T>
     Status TMatrix<T>::set_float(uint row_id, uint col_id, float value) {
+        LAZY_SYNC(this);
         validate_rw(FormatMatrix::CpuLil);
         cpu_lil_add_element(row_id, col_id, static_cast<T>(value), *get<CpuLil<T>>());
         return Status::Ok;
@@ -170,6 +180,7 @@ namespace spla {
 
     template<typename T>
     Status TMatrix<T>::get_int(uint row_id, uint col_id, int32_t& value) {
+        LAZY_SYNC(this);
         validate_rw(FormatMatrix::CpuDok);
 
         auto& Ax    = get<CpuDok<T>>()->Ax;
@@ -184,6 +195,7 @@ namespace spla {
     }
     template<typename T>
     Status TMatrix<T>::get_uint(uint row_id, uint col_id, uint32_t& value) {
+        LAZY_SYNC(this);
         validate_rw(FormatMatrix::CpuDok);
 
         auto& Ax    = get<CpuDok<T>>()->Ax;
@@ -198,6 +210,7 @@ namespace spla {
     }
     template<typename T>
     Status TMatrix<T>::get_float(uint row_id, uint col_id, float& value) {
+        LAZY_SYNC(this);
         validate_rw(FormatMatrix::CpuDok);
 
         auto& Ax    = get<CpuDok<T>>()->Ax;
@@ -213,6 +226,7 @@ namespace spla {
 
     template<typename T>
     Status TMatrix<T>::clear() {
+        LAZY_SYNC(this);
         m_storage.invalidate();
         return Status::Ok;
     }
@@ -246,6 +260,23 @@ namespace spla {
         return m_storage.is_valid(format);
     }
 
+    template<typename T>
+    uint TMatrix<T>::get_n_values() {
+        uint n_values = 0;
+        bool found    = false;
+
+        // Most compact valid format gives the best estimate of stored values
+        for (int i = 0; i < static_cast<int>(FormatMatrix::Count); i++) {
+            if (m_storage.is_valid_i(i) && m_storage.get_ptr_i(i)) {
+                const uint values = m_storage.get_ptr_i(i)->get_n_values();
+                n_values          = found ? std::min(n_values, values) : values;
+                found             = true;
+            }
+        }
+
+        return n_values;
+    }
+
     template<typename T>
     StorageManagerMatrix<T>* TMatrix<T>::get_storage_manager() {
         static std::unique_ptr<StorageManagerMatrix<T>> storage_manager;
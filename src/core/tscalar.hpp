@@ -30,6 +30,7 @@
 
 #include <spla/scalar.hpp>
 
+#include <core/lazy_planner.hpp>
 #include <core/ttype.hpp>
 
 namespace spla {
@@ -57,9 +58,9 @@ namespace spla {
         Status        get_int(std::int32_t& value) override;
         Status        get_uint(std::uint32_t& value) override;
         Status        get_float(float& value) override;
-        T_INT         as_int() override { return static_cast<T_INT>(m_value); }
-        T_UINT        as_uint() override { return static_cast<T_UINT>(m_value); }
-        T_FLOAT       as_float() override { return static_cast<T_FLOAT>(m_value); }
+        T_INT         as_int() override;
+        T_UINT        as_uint() override;
+        T_FLOAT       as_float() override;
 
         void               set_label(std::string label) override;
         const std::string& get_label() const override;
@@ -83,36 +84,58 @@ namespace spla {
 
     template<typename T>
     Status TScalar<T>::set_int(std::int32_t value) {
+        LAZY_SYNC(this);
         m_value = static_cast<T>(value);
         return Status::Ok;
     }
     template<typename T>
     Status TScalar<T>::set_uint(std::uint32_t value) {
+        LAZY_SYNC(this);
         m_value = static_cast<T>(value);
         return Status::Ok;
     }
     template<typename T>
     Status TScalar<T>::set_float(float value) {
+        LAZY_SYNC(this);
         m_value = static_cast<T>(value);
         return Status::Ok;
     }
 
     template<typename T>
     Status TScalar<T>::get_int(std::int32_t& value) {
+        LAZY_SYNC(this);
         value = static_cast<std::int32_t>(m_value);
         return Status::Ok;
     }
     template<typename T>
     Status TScalar<T>::get_uint(std::uint32_t& value) {
+        LAZY_SYNC(this);
         value = static_cast<std::uint32_t>(m_value);
         return Status::Ok;
     }
     template<typename T>
     Status TScalar<T>::get_float(float& value) {
+        LAZY_SYNC(this);
         value = static_cast<float>(m_value);
         return Status::Ok;
     }
 
+    template<typename T>
+    T_INT TScalar<T>::as_int() {
+        lazy_sync(this);
+        return static_cast<T_INT>(m_value);
+    }
+    template<typename T>
+    T_UINT TScalar<T>::as_uint() {
+        lazy_sync(this);
+        return static_cast<T_UINT>(m_value);
+    }
+    template<typename T>
+    T_FLOAT TScalar<T>::as_float() {
+        lazy_sync(this);
+        return static_cast<T_FLOAT>(m_value);
+    }
+
     template<typename T>
     void TScalar<T>::set_label(std::string label) {
         m_label = std::move(label);
@@ -31,6 +31,7 @@
 #include <spla/config.hpp>
 #include <spla/vector.hpp>
 
+#include <core/lazy_planner.hpp>
 #include <core/logger.hpp>
 #include <core/tdecoration.hpp>
 #include <core/top.hpp>
@@ -85,6 +86,8 @@ namespace spla {
         void validate_wd(FormatVector format);
         void validate_ctor(FormatVector format);
         bool is_valid(FormatVector format) const;
+        bool is_bitmap_storage() const;
+        uint get_n_values();
         T    get_fill_value() const { return m_storage.get_fill_value(); }
 
         static StorageManagerVector<T>* get_storage_manager();
@@ -92,6 +95,7 @@ namespace spla {
     private:
         typename StorageManagerVector<T>::Storage m_storage;
         std::string                               m_label;
+        bool                                      m_bitmap_storage = false;
     };
 
     template<typename T>
@@ -119,13 +123,21 @@ namespace spla {
 
     template<typename T>
     Status TVector<T>::set_format(FormatVector format) {
+        LAZY_SYNC(this);
+        // Bitmap keeps structure only, so requesting it makes bitmap the only storage
+        if (format == FormatVector::CpuBitmap) {
+            validate_rwd(format);
+            return Status::Ok;
+        }
         validate_rw(format);
         return Status::Ok;
     }
     template<typename T>
     Status TVector<T>::set_fill_value(const ref_ptr<Scalar>& value) {
+        LAZY_SYNC(this);
         if (value) {
             m_storage.invalidate();
+            m_bitmap_storage = false;
 
             if constexpr (std::is_same<T, T_INT>::value) m_storage.set_fill_value(value->as_int());
             if constexpr (std::is_same<T, T_UINT>::value) m_storage.set_fill_value(value->as_uint());
@@ -138,6 +150,7 @@ namespace spla {
     }
     template<typename T>
     Status TVector<T>::set_reduce(ref_ptr<OpBinary> resolve_duplicates) {
+        LAZY_SYNC(this);
         auto reduce = resolve_duplicates.template cast_safe<TOpBinary<T, T, T>>();
 
         if (reduce) {
@@ -152,8 +165,10 @@ namespace spla {
 
     template<typename T>
     Status TVector<T>::set_int(uint row_id, std::int32_t value) {
+        LAZY_SYNC(this);
         if (is_valid(FormatVector::CpuDense)) {
             get<CpuDenseVec<T>>()->Ax[row_id] = static_cast<T>(value);
+            m_bitmap_storage                  = false;
             return Status::Ok;
         }
 
@@ -163,8 +178,10 @@ namespace spla {
     }
     template<typename T>
     Status TVector<T>::set_uint(uint row_id, std::uint32_t value) {
+        LAZY_SYNC(this);
         if (is_valid(FormatVector::CpuDense)) {
             get<CpuDenseVec<T>>()->Ax[row_id] = static_cast<T>(value);
+            m_bitmap_storage                  = false;
             return Status::Ok;
         }
 
@@ -174,8 +191,10 @@ namespace spla {
     }
     template<typename T>
     Status TVector<T>::set_float(uint row_id, float value) {
+        LAZY_SYNC(this);
         if (is_valid(FormatVector::CpuDense)) {
             get<CpuDenseVec<T>>()->Ax[row_id] = static_cast<T>(value);
+            m_bitmap_storage                  = false;
             return Status::Ok;
         }
 
@@ -186,6 +205,7 @@ namespace spla {
 
     template<typename T>
     Status TVector<T>::get_int(uint row_id, int32_t& value) {
+        LAZY_SYNC(this);
         validate_rw(FormatVector::CpuDok);
 
         const auto& Ax    = get<CpuDokVec<T>>()->Ax;
@@ -200,6 +220,7 @@ namespace spla {
     }
     template<typename T>
     Status TVector<T>::get_uint(uint row_id, uint32_t& value) {
+        LAZY_SYNC(this);
         validate_rw(FormatVector::CpuDok);
 
         const auto& Ax    = get<CpuDokVec<T>>()->Ax;
@@ -214,6 +235,7 @@ namespace spla {
     }
     template<typename T>
     Status TVector<T>::get_float(uint row_id, float& value) {
+        LAZY_SYNC(this);
         validate_rw(FormatVector::CpuDok);
 
         const auto& Ax    = get<CpuDokVec<T>>()->Ax;
@@ -229,6 +251,7 @@ namespace spla {
 
     template<typename T>
     Status TVector<T>::fill_noize(uint seed) {
+        LAZY_SYNC(this);
         validate_wd(FormatVector::CpuDense);
         auto& Ax     = get<CpuDenseVec<T>>()->Ax;
         auto  engine = std::default_random_engine(seed);
@@ -246,6 +269,7 @@ namespace spla {
     }
     template<typename T>
     Status TVector<T>::fill_with(const ref_ptr<Scalar>& value) {
+        LAZY_SYNC(this);
         assert(value);
 
         T t = T();
@@ -263,7 +287,9 @@ namespace spla {
 
     template<typename T>
     Status TVector<T>::clear() {
+        LAZY_SYNC(this);
         m_storage.invalidate();
+        m_bitmap_storage = false;
         return Status::Ok;
     }
 
@@ -277,12 +303,14 @@ namespace spla {
     void TVector<T>::validate_rwd(FormatVector format) {
         StorageManagerVector<T>* manager = get_storage_manager();
         manager->validate_rwd(format, m_storage);
+        m_bitmap_storage = format == FormatVector::CpuBitmap;
     }
 
     template<typename T>
     void TVector<T>::validate_wd(FormatVector format) {
         StorageManagerVector<T>* manager = get_storage_manager();
         manager->validate_wd(format, m_storage);
+        m_bitmap_storage = format == FormatVector::CpuBitmap;
     }
 
     template<typename T>
@@ -296,6 +324,38 @@ namespace spla {
         return m_storage.is_valid(format);
     }
 
+    /**
+     * @brief Checks if bitmap is the authoritative storage of the vector
+     *
+     * Bitmap keeps structure only and reads every set entry back as one. It is authoritative
+     * when requested with set_format or written by a bitmap kernel, and stops being so once
+     * values are written through any other format. A bitmap cached from valued storage
+     * (for instance, when the vector was used as a structural mask) is not authoritative.
+     *
+     * @return True if bitmap is valid and holds the vector content
+     */
+    template<typename T>
+    bool TVector<T>::is_bitmap_storage() const {
+        return m_bitmap_storage && m_storage.is_valid(FormatVector::CpuBitmap);
+    }
+
+    template<typename T>
+    uint TVector<T>::get_n_values() {
+        uint n_values = 0;
+        bool found    = false;
+
+        // Most compact valid format gives the best estimate of stored values
+        for (int i = 0; i < static_cast<int>(FormatVector::Count); i++) {
+            if (m_storage.is_valid_i(i) && m_storage.get_ptr_i(i)) {
+                const uint values = m_storage.get_ptr_i(i)->get_n_values();
+                n_values          = found ? std::min(n_values, values) : values;
+                found             = true;
+            }
+        }
+
+        return n_values;
+    }
+
     template<typename T>
     StorageManagerVector<T>* TVector<T>::get_storage_manager() {
         static std::unique_ptr<StorageManagerVector<T>> storage_manager;
@@ -33,14 +33,20 @@
 #include <cpu/cpu_algo_callback.hpp>
 #include <cpu/cpu_m_reduce.hpp>
 #include <cpu/cpu_m_reduce_by_row.hpp>
+#include <cpu/cpu_m_select.hpp>
+#include <cpu/cpu_m_tril.hpp>
 #include <cpu/cpu_mxmT_masked.hpp>
 #include <cpu/cpu_mxv.hpp>
 #include <cpu/cpu_v_assign.hpp>
 #include <cpu/cpu_v_count_mf.hpp>
 #include <cpu/cpu_v_eadd.hpp>
 #include <cpu/cpu_v_eadd_fdb.hpp>
+#include <cpu/cpu_v_eadd_reduce.hpp>
+#include <cpu/cpu_v_emult.hpp>
+#include <cpu/cpu_v_ewise_chain.hpp>
 #include <cpu/cpu_v_map.hpp>
 #include <cpu/cpu_v_reduce.hpp>
+#include <cpu/cpu_v_select_range.hpp>
 #include <cpu/cpu_vxm.hpp>
 
 namespace spla {
@@ -64,16 +70,36 @@ namespace spla {
         g_registry->add(MAKE_KEY_CPU_0("v_reduce", UINT), std::make_shared<Algo_v_reduce_cpu<T_UINT>>());
         g_registry->add(MAKE_KEY_CPU_0("v_reduce", FLOAT), std::make_shared<Algo_v_reduce_cpu<T_FLOAT>>());
 
+        // algorthm v_select_range
+        g_registry->add(MAKE_KEY_CPU_0("v_select_range", INT), std::make_shared<Algo_v_select_range_cpu<T_INT>>());
+        g_registry->add(MAKE_KEY_CPU_0("v_select_range", UINT), std::make_shared<Algo_v_select_range_cpu<T_UINT>>());
+        g_registry->add(MAKE_KEY_CPU_0("v_select_range", FLOAT), std::make_shared<Algo_v_select_range_cpu<T_FLOAT>>());
+
         // algorthm v_eadd
         g_registry->add(MAKE_KEY_CPU_0("v_eadd", INT), std::make_shared<Algo_v_eadd_cpu<T_INT>>());
         g_registry->add(MAKE_KEY_CPU_0("v_eadd", UINT), std::make_shared<Algo_v_eadd_cpu<T_UINT>>());
         g_registry->add(MAKE_KEY_CPU_0("v_eadd", FLOAT), std::make_shared<Algo_v_eadd_cpu<T_FLOAT>>());
 
+        // algorthm v_emult
+        g_registry->add(MAKE_KEY_CPU_0("v_emult", INT), std::make_shared<Algo_v_emult_cpu<T_INT>>());
+        g_registry->add(MAKE_KEY_CPU_0("v_emult", UINT), std::make_shared<Algo_v_emult_cpu<T_UINT>>());
+        g_registry->add(MAKE_KEY_CPU_0("v_emult", FLOAT), std::make_shared<Algo_v_emult_cpu<T_FLOAT>>());
+
         // algorthm v_eadd_fdb
         g_registry->add(MAKE_KEY_CPU_0("v_eadd_fdb", INT), std::make_shared<Algo_v_eadd_fdb_cpu<T_INT>>());
         g_registry->add(MAKE_KEY_CPU_0("v_eadd_fdb", UINT), std::make_shared<Algo_v_eadd_fdb_cpu<T_UINT>>());
         g_registry->add(MAKE_KEY_CPU_0("v_eadd_fdb", FLOAT), std::make_shared<Algo_v_eadd_fdb_cpu<T_FLOAT>>());
 
+        // algorthm v_eadd_reduce
+        g_registry->add(MAKE_KEY_CPU_0("v_eadd_reduce", INT), std::make_shared<Algo_v_eadd_reduce_cpu<T_INT>>());
+        g_registry->add(MAKE_KEY_CPU_0("v_eadd_reduce", UINT), std::make_shared<Algo_v_eadd_reduce_cpu<T_UINT>>());
+        g_registry->add(MAKE_KEY_CPU_0("v_eadd_reduce", FLOAT), std::make_shared<Algo_v_eadd_reduce_cpu<T_FLOAT>>());
+
+        // algorthm v_ewise_chain
+        g_registry->add(MAKE_KEY_CPU_0("v_ewise_chain", INT), std::make_shared<Algo_v_ewise_chain_cpu<T_INT>>());
+        g_registry->add(MAKE_KEY_CPU_0("v_ewise_chain", UINT), std::make_shared<Algo_v_ewise_chain_cpu<T_UINT>>());
+        g_registry->add(MAKE_KEY_CPU_0("v_ewise_chain", FLOAT), std::make_shared<Algo_v_ewise_chain_cpu<T_FLOAT>>());
+
         // algorthm v_assign_masked
         g_registry->add(MAKE_KEY_CPU_0("v_assign_masked", INT), std::make_shared<Algo_v_assign_masked_cpu<T_INT>>());
         g_registry->add(MAKE_KEY_CPU_0("v_assign_masked", UINT), std::make_shared<Algo_v_assign_masked_cpu<T_UINT>>());
@@ -84,6 +110,16 @@ namespace spla {
         g_registry->add(MAKE_KEY_CPU_0("m_reduce_by_row", UINT), std::make_shared<Algo_m_reduce_by_row_cpu<T_UINT>>());
         g_registry->add(MAKE_KEY_CPU_0("m_reduce_by_row", FLOAT), std::make_shared<Algo_m_reduce_by_row_cpu<T_FLOAT>>());
 
+        // algorthm m_select
+        g_registry->add(MAKE_KEY_CPU_0("m_select", INT), std::make_shared<Algo_m_select_cpu<T_INT>>());
+        g_registry->add(MAKE_KEY_CPU_0("m_select", UINT), std::make_shared<Algo_m_select_cpu<T_UINT>>());
+        g_registry->add(MAKE_KEY_CPU_0("m_select", FLOAT), std::make_shared<Algo_m_select_cpu<T_FLOAT>>());
+
+        // algorthm m_tril
+        g_registry->add(MAKE_KEY_CPU_0("m_tril", INT), std::make_shared<Algo_m_tril_cpu<T_INT>>());
+        g_registry->add(MAKE_KEY_CPU_0("m_tril", UINT), std::make_shared<Algo_m_tril_cpu<T_UINT>>());
+        g_registry->add(MAKE_KEY_CPU_0("m_tril", FLOAT), std::make_shared<Algo_m_tril_cpu<T_FLOAT>>());
+
         // algorthm m_reduce
         g_registry->add(MAKE_KEY_CPU_0("m_reduce", INT), std::make_shared<Algo_m_reduce_cpu<T_INT>>());
         g_registry->add(MAKE_KEY_CPU_0("m_reduce", UINT), std::make_shared<Algo_m_reduce_cpu<T_UINT>>());
@@ -0,0 +1,211 @@
+/**********************************************************************************/
+/* This file is part of spla project                                              */
+/* https://github.com/SparseLinearAlgebra/spla                                    */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2023 SparseLinearAlgebra                                         */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+
+#ifndef SPLA_CPU_FORMAT_BITMAP_VEC_HPP
+#define SPLA_CPU_FORMAT_BITMAP_VEC_HPP
+
+#include <spla/op.hpp>
+
+#include <core/common.hpp>
+#include <cpu/cpu_formats.hpp>
+
+#include <type_traits>
+
+namespace spla {
+
+    /**
+     * @addtogroup internal
+     * @{
+     */
+
+    static constexpr uint BITMAP_WORD_BITS = 64;
+
+    static inline uint cpu_bitmap_words(const uint n_rows) {
+        return div_up(n_rows, BITMAP_WORD_BITS);
+    }
+
+    /** @return Mask of bits in a word `w` which correspond to actual vector rows */
+    static inline std::uint64_t cpu_bitmap_tail_mask(const uint n_rows, const uint w) {
+        const uint rest = n_rows - w * BITMAP_WORD_BITS;
+        return rest >= BITMAP_WORD_BITS ? ~std::uint64_t(0) : (std::uint64_t(1) << rest) - 1;
+    }
+
+    static inline bool cpu_bitmap_test(const std::uint64_t* words, const uint i) {
+        return (words[i / BITMAP_WORD_BITS] >> (i % BITMAP_WORD_BITS)) & 1u;
+    }
+
+    static inline void cpu_bitmap_set(std::uint64_t* words, const uint i) {
+        words[i / BITMAP_WORD_BITS] |= std::uint64_t(1) << (i % BITMAP_WORD_BITS);
+    }
+
+    /**
+     * @brief Selects word of mask entries for which select op is true
+     *
+     * @param word Bitmap word with set entries (evaluated as `1`)
+     * @param select_set Select op result on set entry
+     * @param select_unset Select op result on unset (fill) entry
+     *
+     * @return Word with bits set for selected entries
+     */
+    static inline std::uint64_t cpu_bitmap_select(const std::uint64_t word,
+                                                  const bool          select_set,
+                                                  const bool          select_unset) {
+        return (select_set ? word : std::uint64_t(0)) | (select_unset ? ~word : std::uint64_t(0));
+    }
+
+    /**
+     * @brief Checks if ops form a boolean semiring, so bitmap structure fully defines the product
+     *
+     * @return True if op_multiply is band and op_add is bor of integral type
+     */
+    template<typename T>
+    bool cpu_bitmap_is_bool_semiring(const ref_ptr<OpBinary>& op_multiply, const ref_ptr<OpBinary>& op_add) {
+        if constexpr (std::is_same_v<T, T_INT>) return op_multiply == BAND_INT && op_add == BOR_INT;
+        if constexpr (std::is_same_v<T, T_UINT>) return op_multiply == BAND_UINT && op_add == BOR_UINT;
+        return false;
+    }
+
+    /**
+     * @brief Checks if element-wise op with reduction is a dot product, so unset bitmap entries add nothing
+     *
+     * @return True if op_elem is mult and op_reduce is plus
+     */
+    template<typename T>
+    bool cpu_bitmap_is_dot_semiring(const ref_ptr<OpBinary>& op_elem, const ref_ptr<OpBinary>& op_reduce) {
+        if constexpr (std::is_same_v<T, T_INT>) return op_elem == MULT_INT && op_reduce == PLUS_INT;
+        if constexpr (std::is_same_v<T, T_UINT>) return op_elem == MULT_UINT && op_reduce == PLUS_UINT;
+        if constexpr (std::is_same_v<T, T_FLOAT>) return op_elem == MULT_FLOAT && op_reduce == PLUS_FLOAT;
+        return false;
+    }
+
+    /**
+     * @brief Checks if select op tests only zero/non-zero property, so it is exact on a bitmap
+     *
+     * @return True if op_select is eqzero or nqzero of integral type
+     */
+    template<typename T>
+    bool cpu_bitmap_is_zero_select(const ref_ptr<OpSelect>& op_select) {
+        if constexpr (std::is_same_v<T, T_INT>) return op_select == EQZERO_INT || op_select == NQZERO_INT;
+        if constexpr (std::is_same_v<T, T_UINT>) return op_select == EQZERO_UINT || op_select == NQZERO_UINT;
+        return false;
+    }
+
+    /**
+     * @brief Checks if assignment of non-zero value makes entry set regardless of its previous state
+     *
+     * @return True if op_assign is second or bor of integral type
+     */
+    template<typename T>
+    bool cpu_bitmap_is_set_assign(const ref_ptr<OpBinary>& op_assign) {
+        if constexpr (std::is_same_v<T, T_INT>) return op_assign == SECOND_INT || op_assign == BOR_INT;
+        if constexpr (std::is_same_v<T, T_UINT>) return op_assign == SECOND_UINT || op_assign == BOR_UINT;
+        return false;
+    }
+
+    /**
+     * @brief Evaluates `band(1, x)` for a set bitmap entry
+     *
+     * @return True if result of product with set entry is non-zero
+     */
+    template<typename T>
+    bool cpu_bitmap_band_set(const T x) {
+        if constexpr (std::is_integral_v<T>) return (x & T(1)) != T(0);
+        return false;
+    }
+
+    template<typename T>
+    void cpu_bitmap_vec_resize(const uint       n_rows,
+                               CpuBitmapVec<T>& vec) {
+        vec.Aw.resize(cpu_bitmap_words(n_rows));
+    }
+
+    template<typename T>
+    void cpu_bitmap_vec_clear(CpuBitmapVec<T>& vec) {
+        std::fill(vec.Aw.begin(), vec.Aw.end(), std::uint64_t(0));
+        vec.values = 0;
+    }
+
+    template<typename T>
+    uint cpu_bitmap_vec_count(const CpuBitmapVec<T>& vec) {
+        uint count = 0;
+        for (const std::uint64_t word : vec.Aw) {
+            count += popcount64(word);
+        }
+        return count;
+    }
+
+    template<typename T>
+    void cpu_bitmap_vec_to_dense(const uint             n_rows,
+                                 const CpuBitmapVec<T>& in,
+                                 CpuDenseVec<T>&        out) {
+        assert(out.Ax.size() == n_rows);
+
+        const uint n_words = cpu_bitmap_words(n_rows);
+
+        for (uint w = 0; w < n_words; ++w) {
+            std::uint64_t word = in.Aw[w];
+
+            while (word) {
+                const uint i = w * BITMAP_WORD_BITS + ctz64(word);
+                out.Ax[i]    = T(1);
+                word &= word - 1;
+            }
+        }
+    }
+
+    template<typename T>
+    void cpu_bitmap_vec_to_coo(const uint             n_rows,
+                               const CpuBitmapVec<T>& in,
+                               CpuCooVec<T>&          out) {
+        assert(out.Ai.size() == in.values);
+        assert(out.Ax.size() == in.values);
+
+        const uint n_words = cpu_bitmap_words(n_rows);
+        uint       k       = 0;
+
+        for (uint w = 0; w < n_words; ++w) {
+            std::uint64_t word = in.Aw[w];
+
+            while (word) {
+                out.Ai[k] = w * BITMAP_WORD_BITS + ctz64(word);
+                out.Ax[k] = T(1);
+                word &= word - 1;
+                k += 1;
+            }
+        }
+
+        out.values = k;
+    }
+
+    /**
+     * @}
+     */
+
+}// namespace spla
+
+#endif//SPLA_CPU_FORMAT_BITMAP_VEC_HPP
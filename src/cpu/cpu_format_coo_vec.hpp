@@ -28,6 +28,7 @@
 #ifndef SPLA_CPU_FORMAT_COO_VEC_HPP
 #define SPLA_CPU_FORMAT_COO_VEC_HPP
 
+#include <cpu/cpu_format_bitmap_vec.hpp>
 #include <cpu/cpu_formats.hpp>
 
 namespace spla {
@@ -66,6 +67,23 @@ namespace spla {
         }
     }
 
+    template<typename T>
+    void cpu_coo_vec_to_bitmap(const T             fill_value,
+                               const CpuCooVec<T>& in,
+                               CpuBitmapVec<T>&    out) {
+        uint values = 0;
+
+        for (std::size_t k = 0; k < in.Ai.size(); ++k) {
+            if (in.Ax[k] != fill_value) {
+                const uint i = in.Ai[k];
+                out.Aw[i / BITMAP_WORD_BITS] |= std::uint64_t(1) << (i % BITMAP_WORD_BITS);
+                values += 1;
+            }
+        }
+
+        out.values = values;
+    }
+
     /**
      * @}
      */
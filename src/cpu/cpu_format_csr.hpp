@@ -89,6 +89,31 @@ namespace spla {
         }
     }
 
+    template<typename T>
+    void cpu_csr_to_lil(uint             n_rows,
+                        const CpuCsr<T>& in,
+                        CpuLil<T>&       out) {
+        using Entry = typename CpuLil<T>::Entry;
+
+        auto& Ap = in.Ap;
+        auto& Aj = in.Aj;
+        auto& Ax = in.Ax;
+
+        assert(out.Ar.size() == n_rows);
+
+        for (uint i = 0; i < n_rows; i++) {
+            auto& row = out.Ar[i];
+            row.clear();
+            row.reserve(Ap[i + 1] - Ap[i]);
+
+            for (uint j = Ap[i]; j < Ap[i + 1]; j++) {
+                row.push_back(Entry(Aj[j], Ax[j]));
+            }
+        }
+
+        out.values = in.values;
+    }
+
     /**
      * @}
      */
@@ -28,6 +28,8 @@
 #ifndef SPLA_CPU_FORMAT_DENSE_VEC_HPP
 #define SPLA_CPU_FORMAT_DENSE_VEC_HPP
 
+#include <core/common.hpp>
+#include <cpu/cpu_format_bitmap_vec.hpp>
 #include <cpu/cpu_formats.hpp>
 
 namespace spla {
@@ -66,6 +68,25 @@ namespace spla {
         }
     }
 
+    template<typename T>
+    void cpu_dense_vec_to_bitmap(const uint            n_rows,
+                                 const T               fill_value,
+                                 const CpuDenseVec<T>& in,
+                                 CpuBitmapVec<T>&      out) {
+        assert(out.Aw.size() == cpu_bitmap_words(n_rows));
+
+        uint values = 0;
+
+        for (uint i = 0; i < n_rows; ++i) {
+            if (in.Ax[i] != fill_value) {
+                out.Aw[i / BITMAP_WORD_BITS] |= std::uint64_t(1) << (i % BITMAP_WORD_BITS);
+                values += 1;
+            }
+        }
+
+        out.values = values;
+    }
+
     /**
      * @}
      */
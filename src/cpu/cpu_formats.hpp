@@ -37,6 +37,7 @@
 
 #include <algorithm>
 #include <cassert>
+#include <cstdint>
 #include <functional>
 #include <numeric>
 #include <string>
@@ -58,6 +59,8 @@ namespace spla {
 
         ~CpuDokVec() override = default;
 
+        [[nodiscard]] std::size_t get_mem_size() const override { return Ax.size() * (sizeof(uint) + sizeof(T)); }
+
         using Reduce = std::function<T(T accum, T added)>;
 
         robin_hood::unordered_flat_map<uint, T> Ax{};
@@ -77,6 +80,8 @@ namespace spla {
 
         ~CpuDenseVec() override = default;
 
+        [[nodiscard]] std::size_t get_mem_size() const override { return Ax.size() * sizeof(T); }
+
         std::vector<T> Ax{};
     };
 
@@ -93,10 +98,34 @@ namespace spla {
 
         ~CpuCooVec() override = default;
 
+        [[nodiscard]] std::size_t get_mem_size() const override { return Ai.size() * sizeof(uint) + Ax.size() * sizeof(T); }
+
         std::vector<uint> Ai;
         std::vector<T>    Ax;
     };
 
+    /**
+     * @class CpuBitmapVec
+     * @brief CPU bit-set vector representation storing structure of non-fill entries
+     *
+     * Each entry takes a single bit, packed into 64-bit words. Bit is set if entry
+     * is not equal to the vector fill value. Bitmap does not store values, set entries
+     * are read back as `1`. Use it for boolean frontiers and visited sets.
+     *
+     * @tparam T
+     */
+    template<typename T>
+    class CpuBitmapVec : public TDecoration<T> {
+    public:
+        static constexpr FormatVector FORMAT = FormatVector::CpuBitmap;
+
+        ~CpuBitmapVec() override = default;
+
+        [[nodiscard]] std::size_t get_mem_size() const override { return Aw.size() * sizeof(std::uint64_t); }
+
+        std::vector<std::uint64_t> Aw{};
+    };
+
     /**
      * @class CpuLil
      * @brief CPU list-of-list matrix format for fast incremental build
@@ -110,6 +139,12 @@ namespace spla {
 
         ~CpuLil() override = default;
 
+        [[nodiscard]] std::size_t get_mem_size() const override {
+            std::size_t size = Ar.size() * sizeof(Row);
+            for (const auto& row : Ar) size += row.size() * sizeof(Entry);
+            return size;
+        }
+
         using Entry  = std::pair<uint, T>;
         using Row    = std::vector<Entry>;
         using Reduce = std::function<T(T accum, T added)>;
@@ -131,6 +166,8 @@ namespace spla {
 
         ~CpuDok() override = default;
 
+        [[nodiscard]] std::size_t get_mem_size() const override { return Ax.size() * (sizeof(Key) + sizeof(T)); }
+
         using Key    = std::pair<uint, uint>;
         using Reduce = std::function<T(T accum, T added)>;
 
@@ -151,6 +188,8 @@ namespace spla {
 
         ~CpuCoo() override = default;
 
+        [[nodiscard]] std::size_t get_mem_size() const override { return (Ai.size() + Aj.size()) * sizeof(uint) + Ax.size() * sizeof(T); }
+
         std::vector<uint> Ai;
         std::vector<uint> Aj;
         std::vector<T>    Ax;
@@ -169,6 +208,8 @@ namespace spla {
 
         ~CpuCsr() override = default;
 
+        [[nodiscard]] std::size_t get_mem_size() const override { return (Ap.size() + Aj.size()) * sizeof(uint) + Ax.size() * sizeof(T); }
+
         std::vector<uint> Ap;
         std::vector<uint> Aj;
         std::vector<T>    Ax;
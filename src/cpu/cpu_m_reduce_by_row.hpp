@@ -62,11 +62,62 @@ namespace spla {
             if (M->is_valid(FormatMatrix::CpuDok)) {
                 return execute_dok(ctx);
             }
+            if (M->is_valid(FormatMatrix::CpuLil) || M->is_valid(FormatMatrix::CpuCsr)) {
+                return execute_lil(ctx);
+            }
 
             return execute_dok(ctx);
         }
 
     private:
+        Status execute_lil(const DispatchContext& ctx) {
+            TIME_PROFILE_SCOPE("cpu/m_reduce_by_row_lil");
+
+            auto t         = ctx.task.template cast_safe<ScheduleTask_m_reduce_by_row>();
+            auto r         = t->r.template cast_safe<TVector<T>>();
+            auto M         = t->M.template cast_safe<TMatrix<T>>();
+            auto op_reduce = t->op_reduce.template cast_safe<TOpBinary<T, T, T>>();
+            auto init      = t->init.template cast_safe<TScalar<T>>();
+
+            r->validate_wd(FormatVector::CpuDense);
+            M->validate_rw(FormatMatrix::CpuLil);
+
+            CpuDenseVec<T>*  p_dense_r = r->template get<CpuDenseVec<T>>();
+            const CpuLil<T>* p_lil_M   = M->template get<CpuLil<T>>();
+
+            auto&      func_reduce = op_reduce->function;
+            const T    sum_init    = init->get_value();
+            const uint DM          = M->get_n_rows();
+
+            // Structure only reduction treats stored values as 1, so plus gives row degrees without visiting entries
+            const bool struct_only = t->get_desc_or_default()->get_struct_only();
+            const bool is_count    = struct_only && is_plus(t->op_reduce);
+
+            for (uint i = 0; i < DM; ++i) {
+                const auto& row = p_lil_M->Ar[i];
+
+                if (is_count) {
+                    p_dense_r->Ax[i] = sum_init + T(row.size());
+                    continue;
+                }
+
+                T sum = sum_init;
+                for (const auto& j_x : row) {
+                    sum = func_reduce(sum, struct_only ? T(1) : j_x.second);
+                }
+                p_dense_r->Ax[i] = sum;
+            }
+
+            return Status::Ok;
+        }
+
+        static bool is_plus(const ref_ptr<OpBinary>& op) {
+            if constexpr (std::is_same_v<T, T_INT>) return op == PLUS_INT;
+            if constexpr (std::is_same_v<T, T_UINT>) return op == PLUS_UINT;
+            if constexpr (std::is_same_v<T, T_FLOAT>) return op == PLUS_FLOAT;
+            return false;
+        }
+
         Status execute_dok(const DispatchContext& ctx) {
             auto t         = ctx.task.template cast_safe<ScheduleTask_m_reduce_by_row>();
             auto r         = t->r.template cast_safe<TVector<T>>();
@@ -82,11 +133,12 @@ namespace spla {
 
             std::fill(p_dense_r->Ax.begin(), p_dense_r->Ax.end(), init->get_value());
 
-            auto& func_reduce = op_reduce->function;
+            auto&      func_reduce = op_reduce->function;
+            const bool struct_only = t->get_desc_or_default()->get_struct_only();
 
             for (const auto& entry : p_dok_M->Ax) {
                 const uint i = entry.first.first;
-                const T    x = entry.second;
+                const T    x = struct_only ? T(1) : entry.second;
 
                 p_dense_r->Ax[i] = func_reduce(p_dense_r->Ax[i], x);
             }
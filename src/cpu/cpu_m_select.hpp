@@ -0,0 +1,96 @@
+/**********************************************************************************/
+/* This file is part of spla project                                              */
+/* https://github.com/SparseLinearAlgebra/spla                                    */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2023 SparseLinearAlgebra                                         */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#ifndef SPLA_CPU_M_SELECT_HPP
+#define SPLA_CPU_M_SELECT_HPP
+
+#include <schedule/schedule_tasks.hpp>
+
+#include <core/dispatcher.hpp>
+#include <core/registry.hpp>
+#include <core/tmatrix.hpp>
+#include <core/top.hpp>
+#include <core/ttype.hpp>
+
+namespace spla {
+
+    template<typename T>
+    class Algo_m_select_cpu final : public RegistryAlgo {
+    public:
+        ~Algo_m_select_cpu() override = default;
+
+        std::string get_name() override {
+            return "m_select";
+        }
+
+        std::string get_description() override {
+            return "sequential matrix select of entries on cpu";
+        }
+
+        Status execute(const DispatchContext& ctx) override {
+            return execute_lil(ctx);
+        }
+
+    private:
+        Status execute_lil(const DispatchContext& ctx) {
+            TIME_PROFILE_SCOPE("cpu/matrix_select_lil");
+
+            auto t         = ctx.task.template cast_safe<ScheduleTask_m_select>();
+            auto R         = t->R.template cast_safe<TMatrix<T>>();
+            auto M         = t->M.template cast_safe<TMatrix<T>>();
+            auto op_select = t->op_select.template cast_safe<TOpSelect<T>>();
+
+            M->validate_rw(FormatMatrix::CpuLil);
+            R->validate_wd(FormatMatrix::CpuLil);
+            TIME_PROFILE_SCOPE_WORK(M->get_n_values());
+
+            const CpuLil<T>* p_lil_M = M->template get<CpuLil<T>>();
+            CpuLil<T>*       p_lil_R = R->template get<CpuLil<T>>();
+            const auto&      func    = op_select->function;
+
+            const uint DM     = M->get_n_rows();
+            uint       values = 0;
+
+            for (uint i = 0; i < DM; ++i) {
+                auto& row_R = p_lil_R->Ar[i];
+
+                for (const auto& j_x : p_lil_M->Ar[i]) {
+                    if (func(j_x.second)) row_R.push_back(j_x);
+                }
+
+                values += uint(row_R.size());
+            }
+
+            p_lil_R->values = values;
+
+            return Status::Ok;
+        }
+    };
+
+}// namespace spla
+
+#endif//SPLA_CPU_M_SELECT_HPP
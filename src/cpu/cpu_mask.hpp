@@ -0,0 +1,159 @@
+/**********************************************************************************/
+/* This file is part of spla project                                              */
+/* https://github.com/SparseLinearAlgebra/spla                                    */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2023 SparseLinearAlgebra                                         */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+
+#ifndef SPLA_CPU_MASK_HPP
+#define SPLA_CPU_MASK_HPP
+
+#include <spla/descriptor.hpp>
+
+#include <core/top.hpp>
+#include <core/tvector.hpp>
+#include <cpu/cpu_format_bitmap_vec.hpp>
+#include <cpu/cpu_formats.hpp>
+
+#include <functional>
+
+namespace spla {
+
+    /**
+     * @addtogroup internal
+     * @{
+     */
+
+    /**
+     * @class CpuMask
+     * @brief Resolves optional mask vector, its select op and descriptor modes into row selection
+     *
+     * Null mask selects all rows. Structural mask selects rows with stored (non-fill) entries,
+     * valued mask selects rows for which select op is true. Complement inverts selection.
+     * Null select op makes mask structural.
+     *
+     * @tparam T Type of mask elements
+     */
+    template<typename T>
+    class CpuMask {
+    public:
+        CpuMask(const ref_ptr<TVector<T>>& mask, const ref_ptr<TOpSelect<T>>& op_select, const ref_ptr<Descriptor>& desc)
+            : m_mask(mask) {
+            m_structural = desc->get_mask_structure() || op_select.is_null();
+            m_complement = desc->get_mask_complement();
+
+            if (m_mask) {
+                m_fill = m_mask->get_fill_value();
+            }
+            if (op_select) {
+                m_select = op_select->function;
+                m_exact  = cpu_bitmap_is_zero_select<T>(op_select.template as<OpSelect>()) && m_fill == T(0);
+            }
+        }
+
+        /** @return True if all rows are selected, so no per-row check is required */
+        bool is_null() const { return m_mask.is_null() && !m_complement; }
+
+        /** @return True if mask is already valid bitmap and selection can be evaluated on its words */
+        bool is_bitmap() const {
+            if (!m_mask) return true;
+            return m_mask->is_valid(FormatVector::CpuBitmap) && (m_structural || m_exact);
+        }
+
+        /** @return True if mask is stored sparse and selected rows are a subset of its entries */
+        bool is_sparse() const {
+            if (!m_mask || m_complement) return false;
+            if (!m_structural && m_select(m_fill)) return false;
+            return m_mask->is_valid(FormatVector::CpuCoo) ||
+                   (m_mask->is_valid(FormatVector::CpuDok) && !m_mask->is_valid(FormatVector::CpuDense));
+        }
+
+        /** @brief Prepares mask for `test` random access queries, preferring cheap exact bitmap */
+        void bind_test() {
+            if (!m_mask) return;
+            if (is_bitmap() || m_structural) {
+                bind_bitmap();
+                return;
+            }
+            m_mask->validate_rw(FormatVector::CpuDense);
+            m_dense = m_mask->template get<CpuDenseVec<T>>();
+        }
+
+        /** @brief Prepares mask for `word` queries */
+        void bind_bitmap() {
+            if (!m_mask) return;
+            m_mask->validate_rw(FormatVector::CpuBitmap);
+            m_bitmap       = m_mask->template get<CpuBitmapVec<T>>();
+            m_select_set   = m_structural || m_select(T(1));
+            m_select_unset = !m_structural && m_select(T(0));
+        }
+
+        /** @brief Prepares mask for iteration over `sparse` entries */
+        void bind_sparse() {
+            m_mask->validate_rw(FormatVector::CpuCoo);
+            m_coo = m_mask->template get<CpuCooVec<T>>();
+        }
+
+        /** @return True if row `i` is selected; requires `bind_test` */
+        bool test(const uint i) const {
+            if (!m_mask) return !m_complement;
+            if (m_bitmap) return (word(i / BITMAP_WORD_BITS) >> (i % BITMAP_WORD_BITS)) & 1u;
+            return (m_structural ? m_dense->Ax[i] != m_fill : m_select(m_dense->Ax[i])) != m_complement;
+        }
+
+        /** @return True if stored sparse mask entry with value `x` is selected */
+        bool test_entry(const T x) const {
+            return m_structural ? x != m_fill : m_select(x);
+        }
+
+        /** @return Word `w` of selected rows bits, bits past vector size are not trimmed; requires `bind_bitmap` */
+        std::uint64_t word(const uint w) const {
+            const std::uint64_t inv = m_complement ? ~std::uint64_t(0) : std::uint64_t(0);
+            if (!m_mask) return ~inv;
+            return cpu_bitmap_select(m_bitmap->Aw[w], m_select_set, m_select_unset) ^ inv;
+        }
+
+        const CpuCooVec<T>* sparse() const { return m_coo; }
+
+    private:
+        ref_ptr<TVector<T>>    m_mask;
+        std::function<bool(T)> m_select;
+        T                      m_fill         = T();
+        bool                   m_structural   = false;
+        bool                   m_complement   = false;
+        bool                   m_exact        = false;
+        bool                   m_select_set   = false;
+        bool                   m_select_unset = false;
+        const CpuDenseVec<T>*  m_dense        = nullptr;
+        const CpuBitmapVec<T>* m_bitmap       = nullptr;
+        const CpuCooVec<T>*    m_coo          = nullptr;
+    };
+
+    /**
+     * @}
+     */
+
+}// namespace spla
+
+#endif//SPLA_CPU_MASK_HPP
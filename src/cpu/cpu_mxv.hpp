@@ -38,6 +38,10 @@
 #include <core/ttype.hpp>
 #include <core/tvector.hpp>
 
+#include <cpu/cpu_format_bitmap_vec.hpp>
+#include <cpu/cpu_format_dense_vec.hpp>
+#include <cpu/cpu_mask.hpp>
+
 namespace spla {
 
     template<typename T>
@@ -54,54 +58,228 @@ namespace spla {
         }
 
         Status execute(const DispatchContext& ctx) override {
+            auto t         = ctx.task.template cast_safe<ScheduleTask_mxv_masked>();
+            auto r         = t->r.template cast_safe<TVector<T>>();
+            auto mask      = t->mask.template cast_safe<TVector<T>>();
+            auto v         = t->v.template cast_safe<TVector<T>>();
+            auto op_select = t->op_select.template cast_safe<TOpSelect<T>>();
+            auto init      = t->init.template cast_safe<TScalar<T>>();
+
+            CpuMask<T> cpu_mask(mask, op_select, t->get_desc_or_default());
+
+            if (v->is_bitmap_storage() &&
+                cpu_mask.is_bitmap() &&
+                t->op_accum.is_null() &&
+                cpu_bitmap_is_bool_semiring<T>(t->op_multiply, t->op_add) &&
+                init->get_value() == T(0) &&
+                r->get_fill_value() == T(0) &&
+                v->get_fill_value() == T(0))
+                return execute_bitmap(ctx, cpu_mask);
+            if (cpu_mask.is_sparse())
+                return execute_sparse_mask(ctx, cpu_mask);
+
+            return execute_dense(ctx, cpu_mask);
+        }
+
+    private:
+        Status execute_dense(const DispatchContext& ctx, CpuMask<T>& cpu_mask) {
             TIME_PROFILE_SCOPE("cpu/mxv");
 
             auto t = ctx.task.template cast_safe<ScheduleTask_mxv_masked>();
 
             auto r           = t->r.template cast_safe<TVector<T>>();
-            auto mask        = t->mask.template cast_safe<TVector<T>>();
             auto M           = t->M.template cast_safe<TMatrix<T>>();
             auto v           = t->v.template cast_safe<TVector<T>>();
             auto op_multiply = t->op_multiply.template cast_safe<TOpBinary<T, T, T>>();
             auto op_add      = t->op_add.template cast_safe<TOpBinary<T, T, T>>();
-            auto op_select   = t->op_select.template cast_safe<TOpSelect<T>>();
+            auto op_accum    = t->op_accum.template cast_safe<TOpBinary<T, T, T>>();
+            auto changed     = t->changed.template cast_safe<TVector<T>>();
             auto init        = t->init.template cast_safe<TScalar<T>>();
 
             const uint DM       = M->get_n_rows();
             const T    sum_init = init->get_value();
 
-            r->validate_wd(FormatVector::CpuDense);
-            mask->validate_rw(FormatVector::CpuDense);
+            if (op_accum) {
+                r->validate_rwd(FormatVector::CpuDense);
+            } else {
+                r->validate_wd(FormatVector::CpuDense);
+            }
+            if (changed) changed->validate_wd(FormatVector::CpuCoo);
             v->validate_rw(FormatVector::CpuDense);
             M->validate_rw(FormatMatrix::CpuLil);
+            TIME_PROFILE_SCOPE_WORK(M->get_n_values());
+            cpu_mask.bind_test();
 
-            CpuDenseVec<T>*       p_dense_r    = r->template get<CpuDenseVec<T>>();
-            const CpuDenseVec<T>* p_dense_mask = mask->template get<CpuDenseVec<T>>();
-            const CpuDenseVec<T>* p_dense_v    = v->template get<CpuDenseVec<T>>();
-            const CpuLil<T>*      p_lil_M      = M->template get<CpuLil<T>>();
-            auto                  early_exit   = t->get_desc_or_default()->get_early_exit();
+            CpuDenseVec<T>*       p_dense_r  = r->template get<CpuDenseVec<T>>();
+            CpuCooVec<T>*         p_changed  = changed ? changed->template get<CpuCooVec<T>>() : nullptr;
+            const CpuDenseVec<T>* p_dense_v  = v->template get<CpuDenseVec<T>>();
+            const CpuLil<T>*      p_lil_M    = M->template get<CpuLil<T>>();
+            auto                  early_exit = t->get_desc_or_default()->get_early_exit();
 
             auto& func_multiply = op_multiply->function;
             auto& func_add      = op_add->function;
-            auto& func_select   = op_select->function;
 
-            for (uint i = 0; i < DM; ++i) {
+            auto row_product = [&](uint i) {
                 T sum = sum_init;
 
-                if (func_select(p_dense_mask->Ax[i])) {
-                    const auto& row = p_lil_M->Ar[i];
+                for (const auto& j_x : p_lil_M->Ar[i]) {
+                    const uint j = j_x.first;
+                    sum          = func_add(sum, func_multiply(j_x.second, p_dense_v->Ax[j]));
+
+                    if ((sum != sum_init) && early_exit) break;
+                }
+
+                return sum;
+            };
+
+            if (op_accum) {
+                for (uint i = 0; i < DM; ++i) {
+                    if (!p_lil_M->Ar[i].empty() && (cpu_mask.is_null() || cpu_mask.test(i))) {
+                        accum(i, row_product(i), op_accum->function, *p_dense_r, p_changed);
+                    }
+                }
+            } else if (cpu_mask.is_null()) {
+                for (uint i = 0; i < DM; ++i) {
+                    p_dense_r->Ax[i] = row_product(i);
+                }
+            } else {
+                for (uint i = 0; i < DM; ++i) {
+                    p_dense_r->Ax[i] = cpu_mask.test(i) ? row_product(i) : sum_init;
+                }
+            }
+
+            if (p_changed) p_changed->values = uint(p_changed->Ai.size());
+
+            return Status::Ok;
+        }
+
+        Status execute_sparse_mask(const DispatchContext& ctx, CpuMask<T>& cpu_mask) {
+            TIME_PROFILE_SCOPE("cpu/mxv_sparse_mask");
+
+            auto t = ctx.task.template cast_safe<ScheduleTask_mxv_masked>();
+
+            auto r           = t->r.template cast_safe<TVector<T>>();
+            auto M           = t->M.template cast_safe<TMatrix<T>>();
+            auto v           = t->v.template cast_safe<TVector<T>>();
+            auto op_multiply = t->op_multiply.template cast_safe<TOpBinary<T, T, T>>();
+            auto op_add      = t->op_add.template cast_safe<TOpBinary<T, T, T>>();
+            auto op_accum    = t->op_accum.template cast_safe<TOpBinary<T, T, T>>();
+            auto changed     = t->changed.template cast_safe<TVector<T>>();
+            auto init        = t->init.template cast_safe<TScalar<T>>();
+
+            const T sum_init = init->get_value();
+
+            if (op_accum) {
+                r->validate_rwd(FormatVector::CpuDense);
+            } else {
+                r->validate_wd(FormatVector::CpuDense);
+            }
+            if (changed) changed->validate_wd(FormatVector::CpuCoo);
+            v->validate_rw(FormatVector::CpuDense);
+            M->validate_rw(FormatMatrix::CpuLil);
+            TIME_PROFILE_SCOPE_WORK(M->get_n_values());
+            cpu_mask.bind_sparse();
+
+            CpuDenseVec<T>*       p_dense_r   = r->template get<CpuDenseVec<T>>();
+            CpuCooVec<T>*         p_changed   = changed ? changed->template get<CpuCooVec<T>>() : nullptr;
+            const CpuDenseVec<T>* p_dense_v   = v->template get<CpuDenseVec<T>>();
+            const CpuCooVec<T>*   p_mask_coo  = cpu_mask.sparse();
+            const CpuLil<T>*      p_lil_M     = M->template get<CpuLil<T>>();
+            auto                  early_exit  = t->get_desc_or_default()->get_early_exit();
+            const uint            mask_values = p_mask_coo->values;
+
+            auto& func_multiply = op_multiply->function;
+            auto& func_add      = op_add->function;
+
+            if (!op_accum) cpu_dense_vec_fill(sum_init, *p_dense_r);
+
+            for (uint idx = 0; idx < mask_values; ++idx) {
+                if (!cpu_mask.test_entry(p_mask_coo->Ax[idx])) continue;
+
+                const uint i   = p_mask_coo->Ai[idx];
+                T          sum = sum_init;
+
+                if (op_accum && p_lil_M->Ar[i].empty()) continue;
+
+                for (const auto& j_x : p_lil_M->Ar[i]) {
+                    const uint j = j_x.first;
+                    sum          = func_add(sum, func_multiply(j_x.second, p_dense_v->Ax[j]));
+
+                    if ((sum != sum_init) && early_exit) break;
+                }
+
+                if (op_accum) {
+                    accum(i, sum, op_accum->function, *p_dense_r, p_changed);
+                } else {
+                    p_dense_r->Ax[i] = sum;
+                }
+            }
+
+            if (p_changed) p_changed->values = uint(p_changed->Ai.size());
+
+            return Status::Ok;
+        }
+
+        template<typename Function>
+        static void accum(uint i, T x, const Function& func_accum, CpuDenseVec<T>& r, CpuCooVec<T>* changed) {
+            const T prev = r.Ax[i];
+            r.Ax[i]      = func_accum(prev, x);
+
+            if (changed && prev != r.Ax[i]) {
+                changed->Ai.push_back(i);
+                changed->Ax.push_back(r.Ax[i]);
+            }
+        }
+
+        Status execute_bitmap(const DispatchContext& ctx, CpuMask<T>& cpu_mask) {
+            TIME_PROFILE_SCOPE("cpu/mxv_bitmap");
+
+            auto t = ctx.task.template cast_safe<ScheduleTask_mxv_masked>();
 
-                    for (const auto& j_x : row) {
-                        const uint j = j_x.first;
-                        sum          = func_add(sum, func_multiply(j_x.second, p_dense_v->Ax[j]));
+            auto r = t->r.template cast_safe<TVector<T>>();
+            auto M = t->M.template cast_safe<TMatrix<T>>();
+            auto v = t->v.template cast_safe<TVector<T>>();
 
-                        if ((sum != sum_init) && early_exit) break;
+            const uint DM = M->get_n_rows();
+
+            r->validate_wd(FormatVector::CpuBitmap);
+            v->validate_rw(FormatVector::CpuBitmap);
+            M->validate_rw(FormatMatrix::CpuLil);
+            TIME_PROFILE_SCOPE_WORK(M->get_n_values());
+            cpu_mask.bind_bitmap();
+
+            CpuBitmapVec<T>*       p_bitmap_r = r->template get<CpuBitmapVec<T>>();
+            const CpuBitmapVec<T>* p_bitmap_v = v->template get<CpuBitmapVec<T>>();
+            const CpuLil<T>*       p_lil_M    = M->template get<CpuLil<T>>();
+            auto                   early_exit = t->get_desc_or_default()->get_early_exit();
+
+            const uint           n_words = cpu_bitmap_words(DM);
+            const std::uint64_t* v_words = p_bitmap_v->Aw.data();
+            uint                 values  = 0;
+
+            for (uint w = 0; w < n_words; ++w) {
+                std::uint64_t word   = cpu_mask.word(w) & cpu_bitmap_tail_mask(DM, w);
+                std::uint64_t result = 0;
+
+                while (word) {
+                    const uint          i   = w * BITMAP_WORD_BITS + ctz64(word);
+                    const std::uint64_t bit = word & (~word + 1);
+                    word &= word - 1;
+
+                    for (const auto& j_x : p_lil_M->Ar[i]) {
+                        if (cpu_bitmap_test(v_words, j_x.first) && cpu_bitmap_band_set(j_x.second)) {
+                            result |= bit;
+                            if (early_exit) break;
+                        }
                     }
                 }
 
-                p_dense_r->Ax[i] = sum;
+                p_bitmap_r->Aw[w] = result;
+                values += popcount64(result);
             }
 
+            p_bitmap_r->values = values;
+
             return Status::Ok;
         }
     };
@@ -37,6 +37,8 @@
 #include <core/ttype.hpp>
 #include <core/tvector.hpp>
 
+#include <cpu/cpu_format_bitmap_vec.hpp>
+
 namespace spla {
 
     template<typename T>
@@ -54,8 +56,19 @@ namespace spla {
 
         Status execute(const DispatchContext& ctx) override {
             auto                t    = ctx.task.template cast_safe<ScheduleTask_v_assign_masked>();
+            ref_ptr<TVector<T>> r    = t->r.template cast_safe<TVector<T>>();
             ref_ptr<TVector<T>> mask = t->mask.template cast_safe<TVector<T>>();
 
+            if (mask->is_valid(FormatVector::CpuBitmap) &&
+                cpu_bitmap_is_zero_select<T>(t->op_select) &&
+                mask->get_fill_value() == T(0)) {
+                if (r->is_bitmap_storage() &&
+                    r->get_fill_value() == T(0) &&
+                    cpu_bitmap_is_set_assign<T>(t->op_assign) &&
+                    t->value.template cast_safe<TScalar<T>>()->get_value() != T(0))
+                    return execute_bm2bm(ctx);
+                return execute_bm2dn(ctx);
+            }
             if (mask->is_valid(FormatVector::CpuCoo))
                 return execute_sp2dn(ctx);
             if (mask->is_valid(FormatVector::CpuDense))
@@ -130,6 +143,79 @@ namespace spla {
 
             return Status::Ok;
         }
+
+        Status execute_bm2dn(const DispatchContext& ctx) {
+            TIME_PROFILE_SCOPE("cpu/vector_assign_bitmap2dense");
+
+            auto t = ctx.task.template cast_safe<ScheduleTask_v_assign_masked>();
+
+            auto r         = t->r.template cast_safe<TVector<T>>();
+            auto mask      = t->mask.template cast_safe<TVector<T>>();
+            auto value     = t->value.template cast_safe<TScalar<T>>();
+            auto op_assign = t->op_assign.template cast_safe<TOpBinary<T, T, T>>();
+            auto op_select = t->op_select.template cast_safe<TOpSelect<T>>();
+
+            auto assign_value = value->get_value();
+
+            r->validate_rwd(FormatVector::CpuDense);
+            mask->validate_rw(FormatVector::CpuBitmap);
+
+            auto*       p_r_dense     = r->template get<CpuDenseVec<T>>();
+            const auto* p_mask_bitmap = mask->template get<CpuBitmapVec<T>>();
+            const auto& func_assign   = op_assign->function;
+            const auto& func_select   = op_select->function;
+
+            const bool select_set   = func_select(T(1));
+            const bool select_unset = func_select(T(0));
+
+            const uint N       = r->get_n_rows();
+            const uint n_words = cpu_bitmap_words(N);
+
+            for (uint w = 0; w < n_words; ++w) {
+                std::uint64_t word = cpu_bitmap_select(p_mask_bitmap->Aw[w], select_set, select_unset) & cpu_bitmap_tail_mask(N, w);
+
+                while (word) {
+                    const uint i     = w * BITMAP_WORD_BITS + ctz64(word);
+                    p_r_dense->Ax[i] = func_assign(p_r_dense->Ax[i], assign_value);
+                    word &= word - 1;
+                }
+            }
+
+            return Status::Ok;
+        }
+
+        Status execute_bm2bm(const DispatchContext& ctx) {
+            TIME_PROFILE_SCOPE("cpu/vector_assign_bitmap2bitmap");
+
+            auto t = ctx.task.template cast_safe<ScheduleTask_v_assign_masked>();
+
+            auto r         = t->r.template cast_safe<TVector<T>>();
+            auto mask      = t->mask.template cast_safe<TVector<T>>();
+            auto op_select = t->op_select.template cast_safe<TOpSelect<T>>();
+
+            r->validate_rwd(FormatVector::CpuBitmap);
+            mask->validate_rw(FormatVector::CpuBitmap);
+
+            auto*       p_r_bitmap    = r->template get<CpuBitmapVec<T>>();
+            const auto* p_mask_bitmap = mask->template get<CpuBitmapVec<T>>();
+            const auto& func_select   = op_select->function;
+
+            const bool select_set   = func_select(T(1));
+            const bool select_unset = func_select(T(0));
+
+            const uint N       = r->get_n_rows();
+            const uint n_words = cpu_bitmap_words(N);
+            uint       values  = 0;
+
+            for (uint w = 0; w < n_words; ++w) {
+                p_r_bitmap->Aw[w] |= cpu_bitmap_select(p_mask_bitmap->Aw[w], select_set, select_unset) & cpu_bitmap_tail_mask(N, w);
+                values += popcount64(p_r_bitmap->Aw[w]);
+            }
+
+            p_r_bitmap->values = values;
+
+            return Status::Ok;
+        }
     };
 
 }// namespace spla
@@ -37,6 +37,8 @@
 #include <core/ttype.hpp>
 #include <core/tvector.hpp>
 
+#include <cpu/cpu_format_bitmap_vec.hpp>
+
 namespace spla {
 
     template<typename T>
@@ -56,6 +58,8 @@ namespace spla {
             auto                t = ctx.task.template cast_safe<ScheduleTask_v_count_mf>();
             ref_ptr<TVector<T>> v = t->v.template cast_safe<TVector<T>>();
 
+            if (v->is_valid(FormatVector::CpuBitmap))
+                return execute_bitmap(ctx);
             if (v->is_valid(FormatVector::CpuDok))
                 return execute_dok(ctx);
             if (v->is_valid(FormatVector::CpuCoo))
@@ -67,6 +71,17 @@ namespace spla {
         }
 
     private:
+        Status execute_bitmap(const DispatchContext& ctx) {
+            TIME_PROFILE_SCOPE("cpu/v_count_mf_bitmap");
+
+            auto                t     = ctx.task.template cast_safe<ScheduleTask_v_count_mf>();
+            ref_ptr<TVector<T>> v     = t->v.template cast_safe<TVector<T>>();
+            CpuBitmapVec<T>*    dec_v = v->template get<CpuBitmapVec<T>>();
+
+            t->r->set_uint(cpu_bitmap_vec_count(*dec_v));
+
+            return Status::Ok;
+        }
         Status execute_dok(const DispatchContext& ctx) {
             TIME_PROFILE_SCOPE("cpu/v_count_mf_dok");
 
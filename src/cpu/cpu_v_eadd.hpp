@@ -37,6 +37,10 @@
 #include <core/ttype.hpp>
 #include <core/tvector.hpp>
 
+#include <algorithm>
+#include <limits>
+#include <vector>
+
 namespace spla {
 
     template<typename T>
@@ -54,17 +58,83 @@ namespace spla {
 
         Status execute(const DispatchContext& ctx) override {
             auto                t = ctx.task.template cast_safe<ScheduleTask_v_eadd>();
-            ref_ptr<TVector<T>> u = t->r.template cast_safe<TVector<T>>();
+            ref_ptr<TVector<T>> u = t->u.template cast_safe<TVector<T>>();
             ref_ptr<TVector<T>> v = t->v.template cast_safe<TVector<T>>();
 
             if (u->is_valid(FormatVector::CpuDense) && v->is_valid(FormatVector::CpuDense)) {
                 return execute_dn2dn(ctx);
             }
+            if (is_sparse_exact(ctx)) {
+                return execute_sp2sp(ctx);
+            }
 
             return execute_dn2dn(ctx);
         }
 
     private:
+        /** Sparse result is exact if op on two fill values gives fill value of result */
+        static bool is_sparse_exact(const DispatchContext& ctx) {
+            auto t  = ctx.task.template cast_safe<ScheduleTask_v_eadd>();
+            auto r  = t->r.template cast_safe<TVector<T>>();
+            auto u  = t->u.template cast_safe<TVector<T>>();
+            auto v  = t->v.template cast_safe<TVector<T>>();
+            auto op = t->op.template cast_safe<TOpBinary<T, T, T>>();
+
+            return u->is_valid(FormatVector::CpuCoo) &&
+                   v->is_valid(FormatVector::CpuCoo) &&
+                   op->function(u->get_fill_value(), v->get_fill_value()) == r->get_fill_value();
+        }
+
+        Status execute_sp2sp(const DispatchContext& ctx) {
+            TIME_PROFILE_SCOPE("cpu/vector_eadd_sp2sp");
+
+            auto                        t  = ctx.task.template cast_safe<ScheduleTask_v_eadd>();
+            ref_ptr<TVector<T>>         r  = t->r.template cast_safe<TVector<T>>();
+            ref_ptr<TVector<T>>         u  = t->u.template cast_safe<TVector<T>>();
+            ref_ptr<TVector<T>>         v  = t->v.template cast_safe<TVector<T>>();
+            ref_ptr<TOpBinary<T, T, T>> op = t->op.template cast_safe<TOpBinary<T, T, T>>();
+
+            const auto* p_u      = u->template get<CpuCooVec<T>>();
+            const auto* p_v      = v->template get<CpuCooVec<T>>();
+            const auto& function = op->function;
+            const T     fill_u   = u->get_fill_value();
+            const T     fill_v   = v->get_fill_value();
+
+            // Inputs are copied since r may alias u or v; coo from select and vxm is already sorted by index
+            std::vector<std::pair<uint, T>> entries_u(p_u->values);
+            std::vector<std::pair<uint, T>> entries_v(p_v->values);
+            for (uint k = 0; k < p_u->values; k++) entries_u[k] = {p_u->Ai[k], p_u->Ax[k]};
+            for (uint k = 0; k < p_v->values; k++) entries_v[k] = {p_v->Ai[k], p_v->Ax[k]};
+
+            auto by_index = [](const std::pair<uint, T>& a, const std::pair<uint, T>& b) { return a.first < b.first; };
+            if (!std::is_sorted(entries_u.begin(), entries_u.end(), by_index)) std::sort(entries_u.begin(), entries_u.end(), by_index);
+            if (!std::is_sorted(entries_v.begin(), entries_v.end(), by_index)) std::sort(entries_v.begin(), entries_v.end(), by_index);
+
+            r->validate_wd(FormatVector::CpuCoo);
+            auto* p_r = r->template get<CpuCooVec<T>>();
+
+            p_r->Ai.reserve(entries_u.size() + entries_v.size());
+            p_r->Ax.reserve(entries_u.size() + entries_v.size());
+
+            std::size_t k_u = 0, k_v = 0;
+
+            while (k_u < entries_u.size() || k_v < entries_v.size()) {
+                const uint i_u = k_u < entries_u.size() ? entries_u[k_u].first : std::numeric_limits<uint>::max();
+                const uint i_v = k_v < entries_v.size() ? entries_v[k_v].first : std::numeric_limits<uint>::max();
+                const uint i   = std::min(i_u, i_v);
+
+                const T x_u = i_u == i ? entries_u[k_u++].second : fill_u;
+                const T x_v = i_v == i ? entries_v[k_v++].second : fill_v;
+
+                p_r->Ai.push_back(i);
+                p_r->Ax.push_back(function(x_u, x_v));
+            }
+
+            p_r->values = uint(p_r->Ai.size());
+
+            return Status::Ok;
+        }
+
         Status execute_dn2dn(const DispatchContext& ctx) {
             TIME_PROFILE_SCOPE("cpu/vector_eadd_dn2dn");
 
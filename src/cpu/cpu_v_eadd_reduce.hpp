@@ -0,0 +1,197 @@
+/**********************************************************************************/
+/* This file is part of spla project                                              */
+/* https://github.com/SparseLinearAlgebra/spla                                    */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2023 SparseLinearAlgebra                                         */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#ifndef SPLA_CPU_V_EADD_REDUCE_HPP
+#define SPLA_CPU_V_EADD_REDUCE_HPP
+
+#include <schedule/schedule_tasks.hpp>
+
+#include <core/dispatcher.hpp>
+#include <core/registry.hpp>
+#include <core/top.hpp>
+#include <core/tscalar.hpp>
+#include <core/ttype.hpp>
+#include <core/tvector.hpp>
+
+#include <cpu/cpu_format_bitmap_vec.hpp>
+
+namespace spla {
+
+    template<typename T>
+    class Algo_v_eadd_reduce_cpu final : public RegistryAlgo {
+    public:
+        ~Algo_v_eadd_reduce_cpu() override = default;
+
+        std::string get_name() override {
+            return "v_eadd_reduce";
+        }
+
+        std::string get_description() override {
+            return "sequential element-wise vector operation with reduction on cpu";
+        }
+
+        Status execute(const DispatchContext& ctx) override {
+            auto t = ctx.task.template cast_safe<ScheduleTask_v_eadd_reduce>();
+            auto u = t->u.template cast_safe<TVector<T>>();
+
+            if (u->is_bitmap_storage() &&
+                u->get_fill_value() == T(0) &&
+                cpu_bitmap_is_dot_semiring<T>(t->op_elem, t->op_reduce))
+                return execute_bitmap2dn(ctx);
+
+            return execute_dn2dn(ctx);
+        }
+
+    private:
+        Status execute_bitmap2dn(const DispatchContext& ctx) {
+            TIME_PROFILE_SCOPE("cpu/vector_eadd_reduce_bitmap2dn");
+
+            auto t = ctx.task.template cast_safe<ScheduleTask_v_eadd_reduce>();
+
+            auto r = t->r.template cast_safe<TScalar<T>>();
+            auto s = t->s.template cast_safe<TScalar<T>>();
+            auto u = t->u.template cast_safe<TVector<T>>();
+            auto v = t->v.template cast_safe<TVector<T>>();
+
+            v->validate_rw(FormatVector::CpuDense);
+
+            const auto* p_u  = u->template get<CpuBitmapVec<T>>();
+            const auto* p_v  = v->template get<CpuDenseVec<T>>();
+            const T*    p_vx = p_v->Ax.data();
+
+            const uint n_words = cpu_bitmap_words(u->get_n_rows());
+
+            // Unset entries are zero, so dot product takes only set entries of u, read as 1
+            T sum = s->get_value();
+
+            for (uint w = 0; w < n_words; ++w) {
+                std::uint64_t word = p_u->Aw[w];
+
+                while (word) {
+                    sum += p_vx[w * BITMAP_WORD_BITS + ctz64(word)];
+                    word &= word - 1;
+                }
+            }
+
+            r->get_value() = sum;
+
+            return Status::Ok;
+        }
+
+        Status execute_dn2dn(const DispatchContext& ctx) {
+            TIME_PROFILE_SCOPE("cpu/vector_eadd_reduce_dn2dn");
+
+            auto t = ctx.task.template cast_safe<ScheduleTask_v_eadd_reduce>();
+
+            auto r         = t->r.template cast_safe<TScalar<T>>();
+            auto s         = t->s.template cast_safe<TScalar<T>>();
+            auto u         = t->u.template cast_safe<TVector<T>>();
+            auto v         = t->v.template cast_safe<TVector<T>>();
+            auto op_elem   = t->op_elem.template cast_safe<TOpBinary<T, T, T>>();
+            auto op_reduce = t->op_reduce.template cast_safe<TOpBinary<T, T, T>>();
+
+            u->validate_rw(FormatVector::CpuDense);
+            v->validate_rw(FormatVector::CpuDense);
+
+            const auto* p_u         = u->template get<CpuDenseVec<T>>();
+            const auto* p_v         = v->template get<CpuDenseVec<T>>();
+            const auto& func_elem   = op_elem->function;
+            const auto& func_reduce = op_reduce->function;
+            const T*    p_ux        = p_u->Ax.data();
+            const T*    p_vx        = p_v->Ax.data();
+
+            const uint N = u->get_n_rows();
+
+            if (is_plus(t->op_reduce) && is_minus_pow2(t->op_elem)) {
+                r->get_value() = reduce_lanes(p_ux, p_vx, N, s->get_value(), [](T a, T b) { return (a - b) * (a - b); });
+                return Status::Ok;
+            }
+            if (is_plus(t->op_reduce) && is_mult(t->op_elem)) {
+                r->get_value() = reduce_lanes(p_ux, p_vx, N, s->get_value(), [](T a, T b) { return a * b; });
+                return Status::Ok;
+            }
+
+            T sum = s->get_value();
+
+            for (uint i = 0; i < N; i++) {
+                sum = func_reduce(sum, func_elem(p_ux[i], p_vx[i]));
+            }
+
+            r->get_value() = sum;
+
+            return Status::Ok;
+        }
+
+        /**
+         * @brief Sums inlined element op over independent lanes, so compiler vectorizes the loop
+         *
+         * Lanes split the serial dependency of a single sum, and their fixed count lets the inner
+         * loop map onto vector registers without fast-math. Float sums are reassociated by lanes.
+         */
+        template<typename Elem>
+        static T reduce_lanes(const T* __restrict ux, const T* __restrict vx, uint N, T init, Elem elem) {
+            constexpr uint LANES = 8;
+
+            T    acc[LANES] = {};
+            uint i          = 0;
+
+            for (; i + LANES <= N; i += LANES) {
+                for (uint l = 0; l < LANES; ++l) {
+                    acc[l] += elem(ux[i + l], vx[i + l]);
+                }
+            }
+
+            T sum = init;
+            for (uint l = 0; l < LANES; ++l) sum += acc[l];
+            for (; i < N; ++i) sum += elem(ux[i], vx[i]);
+
+            return sum;
+        }
+
+        static bool is_plus(const ref_ptr<OpBinary>& op) {
+            if constexpr (std::is_same_v<T, T_INT>) return op == PLUS_INT;
+            if constexpr (std::is_same_v<T, T_UINT>) return op == PLUS_UINT;
+            if constexpr (std::is_same_v<T, T_FLOAT>) return op == PLUS_FLOAT;
+            return false;
+        }
+        static bool is_mult(const ref_ptr<OpBinary>& op) {
+            if constexpr (std::is_same_v<T, T_INT>) return op == MULT_INT;
+            if constexpr (std::is_same_v<T, T_UINT>) return op == MULT_UINT;
+            if constexpr (std::is_same_v<T, T_FLOAT>) return op == MULT_FLOAT;
+            return false;
+        }
+        static bool is_minus_pow2(const ref_ptr<OpBinary>& op) {
+            if constexpr (std::is_same_v<T, T_INT>) return op == MINUS_POW2_INT;
+            if constexpr (std::is_same_v<T, T_UINT>) return op == MINUS_POW2_UINT;
+            if constexpr (std::is_same_v<T, T_FLOAT>) return op == MINUS_POW2_FLOAT;
+            return false;
+        }
+    };
+
+}// namespace spla
+
+#endif//SPLA_CPU_V_EADD_REDUCE_HPP
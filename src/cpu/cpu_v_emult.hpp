@@ -0,0 +1,162 @@
+/**********************************************************************************/
+/* This file is part of spla project                                              */
+/* https://github.com/SparseLinearAlgebra/spla                                    */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2023 SparseLinearAlgebra                                         */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#ifndef SPLA_CPU_V_EMULT_HPP
+#define SPLA_CPU_V_EMULT_HPP
+
+#include <schedule/schedule_tasks.hpp>
+
+#include <core/dispatcher.hpp>
+#include <core/registry.hpp>
+#include <core/top.hpp>
+#include <core/tscalar.hpp>
+#include <core/ttype.hpp>
+#include <core/tvector.hpp>
+
+#include <vector>
+
+namespace spla {
+
+    template<typename T>
+    class Algo_v_emult_cpu final : public RegistryAlgo {
+    public:
+        ~Algo_v_emult_cpu() override = default;
+
+        std::string get_name() override {
+            return "v_emult";
+        }
+
+        std::string get_description() override {
+            return "sequential element-wise mult vector operation";
+        }
+
+        Status execute(const DispatchContext& ctx) override {
+            auto                t = ctx.task.template cast_safe<ScheduleTask_v_emult>();
+            ref_ptr<TVector<T>> u = t->u.template cast_safe<TVector<T>>();
+
+            if (u->is_valid(FormatVector::CpuCoo)) {
+                return execute_sp2sp(ctx);
+            }
+            if (u->is_valid(FormatVector::CpuDense)) {
+                return execute_dn2sp(ctx);
+            }
+
+            return execute_sp2sp(ctx);
+        }
+
+    private:
+        Status execute_sp2sp(const DispatchContext& ctx) {
+            TIME_PROFILE_SCOPE("cpu/vector_emult_sp2sp");
+
+            auto                        t  = ctx.task.template cast_safe<ScheduleTask_v_emult>();
+            ref_ptr<TVector<T>>         r  = t->r.template cast_safe<TVector<T>>();
+            ref_ptr<TVector<T>>         u  = t->u.template cast_safe<TVector<T>>();
+            ref_ptr<TVector<T>>         v  = t->v.template cast_safe<TVector<T>>();
+            ref_ptr<TOpBinary<T, T, T>> op = t->op.template cast_safe<TOpBinary<T, T, T>>();
+
+            u->validate_rw(FormatVector::CpuCoo);
+            v->validate_rw(FormatVector::CpuDense);
+
+            // Result is written after inputs are read, since r may alias u
+            const auto* p_u      = u->template get<CpuCooVec<T>>();
+            const auto* p_v      = v->template get<CpuDenseVec<T>>();
+            const auto& function = op->function;
+            const T     fill_r   = r->get_fill_value();
+
+            std::vector<uint> Ri;
+            std::vector<T>    Rx;
+            Ri.reserve(p_u->values);
+            Rx.reserve(p_u->values);
+
+            for (uint k = 0; k < p_u->values; k++) {
+                const uint i = p_u->Ai[k];
+                const T    x = function(p_u->Ax[k], p_v->Ax[i]);
+
+                if (x != fill_r) {
+                    Ri.push_back(i);
+                    Rx.push_back(x);
+                }
+            }
+
+            r->validate_wd(FormatVector::CpuCoo);
+            auto* p_r = r->template get<CpuCooVec<T>>();
+
+            p_r->values = uint(Ri.size());
+            p_r->Ai     = std::move(Ri);
+            p_r->Ax     = std::move(Rx);
+
+            return Status::Ok;
+        }
+
+        Status execute_dn2sp(const DispatchContext& ctx) {
+            TIME_PROFILE_SCOPE("cpu/vector_emult_dn2sp");
+
+            auto                        t  = ctx.task.template cast_safe<ScheduleTask_v_emult>();
+            ref_ptr<TVector<T>>         r  = t->r.template cast_safe<TVector<T>>();
+            ref_ptr<TVector<T>>         u  = t->u.template cast_safe<TVector<T>>();
+            ref_ptr<TVector<T>>         v  = t->v.template cast_safe<TVector<T>>();
+            ref_ptr<TOpBinary<T, T, T>> op = t->op.template cast_safe<TOpBinary<T, T, T>>();
+
+            u->validate_rw(FormatVector::CpuDense);
+            v->validate_rw(FormatVector::CpuDense);
+
+            const auto* p_u      = u->template get<CpuDenseVec<T>>();
+            const auto* p_v      = v->template get<CpuDenseVec<T>>();
+            const auto& function = op->function;
+            const T     fill_u   = u->get_fill_value();
+            const T     fill_r   = r->get_fill_value();
+
+            std::vector<uint> Ri;
+            std::vector<T>    Rx;
+
+            const uint N = u->get_n_rows();
+
+            for (uint i = 0; i < N; i++) {
+                if (p_u->Ax[i] == fill_u) continue;
+
+                const T x = function(p_u->Ax[i], p_v->Ax[i]);
+
+                if (x != fill_r) {
+                    Ri.push_back(i);
+                    Rx.push_back(x);
+                }
+            }
+
+            r->validate_wd(FormatVector::CpuCoo);
+            auto* p_r = r->template get<CpuCooVec<T>>();
+
+            p_r->values = uint(Ri.size());
+            p_r->Ai     = std::move(Ri);
+            p_r->Ax     = std::move(Rx);
+
+            return Status::Ok;
+        }
+    };
+
+}// namespace spla
+
+#endif//SPLA_CPU_V_EMULT_HPP
@@ -0,0 +1,200 @@
+/**********************************************************************************/
+/* This file is part of spla project                                              */
+/* https://github.com/SparseLinearAlgebra/spla                                    */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2023 SparseLinearAlgebra                                         */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#ifndef SPLA_CPU_V_EWISE_CHAIN_HPP
+#define SPLA_CPU_V_EWISE_CHAIN_HPP
+
+#include <schedule/schedule_tasks.hpp>
+
+#include <core/dispatcher.hpp>
+#include <core/registry.hpp>
+#include <core/top.hpp>
+#include <core/tscalar.hpp>
+#include <core/ttype.hpp>
+#include <core/tvector.hpp>
+
+namespace spla {
+
+    template<typename T>
+    class Algo_v_ewise_chain_cpu final : public RegistryAlgo {
+    public:
+        ~Algo_v_ewise_chain_cpu() override = default;
+
+        std::string get_name() override {
+            return "v_ewise_chain";
+        }
+
+        std::string get_description() override {
+            return "sequential fused element-wise ops chain with optional reduction on cpu";
+        }
+
+        Status execute(const DispatchContext& ctx) override {
+            auto t = ctx.task.template cast_safe<ScheduleTask_v_ewise_chain>();
+            auto u = t->u.template cast_safe<TVector<T>>();
+
+            // Single pass is exact only where each stage alone would take its dense path
+            const bool is_dense = t->op_elem
+                                          ? is_eadd_dense(t)
+                                          : u->is_valid(FormatVector::CpuDense) && !u->is_valid(FormatVector::CpuCoo);
+
+            if (is_dense) {
+                return execute_dense(ctx);
+            }
+
+            return execute_staged(ctx);
+        }
+
+    private:
+        /** Same choice as Algo_v_eadd_cpu, dense result of eadd then keeps maps and reduce dense */
+        static bool is_eadd_dense(const ref_ptr<ScheduleTask_v_ewise_chain>& t) {
+            auto u  = t->u.template cast_safe<TVector<T>>();
+            auto v  = t->v.template cast_safe<TVector<T>>();
+            auto op = t->op_elem.template cast_safe<TOpBinary<T, T, T>>();
+
+            if (u->is_valid(FormatVector::CpuDense) && v->is_valid(FormatVector::CpuDense)) {
+                return true;
+            }
+
+            const bool is_last = t->ops_map.empty() && !t->op_reduce;
+            auto       r       = (is_last ? t->r : t->temps.front()).template cast_safe<TVector<T>>();
+
+            return !(u->is_valid(FormatVector::CpuCoo) && v->is_valid(FormatVector::CpuCoo) &&
+                     op->function(u->get_fill_value(), v->get_fill_value()) == r->get_fill_value());
+        }
+
+        Status execute_dense(const DispatchContext& ctx) {
+            TIME_PROFILE_SCOPE("cpu/vector_ewise_chain_dense");
+
+            auto t = ctx.task.template cast_safe<ScheduleTask_v_ewise_chain>();
+
+            auto u         = t->u.template cast_safe<TVector<T>>();
+            auto v         = t->v.template cast_safe<TVector<T>>();
+            auto op_elem   = t->op_elem.template cast_safe<TOpBinary<T, T, T>>();
+            auto op_reduce = t->op_reduce.template cast_safe<TOpBinary<T, T, T>>();
+
+            std::vector<std::function<T(T)>> funcs_map;
+            funcs_map.reserve(t->ops_map.size());
+            for (const auto& op : t->ops_map) {
+                funcs_map.push_back(op.template cast_safe<TOpUnary<T, T>>()->function);
+            }
+
+            u->validate_rw(FormatVector::CpuDense);
+            if (op_elem) v->validate_rw(FormatVector::CpuDense);
+
+            const T*   p_ux = u->template get<CpuDenseVec<T>>()->Ax.data();
+            const T*   p_vx = op_elem ? v->template get<CpuDenseVec<T>>()->Ax.data() : nullptr;
+            const uint N    = u->get_n_rows();
+
+            auto element = [&](uint i) {
+                T x = op_elem ? op_elem->function(p_ux[i], p_vx[i]) : p_ux[i];
+                for (const auto& func : funcs_map) x = func(x);
+                return x;
+            };
+
+            if (op_reduce) {
+                auto& func_reduce = op_reduce->function;
+                auto  reduced     = t->reduced.template cast_safe<TScalar<T>>();
+                T     sum         = t->s.template cast_safe<TScalar<T>>()->get_value();
+
+                for (uint i = 0; i < N; i++) {
+                    sum = func_reduce(sum, element(i));
+                }
+
+                reduced->get_value() = sum;
+                return Status::Ok;
+            }
+
+            auto r = t->r.template cast_safe<TVector<T>>();
+            r->validate_wd(FormatVector::CpuDense);
+            T* p_rx = r->template get<CpuDenseVec<T>>()->Ax.data();
+
+            for (uint i = 0; i < N; i++) {
+                p_rx[i] = element(i);
+            }
+
+            return Status::Ok;
+        }
+
+        /** Runs chain stage by stage through original temporaries, so sparse inputs keep per-stage semantics */
+        Status execute_staged(const DispatchContext& ctx) {
+            auto        t            = ctx.task.template cast_safe<ScheduleTask_v_ewise_chain>();
+            Dispatcher* g_dispatcher = Library::get()->get_dispatcher();
+
+            std::vector<ref_ptr<ScheduleTask>> stages;
+            std::size_t                        next_temp = 0;
+            ref_ptr<Vector>                    input     = t->u;
+
+            const std::size_t n_outputs = (t->op_elem ? 1 : 0) + t->ops_map.size();
+
+            auto output = [&]() {
+                const bool is_last = next_temp + 1 == n_outputs && !t->op_reduce;
+                return is_last ? t->r : t->temps[next_temp++];
+            };
+
+            if (t->op_elem) {
+                auto eadd = make_ref<ScheduleTask_v_eadd>();
+                eadd->r   = output();
+                eadd->u   = t->u;
+                eadd->v   = t->v;
+                eadd->op  = t->op_elem;
+                input     = eadd->r;
+                stages.push_back(eadd.as<ScheduleTask>());
+            }
+            for (const auto& op : t->ops_map) {
+                auto map = make_ref<ScheduleTask_v_map>();
+                map->r   = output();
+                map->v   = input;
+                map->op  = op;
+                input    = map->r;
+                stages.push_back(map.as<ScheduleTask>());
+            }
+            if (t->op_reduce) {
+                auto reduce       = make_ref<ScheduleTask_v_reduce>();
+                reduce->r         = t->reduced;
+                reduce->s         = t->s;
+                reduce->v         = input;
+                reduce->op_reduce = t->op_reduce;
+                stages.push_back(reduce.as<ScheduleTask>());
+            }
+
+            for (const auto& stage : stages) {
+                DispatchContext stage_ctx{};
+                stage_ctx.task = stage;
+
+                Status status = g_dispatcher->dispatch(stage_ctx);
+                if (status != Status::Ok) {
+                    return status;
+                }
+            }
+
+            return Status::Ok;
+        }
+    };
+
+}// namespace spla
+
+#endif//SPLA_CPU_V_EWISE_CHAIN_HPP
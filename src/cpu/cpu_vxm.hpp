@@ -38,6 +38,9 @@
 #include <core/ttype.hpp>
 #include <core/tvector.hpp>
 
+#include <cpu/cpu_format_bitmap_vec.hpp>
+#include <cpu/cpu_mask.hpp>
+
 #include <robin_hood.hpp>
 
 namespace spla {
@@ -56,36 +59,52 @@ namespace spla {
         }
 
         Status execute(const DispatchContext& ctx) override {
+            auto t         = ctx.task.template cast_safe<ScheduleTask_vxm_masked>();
+            auto r         = t->r.template cast_safe<TVector<T>>();
+            auto mask      = t->mask.template cast_safe<TVector<T>>();
+            auto v         = t->v.template cast_safe<TVector<T>>();
+            auto op_select = t->op_select.template cast_safe<TOpSelect<T>>();
+            auto init      = t->init.template cast_safe<TScalar<T>>();
+
+            CpuMask<T> cpu_mask(mask, op_select, t->get_desc_or_default());
+
+            if (v->is_bitmap_storage() &&
+                cpu_mask.is_bitmap() &&
+                t->op_accum.is_null() &&
+                cpu_bitmap_is_bool_semiring<T>(t->op_multiply, t->op_add) &&
+                init->get_value() == T(0) &&
+                r->get_fill_value() == T(0) &&
+                v->get_fill_value() == T(0))
+                return execute_bitmap(ctx, cpu_mask);
+
+            return execute_sparse(ctx, cpu_mask);
+        }
+
+    private:
+        Status execute_sparse(const DispatchContext& ctx, CpuMask<T>& cpu_mask) {
             TIME_PROFILE_SCOPE("cpu/vxm");
 
             auto t = ctx.task.template cast_safe<ScheduleTask_vxm_masked>();
 
             auto r           = t->r.template cast_safe<TVector<T>>();
-            auto mask        = t->mask.template cast_safe<TVector<T>>();
             auto v           = t->v.template cast_safe<TVector<T>>();
             auto M           = t->M.template cast_safe<TMatrix<T>>();
             auto op_multiply = t->op_multiply.template cast_safe<TOpBinary<T, T, T>>();
             auto op_add      = t->op_add.template cast_safe<TOpBinary<T, T, T>>();
-            auto op_select   = t->op_select.template cast_safe<TOpSelect<T>>();
-            auto init        = t->init.template cast_safe<TScalar<T>>();
 
-            const T sum_init = init->get_value();
-
-            r->validate_wd(FormatVector::CpuCoo);
-            mask->validate_rw(FormatVector::CpuDense);
             v->validate_rw(FormatVector::CpuCoo);
             M->validate_rw(FormatMatrix::CpuLil);
+            TIME_PROFILE_SCOPE_WORK(M->get_n_values());
+            cpu_mask.bind_test();
 
-            CpuCooVec<T>*         p_sparse_r   = r->template get<CpuCooVec<T>>();
-            const CpuDenseVec<T>* p_dense_mask = mask->template get<CpuDenseVec<T>>();
-            const CpuCooVec<T>*   p_sparse_v   = v->template get<CpuCooVec<T>>();
-            const CpuLil<T>*      p_lil_M      = M->template get<CpuLil<T>>();
+            const CpuCooVec<T>* p_sparse_v = v->template get<CpuCooVec<T>>();
+            const CpuLil<T>*    p_lil_M    = M->template get<CpuLil<T>>();
 
             auto& func_multiply = op_multiply->function;
             auto& func_add      = op_add->function;
-            auto& func_select   = op_select->function;
 
-            const uint N = p_sparse_v->values;
+            const uint N         = p_sparse_v->values;
+            const bool need_test = !cpu_mask.is_null();
 
             robin_hood::unordered_flat_map<uint, T> r_tmp;
 
@@ -98,14 +117,14 @@ namespace spla {
                 for (const auto& j_x : row) {
                     const uint j = j_x.first;
 
-                    if (func_select(p_dense_mask->Ax[j])) {
-                        auto r_x = r_tmp.find(j);
+                    if (need_test && !cpu_mask.test(j)) continue;
 
-                        if (r_x != r_tmp.end())
-                            r_x->second = func_add(r_x->second, func_multiply(v_x, j_x.second));
-                        else
-                            r_tmp[j] = func_multiply(v_x, j_x.second);
-                    }
+                    auto r_x = r_tmp.find(j);
+
+                    if (r_x != r_tmp.end())
+                        r_x->second = func_add(r_x->second, func_multiply(v_x, j_x.second));
+                    else
+                        r_tmp[j] = func_multiply(v_x, j_x.second);
                 }
             }
 
@@ -116,6 +135,13 @@ namespace spla {
             }
             std::sort(r_entries.begin(), r_entries.end());
 
+            if (t->op_accum) {
+                return accum(t, r_entries);
+            }
+
+            r->validate_wd(FormatVector::CpuCoo);
+            CpuCooVec<T>* p_sparse_r = r->template get<CpuCooVec<T>>();
+
             p_sparse_r->values = uint(r_tmp.size());
             p_sparse_r->Ai.reserve(r_tmp.size());
             p_sparse_r->Ax.reserve(r_tmp.size());
@@ -126,6 +152,84 @@ namespace spla {
 
             return Status::Ok;
         }
+
+        static Status accum(const ref_ptr<ScheduleTask_vxm_masked>& t, const std::vector<std::pair<uint, T>>& r_entries) {
+            auto r        = t->r.template cast_safe<TVector<T>>();
+            auto changed  = t->changed.template cast_safe<TVector<T>>();
+            auto op_accum = t->op_accum.template cast_safe<TOpBinary<T, T, T>>();
+            auto op_add   = t->op_add.template cast_safe<TOpBinary<T, T, T>>();
+            auto init     = t->init.template cast_safe<TScalar<T>>();
+
+            r->validate_rwd(FormatVector::CpuDense);
+            if (changed) changed->validate_wd(FormatVector::CpuCoo);
+
+            CpuDenseVec<T>* p_dense_r  = r->template get<CpuDenseVec<T>>();
+            CpuCooVec<T>*   p_changed  = changed ? changed->template get<CpuCooVec<T>>() : nullptr;
+            auto&           func_accum = op_accum->function;
+            auto&           func_add   = op_add->function;
+            const T         sum_init   = init->get_value();
+
+            for (const auto& e : r_entries) {
+                const T prev           = p_dense_r->Ax[e.first];
+                p_dense_r->Ax[e.first] = func_accum(prev, func_add(sum_init, e.second));
+
+                if (p_changed && prev != p_dense_r->Ax[e.first]) {
+                    p_changed->Ai.push_back(e.first);
+                    p_changed->Ax.push_back(p_dense_r->Ax[e.first]);
+                }
+            }
+
+            if (p_changed) p_changed->values = uint(p_changed->Ai.size());
+
+            return Status::Ok;
+        }
+
+        Status execute_bitmap(const DispatchContext& ctx, CpuMask<T>& cpu_mask) {
+            TIME_PROFILE_SCOPE("cpu/vxm_bitmap");
+
+            auto t = ctx.task.template cast_safe<ScheduleTask_vxm_masked>();
+
+            auto r = t->r.template cast_safe<TVector<T>>();
+            auto v = t->v.template cast_safe<TVector<T>>();
+            auto M = t->M.template cast_safe<TMatrix<T>>();
+
+            r->validate_wd(FormatVector::CpuBitmap);
+            v->validate_rw(FormatVector::CpuBitmap);
+            M->validate_rw(FormatMatrix::CpuLil);
+            TIME_PROFILE_SCOPE_WORK(M->get_n_values());
+            cpu_mask.bind_bitmap();
+
+            CpuBitmapVec<T>*       p_bitmap_r = r->template get<CpuBitmapVec<T>>();
+            const CpuBitmapVec<T>* p_bitmap_v = v->template get<CpuBitmapVec<T>>();
+            const CpuLil<T>*       p_lil_M    = M->template get<CpuLil<T>>();
+
+            const uint N       = v->get_n_rows();
+            const uint n_words = cpu_bitmap_words(N);
+
+            std::uint64_t* r_words = p_bitmap_r->Aw.data();
+
+            for (uint w = 0; w < n_words; ++w) {
+                std::uint64_t word = p_bitmap_v->Aw[w];
+
+                while (word) {
+                    const uint v_i = w * BITMAP_WORD_BITS + ctz64(word);
+                    word &= word - 1;
+
+                    for (const auto& j_x : p_lil_M->Ar[v_i]) {
+                        const uint          j   = j_x.first;
+                        const std::uint64_t bit = std::uint64_t(1) << (j % BITMAP_WORD_BITS);
+
+                        if ((cpu_mask.word(j / BITMAP_WORD_BITS) & bit) && cpu_bitmap_band_set(j_x.second)) {
+                            r_words[j / BITMAP_WORD_BITS] |= bit;
+                        }
+                    }
+                }
+            }
+
+            p_bitmap_r->values = cpu_bitmap_vec_count(*p_bitmap_r);
+
+            return Status::Ok;
+        }
     };
 
 }// namespace spla
@@ -29,13 +29,20 @@
 #include <spla/library.hpp>
 
 #include <core/dispatcher.hpp>
+#include <core/lazy_planner.hpp>
 #include <schedule/schedule_tasks.hpp>
 #include <utility>
 
 namespace spla {
 
-    static Status execute_immediate(ref_ptr<ScheduleTask> task) {
-        Dispatcher*     g_dispatcher = Library::get()->get_dispatcher();
+    static Status execute_or_defer(ref_ptr<ScheduleTask> task) {
+        Library* g_lib = Library::get();
+
+        if (g_lib->is_set_lazy_execution()) {
+            return g_lib->get_lazy_planner()->submit(std::move(task));
+        }
+
+        Dispatcher*     g_dispatcher = g_lib->get_dispatcher();
         DispatchContext ctx{};
         ctx.thread_id = 0;
         ctx.step_id   = 0;
@@ -49,7 +56,7 @@ namespace spla {
         *task_hnd = task.as<ScheduleTask>();               \
         return Status::Ok;                                 \
     } else {                                               \
-        return execute_immediate(task.as<ScheduleTask>()); \
+        return execute_or_defer(task.as<ScheduleTask>()); \
     }
 
 
@@ -135,6 +142,62 @@ namespace spla {
         EXEC_OR_MAKE_TASK
     }
 
+    Status exec_mxv_masked_accum(
+            ref_ptr<Vector>        r,
+            ref_ptr<Vector>        mask,
+            ref_ptr<Matrix>        M,
+            ref_ptr<Vector>        v,
+            ref_ptr<OpBinary>      op_multiply,
+            ref_ptr<OpBinary>      op_add,
+            ref_ptr<OpSelect>      op_select,
+            ref_ptr<Scalar>        init,
+            ref_ptr<OpBinary>      op_accum,
+            ref_ptr<Vector>        changed,
+            ref_ptr<Descriptor>    desc,
+            ref_ptr<ScheduleTask>* task_hnd) {
+        auto task         = make_ref<ScheduleTask_mxv_masked>();
+        task->r           = std::move(r);
+        task->mask        = std::move(mask);
+        task->M           = std::move(M);
+        task->v           = std::move(v);
+        task->op_multiply = std::move(op_multiply);
+        task->op_add      = std::move(op_add);
+        task->op_select   = std::move(op_select);
+        task->init        = std::move(init);
+        task->op_accum    = std::move(op_accum);
+        task->changed     = std::move(changed);
+        task->desc        = std::move(desc);
+        EXEC_OR_MAKE_TASK
+    }
+
+    Status exec_vxm_masked_accum(
+            ref_ptr<Vector>        r,
+            ref_ptr<Vector>        mask,
+            ref_ptr<Vector>        v,
+            ref_ptr<Matrix>        M,
+            ref_ptr<OpBinary>      op_multiply,
+            ref_ptr<OpBinary>      op_add,
+            ref_ptr<OpSelect>      op_select,
+            ref_ptr<Scalar>        init,
+            ref_ptr<OpBinary>      op_accum,
+            ref_ptr<Vector>        changed,
+            ref_ptr<Descriptor>    desc,
+            ref_ptr<ScheduleTask>* task_hnd) {
+        auto task         = make_ref<ScheduleTask_vxm_masked>();
+        task->r           = std::move(r);
+        task->mask        = std::move(mask);
+        task->v           = std::move(v);
+        task->M           = std::move(M);
+        task->op_multiply = std::move(op_multiply);
+        task->op_add      = std::move(op_add);
+        task->op_select   = std::move(op_select);
+        task->init        = std::move(init);
+        task->op_accum    = std::move(op_accum);
+        task->changed     = std::move(changed);
+        task->desc        = std::move(desc);
+        EXEC_OR_MAKE_TASK
+    }
+
     Status exec_m_reduce_by_row(
             ref_ptr<Vector>        r,
             ref_ptr<Matrix>        M,
@@ -151,6 +214,34 @@ namespace spla {
         EXEC_OR_MAKE_TASK
     }
 
+    Status exec_m_select(
+            ref_ptr<Matrix>        R,
+            ref_ptr<Matrix>        M,
+            ref_ptr<OpSelect>      op_select,
+            ref_ptr<Descriptor>    desc,
+            ref_ptr<ScheduleTask>* task_hnd) {
+        auto task       = make_ref<ScheduleTask_m_select>();
+        task->R         = std::move(R);
+        task->M         = std::move(M);
+        task->op_select = std::move(op_select);
+        task->desc      = std::move(desc);
+        EXEC_OR_MAKE_TASK
+    }
+
+    Status exec_m_tril(
+            ref_ptr<Matrix>        R,
+            ref_ptr<Matrix>        M,
+            ref_ptr<Vector>        key,
+            ref_ptr<Descriptor>    desc,
+            ref_ptr<ScheduleTask>* task_hnd) {
+        auto task  = make_ref<ScheduleTask_m_tril>();
+        task->R    = std::move(R);
+        task->M    = std::move(M);
+        task->key  = std::move(key);
+        task->desc = std::move(desc);
+        EXEC_OR_MAKE_TASK
+    }
+
     Status exec_m_reduce(
             ref_ptr<Scalar>        r,
             ref_ptr<Scalar>        s,
@@ -183,6 +274,22 @@ namespace spla {
         EXEC_OR_MAKE_TASK
     }
 
+    Status exec_v_emult(
+            ref_ptr<Vector>        r,
+            ref_ptr<Vector>        u,
+            ref_ptr<Vector>        v,
+            ref_ptr<OpBinary>      op,
+            ref_ptr<Descriptor>    desc,
+            ref_ptr<ScheduleTask>* task_hnd) {
+        auto task  = make_ref<ScheduleTask_v_emult>();
+        task->r    = std::move(r);
+        task->u    = std::move(u);
+        task->v    = std::move(v);
+        task->op   = std::move(op);
+        task->desc = std::move(desc);
+        EXEC_OR_MAKE_TASK
+    }
+
     Status exec_v_eadd_fdb(
             ref_ptr<Vector>        r,
             ref_ptr<Vector>        v,
@@ -231,6 +338,22 @@ namespace spla {
         EXEC_OR_MAKE_TASK
     }
 
+    Status exec_v_select_range(
+            ref_ptr<Vector>        r,
+            ref_ptr<Vector>        v,
+            ref_ptr<Scalar>        lo,
+            ref_ptr<Scalar>        hi,
+            ref_ptr<Descriptor>    desc,
+            ref_ptr<ScheduleTask>* task_hnd) {
+        auto task  = make_ref<ScheduleTask_v_select_range>();
+        task->r    = std::move(r);
+        task->v    = std::move(v);
+        task->lo   = std::move(lo);
+        task->hi   = std::move(hi);
+        task->desc = std::move(desc);
+        EXEC_OR_MAKE_TASK
+    }
+
     Status exec_v_reduce(
             ref_ptr<Scalar>        r,
             ref_ptr<Scalar>        s,
@@ -247,6 +370,26 @@ namespace spla {
         EXEC_OR_MAKE_TASK
     }
 
+    Status exec_v_eadd_reduce(
+            ref_ptr<Scalar>        r,
+            ref_ptr<Scalar>        s,
+            ref_ptr<Vector>        u,
+            ref_ptr<Vector>        v,
+            ref_ptr<OpBinary>      op_elem,
+            ref_ptr<OpBinary>      op_reduce,
+            ref_ptr<Descriptor>    desc,
+            ref_ptr<ScheduleTask>* task_hnd) {
+        auto task       = make_ref<ScheduleTask_v_eadd_reduce>();
+        task->r         = std::move(r);
+        task->s         = std::move(s);
+        task->u         = std::move(u);
+        task->v         = std::move(v);
+        task->op_elem   = std::move(op_elem);
+        task->op_reduce = std::move(op_reduce);
+        task->desc      = std::move(desc);
+        EXEC_OR_MAKE_TASK
+    }
+
     Status exec_v_count_mf(
             ref_ptr<Scalar>        r,
             ref_ptr<Vector>        v,
@@ -30,6 +30,8 @@
 #include <spla/timer.hpp>
 
 #include <core/logger.hpp>
+#include <core/tmatrix.hpp>
+#include <core/ttype.hpp>
 
 #include <algorithm>
 #include <cassert>
@@ -38,8 +40,11 @@
 #include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <limits>
 #include <numeric>
 #include <string>
+#include <thread>
+#include <type_traits>
 #include <utility>
 
 namespace spla {
@@ -378,4 +383,309 @@ namespace spla {
         return m_n_values;
     }
 
+    static std::uint64_t gen_next(std::uint64_t& state) {
+        // splitmix64: passes BigCrush and allows to start independent stream from any counter
+        std::uint64_t z = (state += 0x9e3779b97f4a7c15ull);
+        z               = (z ^ (z >> 30u)) * 0xbf58476d1ce4e5b9ull;
+        z               = (z ^ (z >> 27u)) * 0x94d049bb133111ebull;
+        return z ^ (z >> 31u);
+    }
+
+    static std::uint64_t gen_stream(std::uint64_t seed, std::uint64_t counter) {
+        std::uint64_t state = seed ^ (counter * 0xd1b54a32d192ed03ull);
+        return gen_next(state);
+    }
+
+    static double gen_uniform(std::uint64_t& state) {
+        return static_cast<double>(gen_next(state) >> 11u) * 0x1.0p-53;
+    }
+
+    static std::uint64_t gen_pack(uint i, uint j) {
+        return (std::uint64_t(i) << 32u) | std::uint64_t(j);
+    }
+
+    static std::size_t gen_n_workers(std::size_t count, uint n_threads) {
+        const std::size_t MIN_PER_THREAD = 1u << 16u;
+        const std::size_t n_hw           = std::max(1u, std::thread::hardware_concurrency());
+        const std::size_t n_max          = n_threads ? n_threads : n_hw;
+        return std::max<std::size_t>(1, std::min(n_max, count / MIN_PER_THREAD));
+    }
+
+    template<typename Function>
+    static void gen_workers(std::size_t n_workers, Function function) {
+        if (n_workers == 1) {
+            function(std::size_t(0));
+            return;
+        }
+
+        std::vector<std::thread> threads;
+
+        for (std::size_t t = 0; t < n_workers; t++) {
+            threads.emplace_back([=]() { function(t); });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    }
+
+    template<typename Function>
+    static void gen_parallel(std::size_t count, uint n_threads, Function function) {
+        const std::size_t n_used = gen_n_workers(count, n_threads);
+        const std::size_t chunk  = (count + n_used - 1) / n_used;
+
+        gen_workers(n_used, [=](std::size_t t) {
+            const std::size_t begin = std::min(count, t * chunk);
+            const std::size_t end   = std::min(count, begin + chunk);
+            function(begin, end);
+        });
+    }
+
+    static void gen_sort(std::vector<std::uint64_t>& edges, uint n_threads) {
+        const std::size_t count  = edges.size();
+        const std::size_t n_used = gen_n_workers(count, n_threads);
+        const std::size_t chunk  = (count + n_used - 1) / n_used;
+        const auto        first  = edges.begin();
+
+        auto bound = [=](std::size_t t) { return first + std::ptrdiff_t(std::min(count, std::min(t, n_used) * chunk)); };
+
+        // Sort chunks independently, then merge pairs of neighbour runs in log2(n_used) rounds
+        gen_workers(n_used, [&](std::size_t t) { std::sort(bound(t), bound(t + 1)); });
+
+        for (std::size_t width = 1; width < n_used; width *= 2) {
+            gen_workers((n_used + 2 * width - 1) / (2 * width), [&](std::size_t m) {
+                std::inplace_merge(bound(2 * width * m), bound(2 * width * m + width), bound(2 * width * (m + 1)));
+            });
+        }
+    }
+
+    template<typename T>
+    static T gen_weight(std::uint64_t seed, uint i, uint j, bool weighted) {
+        if (!weighted) {
+            return T(1);
+        }
+
+        const std::uint64_t h = gen_stream(seed ^ 0x2545f4914f6cdd1dull, gen_pack(std::min(i, j), std::max(i, j)));
+
+        if constexpr (std::is_floating_point_v<T>) {
+            return static_cast<T>(static_cast<double>((h >> 40u) + 1) * 0x1.0p-24);
+        } else {
+            return static_cast<T>(1 + h % 255);
+        }
+    }
+
+    template<typename T>
+    static Status gen_fill(const ref_ptr<Matrix>& M, const std::vector<uint>& Ai, const std::vector<uint>& Aj, uint n, std::uint64_t seed, bool weighted, uint n_threads) {
+        auto* t_M = dynamic_cast<TMatrix<T>*>(M.get());
+        assert(t_M);
+
+        M->clear();
+        t_M->validate_wd(FormatMatrix::CpuCsr);
+
+        auto*             csr      = t_M->template get<CpuCsr<T>>();
+        const std::size_t n_values = Ai.size();
+
+        cpu_csr_resize(n, uint(n_values), *csr);
+
+        // Rows are sorted, so offset of each row is found independently by binary search
+        gen_parallel(std::size_t(n) + 1, n_threads, [&](std::size_t begin, std::size_t end) {
+            for (std::size_t i = begin; i < end; i++) {
+                csr->Ap[i] = uint(std::lower_bound(Ai.begin(), Ai.end(), uint(i)) - Ai.begin());
+            }
+        });
+        gen_parallel(n_values, n_threads, [&](std::size_t begin, std::size_t end) {
+            for (std::size_t k = begin; k < end; k++) {
+                csr->Aj[k] = Aj[k];
+                csr->Ax[k] = gen_weight<T>(seed, Ai[k], Aj[k], weighted);
+            }
+        });
+
+        return Status::Ok;
+    }
+
+    GraphGenerator::GraphGenerator(std::uint64_t seed) : m_seed(seed) {
+    }
+
+    bool GraphGenerator::generate_rmat(uint scale, uint edge_factor, float a, float b, float c, bool make_undirected, bool remove_loops, bool permute) {
+        if (scale < 1 || scale > 31 || a < 0.0f || b < 0.0f || c < 0.0f || a + b + c > 1.0f) {
+            LOG_MSG(Status::InvalidArgument, "invalid r-mat params scale=" << scale << " a=" << a << " b=" << b << " c=" << c);
+            return false;
+        }
+
+        const uint          n       = uint(1) << scale;
+        const std::size_t   n_edges = std::size_t(edge_factor) << scale;
+        const std::uint64_t seed    = m_seed;
+        const double        ab      = double(a) + double(b);
+        const double        abc     = ab + double(c);
+
+        std::vector<uint> perm;
+
+        if (permute) {
+            // Fisher-Yates with own stream, so relabeling does not depend on edges
+            std::uint64_t state = seed ^ 0x8cb92ba72f3d8dd7ull;
+            perm.resize(n);
+            std::iota(perm.begin(), perm.end(), 0);
+            for (uint i = n - 1; i > 0; i--) {
+                std::swap(perm[i], perm[gen_next(state) % (std::uint64_t(i) + 1)]);
+            }
+        }
+
+        std::vector<std::uint64_t> edges(n_edges);
+
+        gen_parallel(n_edges, m_n_threads, [&](std::size_t begin, std::size_t end) {
+            for (std::size_t k = begin; k < end; k++) {
+                std::uint64_t state = gen_stream(seed, k);
+                uint          i     = 0;
+                uint          j     = 0;
+
+                for (uint level = 0; level < scale; level++) {
+                    const double r = gen_uniform(state);
+                    i              = (i << 1u) | uint(r >= ab);
+                    j              = (j << 1u) | uint((r >= a && r < ab) || r >= abc);
+                }
+
+                edges[k] = permute ? gen_pack(perm[i], perm[j]) : gen_pack(i, j);
+            }
+        });
+
+        finalize(edges, n, make_undirected, remove_loops);
+        return true;
+    }
+
+    bool GraphGenerator::generate_uniform(uint n_vertices, std::size_t n_edges, bool make_undirected, bool remove_loops) {
+        if (n_vertices == 0) {
+            LOG_MSG(Status::InvalidArgument, "graph must have vertices");
+            return false;
+        }
+
+        const std::uint64_t        seed = m_seed;
+        std::vector<std::uint64_t> edges(n_edges);
+
+        gen_parallel(n_edges, m_n_threads, [&](std::size_t begin, std::size_t end) {
+            for (std::size_t k = begin; k < end; k++) {
+                const std::uint64_t r = gen_stream(seed, k);
+                const auto          i = uint((std::uint64_t(r & 0xffffffffu) * n_vertices) >> 32u);
+                const auto          j = uint(((r >> 32u) * n_vertices) >> 32u);
+                edges[k]              = gen_pack(i, j);
+            }
+        });
+
+        finalize(edges, n_vertices, make_undirected, remove_loops);
+        return true;
+    }
+
+    bool GraphGenerator::generate_grid(uint dim_x, uint dim_y, uint dim_z) {
+        const std::uint64_t n = std::uint64_t(dim_x) * dim_y * dim_z;
+
+        if (n == 0 || n > std::numeric_limits<uint>::max()) {
+            LOG_MSG(Status::InvalidArgument, "invalid grid dims " << dim_x << "x" << dim_y << "x" << dim_z);
+            return false;
+        }
+
+        std::vector<std::uint64_t> edges;
+        edges.reserve(n * (dim_z > 1 ? 3 : 2));
+
+        for (uint z = 0; z < dim_z; z++) {
+            for (uint y = 0; y < dim_y; y++) {
+                for (uint x = 0; x < dim_x; x++) {
+                    const uint v = x + dim_x * (y + dim_y * z);
+                    if (x + 1 < dim_x) edges.push_back(gen_pack(v, v + 1));
+                    if (y + 1 < dim_y) edges.push_back(gen_pack(v, v + dim_x));
+                    if (z + 1 < dim_z) edges.push_back(gen_pack(v, v + dim_x * dim_y));
+                }
+            }
+        }
+
+        finalize(edges, uint(n), true, true);
+        return true;
+    }
+
+    void GraphGenerator::finalize(std::vector<std::uint64_t>& edges, uint n_vertices, bool make_undirected, bool remove_loops) {
+        if (make_undirected) {
+            const std::size_t n_directed = edges.size();
+            edges.resize(2 * n_directed);
+            gen_parallel(n_directed, m_n_threads, [&](std::size_t begin, std::size_t end) {
+                for (std::size_t k = begin; k < end; k++) {
+                    edges[n_directed + k] = (edges[k] << 32u) | (edges[k] >> 32u);
+                }
+            });
+        }
+
+        gen_sort(edges, m_n_threads);
+
+        // Loops and duplicates are dropped while splitting into Ai and Aj: each chunk counts
+        // kept edges, then writes them at its offset, so no compacted copy of edges is made
+        auto keep = [&](std::size_t k) {
+            const std::uint64_t e = edges[k];
+            return !(remove_loops && (e >> 32u) == (e & 0xffffffffu)) && (k == 0 || edges[k - 1] != e);
+        };
+
+        const std::size_t        count  = edges.size();
+        const std::size_t        n_used = gen_n_workers(count, m_n_threads);
+        const std::size_t        chunk  = (count + n_used - 1) / n_used;
+        std::vector<std::size_t> offsets(n_used + 1, 0);
+
+        gen_workers(n_used, [&](std::size_t t) {
+            const std::size_t end = std::min(count, (t + 1) * chunk);
+            for (std::size_t k = std::min(count, t * chunk); k < end; k++) {
+                offsets[t + 1] += keep(k);
+            }
+        });
+        for (std::size_t t = 0; t < n_used; t++) {
+            offsets[t + 1] += offsets[t];
+        }
+
+        m_n_vertices = n_vertices;
+        m_Ai.resize(offsets[n_used]);
+        m_Aj.resize(offsets[n_used]);
+
+        gen_workers(n_used, [&](std::size_t t) {
+            const std::size_t end = std::min(count, (t + 1) * chunk);
+            std::size_t       dst = offsets[t];
+            for (std::size_t k = std::min(count, t * chunk); k < end; k++) {
+                if (keep(k)) {
+                    m_Ai[dst] = uint(edges[k] >> 32u);
+                    m_Aj[dst] = uint(edges[k] & 0xffffffffu);
+                    dst += 1;
+                }
+            }
+        });
+    }
+
+    Status GraphGenerator::fill(const ref_ptr<Matrix>& M, bool weighted) const {
+        if (M.is_null() || M->get_n_rows() != m_n_vertices || M->get_n_cols() != m_n_vertices) {
+            LOG_MSG(Status::InvalidArgument, "matrix must be square of size " << m_n_vertices);
+            return Status::InvalidArgument;
+        }
+
+        const ref_ptr<Type> type = M->get_type();
+
+        if (type == INT) return gen_fill<T_INT>(M, m_Ai, m_Aj, m_n_vertices, m_seed, weighted, m_n_threads);
+        if (type == UINT) return gen_fill<T_UINT>(M, m_Ai, m_Aj, m_n_vertices, m_seed, weighted, m_n_threads);
+        if (type == FLOAT) return gen_fill<T_FLOAT>(M, m_Ai, m_Aj, m_n_vertices, m_seed, weighted, m_n_threads);
+
+        LOG_MSG(Status::InvalidArgument, "not supported matrix type " << type->get_name());
+        return Status::InvalidArgument;
+    }
+
+    void GraphGenerator::set_n_threads(uint n_threads) {
+        m_n_threads = n_threads;
+    }
+
+    const std::vector<uint>& GraphGenerator::get_Ai() const {
+        return m_Ai;
+    }
+    const std::vector<uint>& GraphGenerator::get_Aj() const {
+        return m_Aj;
+    }
+
+    uint GraphGenerator::get_n_rows() const {
+        return m_n_vertices;
+    }
+    uint GraphGenerator::get_n_cols() const {
+        return m_n_vertices;
+    }
+    std::size_t GraphGenerator::get_n_values() const {
+        return m_Ai.size();
+    }
+
 }// namespace spla
\ No newline at end of file
@@ -29,12 +29,15 @@
 
 #include <core/accelerator.hpp>
 #include <core/dispatcher.hpp>
+#include <core/lazy_planner.hpp>
 #include <core/logger.hpp>
 #include <core/registry.hpp>
 #include <core/top.hpp>
 
 #include <cpu/cpu_algo_registry.hpp>
 
+#include <fstream>
+#include <sstream>
 #include <iostream>
 
 #if defined(SPLA_BUILD_OPENCL)
@@ -42,6 +45,8 @@
     #include <opencl/cl_algo_registry.hpp>
 #endif
 
+#include <profiling/dispatch_tracer.hpp>
+#include <profiling/perf_counters.hpp>
 #include <profiling/time_profiler.hpp>
 
 namespace spla {
@@ -74,6 +79,8 @@ namespace spla {
         m_registry = std::make_unique<Registry>();
         // Setup dispatcher (always available)
         m_dispatcher = std::make_unique<Dispatcher>();
+        // Setup lazy planner (always available, used only in lazy mode)
+        m_lazy_planner = std::make_unique<LazyPlanner>();
 
         // Register build-in bin ops (id's done here, since registration depend on types)
         register_ops();
@@ -86,9 +93,12 @@ namespace spla {
         register_algo_cl(m_registry.get());
 #endif
 
-#ifndef SPLA_RELEASE
-        // Setup profiler (do not have only in release builds)
+        // Setup profiler (always available, enabled by default only in debug builds)
         m_time_profiler = std::make_unique<TimeProfiler>();
+        // Setup dispatch trace recorder (always available, disabled by default)
+        m_dispatch_tracer = std::make_unique<DispatchTracer>();
+#ifndef SPLA_RELEASE
+        m_time_profiler->set_enabled(true);
 #endif
     }
 
@@ -97,6 +107,8 @@ namespace spla {
     void Library::finalize() {
         LOG_MSG(Status::Ok, "finalize library state");
 
+        m_lazy_planner->sync_all();
+
         if (m_accelerator) {
             LOG_MSG(Status::Ok, "release accelerator: " << m_accelerator->get_name());
             m_accelerator.reset();
@@ -137,6 +149,22 @@ namespace spla {
         return m_accelerator ? m_accelerator->set_queues_count(count) : Status::NoAcceleration;
     }
 
+    Status Library::set_program_cache(const std::string& dir, std::size_t max_size) {
+        return m_accelerator ? m_accelerator->set_program_cache(dir, max_size) : Status::NoAcceleration;
+    }
+
+    Status Library::set_precompile(bool value) {
+        return m_accelerator ? m_accelerator->set_precompile(value) : Status::NoAcceleration;
+    }
+
+    Status Library::set_mem_cache_limit(std::size_t bytes) {
+        return m_accelerator ? m_accelerator->set_mem_cache_limit(bytes) : Status::NoAcceleration;
+    }
+
+    Status Library::get_mem_stats(std::size_t& bytes_live, std::size_t& bytes_cached, double& hit_rate) {
+        return m_accelerator ? m_accelerator->get_mem_stats(bytes_live, bytes_cached, hit_rate) : Status::NoAcceleration;
+    }
+
     Status Library::set_message_callback(MessageCallback callback) {
         m_logger->set_msg_callback(std::move(callback));
         LOG_MSG(Status::Ok, "set new message callback");
@@ -172,6 +200,20 @@ namespace spla {
         return m_force_no_acc;
     }
 
+    Status Library::set_lazy_execution(bool value) {
+        LOG_MSG(Status::Ok, "lazy execution: " << value);
+        m_lazy = value;
+        return value ? Status::Ok : m_lazy_planner->sync_all();
+    }
+
+    bool Library::is_set_lazy_execution() {
+        return m_lazy;
+    }
+
+    Status Library::wait() {
+        return m_lazy_planner->sync_all();
+    }
+
     Status Library::get_accelerator_info(std::string& info) {
         if (!m_accelerator) {
             return Status::NoAcceleration;
@@ -180,17 +222,73 @@ namespace spla {
         return Status::Ok;
     }
 
+    Status Library::time_profile_enable(bool value) {
+        LOG_MSG(Status::Ok, "time profile: " << value);
+        m_time_profiler->set_enabled(value);
+        return Status::Ok;
+    }
+
+    bool Library::is_set_time_profile() {
+        return m_time_profiler->is_enabled();
+    }
+
+    Status Library::time_profile_enable_counters(bool value) {
+        if (value && !PerfCounterGroup().is_available()) {
+            LOG_MSG(Status::Ok, "hardware counters are not available, profile only durations");
+        }
+
+        LOG_MSG(Status::Ok, "time profile counters: " << value);
+        m_time_profiler->set_counters_enabled(value);
+        return Status::Ok;
+    }
+
+    bool Library::is_set_time_profile_counters() {
+        return m_time_profiler->is_counters_enabled();
+    }
+
     Status Library::time_profile_dump() {
-#ifndef SPLA_RELEASE
         m_time_profiler->dump(std::cout);
-#endif
         return Status::Ok;
     }
 
     Status Library::time_profile_reset() {
-#ifndef SPLA_RELEASE
         m_time_profiler->reset();
-#endif
+        return Status::Ok;
+    }
+
+    Status Library::time_profile_export_trace(const std::string& file_path) {
+        std::ofstream file(file_path);
+
+        if (!file.is_open()) {
+            LOG_MSG(Status::InvalidArgument, "failed to open file " << file_path);
+            return Status::InvalidArgument;
+        }
+
+        m_time_profiler->export_trace(file);
+        return Status::Ok;
+    }
+
+    Status Library::dispatch_trace_enable(bool value) {
+        LOG_MSG(Status::Ok, "dispatch trace: " << value);
+        m_dispatch_tracer->set_enabled(value);
+        return Status::Ok;
+    }
+
+    Status Library::dispatch_trace_drain_json(std::string& json) {
+        std::vector<DispatchTraceEvent> events;
+        std::stringstream               stream;
+        m_dispatch_tracer->drain(events);
+        DispatchTracer::write_json(events, stream);
+        json = stream.str();
+        return Status::Ok;
+    }
+
+    Status Library::dispatch_trace_drain_csv(std::string& csv) {
+        std::vector<DispatchTraceEvent> events;
+        std::stringstream               stream;
+        m_dispatch_tracer->drain(events);
+        DispatchTracer::write_csv(events, stream);
+        csv = stream.str();
         return Status::Ok;
     }
 
@@ -214,6 +312,14 @@ namespace spla {
         return m_time_profiler.get();
     }
 
+    class DispatchTracer* Library::get_dispatch_tracer() {
+        return m_dispatch_tracer.get();
+    }
+
+    class LazyPlanner* Library::get_lazy_planner() {
+        return m_lazy_planner.get();
+    }
+
     Library* Library::get() {
         static std::unique_ptr<Library> g_library;
 
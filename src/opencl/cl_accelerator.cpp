@@ -27,17 +27,23 @@
 
 #include "cl_accelerator.hpp"
 
-#include <opencl/cl_alloc_general.hpp>
-#include <opencl/cl_alloc_linear.hpp>
+#include <opencl/cl_alloc_pool.hpp>
 #include <opencl/cl_counter.hpp>
 #include <opencl/cl_program_cache.hpp>
+#include <opencl/cl_program_disk_cache.hpp>
+#include <opencl/cl_program_precompiler.hpp>
 
+#include <cstdlib>
+#include <cstring>
 #include <sstream>
 
 namespace spla {
 
-    CLAccelerator::CLAccelerator()  = default;
-    CLAccelerator::~CLAccelerator() = default;
+    CLAccelerator::CLAccelerator() = default;
+    CLAccelerator::~CLAccelerator() {
+        // Background builds use context and cache, so must be finished before those released
+        m_precompiler.reset();
+    }
 
     Status CLAccelerator::init() {
         m_description = "no platform or device";
@@ -53,6 +59,15 @@ namespace spla {
 
         m_cache = std::make_unique<CLProgramCache>();
 
+        // Persistent cache of binaries is opt-in, so processes sharing a machine may share compiled programs
+        if (const char* cache_dir = std::getenv("SPLA_CL_CACHE_DIR")) {
+            set_program_cache(cache_dir, CLProgramDiskCache::DEFAULT_MAX_SIZE);
+        }
+
+        if (const char* precompile = std::getenv("SPLA_CL_PRECOMPILE")) {
+            if (std::strcmp(precompile, "1") == 0) set_precompile(true);
+        }
+
         // Output handy info
         LOG_MSG(Status::Ok, "Initialize accelerator: " << get_description());
 
@@ -71,10 +86,9 @@ namespace spla {
             return Status::InvalidArgument;
         }
 
+        m_precompiler.reset();
         m_counter_pool.reset();
-        m_alloc_general.reset();
-        m_alloc_linear.reset();
-        m_alloc_tmp = nullptr;
+        m_alloc_pool.reset();
         m_device    = cl::Device();
         m_platform  = available_platforms[index];
         LOG_MSG(Status::Ok, "select OpenCL platform " << m_platform.getInfo<CL_PLATFORM_NAME>());
@@ -94,6 +108,7 @@ namespace spla {
             return Status::DeviceNotFound;
         }
 
+        m_precompiler.reset();
         m_device = available_devices[index];
         LOG_MSG(Status::Ok, "select OpenCL device " << m_device.getInfo<CL_DEVICE_NAME>());
 
@@ -105,6 +120,9 @@ namespace spla {
         m_max_local_mem = m_device.getInfo<CL_DEVICE_LOCAL_MEM_SIZE>();
         m_addr_align    = m_device.getInfo<CL_DEVICE_MEM_BASE_ADDR_ALIGN>() / 8;// from bits to bytes
 
+        // Deprecated since 2.0, but still reported by cpu and integrated devices runtimes
+        m_is_unified_memory = m_device.getInfo<CL_DEVICE_HOST_UNIFIED_MEMORY>();
+
         m_is_nvidia = false;
         m_is_amd    = false;
         m_is_intel  = false;
@@ -155,40 +173,240 @@ namespace spla {
              << " vendor:" << m_vendor_code
              << " mcu:" << m_max_cu
              << " wave:" << m_wave_size
-             << " mwgs:" << m_max_wgs;
+             << " mwgs:" << m_max_wgs
+             << " unified:" << m_is_unified_memory;
 
         m_description = desc.str();
 
+        // Binaries are valid only for exactly the same device and driver, so all of those are in cache keys
+        std::stringstream identity;
+        identity << m_platform.getInfo<CL_PLATFORM_NAME>() << "|"
+                 << m_platform.getInfo<CL_PLATFORM_VERSION>() << "|"
+                 << m_device.getInfo<CL_DEVICE_NAME>() << "|"
+                 << m_device.getInfo<CL_DEVICE_VERSION>() << "|"
+                 << m_device.getInfo<CL_DRIVER_VERSION>() << "|"
+                 << m_vendor_id;
+
+        m_device_identity = identity.str();
+
         LOG_MSG(Status::Ok, m_description);
 
         return Status::Ok;
     }
     Status CLAccelerator::set_queues_count(int count) {
+        if (count < 1) {
+            LOG_MSG(Status::InvalidArgument, "at least one queue required for computations");
+            return Status::InvalidArgument;
+        }
+
+        m_precompiler.reset();
         m_context = cl::Context(m_device);
         m_queues.clear();
         m_queues.reserve(count);
 
-        for (int i = 0; i < count; i++) {
-            cl_command_queue_properties properties = 0;
+        cl_command_queue_properties properties = 0;
 #ifndef SPLA_RELEASE
-            properties = CL_QUEUE_PROFILING_ENABLE;
+        properties = CL_QUEUE_PROFILING_ENABLE;
 #endif
+
+        for (int i = 0; i < count; i++) {
             cl::CommandQueue queue(m_context, properties);
             m_queues.emplace_back(std::move(queue));
         }
 
-        m_counter_pool  = std::make_unique<CLCounterPool>();
-        m_alloc_general = std::make_unique<CLAllocGeneral>();
-        m_alloc_tmp     = m_alloc_general.get();
+        m_queue_copy = cl::CommandQueue(m_context, properties);
+        m_queue_used.assign(count, false);
+        m_queue_id = 0;
+        m_uploads.clear();
+        m_arg_events.clear();
+
+        // Decorations of unified memory devices are mapped to host instead of copied
+        cl_mem_flags pool_flags = CL_MEM_READ_WRITE;
+        if (m_is_unified_memory) pool_flags |= CL_MEM_ALLOC_HOST_PTR;
+
+        m_counter_pool = std::make_unique<CLCounterPool>();
+        m_alloc_pool   = std::make_unique<CLAllocPool>(m_addr_align, pool_flags, m_mem_cache_limit);
+
+        LOG_MSG(Status::Ok, "configure " << count << " queues for computations and one for transfers");
+        return Status::Ok;
+    }
+    Status CLAccelerator::set_program_cache(const std::string& dir, std::size_t max_size) {
+        if (dir.empty()) {
+            m_disk_cache.reset();
+            LOG_MSG(Status::Ok, "disable program disk cache");
+            return Status::Ok;
+        }
 
-        if (!is_nvidia()) {
-            m_alloc_linear = std::make_unique<CLAllocLinear>(CLAllocLinear::DEFAULT_SIZE, m_addr_align);
-            m_alloc_tmp    = m_alloc_linear.get();
+        m_disk_cache = std::make_unique<CLProgramDiskCache>(dir, max_size);
+        LOG_MSG(Status::Ok, "set program disk cache " << dir << " max size " << max_size << " bytes");
+        return Status::Ok;
+    }
+    Status CLAccelerator::set_precompile(bool value) {
+        if (!value) {
+            m_precompiler.reset();
+            return Status::Ok;
+        }
+        if (!m_cache) {
+            LOG_MSG(Status::InvalidState, "accelerator is not initialized to precompile programs");
+            return Status::InvalidState;
         }
+        if (!m_precompiler) {
+            m_precompiler = std::make_unique<CLProgramPrecompiler>();
+            m_precompiler->start();
+            LOG_MSG(Status::Ok, "start background programs precompilation");
+        }
+        return Status::Ok;
+    }
+    Status CLAccelerator::set_mem_cache_limit(std::size_t bytes) {
+        m_mem_cache_limit = bytes;
+        if (m_alloc_pool) m_alloc_pool->set_high_water_mark(bytes);
+        LOG_MSG(Status::Ok, "set device memory cache limit " << bytes << " bytes");
+        return Status::Ok;
+    }
+    Status CLAccelerator::get_mem_stats(std::size_t& bytes_live, std::size_t& bytes_cached, double& hit_rate) {
+        if (!m_alloc_pool) return Status::InvalidState;
 
-        LOG_MSG(Status::Ok, "configure " << count << " queues for computations");
+        const CLAllocPool::Stats stats = m_alloc_pool->get_stats();
+        bytes_live                     = stats.bytes_live;
+        bytes_cached                   = stats.bytes_cached;
+        hit_rate                       = stats.hit_rate();
         return Status::Ok;
     }
+    void CLAccelerator::begin_task(const ref_ptr<ScheduleTask>& task, int queue_id) {
+        m_in_task  = true;
+        m_queue_id = queue_id % static_cast<int>(m_queues.size());
+
+        if (m_queues.size() == 1) return;
+
+        m_queue_used[m_queue_id] = true;
+
+        // Task depends on previous tasks of the step which share any argument with it,
+        // so it waits for them if those were run on other queues
+        std::vector<cl::Event> wait_list;
+
+        for (const auto& arg : task->get_args()) {
+            auto query = m_arg_events.find(arg.get());
+            if (query != m_arg_events.end() && query->second.queue_id != m_queue_id) {
+                wait_list.push_back(query->second.event);
+            }
+        }
+
+        if (!wait_list.empty()) {
+            m_queues[m_queue_id].enqueueBarrierWithWaitList(&wait_list);
+        }
+    }
+    void CLAccelerator::end_task(const ref_ptr<ScheduleTask>& task) {
+        // Uploads are ordered before the task end marker, even if task has not used the queue since
+        if (!m_uploads.empty()) {
+            get_queue_compute();
+        }
+
+        if (m_queues.size() > 1) {
+            cl::Event marker;
+            m_queues[m_queue_id].enqueueMarkerWithWaitList(nullptr, &marker);
+
+            for (const auto& arg : task->get_args()) {
+                m_arg_events[arg.get()] = ArgEvent{m_queue_id, marker};
+            }
+        }
+
+        m_in_task  = false;
+        m_queue_id = 0;
+    }
+    void CLAccelerator::join_tasks() {
+        m_arg_events.clear();
+
+        if (m_queues.size() == 1) return;
+
+        std::vector<cl::Event> markers;
+
+        for (std::size_t i = 0; i < m_queues.size(); i++) {
+            if (m_queue_used[i]) {
+                markers.emplace_back();
+                m_queues[i].enqueueMarkerWithWaitList(nullptr, &markers.back());
+            }
+        }
+
+        // Work of the step on secondary queues goes before anything enqueued after on any queue
+        if (markers.empty()) return;
+
+        markers.emplace_back();
+        m_queues.front().enqueueMarkerWithWaitList(nullptr, &markers.back());
+
+        for (auto& queue : m_queues) {
+            queue.enqueueBarrierWithWaitList(&markers);
+        }
+
+        m_queue_used.assign(m_queues.size(), false);
+    }
+    cl::CommandQueue& CLAccelerator::get_queue_compute() {
+        auto& queue = m_queues[m_queue_id];
+
+        if (!m_uploads.empty()) {
+            queue.enqueueBarrierWithWaitList(&m_uploads);
+            m_uploads.clear();
+        }
+
+        return queue;
+    }
+    cl::CommandQueue& CLAccelerator::get_queue_copy() {
+        // Reads of results must go after all computations enqueued so far
+        std::vector<cl::Event> markers(m_queues.size());
+
+        for (std::size_t i = 0; i < m_queues.size(); i++) {
+            m_queues[i].enqueueMarkerWithWaitList(nullptr, &markers[i]);
+        }
+
+        m_queue_copy.enqueueBarrierWithWaitList(&markers);
+        return m_queue_copy;
+    }
+    void CLAccelerator::upload(const cl::Buffer& buffer, std::size_t size, const void* data) {
+        if (size == 0) return;
+
+        cl::Event event;
+
+        if (m_is_unified_memory) {
+            // Buffer is host memory already, so data is written in place without device copy
+            void* mapped = m_queue_copy.enqueueMapBuffer(buffer, true, CL_MAP_WRITE_INVALIDATE_REGION, 0, size);
+            std::memcpy(mapped, data, size);
+            m_queue_copy.enqueueUnmapMemObject(buffer, mapped, nullptr, &event);
+        } else {
+            // Data is copied to pinned staging on creation, so host is free of it before device copy is done
+            const auto flags = CL_MEM_READ_ONLY | CL_MEM_HOST_NO_ACCESS | CL_MEM_ALLOC_HOST_PTR | CL_MEM_COPY_HOST_PTR;
+            cl::Buffer staging(m_context, flags, size, const_cast<void*>(data));
+            m_queue_copy.enqueueCopyBuffer(staging, buffer, 0, 0, size, nullptr, &event);
+        }
+
+        // Outside of task the next user of buffer may be on any queue
+        if (!m_in_task) {
+            event.wait();
+            return;
+        }
+
+        m_uploads.push_back(std::move(event));
+    }
+    void CLAccelerator::download(const cl::Buffer& buffer, std::size_t size, void* data, bool blocking) {
+        cl::CommandQueue& queue = get_queue_copy();
+
+        // Previous non-blocking downloads must be complete on return anyway
+        if (size == 0) {
+            if (blocking) queue.finish();
+            return;
+        }
+
+        if (m_is_unified_memory) {
+            // Mapping of host allocated buffer is free, so data is copied once by host
+            void* mapped = queue.enqueueMapBuffer(buffer, true, CL_MAP_READ, 0, size);
+            std::memcpy(data, mapped, size);
+            queue.enqueueUnmapMemObject(buffer, mapped);
+            return;
+        }
+
+        const auto flags = CL_MEM_READ_ONLY | CL_MEM_HOST_READ_ONLY | CL_MEM_ALLOC_HOST_PTR;
+        cl::Buffer staging(m_context, flags, size);
+        queue.enqueueCopyBuffer(buffer, staging, 0, 0, size);
+        queue.enqueueReadBuffer(staging, blocking, 0, size, data);
+    }
     const std::string& CLAccelerator::get_name() {
         return m_name;
     }
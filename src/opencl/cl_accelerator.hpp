@@ -34,6 +34,7 @@
 #include <spla/library.hpp>
 
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include <svector.hpp>
@@ -70,19 +71,31 @@ namespace spla {
         Status             set_platform(int index) override;
         Status             set_device(int index) override;
         Status             set_queues_count(int count) override;
+        Status             set_program_cache(const std::string& dir, std::size_t max_size) override;
+        Status             set_precompile(bool value) override;
+        Status             set_mem_cache_limit(std::size_t bytes) override;
+        Status             get_mem_stats(std::size_t& bytes_live, std::size_t& bytes_cached, double& hit_rate) override;
+        void               begin_task(const ref_ptr<ScheduleTask>& task, int queue_id) override;
+        void               end_task(const ref_ptr<ScheduleTask>& task) override;
+        void               join_tasks() override;
         const std::string& get_name() override;
         const std::string& get_description() override;
         const std::string& get_suffix() override;
 
-        cl::Platform&         get_platform() { return m_platform; }
-        cl::Device&           get_device() { return m_device; }
-        cl::Context&          get_context() { return m_context; }
-        cl::CommandQueue&     get_queue_default() { return m_queues.front(); }
-        class CLProgramCache* get_cache() { return m_cache.get(); }
-        class CLCounterPool*  get_counter_pool() { return m_counter_pool.get(); }
-        class CLAllocGeneral* get_alloc_general() { return m_alloc_general.get(); }
-        class CLAlloc*        get_alloc_tmp() { return m_alloc_tmp; }
+        cl::Platform&             get_platform() { return m_platform; }
+        cl::Device&               get_device() { return m_device; }
+        cl::Context&              get_context() { return m_context; }
+        cl::CommandQueue&         get_queue_compute();
+        cl::CommandQueue&         get_queue_copy();
+        class CLProgramCache*     get_cache() { return m_cache.get(); }
+        class CLProgramDiskCache* get_disk_cache() { return m_disk_cache.get(); }
+        class CLCounterPool*      get_counter_pool() { return m_counter_pool.get(); }
+        class CLAllocPool*        get_alloc_pool() { return m_alloc_pool.get(); }
 
+        void upload(const cl::Buffer& buffer, std::size_t size, const void* data);
+        void download(const cl::Buffer& buffer, std::size_t size, void* data, bool blocking = true);
+
+        [[nodiscard]] const std::string& get_device_identity() const { return m_device_identity; }
         [[nodiscard]] const std::string& get_vendor_name() const { return m_vendor_name; }
         [[nodiscard]] const std::string& get_vendor_code() const { return m_vendor_code; }
         [[nodiscard]] uint               get_vendor_id() const { return m_vendor_id; }
@@ -96,35 +109,51 @@ namespace spla {
         [[nodiscard]] bool               is_nvidia() const { return m_is_nvidia; }
         [[nodiscard]] bool               is_amd() const { return m_is_amd; }
         [[nodiscard]] bool               is_intel() const { return m_is_intel; }
+        [[nodiscard]] bool               is_unified_memory() const { return m_is_unified_memory; }
 
     private:
-        cl::Platform                          m_platform;
-        cl::Device                            m_device;
-        cl::Context                           m_context;
-        std::unique_ptr<class CLProgramCache> m_cache;
-        std::unique_ptr<class CLCounterPool>  m_counter_pool;
-        std::unique_ptr<class CLAllocLinear>  m_alloc_linear;
-        std::unique_ptr<class CLAllocGeneral> m_alloc_general;
-        class CLAlloc*                        m_alloc_tmp = nullptr;
+        cl::Platform                                      m_platform;
+        cl::Device                                        m_device;
+        cl::Context                                       m_context;
+        std::unique_ptr<class CLProgramCache>             m_cache;
+        std::unique_ptr<class CLProgramDiskCache>         m_disk_cache;
+        std::unique_ptr<class CLProgramPrecompiler>       m_precompiler;
+        std::unique_ptr<class CLCounterPool>              m_counter_pool;
+        std::unique_ptr<class CLAllocPool>                m_alloc_pool;
 
         std::string m_name = "OpenCL";
         std::string m_description;
+        std::string m_device_identity;
         std::string m_suffix = "__cl";
         std::string m_vendor_name;
         std::string m_vendor_code;
-        uint        m_vendor_id        = 0;
-        uint        m_max_cu           = 0;
-        uint        m_max_wgs          = 0;
-        uint        m_max_local_mem    = 0;
-        uint        m_addr_align       = 128;
-        uint        m_default_wgs      = 64;
-        uint        m_wave_size        = 32;
-        uint        m_num_of_mem_banks = 32;
-        bool        m_is_nvidia        = false;
-        bool        m_is_amd           = false;
-        bool        m_is_intel         = false;
-
-        ankerl::svector<cl::CommandQueue, 2> m_queues;
+        std::size_t m_mem_cache_limit   = 256 * 1024 * 1024;
+        uint        m_vendor_id         = 0;
+        uint        m_max_cu            = 0;
+        uint        m_max_wgs           = 0;
+        uint        m_max_local_mem     = 0;
+        uint        m_addr_align        = 128;
+        uint        m_default_wgs       = 64;
+        uint        m_wave_size         = 32;
+        uint        m_num_of_mem_banks  = 32;
+        bool        m_is_nvidia         = false;
+        bool        m_is_amd            = false;
+        bool        m_is_intel          = false;
+        bool        m_is_unified_memory = false;
+
+        /** Last task event of an object argument, used to order tasks on different queues */
+        struct ArgEvent {
+            int       queue_id = 0;
+            cl::Event event;
+        };
+
+        ankerl::svector<cl::CommandQueue, 2>        m_queues;
+        cl::CommandQueue                            m_queue_copy;
+        std::vector<cl::Event>                      m_uploads;
+        std::unordered_map<const Object*, ArgEvent> m_arg_events;
+        std::vector<bool>                           m_queue_used;
+        int                                         m_queue_id = 0;
+        bool                                        m_in_task  = false;
     };
 
     /**
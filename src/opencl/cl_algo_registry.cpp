@@ -31,12 +31,15 @@
 #include <core/top.hpp>
 
 #include <opencl/cl_m_reduce.hpp>
+#include <opencl/cl_m_tril.hpp>
 #include <opencl/cl_mxmT_masked.hpp>
 #include <opencl/cl_mxv.hpp>
 #include <opencl/cl_v_assign.hpp>
 #include <opencl/cl_v_count_mf.hpp>
 #include <opencl/cl_v_eadd.hpp>
 #include <opencl/cl_v_eadd_fdb.hpp>
+#include <opencl/cl_v_eadd_reduce.hpp>
+#include <opencl/cl_v_emult.hpp>
 #include <opencl/cl_v_map.hpp>
 #include <opencl/cl_v_reduce.hpp>
 #include <opencl/cl_vxm.hpp>
@@ -64,11 +67,21 @@ namespace spla {
         g_registry->add(MAKE_KEY_CL_0("v_eadd", UINT), std::make_shared<Algo_v_eadd_cl<T_UINT>>());
         g_registry->add(MAKE_KEY_CL_0("v_eadd", FLOAT), std::make_shared<Algo_v_eadd_cl<T_FLOAT>>());
 
+        // algorthm v_emult
+        g_registry->add(MAKE_KEY_CL_0("v_emult", INT), std::make_shared<Algo_v_emult_cl<T_INT>>());
+        g_registry->add(MAKE_KEY_CL_0("v_emult", UINT), std::make_shared<Algo_v_emult_cl<T_UINT>>());
+        g_registry->add(MAKE_KEY_CL_0("v_emult", FLOAT), std::make_shared<Algo_v_emult_cl<T_FLOAT>>());
+
         // algorthm v_eadd_fdb
         g_registry->add(MAKE_KEY_CL_0("v_eadd_fdb", INT), std::make_shared<Algo_v_eadd_fdb_cl<T_INT>>());
         g_registry->add(MAKE_KEY_CL_0("v_eadd_fdb", UINT), std::make_shared<Algo_v_eadd_fdb_cl<T_UINT>>());
         g_registry->add(MAKE_KEY_CL_0("v_eadd_fdb", FLOAT), std::make_shared<Algo_v_eadd_fdb_cl<T_FLOAT>>());
 
+        // algorthm v_eadd_reduce
+        g_registry->add(MAKE_KEY_CL_0("v_eadd_reduce", INT), std::make_shared<Algo_v_eadd_reduce_cl<T_INT>>());
+        g_registry->add(MAKE_KEY_CL_0("v_eadd_reduce", UINT), std::make_shared<Algo_v_eadd_reduce_cl<T_UINT>>());
+        g_registry->add(MAKE_KEY_CL_0("v_eadd_reduce", FLOAT), std::make_shared<Algo_v_eadd_reduce_cl<T_FLOAT>>());
+
         // algorthm v_assign_masked
         g_registry->add(MAKE_KEY_CL_0("v_assign_masked", INT), std::make_shared<Algo_v_assign_masked_cl<T_INT>>());
         g_registry->add(MAKE_KEY_CL_0("v_assign_masked", UINT), std::make_shared<Algo_v_assign_masked_cl<T_UINT>>());
@@ -79,6 +92,11 @@ namespace spla {
         g_registry->add(MAKE_KEY_CL_0("m_reduce", UINT), std::make_shared<Algo_m_reduce_cl<T_UINT>>());
         g_registry->add(MAKE_KEY_CL_0("m_reduce", FLOAT), std::make_shared<Algo_m_reduce_cl<T_FLOAT>>());
 
+        // algorthm m_tril
+        g_registry->add(MAKE_KEY_CL_0("m_tril", INT), std::make_shared<Algo_m_tril_cl<T_INT>>());
+        g_registry->add(MAKE_KEY_CL_0("m_tril", UINT), std::make_shared<Algo_m_tril_cl<T_UINT>>());
+        g_registry->add(MAKE_KEY_CL_0("m_tril", FLOAT), std::make_shared<Algo_m_tril_cl<T_FLOAT>>());
+
         // algorthm mxv_masked
         g_registry->add(MAKE_KEY_CL_0("mxv_masked", INT), std::make_shared<Algo_mxv_masked_cl<T_INT>>());
         g_registry->add(MAKE_KEY_CL_0("mxv_masked", UINT), std::make_shared<Algo_mxv_masked_cl<T_UINT>>());
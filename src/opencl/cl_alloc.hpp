@@ -40,7 +40,6 @@ namespace spla {
     public:
         virtual ~CLAlloc()                         = default;
         virtual cl::Buffer alloc(std::size_t size) = 0;
-        virtual void       free(cl::Buffer buffer) = 0;
         virtual void       free_all()              = 0;
     };
 
@@ -0,0 +1,197 @@
+/**********************************************************************************/
+/* This file is part of spla project                                              */
+/* https://github.com/SparseLinearAlgebra/spla                                    */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2023 SparseLinearAlgebra                                         */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#include "cl_alloc_pool.hpp"
+
+#include <core/logger.hpp>
+
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace spla {
+
+    static constexpr int CL_ALLOC_POOL_CLASSES_COUNT = 48;
+
+    static int cl_alloc_pool_class(std::size_t size) {
+        int size_class = 0;
+        while ((CLAllocPool::MIN_BLOCK_SIZE << size_class) < size) size_class += 1;
+        return size_class;
+    }
+
+    static std::size_t cl_alloc_pool_class_size(int size_class) {
+        return CLAllocPool::MIN_BLOCK_SIZE << size_class;
+    }
+
+    struct CLAllocPool::State {
+        mutable std::mutex                   mutex;
+        std::vector<std::vector<cl::Buffer>> free_lists{CL_ALLOC_POOL_CLASSES_COUNT};
+        Stats                                stats;
+        std::size_t                          high_water_mark = DEFAULT_HIGH_WATER_MARK;
+        bool                                 closed          = false;
+
+        // Called from driver callback thread
+        void release(int size_class, cl::Buffer& buffer, bool reusable) {
+            std::lock_guard<std::mutex> lock(mutex);
+
+            const std::size_t size = cl_alloc_pool_class_size(size_class);
+            stats.bytes_live -= size;
+
+            if (!closed && reusable && buffer()) {
+                free_lists[size_class].push_back(std::move(buffer));
+                stats.bytes_cached += size;
+            }
+        }
+
+        // Blocks to release are returned, so driver is called outside of lock
+        void trim(std::size_t limit, std::vector<cl::Buffer>& released) {
+            for (int size_class = CL_ALLOC_POOL_CLASSES_COUNT - 1; size_class >= 0 && stats.bytes_cached > limit; size_class--) {
+                auto& free_list = free_lists[size_class];
+
+                while (!free_list.empty() && stats.bytes_cached > limit) {
+                    released.push_back(std::move(free_list.back()));
+                    free_list.pop_back();
+                    stats.bytes_cached -= cl_alloc_pool_class_size(size_class);
+                }
+            }
+        }
+    };
+
+    struct CLAllocPool::Block {
+        std::shared_ptr<State> state;
+        cl::Buffer             buffer;
+        int                    size_class = 0;
+        bool                   reusable   = true;
+
+        ~Block() { state->release(size_class, buffer, reusable); }
+    };
+
+    CLAllocPool::CLAllocPool(std::size_t alignment, cl_mem_flags flags, std::size_t high_water_mark) {
+        m_state                  = std::make_shared<State>();
+        m_state->high_water_mark = high_water_mark;
+        m_alignment              = alignment;
+        m_flags                  = flags;
+    }
+
+    CLAllocPool::~CLAllocPool() {
+        std::vector<cl::Buffer> released;
+        Stats                   stats;
+
+        {
+            std::lock_guard<std::mutex> lock(m_state->mutex);
+            m_state->closed = true;
+            m_state->trim(0, released);
+            stats = m_state->stats;
+        }
+
+        LOG_MSG(Status::Ok, "release pool: live " << stats.bytes_live << " bytes, hits " << stats.n_hits << " misses " << stats.n_misses << " hit rate " << stats.hit_rate());
+    }
+
+    cl::Buffer CLAllocPool::alloc(std::size_t size) {
+        return make_sub_buffer(acquire(size), 0, size);
+    }
+    void CLAllocPool::alloc_paired(std::size_t size1, std::size_t size2, cl::Buffer& buffer1, cl::Buffer& buffer2) {
+        if (get_acc_cl()->is_nvidia()) {
+            buffer1 = alloc(size1);
+            buffer2 = alloc(size2);
+            return;
+        }
+
+        const std::size_t offset = aligns(size1, m_alignment);
+        auto              block  = acquire(offset + size2);
+
+        buffer1 = make_sub_buffer(block, 0, size1);
+        buffer2 = make_sub_buffer(block, offset, size2);
+    }
+    void CLAllocPool::free_all() {
+        std::vector<cl::Buffer> released;
+        std::lock_guard<std::mutex> lock(m_state->mutex);
+        m_state->trim(0, released);
+    }
+
+    void CLAllocPool::set_high_water_mark(std::size_t high_water_mark) {
+        std::lock_guard<std::mutex> lock(m_state->mutex);
+        m_state->high_water_mark = high_water_mark;
+    }
+    CLAllocPool::Stats CLAllocPool::get_stats() const {
+        std::lock_guard<std::mutex> lock(m_state->mutex);
+        return m_state->stats;
+    }
+
+    std::shared_ptr<CLAllocPool::Block> CLAllocPool::acquire(std::size_t size) {
+        const int         size_class = cl_alloc_pool_class(size);
+        const std::size_t block_size = cl_alloc_pool_class_size(size_class);
+
+        auto block        = std::make_shared<Block>();
+        block->state      = m_state;
+        block->size_class = size_class;
+
+        std::vector<cl::Buffer> released;
+
+        {
+            std::lock_guard<std::mutex> lock(m_state->mutex);
+            auto&                       free_list = m_state->free_lists[size_class];
+
+            if (!free_list.empty()) {
+                block->buffer = std::move(free_list.back());
+                free_list.pop_back();
+                m_state->stats.bytes_cached -= block_size;
+                m_state->stats.n_hits += 1;
+            } else {
+                m_state->stats.n_misses += 1;
+            }
+
+            m_state->stats.bytes_live += block_size;
+            m_state->trim(m_state->high_water_mark, released);
+        }
+
+        if (!block->buffer()) {
+            block->buffer = cl::Buffer(get_acc_cl()->get_context(), m_flags, block_size);
+        }
+
+        return block;
+    }
+    cl::Buffer CLAllocPool::make_sub_buffer(const std::shared_ptr<Block>& block, std::size_t offset, std::size_t size) {
+        std::size_t region[2] = {offset, size};
+        cl::Buffer  buffer    = block->buffer.createSubBuffer(CL_MEM_READ_WRITE, CL_BUFFER_CREATE_TYPE_REGION, region);
+
+        // Each sub-buffer holds the block until driver destroys it
+        auto* holder = new std::shared_ptr<Block>(block);
+
+        if (!buffer() || buffer.setDestructorCallback(on_sub_buffer_destroyed, holder) != CL_SUCCESS) {
+            // Release of the block can not be tracked, so it is not reused
+            block->reusable = false;
+            delete holder;
+        }
+
+        return buffer;
+    }
+    void CL_CALLBACK CLAllocPool::on_sub_buffer_destroyed(cl_mem, void* user_data) {
+        delete static_cast<std::shared_ptr<Block>*>(user_data);
+    }
+
+}// namespace spla
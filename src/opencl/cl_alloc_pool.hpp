@@ -0,0 +1,98 @@
+/**********************************************************************************/
+/* This file is part of spla project                                              */
+/* https://github.com/SparseLinearAlgebra/spla                                    */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2023 SparseLinearAlgebra                                         */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#ifndef SPLA_CL_ALLOC_POOL_HPP
+#define SPLA_CL_ALLOC_POOL_HPP
+
+#include <opencl/cl_accelerator.hpp>
+#include <opencl/cl_alloc.hpp>
+
+#include <cstdint>
+#include <memory>
+
+namespace spla {
+
+    /**
+     * @class CLAllocPool
+     * @brief Caching allocator of device buffers with power of two size classes
+     *
+     * Each allocation is served by a pooled block of the nearest power of two size,
+     * and returned to the caller as a sub-buffer of the block. Block goes back to the
+     * free list of its class when all sub-buffers of it are released and all commands
+     * using them are completed, what is reported by opencl destructor callback. So
+     * blocks are never reused while still accessed by any queue, and both temporary
+     * and persistent decoration buffers return to the pool without explicit free.
+     *
+     * Blocks are created with the same flags, so host mapped blocks may be requested
+     * for devices sharing memory with host.
+     *
+     * Total size of cached free blocks is limited by high water mark; once exceeded,
+     * largest cached blocks are released to the driver on next allocation.
+     */
+    class CLAllocPool final : public CLAlloc {
+    public:
+        struct Stats {
+            std::size_t   bytes_live   = 0;
+            std::size_t   bytes_cached = 0;
+            std::uint64_t n_hits       = 0;
+            std::uint64_t n_misses     = 0;
+
+            [[nodiscard]] double hit_rate() const {
+                const std::uint64_t n_total = n_hits + n_misses;
+                return n_total ? double(n_hits) / double(n_total) : 0.0;
+            }
+        };
+
+        static constexpr std::size_t DEFAULT_HIGH_WATER_MARK = 256 * 1024 * 1024;// 256 MiB
+        static constexpr std::size_t MIN_BLOCK_SIZE          = 256;
+
+        CLAllocPool(std::size_t alignment, cl_mem_flags flags, std::size_t high_water_mark = DEFAULT_HIGH_WATER_MARK);
+        ~CLAllocPool() override;
+
+        cl::Buffer alloc(std::size_t size) override;
+        void       alloc_paired(std::size_t size1, std::size_t size2, cl::Buffer& buffer1, cl::Buffer& buffer2);
+        void       free_all() override;
+
+        void                set_high_water_mark(std::size_t high_water_mark);
+        [[nodiscard]] Stats get_stats() const;
+
+    private:
+        struct State;
+        struct Block;
+
+        std::shared_ptr<Block> acquire(std::size_t size);
+        static cl::Buffer      make_sub_buffer(const std::shared_ptr<Block>& block, std::size_t offset, std::size_t size);
+        static void CL_CALLBACK on_sub_buffer_destroyed(cl_mem memobj, void* user_data);
+
+        std::shared_ptr<State> m_state;
+        std::size_t            m_alignment;
+        cl_mem_flags           m_flags;
+    };
+
+}// namespace spla
+
+#endif//SPLA_CL_ALLOC_POOL_HPP
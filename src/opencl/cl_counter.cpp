@@ -30,7 +30,7 @@
 namespace spla {
 
     CLCounter::CLCounter(uint init) {
-        m_buffer = cl::Buffer(get_acc_cl()->get_context(), CL_MEM_READ_WRITE | CL_MEM_COPY_HOST_PTR, sizeof(uint), &init);
+        m_buffer = cl::Buffer(get_acc_cl()->get_context(), CL_MEM_READ_WRITE | CL_MEM_ALLOC_HOST_PTR | CL_MEM_COPY_HOST_PTR, sizeof(uint), &init);
     }
     uint CLCounter::get(cl::CommandQueue& queue, cl::Event* event) {
         uint value;
@@ -38,7 +38,8 @@ namespace spla {
         return value;
     }
     void CLCounter::set(cl::CommandQueue& queue, uint value, cl::Event* event) {
-        queue.enqueueWriteBuffer(m_buffer, true, 0, sizeof(uint), &value, nullptr, event);
+        // Pattern is copied on enqueue, so there is no need to wait for queue
+        queue.enqueueFillBuffer(m_buffer, value, 0, sizeof(uint), nullptr, event);
     }
     cl::Buffer& CLCounter::buffer() {
         return m_buffer;
@@ -48,12 +49,19 @@ namespace spla {
         m_counter = std::move(get_acc_cl()->get_counter_pool()->allocate());
     }
     CLCounterWrapper::~CLCounterWrapper() {
-        get_acc_cl()->get_counter_pool()->release(std::move(m_counter));
+        // Counter passed only as kernel argument is used on compute queue of current task
+        cl::CommandQueue& queue = m_queue() ? m_queue : get_acc_cl()->get_queue_compute();
+
+        cl::Event done;
+        queue.enqueueMarkerWithWaitList(nullptr, &done);
+        get_acc_cl()->get_counter_pool()->release(std::move(m_counter), std::move(done));
     }
     uint CLCounterWrapper::get(cl::CommandQueue& queue, cl::Event* event) {
+        m_queue = queue;
         return m_counter->get(queue, event);
     }
     void CLCounterWrapper::set(cl::CommandQueue& queue, uint value, cl::Event* event) {
+        m_queue = queue;
         m_counter->set(queue, value, event);
     }
     cl::Buffer& CLCounterWrapper::buffer() {
@@ -66,6 +74,16 @@ namespace spla {
         }
     }
     std::shared_ptr<CLCounter> CLCounterPool::allocate() {
+        if (m_counters.empty()) {
+            for (auto it = m_pending.begin(); it != m_pending.end();) {
+                if (it->done.getInfo<CL_EVENT_COMMAND_EXECUTION_STATUS>() == CL_COMPLETE) {
+                    m_counters.push_back(std::move(it->counter));
+                    it = m_pending.erase(it);
+                } else {
+                    ++it;
+                }
+            }
+        }
         if (m_counters.empty()) {
             m_counters.push_back(std::make_shared<CLCounter>());
         }
@@ -74,8 +92,8 @@ namespace spla {
         m_counters.pop_back();
         return counter;
     }
-    void CLCounterPool::release(std::shared_ptr<CLCounter> counter) {
-        m_counters.push_back(std::move(counter));
+    void CLCounterPool::release(std::shared_ptr<CLCounter> counter, cl::Event done) {
+        m_pending.push_back(Pending{std::move(counter), std::move(done)});
     }
 
 }// namespace spla
\ No newline at end of file
@@ -38,6 +38,9 @@ namespace spla {
     /**
      * @class CLCounter
      * @brief Unsigned integer reusable counter for operations
+     *
+     * Counter is stored in pinned host visible memory. Set is enqueued as fill
+     * and never blocks host; only get waits for queue to reach the counter read.
      */
     class CLCounter {
     public:
@@ -54,6 +57,9 @@ namespace spla {
     /**
      * @brief CLCounterWrapper
      * @class Automates allocation and release operations of counters
+     *
+     * Counter goes back to the pool behind a marker on the last queue it was used with,
+     * so fill and kernels still pending on that queue are done before it is reused.
      */
     class CLCounterWrapper {
     public:
@@ -66,21 +72,30 @@ namespace spla {
 
     private:
         std::shared_ptr<CLCounter> m_counter;
+        cl::CommandQueue           m_queue;
     };
 
     /**
      * @class CLCounterPool
      * @brief Global pool with pre-allocated counters
+     *
+     * Released counters are handed out again only once their completion event is complete.
      */
     class CLCounterPool {
     public:
         explicit CLCounterPool(uint pre_allocate = 16);
 
         std::shared_ptr<CLCounter> allocate();
-        void                       release(std::shared_ptr<CLCounter> counter);
+        void                       release(std::shared_ptr<CLCounter> counter, cl::Event done);
 
     private:
+        struct Pending {
+            std::shared_ptr<CLCounter> counter;
+            cl::Event                  done;
+        };
+
         std::vector<std::shared_ptr<CLCounter>> m_counters;
+        std::vector<Pending>                    m_pending;
     };
 
 }// namespace spla
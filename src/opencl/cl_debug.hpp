@@ -44,8 +44,8 @@
                 cl_ulong __queued                   = __cl_event.getProfilingInfo<CL_PROFILING_COMMAND_QUEUED>(); \
                 cl_ulong __start                    = __cl_event.getProfilingInfo<CL_PROFILING_COMMAND_START>();  \
                 cl_ulong __end                      = __cl_event.getProfilingInfo<CL_PROFILING_COMMAND_END>();    \
-                TIME_PROFILE_SUBLABEL.queued_nano   = __end - __queued;                                           \
-                TIME_PROFILE_SUBLABEL.executed_nano = __end - __start;                                            \
+                TIME_PROFILE_SUBLABEL.queued_nano += __end - __queued;                                            \
+                TIME_PROFILE_SUBLABEL.executed_nano += __end - __start;                                           \
                 CL_FINISH(queue);                                                                                 \
             }                                                                                                     \
         } while (false)
@@ -61,8 +61,8 @@
                 cl_ulong __queued                   = __cl_event.getProfilingInfo<CL_PROFILING_COMMAND_QUEUED>(); \
                 cl_ulong __start                    = __cl_event.getProfilingInfo<CL_PROFILING_COMMAND_START>();  \
                 cl_ulong __end                      = __cl_event.getProfilingInfo<CL_PROFILING_COMMAND_END>();    \
-                TIME_PROFILE_SUBLABEL.queued_nano   = __end - __queued;                                           \
-                TIME_PROFILE_SUBLABEL.executed_nano = __end - __start;                                            \
+                TIME_PROFILE_SUBLABEL.queued_nano += __end - __queued;                                            \
+                TIME_PROFILE_SUBLABEL.executed_nano += __end - __start;                                           \
                 CL_FINISH(queue);                                                                                 \
             }                                                                                                     \
         } while (false)
@@ -78,8 +78,8 @@
                 cl_ulong __queued                   = __cl_event.getProfilingInfo<CL_PROFILING_COMMAND_QUEUED>(); \
                 cl_ulong __start                    = __cl_event.getProfilingInfo<CL_PROFILING_COMMAND_START>();  \
                 cl_ulong __end                      = __cl_event.getProfilingInfo<CL_PROFILING_COMMAND_END>();    \
-                TIME_PROFILE_SUBLABEL.queued_nano   = __end - __queued;                                           \
-                TIME_PROFILE_SUBLABEL.executed_nano = __end - __start;                                            \
+                TIME_PROFILE_SUBLABEL.queued_nano += __end - __queued;                                            \
+                TIME_PROFILE_SUBLABEL.executed_nano += __end - __start;                                           \
                 CL_FINISH(queue);                                                                                 \
             }                                                                                                     \
         } while (false)
@@ -95,8 +95,8 @@
                 cl_ulong __queued                   = __cl_event.getProfilingInfo<CL_PROFILING_COMMAND_QUEUED>(); \
                 cl_ulong __start                    = __cl_event.getProfilingInfo<CL_PROFILING_COMMAND_START>();  \
                 cl_ulong __end                      = __cl_event.getProfilingInfo<CL_PROFILING_COMMAND_END>();    \
-                TIME_PROFILE_SUBLABEL.queued_nano   = __end - __queued;                                           \
-                TIME_PROFILE_SUBLABEL.executed_nano = __end - __start;                                            \
+                TIME_PROFILE_SUBLABEL.queued_nano += __end - __queued;                                            \
+                TIME_PROFILE_SUBLABEL.executed_nano += __end - __start;                                           \
                 CL_FINISH(queue);                                                                                 \
             }                                                                                                     \
         } while (false)
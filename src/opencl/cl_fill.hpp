@@ -35,14 +35,21 @@
 namespace spla {
 
     template<typename T>
-    void cl_fill_zero(cl::CommandQueue& queue, cl::Buffer& values, uint n) {
+    std::shared_ptr<CLProgram> cl_fill_program() {
         CLProgramBuilder builder;
         builder.set_name("fill")
                 .add_type("TYPE", get_ttype<T>().template as<Type>())
                 .set_source(source_fill)
                 .acquire();
 
-        auto  fill_zero = builder.make_kernel("fill_zero");
+        return builder.get_program();
+    }
+
+    template<typename T>
+    void cl_fill_zero(cl::CommandQueue& queue, cl::Buffer& values, uint n) {
+        auto program = cl_fill_program<T>();
+
+        auto  fill_zero = program->make_kernel("fill_zero");
         auto* acc       = get_acc_cl();
 
         uint block_size           = acc->get_default_wgs();
@@ -58,13 +65,9 @@ namespace spla {
 
     template<typename T>
     void cl_fill_value(cl::CommandQueue& queue, const cl::Buffer& values, uint n, T value) {
-        CLProgramBuilder builder;
-        builder.set_name("fill")
-                .add_type("TYPE", get_ttype<T>().template as<Type>())
-                .set_source(source_fill)
-                .acquire();
+        auto program = cl_fill_program<T>();
 
-        auto  fill_value = builder.make_kernel("fill_value");
+        auto  fill_value = program->make_kernel("fill_value");
         auto* acc        = get_acc_cl();
 
         uint block_size           = acc->get_default_wgs();
@@ -41,6 +41,17 @@ namespace spla {
      * @{
      */
 
+    template<typename T>
+    std::shared_ptr<CLProgram> cl_vector_format_program() {
+        CLProgramBuilder builder;
+        builder.set_name("vector_format")
+                .add_type("TYPE", get_ttype<T>().template as<Type>())
+                .set_source(source_vector_formats)
+                .acquire();
+
+        return builder.get_program();
+    }
+
     template<typename T>
     void cl_coo_vec_init(const std::size_t n_values,
                          const uint*       Ai,
@@ -50,10 +61,12 @@ namespace spla {
 
         const std::size_t buffer_size_Ai = n_values * sizeof(uint);
         const std::size_t buffer_size_Ax = n_values * sizeof(T);
-        const auto        flags          = CL_MEM_READ_WRITE | CL_MEM_HOST_NO_ACCESS | CL_MEM_COPY_HOST_PTR;
 
-        cl::Buffer buffer_Ai(get_acc_cl()->get_context(), flags, buffer_size_Ai, (void*) Ai);
-        cl::Buffer buffer_Ax(get_acc_cl()->get_context(), flags, buffer_size_Ax, (void*) Ax);
+        cl::Buffer buffer_Ai = get_acc_cl()->get_alloc_pool()->alloc(buffer_size_Ai);
+        cl::Buffer buffer_Ax = get_acc_cl()->get_alloc_pool()->alloc(buffer_size_Ax);
+
+        get_acc_cl()->upload(buffer_Ai, buffer_size_Ai, Ai);
+        get_acc_cl()->upload(buffer_Ax, buffer_size_Ax, Ax);
 
         storage.Ai = std::move(buffer_Ai);
         storage.Ax = std::move(buffer_Ax);
@@ -68,10 +81,9 @@ namespace spla {
 
         const std::size_t buffer_size_Ai = n_values * sizeof(uint);
         const std::size_t buffer_size_Ax = n_values * sizeof(T);
-        const auto        flags          = CL_MEM_READ_WRITE | CL_MEM_HOST_NO_ACCESS;
 
-        cl::Buffer buffer_Ai(get_acc_cl()->get_context(), flags, buffer_size_Ai);
-        cl::Buffer buffer_Ax(get_acc_cl()->get_context(), flags, buffer_size_Ax);
+        cl::Buffer buffer_Ai = get_acc_cl()->get_alloc_pool()->alloc(buffer_size_Ai);
+        cl::Buffer buffer_Ax = get_acc_cl()->get_alloc_pool()->alloc(buffer_size_Ax);
 
         storage.Ai     = std::move(buffer_Ai);
         storage.Ax     = std::move(buffer_Ax);
@@ -89,25 +101,14 @@ namespace spla {
     void cl_coo_vec_read(const std::size_t  n_values,
                          uint*              Ai,
                          T*                 Ax,
-                         const CLCooVec<T>& storage,
-                         cl::CommandQueue&  queue,
-                         bool               blocking = true) {
+                         const CLCooVec<T>& storage) {
         if (n_values == 0) {
             LOG_MSG(Status::Ok, "nothing to do");
             return;
         }
 
-        const std::size_t buffer_size_Ai = n_values * sizeof(uint);
-        const std::size_t buffer_size_Ax = n_values * sizeof(T);
-        const auto        flags          = CL_MEM_READ_ONLY | CL_MEM_HOST_READ_ONLY | CL_MEM_ALLOC_HOST_PTR;
-
-        cl::Buffer staging_Ai(get_acc_cl()->get_context(), flags, buffer_size_Ai);
-        cl::Buffer staging_Ax(get_acc_cl()->get_context(), flags, buffer_size_Ax);
-
-        queue.enqueueCopyBuffer(storage.Ai, staging_Ai, 0, 0, buffer_size_Ai);
-        queue.enqueueCopyBuffer(storage.Ax, staging_Ax, 0, 0, buffer_size_Ax);
-        queue.enqueueReadBuffer(staging_Ai, blocking, 0, buffer_size_Ai, Ai);
-        queue.enqueueReadBuffer(staging_Ax, blocking, 0, buffer_size_Ax, Ax);
+        get_acc_cl()->download(storage.Ai, n_values * sizeof(uint), Ai, false);
+        get_acc_cl()->download(storage.Ax, n_values * sizeof(T), Ax, true);
     }
 
     template<typename T>
@@ -116,11 +117,7 @@ namespace spla {
                              const CLCooVec<T>& in,
                              CLDenseVec<T>&     out,
                              cl::CommandQueue&  queue) {
-        CLProgramBuilder builder;
-        builder.set_name("vector_format")
-                .add_type("TYPE", get_ttype<T>().template as<Type>())
-                .set_source(source_vector_formats)
-                .acquire();
+        auto program = cl_vector_format_program<T>();
 
         cl_fill_value<T>(queue, out.Ax, n_rows, fill_value);
 
@@ -129,7 +126,7 @@ namespace spla {
         uint block_size           = acc->get_default_wgs();
         uint n_groups_to_dispatch = std::max(std::min(in.values / block_size, uint(1024)), uint(1));
 
-        auto kernel = builder.make_kernel("sparse_to_dense");
+        auto kernel = program->make_kernel("sparse_to_dense");
         kernel.setArg(0, in.Ai);
         kernel.setArg(1, in.Ax);
         kernel.setArg(2, out.Ax);
@@ -37,6 +37,14 @@ namespace spla {
      * @{
      */
 
+    template<typename T>
+    void cl_csr_reset_row_blocks(CLCsr<T>& storage) {
+        storage.row_blocks     = cl::Buffer();
+        storage.n_row_blocks   = 0;
+        storage.row_blocks_nnz = 0;
+        storage.max_row_length = 0;
+    }
+
     template<typename T>
     void cl_csr_init(std::size_t n_rows,
                      std::size_t n_values,
@@ -44,64 +52,126 @@ namespace spla {
                      const uint* Aj,
                      const T*    Ax,
                      CLCsr<T>&   storage) {
-        auto&      ctx   = get_acc_cl()->get_context();
-        const auto flags = CL_MEM_READ_WRITE | CL_MEM_HOST_NO_ACCESS | CL_MEM_COPY_HOST_PTR;
+        auto* acc   = get_acc_cl();
+        auto* alloc = acc->get_alloc_pool();
+
+        cl::Buffer cl_Ap = alloc->alloc((n_rows + 1) * sizeof(uint));
+        cl::Buffer cl_Aj = alloc->alloc(n_values * sizeof(uint));
+        cl::Buffer cl_Ax = alloc->alloc(n_values * sizeof(T));
 
-        cl::Buffer cl_Ap(ctx, flags, (n_rows + 1) * sizeof(uint), (void*) Ap);
-        cl::Buffer cl_Aj(ctx, flags, n_values * sizeof(uint), (void*) Aj);
-        cl::Buffer cl_Ax(ctx, flags, n_values * sizeof(T), (void*) Ax);
+        acc->upload(cl_Ap, (n_rows + 1) * sizeof(uint), Ap);
+        acc->upload(cl_Aj, n_values * sizeof(uint), Aj);
+        acc->upload(cl_Ax, n_values * sizeof(T), Ax);
 
         storage.Ap = std::move(cl_Ap);
         storage.Aj = std::move(cl_Aj);
         storage.Ax = std::move(cl_Ax);
 
         storage.values = n_values;
+        cl_csr_reset_row_blocks(storage);
     }
 
     template<typename T>
     void cl_csr_resize(std::size_t n_rows,
                        std::size_t n_values,
                        CLCsr<T>&   storage) {
-        auto&      ctx   = get_acc_cl()->get_context();
-        const auto flags = CL_MEM_READ_WRITE | CL_MEM_HOST_NO_ACCESS;
+        auto* alloc = get_acc_cl()->get_alloc_pool();
 
-        cl::Buffer cl_Ap(ctx, flags, (n_rows + 1) * sizeof(uint));
-        cl::Buffer cl_Aj(ctx, flags, n_values * sizeof(uint));
-        cl::Buffer cl_Ax(ctx, flags, n_values * sizeof(T));
+        cl::Buffer cl_Ap = alloc->alloc((n_rows + 1) * sizeof(uint));
+        cl::Buffer cl_Aj = alloc->alloc(n_values * sizeof(uint));
+        cl::Buffer cl_Ax = alloc->alloc(n_values * sizeof(T));
 
         storage.Ap = std::move(cl_Ap);
         storage.Aj = std::move(cl_Aj);
         storage.Ax = std::move(cl_Ax);
 
         storage.values = n_values;
+        cl_csr_reset_row_blocks(storage);
+    }
+
+    template<typename T>
+    void cl_csr_clear(std::size_t n_rows,
+                      CLCsr<T>&   storage) {
+        auto* acc = get_acc_cl();
+
+        cl::Buffer cl_Ap = acc->get_alloc_pool()->alloc((n_rows + 1) * sizeof(uint));
+        acc->get_queue_compute().enqueueFillBuffer(cl_Ap, uint(0), 0, (n_rows + 1) * sizeof(uint));
+
+        storage.Ap = std::move(cl_Ap);
+        storage.Aj = cl::Buffer();
+        storage.Ax = cl::Buffer();
+
+        storage.values = 0;
+        cl_csr_reset_row_blocks(storage);
+    }
+
+    template<typename T>
+    void cl_csr_read(std::size_t n_rows,
+                     std::size_t n_values,
+                     uint*       Ap,
+                     uint*       Aj,
+                     T*          Ax,
+                     CLCsr<T>&   storage) {
+        auto* acc = get_acc_cl();
+
+        acc->download(storage.Ap, (n_rows + 1) * sizeof(uint), Ap, false);
+        acc->download(storage.Aj, n_values * sizeof(uint), Aj, false);
+        acc->download(storage.Ax, n_values * sizeof(T), Ax, true);
     }
 
+    /**
+     * @brief Splits rows into blocks for CSR-Adaptive processing, once per matrix data
+     *
+     * Consecutive rows are packed into one block while their total values count fits into
+     * `block_nnz`, so block is processed by one work-group; row longer than `block_nnz`
+     * takes a block alone. Blocks are cached in storage until its buffers are reallocated.
+     *
+     * @param n_rows Number of matrix rows
+     * @param block_nnz Max values count of block with several rows
+     * @param storage Matrix storage to compute blocks for
+     */
     template<typename T>
-    void cl_csr_read(std::size_t       n_rows,
-                     std::size_t       n_values,
-                     uint*             Ap,
-                     uint*             Aj,
-                     T*                Ax,
-                     CLCsr<T>&         storage,
-                     cl::CommandQueue& queue,
-                     bool              blocking = true) {
-        const std::size_t buffer_size_Ap = (n_rows + 1) * sizeof(uint);
-        const std::size_t buffer_size_Aj = n_values * sizeof(uint);
-        const std::size_t buffer_size_Ax = n_values * sizeof(T);
-
-        const auto flags = CL_MEM_READ_ONLY | CL_MEM_HOST_READ_ONLY | CL_MEM_ALLOC_HOST_PTR;
-
-        cl::Buffer staging_Ap(get_acc_cl()->get_context(), flags, buffer_size_Ap);
-        cl::Buffer staging_Aj(get_acc_cl()->get_context(), flags, buffer_size_Aj);
-        cl::Buffer staging_Ax(get_acc_cl()->get_context(), flags, buffer_size_Ax);
-
-        queue.enqueueCopyBuffer(storage.Ap, staging_Ap, 0, 0, buffer_size_Ap);
-        queue.enqueueCopyBuffer(storage.Aj, staging_Aj, 0, 0, buffer_size_Aj);
-        queue.enqueueCopyBuffer(storage.Ax, staging_Ax, 0, 0, buffer_size_Ax);
-
-        queue.enqueueReadBuffer(staging_Ap, false, 0, buffer_size_Ap, Ap);
-        queue.enqueueReadBuffer(staging_Aj, false, 0, buffer_size_Aj, Aj);
-        queue.enqueueReadBuffer(staging_Ax, blocking, 0, buffer_size_Ax, Ax);
+    void cl_csr_row_blocks(std::size_t n_rows,
+                           uint        block_nnz,
+                           CLCsr<T>&   storage) {
+        if (storage.row_blocks() && storage.row_blocks_nnz == block_nnz) return;
+
+        auto* acc = get_acc_cl();
+
+        std::vector<uint> Ap(n_rows + 1);
+        acc->download(storage.Ap, (n_rows + 1) * sizeof(uint), Ap.data());
+
+        std::vector<uint> blocks;
+        blocks.reserve(n_rows / 2 + 2);
+        blocks.push_back(0);
+
+        uint max_row_length = 0;
+        uint row            = 0;
+
+        while (row < n_rows) {
+            const uint start = row;
+            uint       nnz   = 0;
+
+            while (row < n_rows && row - start < block_nnz) {
+                const uint length = Ap[row + 1] - Ap[row];
+                max_row_length    = std::max(max_row_length, length);
+
+                if (row > start && nnz + length > block_nnz) break;
+
+                nnz += length;
+                row += 1;
+            }
+
+            blocks.push_back(row);
+        }
+
+        cl::Buffer cl_blocks = acc->get_alloc_pool()->alloc(blocks.size() * sizeof(uint));
+        acc->upload(cl_blocks, blocks.size() * sizeof(uint), blocks.data());
+
+        storage.row_blocks     = std::move(cl_blocks);
+        storage.n_row_blocks   = uint(blocks.size() - 1);
+        storage.row_blocks_nnz = block_nnz;
+        storage.max_row_length = max_row_length;
     }
 
     /**
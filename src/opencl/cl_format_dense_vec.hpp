@@ -30,6 +30,7 @@
 
 #include <opencl/cl_counter.hpp>
 #include <opencl/cl_debug.hpp>
+#include <opencl/cl_format_coo_vec.hpp>
 #include <opencl/cl_formats.hpp>
 #include <opencl/cl_program_builder.hpp>
 #include <opencl/cl_sort_by_key.hpp>
@@ -46,17 +47,16 @@ namespace spla {
     void cl_dense_vec_resize(const std::size_t n_rows,
                              CLDenseVec<T>&    storage) {
         const std::size_t buffer_size = n_rows * sizeof(T);
-        const auto        flags       = CL_MEM_READ_WRITE | CL_MEM_HOST_NO_ACCESS;
 
-        cl::Buffer buffer(get_acc_cl()->get_context(), flags, buffer_size);
-        storage.Ax = std::move(buffer);
+        cl::Buffer buffer = get_acc_cl()->get_alloc_pool()->alloc(buffer_size);
+        storage.Ax        = std::move(buffer);
     }
 
     template<typename T>
     void cl_dense_vec_fill_value(const std::size_t n_rows,
                                  const T           value,
                                  CLDenseVec<T>&    storage) {
-        cl_fill_value<T>(get_acc_cl()->get_queue_default(), storage.Ax, n_rows, value);
+        cl_fill_value<T>(get_acc_cl()->get_queue_compute(), storage.Ax, n_rows, value);
     }
 
     template<typename T>
@@ -66,23 +66,17 @@ namespace spla {
         assert(values);
 
         const std::size_t buffer_size = n_rows * sizeof(T);
-        const auto        flags       = CL_MEM_READ_WRITE | CL_MEM_HOST_NO_ACCESS | CL_MEM_COPY_HOST_PTR;
 
-        cl::Buffer buffer(get_acc_cl()->get_context(), flags, buffer_size, (void*) values);
+        cl::Buffer buffer = get_acc_cl()->get_alloc_pool()->alloc(buffer_size);
+        get_acc_cl()->upload(buffer, buffer_size, values);
         storage.Ax = std::move(buffer);
     }
 
     template<typename T>
     void cl_dense_vec_read(const std::size_t n_rows,
                            T*                values,
-                           CLDenseVec<T>&    storage,
-                           cl::CommandQueue& queue,
-                           bool              blocking = true) {
-        const std::size_t buffer_size = n_rows * sizeof(T);
-        cl::Buffer        staging(get_acc_cl()->get_context(), CL_MEM_READ_ONLY | CL_MEM_HOST_READ_ONLY | CL_MEM_ALLOC_HOST_PTR, buffer_size);
-
-        queue.enqueueCopyBuffer(storage.Ax, staging, 0, 0, buffer_size);
-        queue.enqueueReadBuffer(staging, blocking, 0, buffer_size, values);
+                           CLDenseVec<T>&    storage) {
+        get_acc_cl()->download(storage.Ax, n_rows * sizeof(T), values);
     }
 
     template<typename T>
@@ -92,17 +86,13 @@ namespace spla {
                              CLCooVec<T>&         out,
                              cl::CommandQueue&    queue) {
 
-        CLProgramBuilder builder;
-        builder.set_name("vector_format")
-                .add_type("TYPE", get_ttype<T>().template as<Type>())
-                .set_source(source_vector_formats)
-                .acquire();
+        auto program = cl_vector_format_program<T>();
 
         auto* acc = get_acc_cl();
 
         CLCounterWrapper cl_count;
-        cl::Buffer       temp_Ri(acc->get_context(), CL_MEM_WRITE_ONLY | CL_MEM_HOST_NO_ACCESS, n_rows * sizeof(uint));
-        cl::Buffer       temp_Rx(acc->get_context(), CL_MEM_WRITE_ONLY | CL_MEM_HOST_NO_ACCESS, n_rows * sizeof(T));
+        cl::Buffer       temp_Ri = acc->get_alloc_pool()->alloc(n_rows * sizeof(uint));
+        cl::Buffer       temp_Rx = acc->get_alloc_pool()->alloc(n_rows * sizeof(T));
 
         cl_count.set(queue, 0);
 
@@ -112,7 +102,7 @@ namespace spla {
         cl::NDRange global(block_size * n_groups_to_dispatch);
         cl::NDRange local(block_size);
 
-        auto kernel = builder.make_kernel("dense_to_sparse");
+        auto kernel = program->make_kernel("dense_to_sparse");
         kernel.setArg(0, in.Ax);
         kernel.setArg(1, temp_Ri);
         kernel.setArg(2, temp_Rx);
@@ -124,8 +114,8 @@ namespace spla {
         uint count = cl_count.get(queue);
 
         out.values = count;
-        out.Ai     = cl::Buffer(acc->get_context(), CL_MEM_READ_WRITE | CL_MEM_HOST_NO_ACCESS, count * sizeof(uint));
-        out.Ax     = cl::Buffer(acc->get_context(), CL_MEM_READ_WRITE | CL_MEM_HOST_NO_ACCESS, count * sizeof(T));
+        out.Ai     = acc->get_alloc_pool()->alloc(count * sizeof(uint));
+        out.Ax     = acc->get_alloc_pool()->alloc(count * sizeof(T));
 
         queue.enqueueCopyBuffer(temp_Ri, out.Ai, 0, 0, count * sizeof(uint));
         queue.enqueueCopyBuffer(temp_Rx, out.Ax, 0, 0, count * sizeof(T));
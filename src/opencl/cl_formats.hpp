@@ -34,6 +34,7 @@
 #include <util/pair_hash.hpp>
 
 #include <opencl/cl_accelerator.hpp>
+#include <opencl/cl_alloc_pool.hpp>
 
 #include <algorithm>
 #include <cassert>
@@ -51,6 +52,13 @@ namespace spla {
      * @{
      */
 
+    /**
+     * @brief Size in bytes of allocated buffer, zero for not allocated one
+     */
+    inline std::size_t cl_buffer_size(const cl::Buffer& buffer) {
+        return buffer() ? buffer.getInfo<CL_MEM_SIZE>() : 0;
+    }
+
     /**
      * @class CLDenseVec
      * @brief OpenCL one-dim array for dense vector representation
@@ -64,6 +72,8 @@ namespace spla {
 
         ~CLDenseVec() override = default;
 
+        [[nodiscard]] std::size_t get_mem_size() const override { return cl_buffer_size(Ax); }
+
         cl::Buffer Ax;
     };
 
@@ -80,6 +90,8 @@ namespace spla {
 
         ~CLCooVec() override = default;
 
+        [[nodiscard]] std::size_t get_mem_size() const override { return cl_buffer_size(Ai) + cl_buffer_size(Ax); }
+
         cl::Buffer Ai;
         cl::Buffer Ax;
     };
@@ -97,9 +109,17 @@ namespace spla {
 
         ~CLCsr() override = default;
 
+        [[nodiscard]] std::size_t get_mem_size() const override { return cl_buffer_size(Ap) + cl_buffer_size(Aj) + cl_buffer_size(Ax) + cl_buffer_size(row_blocks); }
+
         cl::Buffer Ap;
         cl::Buffer Aj;
         cl::Buffer Ax;
+
+        /** First row of each block of rows with bounded values count, computed on demand, see cl_csr_row_blocks */
+        cl::Buffer row_blocks;
+        uint       n_row_blocks   = 0;
+        uint       row_blocks_nnz = 0;
+        uint       max_row_length = 0;
     };
 
 
@@ -86,7 +86,7 @@ namespace spla {
 
             const auto* p_cl_csr = M->template get<CLCsr<T>>();
             auto*       p_cl_acc = get_acc_cl();
-            auto&       queue    = p_cl_acc->get_queue_default();
+            auto&       queue    = p_cl_acc->get_queue_compute();
 
             cl_reduce<T>(queue, p_cl_csr->Ax, p_cl_csr->values, s->get_value(), op_reduce, r->get_value());
 
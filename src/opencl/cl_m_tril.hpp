@@ -0,0 +1,152 @@
+/**********************************************************************************/
+/* This file is part of spla project                                              */
+/* https://github.com/SparseLinearAlgebra/spla                                    */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2023 SparseLinearAlgebra                                         */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#ifndef SPLA_CL_M_TRIL_HPP
+#define SPLA_CL_M_TRIL_HPP
+
+#include <schedule/schedule_tasks.hpp>
+
+#include <core/dispatcher.hpp>
+#include <core/registry.hpp>
+#include <core/tmatrix.hpp>
+#include <core/top.hpp>
+#include <core/ttype.hpp>
+#include <core/tvector.hpp>
+
+#include <opencl/cl_counter.hpp>
+#include <opencl/cl_formats.hpp>
+#include <opencl/cl_prefix_sum.hpp>
+#include <opencl/cl_program_builder.hpp>
+#include <opencl/generated/auto_matrix_tril.hpp>
+
+namespace spla {
+
+    template<typename T>
+    class Algo_m_tril_cl final : public RegistryAlgo {
+    public:
+        ~Algo_m_tril_cl() override = default;
+
+        std::string get_name() override {
+            return "m_tril";
+        }
+
+        std::string get_description() override {
+            return "parallel matrix lower triangle by keys order on opencl device";
+        }
+
+        Status execute(const DispatchContext& ctx) override {
+            TIME_PROFILE_SCOPE("opencl/m_tril");
+
+            auto t   = ctx.task.template cast_safe<ScheduleTask_m_tril>();
+            auto R   = t->R.template cast_safe<TMatrix<T>>();
+            auto M   = t->M.template cast_safe<TMatrix<T>>();
+            auto key = t->key.template cast_safe<TVector<T>>();
+
+            std::shared_ptr<CLProgram> program;
+            if (!ensure_kernel(program)) return Status::CompilationError;
+
+            M->validate_rw(FormatMatrix::AccCsr);
+            R->validate_wd(FormatMatrix::AccCsr);
+            if (key) key->validate_rw(FormatVector::AccDense);
+
+            const auto* p_cl_M = M->template get<CLCsr<T>>();
+            auto*       p_cl_R = R->template get<CLCsr<T>>();
+
+            if (p_cl_M->values == 0) {
+                cl_csr_clear<T>(M->get_n_rows(), *p_cl_R);
+                return Status::Ok;
+            }
+
+            auto*      p_cl_acc = get_acc_cl();
+            auto&      queue    = p_cl_acc->get_queue_compute();
+            const uint n        = M->get_n_rows();
+            const uint use_key  = key ? 1u : 0u;
+
+            // Keys buffer is not read without keys, so any valid buffer is passed in its place
+            const cl::Buffer& cl_key = key ? key->template get<CLDenseVec<T>>()->Ax : p_cl_M->Ax;
+
+            cl::Buffer cl_offsets = p_cl_acc->get_alloc_pool()->alloc(sizeof(uint) * (n + 1));
+
+            cl::NDRange global(p_cl_acc->get_default_wgs() * div_up_clamp(n, p_cl_acc->get_default_wgs(), 1u, 1024u));
+            cl::NDRange local(p_cl_acc->get_default_wgs());
+
+            auto kernel_count = program->make_kernel("tril_count");
+            kernel_count.setArg(0, p_cl_M->Ap);
+            kernel_count.setArg(1, p_cl_M->Aj);
+            kernel_count.setArg(2, cl_key);
+            kernel_count.setArg(3, cl_offsets);
+            kernel_count.setArg(4, use_key);
+            kernel_count.setArg(5, n);
+            queue.enqueueNDRangeKernel(kernel_count, cl::NullRange, global, local);
+
+            cl_exclusive_scan(queue, cl_offsets, n + 1, PLUS_UINT.template cast_safe<TOpBinary<uint, uint, uint>>(), p_cl_acc->get_alloc_pool());
+
+            CLCounterWrapper cl_values;
+            queue.enqueueCopyBuffer(cl_offsets, cl_values.buffer(), sizeof(uint) * n, 0, sizeof(uint));
+            const uint values = cl_values.get(queue);
+
+            if (values == 0) {
+                cl_csr_clear<T>(n, *p_cl_R);
+                return Status::Ok;
+            }
+
+            cl_csr_resize<T>(n, values, *p_cl_R);
+            queue.enqueueCopyBuffer(cl_offsets, p_cl_R->Ap, 0, 0, sizeof(uint) * (n + 1));
+
+            auto kernel_fill = program->make_kernel("tril_fill");
+            kernel_fill.setArg(0, p_cl_M->Ap);
+            kernel_fill.setArg(1, p_cl_M->Aj);
+            kernel_fill.setArg(2, p_cl_M->Ax);
+            kernel_fill.setArg(3, cl_key);
+            kernel_fill.setArg(4, p_cl_R->Ap);
+            kernel_fill.setArg(5, p_cl_R->Aj);
+            kernel_fill.setArg(6, p_cl_R->Ax);
+            kernel_fill.setArg(7, use_key);
+            kernel_fill.setArg(8, n);
+            queue.enqueueNDRangeKernel(kernel_fill, cl::NullRange, global, local);
+
+            return Status::Ok;
+        }
+
+    private:
+        bool ensure_kernel(std::shared_ptr<CLProgram>& program) {
+            CLProgramBuilder program_builder;
+            program_builder
+                    .set_name("matrix_tril")
+                    .add_type("TYPE", get_ttype<T>().template as<Type>())
+                    .set_source(source_matrix_tril)
+                    .acquire();
+
+            program = program_builder.get_program();
+
+            return true;
+        }
+    };
+
+}// namespace spla
+
+#endif//SPLA_CL_M_TRIL_HPP
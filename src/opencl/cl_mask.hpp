@@ -1,10 +1,10 @@
 /**********************************************************************************/
 /* This file is part of spla project                                              */
-/* https://github.com/JetBrains-Research/spla                                     */
+/* https://github.com/SparseLinearAlgebra/spla                                    */
 /**********************************************************************************/
 /* MIT License                                                                    */
 /*                                                                                */
-/* Copyright (c) 2021 JetBrains-Research                                          */
+/* Copyright (c) 2023 SparseLinearAlgebra                                         */
 /*                                                                                */
 /* Permission is hereby granted, free of charge, to any person obtaining a copy   */
 /* of this software and associated documentation files (the "Software"), to deal  */
@@ -25,50 +25,68 @@
 /* SOFTWARE.                                                                      */
 /**********************************************************************************/
 
-#ifndef SPLA_CL_ALLOC_LINEAR_HPP
-#define SPLA_CL_ALLOC_LINEAR_HPP
 
-#include <opencl/cl_accelerator.hpp>
-#include <opencl/cl_alloc.hpp>
+#ifndef SPLA_CL_MASK_HPP
+#define SPLA_CL_MASK_HPP
 
-#include <svector.hpp>
+#include <spla/descriptor.hpp>
+
+#include <core/top.hpp>
+#include <core/tvector.hpp>
 
 namespace spla {
 
     /**
-     * @class CLAllocLinear
-     * @brief Linear allocator for temporary device local buffer allocations
-     *
-     * Linear allocator uses linear allocation strategy. It places allocated
-     * buffers sequentially in a large pre-allocated arena buffer. If arena is full,
-     * new arena allocated. On a free all step, all allocations must be invalid.
-     * All allocated arenas cleared, and one new bigger arena allocated.
+     * @addtogroup internal
+     * @{
      */
-    class CLAllocLinear : public CLAlloc {
-    public:
-        static constexpr const uint DEFAULT_SIZE      = 1024 * 1024;// 1 MiB
-        static constexpr const uint DEFAULT_ALIGNMENT = 128;
 
-        explicit CLAllocLinear(std::size_t arena_size = DEFAULT_SIZE, std::size_t alignment = DEFAULT_ALIGNMENT);
-        ~CLAllocLinear() override = default;
+    /**
+     * @brief Mask test mode compiled into kernels with `MASK_MODE` define (see common_api.cl)
+     */
+    enum class CLMaskMode {
+        Valued              = 0,
+        None                = 1,
+        ValuedComplement    = 2,
+        Structure           = 3,
+        StructureComplement = 4
+    };
 
-        cl::Buffer alloc(std::size_t size) override;
-        void       free(cl::Buffer buffer) override;
-        void       free_all() override;
+    /**
+     * @brief Resolves kernel mask mode from optional mask, select op and descriptor
+     *
+     * @param mask Optional mask vector
+     * @param op_select Optional select op; null means structural mask
+     * @param desc Task descriptor
+     * @param mode Resolved mode
+     *
+     * @return False if mode is not supported by kernels and task must be executed elsewhere
+     */
+    template<typename T>
+    bool cl_mask_mode(const ref_ptr<TVector<T>>& mask,
+                      const ref_ptr<OpSelect>&   op_select,
+                      const ref_ptr<Descriptor>& desc,
+                      CLMaskMode&                mode) {
+        const bool complement = desc->get_mask_complement();
+        const bool structural = desc->get_mask_structure() || op_select.is_null();
 
-    protected:
-        void expand();
-        void shrink();
+        if (!mask) {
+            mode = CLMaskMode::None;
+            return !complement;
+        }
+        if (structural) {
+            mode = complement ? CLMaskMode::StructureComplement : CLMaskMode::Structure;
+            return mask->get_fill_value() == T(0);
+        }
 
-    private:
-        ankerl::svector<cl::Buffer, 4> m_arena;
-        std::size_t                    m_alignment       = 128;
-        std::size_t                    m_curr_offset     = 0;
-        std::size_t                    m_total_allocated = 0;
-        std::size_t                    m_arena_size      = 0;
-        std::size_t                    m_fallback_size   = 0;
-    };
+        mode = complement ? CLMaskMode::ValuedComplement : CLMaskMode::Valued;
+        return true;
+    }
+
+    /**
+     * @}
+     */
 
 }// namespace spla
 
-#endif//SPLA_CL_ALLOC_LINEAR_HPP
+#endif//SPLA_CL_MASK_HPP
@@ -100,12 +100,40 @@ namespace spla {
             }
 
             auto* p_cl_acc = get_acc_cl();
-            auto& queue    = p_cl_acc->get_queue_default();
+            auto& queue    = p_cl_acc->get_queue_compute();
 
             cl_csr_resize<T>(R->get_n_rows(), p_cl_mask->values, *p_cl_R);
             queue.enqueueCopyBuffer(p_cl_mask->Ap, p_cl_R->Ap, 0, 0, sizeof(uint) * (R->get_n_rows() + 1));
             queue.enqueueCopyBuffer(p_cl_mask->Aj, p_cl_R->Aj, 0, 0, sizeof(uint) * (p_cl_R->values));
 
+            // rows shorter than half of subgroup leave most of its lanes idle, so these are merged by single work-item
+            const uint avg_degree = (p_cl_A->values + p_cl_B->values) / std::max(A->get_n_rows() + B->get_n_rows(), 1u);
+            const bool is_vector  = avg_degree >= p_cl_acc->get_wave_size() / 2;
+
+            if (is_vector) {
+                auto kernel = program->make_kernel("mxmT_masked_csr_vector");
+                kernel.setArg(0, p_cl_A->Ap);
+                kernel.setArg(1, p_cl_A->Aj);
+                kernel.setArg(2, p_cl_A->Ax);
+                kernel.setArg(3, p_cl_B->Ap);
+                kernel.setArg(4, p_cl_B->Aj);
+                kernel.setArg(5, p_cl_B->Ax);
+                kernel.setArg(6, p_cl_mask->Ap);
+                kernel.setArg(7, p_cl_mask->Aj);
+                kernel.setArg(8, p_cl_mask->Ax);
+                kernel.setArg(9, p_cl_R->Ax);
+                kernel.setArg(10, T(init->get_value()));
+                kernel.setArg(11, R->get_n_rows());
+
+                uint n_groups_to_dispatch = clamp(R->get_n_rows(), 1, 4096);
+
+                cl::NDRange exec_global(m_block_size * n_groups_to_dispatch);
+                cl::NDRange exec_local(m_block_size);
+                CL_DISPATCH_PROFILED("exec-vector", queue, kernel, cl::NDRange(), exec_global, exec_local);
+
+                return Status::Ok;
+            }
+
             auto kernel = program->make_kernel("mxmT_masked_csr_scalar");
             kernel.setArg(0, p_cl_A->Ap);
             kernel.setArg(1, p_cl_A->Aj);
@@ -133,9 +161,15 @@ namespace spla {
                            const ref_ptr<TOpBinary<T, T, T>>& op_add,
                            const ref_ptr<TOpSelect<T>>&       op_select,
                            std::shared_ptr<CLProgram>&        program) {
-            m_block_size  = get_acc_cl()->get_default_wgs();
+            auto* p_cl_acc = get_acc_cl();
+
+            m_block_size  = align(p_cl_acc->get_default_wgs(), p_cl_acc->get_wave_size());
             m_block_count = 1;
 
+            // half of local memory for row of A, so few work-groups still share compute unit
+            const uint local_budget = p_cl_acc->get_max_local_mem() / 2 - m_block_size * uint(sizeof(T) + sizeof(uint));
+            m_local_A_size          = std::max(std::min(local_budget / uint(sizeof(uint) + sizeof(T)), MAX_LOCAL_A_SIZE), 1u);
+
             assert(m_block_count >= 1);
 
             CLProgramBuilder program_builder;
@@ -144,6 +178,7 @@ namespace spla {
                     .add_define("WARP_SIZE", get_acc_cl()->get_wave_size())
                     .add_define("BLOCK_SIZE", m_block_size)
                     .add_define("BLOCK_COUNT", m_block_count)
+                    .add_define("LOCAL_A_SIZE", m_local_A_size)
                     .add_type("TYPE", get_ttype<T>().template as<Type>())
                     .add_op("OP_BINARY1", op_multiply.template as<OpBinary>())
                     .add_op("OP_BINARY2", op_add.template as<OpBinary>())
@@ -157,8 +192,12 @@ namespace spla {
         }
 
     private:
-        uint m_block_size  = 0;
-        uint m_block_count = 0;
+        /** Limit of row of A cached in local memory by vector kernel */
+        static constexpr uint MAX_LOCAL_A_SIZE = 4096;
+
+        uint m_block_size   = 0;
+        uint m_block_count  = 0;
+        uint m_local_A_size = 0;
     };
 
 }// namespace spla
@@ -40,11 +40,14 @@
 
 #include <opencl/cl_counter.hpp>
 #include <opencl/cl_debug.hpp>
+#include <opencl/cl_format_csr.hpp>
 #include <opencl/cl_formats.hpp>
+#include <opencl/cl_mask.hpp>
 #include <opencl/cl_program_builder.hpp>
 #include <opencl/generated/auto_mxv.hpp>
 
 #include <algorithm>
+#include <cstdint>
 #include <sstream>
 
 namespace spla {
@@ -64,18 +67,38 @@ namespace spla {
 
         Status execute(const DispatchContext& ctx) override {
             auto t          = ctx.task.template cast_safe<ScheduleTask_mxv_masked>();
+            auto mask       = t->mask.template cast_safe<TVector<T>>();
             auto early_exit = t->get_desc_or_default()->get_early_exit();
 
+            if (!cl_mask_mode(mask, t->op_select, t->get_desc_or_default(), m_mask_mode)) {
+                return Status::NotImplemented;
+            }
+            if (t->op_accum) {
+                return Status::NotImplemented;
+            }
+
             if (early_exit) {
                 return execute_config_scalar(ctx);
             } else {
-                return execute_vector(ctx);
+                return execute_adaptive(ctx);
             }
         }
 
+        /**
+         * @brief Builds program of product with given ops and mask mode ahead of first dispatch
+         */
+        void precompile(const ref_ptr<TOpBinary<T, T, T>>& op_multiply,
+                        const ref_ptr<TOpBinary<T, T, T>>& op_add,
+                        const ref_ptr<TOpSelect<T>>&       op_select,
+                        CLMaskMode                         mask_mode) {
+            std::shared_ptr<CLProgram> program;
+            m_mask_mode = mask_mode;
+            ensure_kernel(op_multiply, op_add, op_select, program);
+        }
+
     private:
-        Status execute_vector(const DispatchContext& ctx) {
-            TIME_PROFILE_SCOPE("opencl/mxv/vector");
+        Status execute_adaptive(const DispatchContext& ctx) {
+            TIME_PROFILE_SCOPE("opencl/mxv/adaptive");
 
             auto t = ctx.task.template cast_safe<ScheduleTask_mxv_masked>();
 
@@ -89,87 +112,75 @@ namespace spla {
             ref_ptr<TScalar<T>>         init        = t->init.template cast_safe<TScalar<T>>();
 
             r->validate_wd(FormatVector::AccDense);
-            mask->validate_rw(FormatVector::AccDense);
+            if (mask) mask->validate_rw(FormatVector::AccDense);
             M->validate_rw(FormatMatrix::AccCsr);
+            TIME_PROFILE_SCOPE_WORK(M->get_n_values());
             v->validate_rw(FormatVector::AccDense);
 
             std::shared_ptr<CLProgram> program;
             if (!ensure_kernel(op_multiply, op_add, op_select, program)) return Status::CompilationError;
 
             auto* p_cl_r    = r->template get<CLDenseVec<T>>();
-            auto* p_cl_mask = mask->template get<CLDenseVec<T>>();
+            auto* p_cl_mask = mask ? mask->template get<CLDenseVec<T>>() : nullptr;
             auto* p_cl_M    = M->template get<CLCsr<T>>();
             auto* p_cl_v    = v->template get<CLDenseVec<T>>();
 
             auto* p_cl_acc = get_acc_cl();
-            auto& queue    = p_cl_acc->get_queue_default();
-
-            auto kernel_vector = program->make_kernel("mxv_vector");
-            kernel_vector.setArg(0, p_cl_M->Ap);
-            kernel_vector.setArg(1, p_cl_M->Aj);
-            kernel_vector.setArg(2, p_cl_M->Ax);
-            kernel_vector.setArg(3, p_cl_v->Ax);
-            kernel_vector.setArg(4, p_cl_mask->Ax);
-            kernel_vector.setArg(5, p_cl_r->Ax);
-            kernel_vector.setArg(6, init->get_value());
-            kernel_vector.setArg(7, r->get_n_rows());
-
-            uint n_groups_to_dispatch = div_up_clamp(r->get_n_rows(), m_block_count, 1, 512);
-
-            cl::NDRange exec_global(m_block_count * n_groups_to_dispatch, m_block_size);
-            cl::NDRange exec_local(m_block_count, m_block_size);
-            CL_DISPATCH_PROFILED("exec", queue, kernel_vector, cl::NDRange(), exec_global, exec_local);
-
-            return Status::Ok;
-        }
-
-        Status execute_scalar(const DispatchContext& ctx) {
-            TIME_PROFILE_SCOPE("opencl/mxv/scalar");
-
-            auto t = ctx.task.template cast_safe<ScheduleTask_mxv_masked>();
-
-            ref_ptr<TVector<T>>         r           = t->r.template cast_safe<TVector<T>>();
-            ref_ptr<TVector<T>>         mask        = t->mask.template cast_safe<TVector<T>>();
-            ref_ptr<TMatrix<T>>         M           = t->M.template cast_safe<TMatrix<T>>();
-            ref_ptr<TVector<T>>         v           = t->v.template cast_safe<TVector<T>>();
-            ref_ptr<TOpBinary<T, T, T>> op_multiply = t->op_multiply.template cast_safe<TOpBinary<T, T, T>>();
-            ref_ptr<TOpBinary<T, T, T>> op_add      = t->op_add.template cast_safe<TOpBinary<T, T, T>>();
-            ref_ptr<TOpSelect<T>>       op_select   = t->op_select.template cast_safe<TOpSelect<T>>();
-            ref_ptr<TScalar<T>>         init        = t->init.template cast_safe<TScalar<T>>();
-
-            r->validate_wd(FormatVector::AccDense);
-            mask->validate_rw(FormatVector::AccDense);
-            M->validate_rw(FormatMatrix::AccCsr);
-            v->validate_rw(FormatVector::AccDense);
-
-            std::shared_ptr<CLProgram> program;
-            if (!ensure_kernel(op_multiply, op_add, op_select, program)) return Status::CompilationError;
-
-            auto* p_cl_r     = r->template get<CLDenseVec<T>>();
-            auto* p_cl_mask  = mask->template get<CLDenseVec<T>>();
-            auto* p_cl_M     = M->template get<CLCsr<T>>();
-            auto* p_cl_v     = v->template get<CLDenseVec<T>>();
-            auto  early_exit = t->get_desc_or_default()->get_early_exit();
-
-            auto* p_cl_acc = get_acc_cl();
-            auto& queue    = p_cl_acc->get_queue_default();
+            auto& queue    = p_cl_acc->get_queue_compute();
+
+            const uint n_rows   = M->get_n_rows();
+            const uint n_values = p_cl_M->values;
+
+            CL_PROFILE_BEGIN("row-blocks", queue)
+            cl_csr_row_blocks(n_rows, ADAPTIVE_BLOCK_NNZ, *p_cl_M);
+            CL_PROFILE_END();
+
+            // single row heavier than fair share of compute unit stalls it, so values are split evenly instead
+            const bool is_skewed = p_cl_M->max_row_length > ADAPTIVE_BLOCK_NNZ &&
+                                   std::uint64_t(p_cl_M->max_row_length) * p_cl_acc->get_max_cu() > n_values;
+
+            if (is_skewed) {
+                const uint work             = n_rows + n_values;
+                const uint n_groups         = div_up_clamp(work, m_adaptive_block_size * MERGE_PATH_ITEMS_PER_THREAD, 1, 4096);
+                const uint items_per_thread = div_up(work, n_groups * m_adaptive_block_size);
+
+                queue.enqueueFillBuffer(p_cl_r->Ax, init->get_value(), 0, n_rows * sizeof(T));
+
+                auto kernel_merge_path = program->make_kernel("mxv_merge_path");
+                kernel_merge_path.setArg(0, p_cl_M->Ap);
+                kernel_merge_path.setArg(1, p_cl_M->Aj);
+                kernel_merge_path.setArg(2, p_cl_M->Ax);
+                kernel_merge_path.setArg(3, p_cl_v->Ax);
+                kernel_merge_path.setArg(4, p_cl_mask ? p_cl_mask->Ax : cl::Buffer());
+                kernel_merge_path.setArg(5, p_cl_r->Ax);
+                kernel_merge_path.setArg(6, init->get_value());
+                kernel_merge_path.setArg(7, n_rows);
+                kernel_merge_path.setArg(8, n_values);
+                kernel_merge_path.setArg(9, items_per_thread);
+
+                cl::NDRange exec_global(m_adaptive_block_size * n_groups);
+                cl::NDRange exec_local(m_adaptive_block_size);
+                CL_DISPATCH_PROFILED("exec-merge-path", queue, kernel_merge_path, cl::NDRange(), exec_global, exec_local);
+
+                return Status::Ok;
+            }
 
-            auto kernel_scalar = program->make_kernel("mxv_scalar");
-            kernel_scalar.setArg(0, p_cl_M->Ap);
-            kernel_scalar.setArg(1, p_cl_M->Aj);
-            kernel_scalar.setArg(2, p_cl_M->Ax);
-            kernel_scalar.setArg(3, p_cl_v->Ax);
-            kernel_scalar.setArg(4, p_cl_mask->Ax);
-            kernel_scalar.setArg(5, p_cl_r->Ax);
-            kernel_scalar.setArg(6, init->get_value());
-            kernel_scalar.setArg(7, r->get_n_rows());
-            kernel_scalar.setArg(8, uint(early_exit));
+            auto kernel_adaptive = program->make_kernel("mxv_adaptive");
+            kernel_adaptive.setArg(0, p_cl_M->Ap);
+            kernel_adaptive.setArg(1, p_cl_M->Aj);
+            kernel_adaptive.setArg(2, p_cl_M->Ax);
+            kernel_adaptive.setArg(3, p_cl_v->Ax);
+            kernel_adaptive.setArg(4, p_cl_mask ? p_cl_mask->Ax : cl::Buffer());
+            kernel_adaptive.setArg(5, p_cl_r->Ax);
+            kernel_adaptive.setArg(6, p_cl_M->row_blocks);
+            kernel_adaptive.setArg(7, init->get_value());
+            kernel_adaptive.setArg(8, p_cl_M->n_row_blocks);
 
-            uint n_groups_to_dispatch = div_up_clamp(r->get_n_rows(), m_block_size, 1, 512);
+            uint n_groups_to_dispatch = clamp(p_cl_M->n_row_blocks, 1, 4096);
 
-            cl::NDRange exec_global(m_block_size * n_groups_to_dispatch);
-            cl::NDRange exec_local(m_block_size);
-            CL_DISPATCH_PROFILED("exec", queue, kernel_scalar, cl::NDRange(), exec_global, exec_local);
+            cl::NDRange exec_global(m_adaptive_block_size * n_groups_to_dispatch);
+            cl::NDRange exec_local(m_adaptive_block_size);
+            CL_DISPATCH_PROFILED("exec", queue, kernel_adaptive, cl::NDRange(), exec_global, exec_local);
 
             return Status::Ok;
         }
@@ -189,28 +200,29 @@ namespace spla {
             ref_ptr<TScalar<T>>         init        = t->init.template cast_safe<TScalar<T>>();
 
             r->validate_wd(FormatVector::AccDense);
-            mask->validate_rw(FormatVector::AccDense);
+            if (mask) mask->validate_rw(FormatVector::AccDense);
             M->validate_rw(FormatMatrix::AccCsr);
+            TIME_PROFILE_SCOPE_WORK(M->get_n_values());
             v->validate_rw(FormatVector::AccDense);
 
             std::shared_ptr<CLProgram> program;
             if (!ensure_kernel(op_multiply, op_add, op_select, program)) return Status::CompilationError;
 
             auto* p_cl_r     = r->template get<CLDenseVec<T>>();
-            auto* p_cl_mask  = mask->template get<CLDenseVec<T>>();
+            auto* p_cl_mask  = mask ? mask->template get<CLDenseVec<T>>() : nullptr;
             auto* p_cl_M     = M->template get<CLCsr<T>>();
             auto* p_cl_v     = v->template get<CLDenseVec<T>>();
             auto  early_exit = t->get_desc_or_default()->get_early_exit();
 
             auto* p_cl_acc = get_acc_cl();
-            auto& queue    = p_cl_acc->get_queue_default();
+            auto& queue    = p_cl_acc->get_queue_compute();
 
             uint       config_size = 0;
-            cl::Buffer cl_config(p_cl_acc->get_context(), CL_MEM_READ_WRITE | CL_MEM_HOST_NO_ACCESS, sizeof(uint) * M->get_n_rows());
+            cl::Buffer cl_config = p_cl_acc->get_alloc_pool()->alloc(sizeof(uint) * M->get_n_rows());
             cl::Buffer cl_config_size(p_cl_acc->get_context(), CL_MEM_READ_WRITE | CL_MEM_HOST_READ_ONLY | CL_MEM_COPY_HOST_PTR, sizeof(uint), &config_size);
 
             auto kernel_config = program->make_kernel("mxv_config");
-            kernel_config.setArg(0, p_cl_mask->Ax);
+            kernel_config.setArg(0, p_cl_mask ? p_cl_mask->Ax : cl::Buffer());
             kernel_config.setArg(1, p_cl_r->Ax);
             kernel_config.setArg(2, cl_config);
             kernel_config.setArg(3, cl_config_size);
@@ -249,21 +261,23 @@ namespace spla {
                            const ref_ptr<TOpBinary<T, T, T>>& op_add,
                            const ref_ptr<TOpSelect<T>>&       op_select,
                            std::shared_ptr<CLProgram>&        program) {
-            m_block_size  = get_acc_cl()->get_wave_size();
-            m_block_count = 1;
+            m_block_size          = get_acc_cl()->get_wave_size();
+            m_adaptive_block_size = get_acc_cl()->get_default_wgs();
 
-            assert(m_block_count >= 1);
+            assert(m_adaptive_block_size <= ADAPTIVE_BLOCK_NNZ);
 
             CLProgramBuilder program_builder;
             program_builder
                     .set_name("mxv")
-                    .add_define("WARP_SIZE", get_acc_cl()->get_wave_size())
-                    .add_define("BLOCK_SIZE", m_block_size)
-                    .add_define("BLOCK_COUNT", m_block_count)
+                    .add_define("ADAPTIVE_BLOCK_NNZ", ADAPTIVE_BLOCK_NNZ)
+                    .add_define("MASK_MODE", static_cast<int>(m_mask_mode))
                     .add_type("TYPE", get_ttype<T>().template as<Type>())
                     .add_op("OP_BINARY1", op_multiply.template as<OpBinary>())
-                    .add_op("OP_BINARY2", op_add.template as<OpBinary>())
-                    .add_op("OP_SELECT", op_select.template as<OpSelect>())
+                    .add_op("OP_BINARY2", op_add.template as<OpBinary>());
+            if (op_select) {
+                program_builder.add_op("OP_SELECT", op_select.template as<OpSelect>());
+            }
+            program_builder
                     .set_source(source_mxv)
                     .acquire();
 
@@ -273,8 +287,14 @@ namespace spla {
         }
 
     private:
-        uint m_block_size  = 0;
-        uint m_block_count = 0;
+        /** Max values count of block of several rows, streamed through local memory */
+        static constexpr uint ADAPTIVE_BLOCK_NNZ = 1024;
+        /** Target count of rows and values consumed by single work-item of merge-path kernel */
+        static constexpr uint MERGE_PATH_ITEMS_PER_THREAD = 16;
+
+        uint       m_block_size          = 0;
+        uint       m_adaptive_block_size = 0;
+        CLMaskMode m_mask_mode           = CLMaskMode::Valued;
     };
 
 }// namespace spla
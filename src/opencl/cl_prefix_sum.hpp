@@ -35,6 +35,24 @@
 
 namespace spla {
 
+    template<typename T>
+    std::shared_ptr<CLProgram> cl_prefix_sum_program(const ref_ptr<TOpBinary<T, T, T>>& op) {
+        auto*      cl_acc     = get_acc_cl();
+        const uint block_size = std::min(cl_acc->get_max_wgs(), uint(256));
+
+        CLProgramBuilder builder;
+        builder.set_name("prefix_sum")
+                .add_type("TYPE", get_ttype<T>().template as<Type>())
+                .add_define("BLOCK_SIZE", block_size)
+                .add_define("WARP_SIZE", cl_acc->get_wave_size())
+                .add_define("LM_NUM_MEM_BANKS", cl_acc->get_num_of_mem_banks())
+                .add_op("OP_BINARY", op.template as<OpBinary>())
+                .set_source(source_prefix_sum)
+                .acquire();
+
+        return builder.get_program();
+    }
+
     template<typename T>
     void cl_exclusive_scan(cl::CommandQueue& queue, cl::Buffer& values, uint n, const ref_ptr<TOpBinary<T, T, T>>& op, CLAlloc* tmp_alloc) {
         auto*      cl_acc           = get_acc_cl();
@@ -47,20 +65,12 @@ namespace spla {
         //  - no BC (basic) : 1M values in ms: 2.727, 2.822, 2.726, 2.83, 2.773, 2.773, 2.841, 2.824, 2.792
         //  - no BC (unroll): 1M values in ms: 2.862, 2.775, 2.776, 2.77, 2.653, 2.677, 2.93, 2.748, 2.693
 
-        CLProgramBuilder builder;
-        builder.set_name("prefix_sum")
-                .add_type("TYPE", get_ttype<T>().template as<Type>())
-                .add_define("BLOCK_SIZE", block_size)
-                .add_define("WARP_SIZE", cl_acc->get_wave_size())
-                .add_define("LM_NUM_MEM_BANKS", cl_acc->get_num_of_mem_banks())
-                .add_op("OP_BINARY", op.template as<OpBinary>())
-                .set_source(source_prefix_sum)
-                .acquire();
+        auto program = cl_prefix_sum_program<T>(op);
 
         uint       n_groups_to_run = n / values_per_block + (n % values_per_block ? 1 : 0);
         cl::Buffer cl_carry        = tmp_alloc->alloc(sizeof(T) * n_groups_to_run);
 
-        auto kernel_prescan = builder.make_kernel("prefix_sum_prescan_unroll");
+        auto kernel_prescan = program->make_kernel("prefix_sum_prescan_unroll");
         kernel_prescan.setArg(0, values);
         kernel_prescan.setArg(1, cl_carry);
         kernel_prescan.setArg(2, n);
@@ -72,7 +82,7 @@ namespace spla {
         if (n_groups_to_run > 1) {
             cl_exclusive_scan<T>(queue, cl_carry, n_groups_to_run, op, tmp_alloc);
 
-            auto kernel_propagate = builder.make_kernel("prefix_sum_propagate");
+            auto kernel_propagate = program->make_kernel("prefix_sum_propagate");
             kernel_propagate.setArg(0, values);
             kernel_propagate.setArg(1, cl_carry);
             kernel_propagate.setArg(2, n);
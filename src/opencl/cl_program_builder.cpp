@@ -27,6 +27,7 @@
 
 #include "cl_program_builder.hpp"
 
+#include <opencl/cl_program_disk_cache.hpp>
 #include <opencl/generated/auto_common_api.hpp>
 #include <spla/timer.hpp>
 
@@ -34,6 +35,8 @@
 
 namespace spla {
 
+    static const char* BUILD_OPTIONS = "-cl-std=CL1.2";
+
     CLProgramBuilder& CLProgramBuilder::set_name(const char* name) {
         m_name = name;
         return *this;
@@ -66,12 +69,9 @@ namespace spla {
         CLAccelerator*  acc   = get_acc_cl();
         CLProgramCache* cache = acc->get_cache();
 
-        std::stringstream cache_key;
-        cache_key << m_name;
-        for (auto& entry : m_defines) cache_key << entry.first << entry.second;
-        for (auto& entry : m_functions) cache_key << entry.first << entry.second->get_name();
+        const std::string key = make_key();
 
-        m_program = cache->get_program(cache_key.str());
+        m_program = cache->get_program(key);
 
         if (m_program) {
 #ifdef SPLA_DEBUG
@@ -80,6 +80,16 @@ namespace spla {
             return;
         }
 
+        // Key is reserved by this builder now, so it must be released if build fails
+        struct BuildGuard {
+            CLProgramCache*    cache;
+            const std::string& key;
+            bool               done = false;
+            ~BuildGuard() {
+                if (!done) cache->cancel_program(key);
+            }
+        } guard{cache, key};
+
         std::stringstream builder;
 
         for (const auto& define : m_defines) {
@@ -93,30 +103,84 @@ namespace spla {
         }
         builder << m_source;
 
-        m_program_code       = builder.str();
-        m_program            = std::make_shared<CLProgram>();
-        m_program->m_program = cl::Program(acc->get_context(), m_program_code);
+        m_program_code = builder.str();
+        m_program      = std::make_shared<CLProgram>();
+
+        CLProgramDiskCache*        disk_cache = acc->get_disk_cache();
+        std::string                disk_key;
+        std::vector<unsigned char> binary;
+        bool                       from_disk = false;
 
         Timer t;
         t.start();
-        auto status = m_program->m_program.build("-cl-std=CL1.2");
-        t.stop();
 
-        if (status != CL_SUCCESS) {
-            LOG_MSG(Status::Error, "failed to build program: " << m_program->m_program.getBuildInfo<CL_PROGRAM_BUILD_LOG>(acc->get_device()));
-            LOG_MSG(Status::Error, "src\n" << m_source);
-            throw std::runtime_error("failed to build program");
+        if (disk_cache) {
+            disk_key  = acc->get_device_identity() + "\n" + BUILD_OPTIONS + "\n" + m_program_code;
+            from_disk = disk_cache->load(disk_key, binary) && build_from_binary(acc, binary);
+        }
+
+        if (!from_disk) {
+            m_program->m_program = cl::Program(acc->get_context(), m_program_code);
+
+            auto status = m_program->m_program.build(BUILD_OPTIONS);
+
+            if (status != CL_SUCCESS) {
+                LOG_MSG(Status::Error, "failed to build program: " << m_program->m_program.getBuildInfo<CL_PROGRAM_BUILD_LOG>(acc->get_device()));
+                LOG_MSG(Status::Error, "src\n" << m_source);
+                throw std::runtime_error("failed to build program");
+            }
+
+            if (disk_cache) {
+                auto binaries = m_program->m_program.getInfo<CL_PROGRAM_BINARIES>();
+                if (binaries.size() == 1) disk_cache->store(disk_key, binaries.front());
+            }
         }
 
+        t.stop();
+
         m_program->m_sources.emplace_back(m_source);
         m_program->m_defines   = std::move(m_defines);
         m_program->m_functions = std::move(m_functions);
         m_program->m_source    = std::move(m_program_code);
         m_program->m_name      = std::move(m_name);
-        m_program->m_key       = cache_key.str();
-        LOG_MSG(Status::Ok, "build program '" << m_program->m_name << "' in " << t.get_elapsed_sec() << " sec (full name '" << m_program->m_key << "')");
+        m_program->m_key       = key;
+        LOG_MSG(Status::Ok, (from_disk ? "load program '" : "build program '") << m_program->m_name << "' in " << t.get_elapsed_sec() << " sec (full name '" << m_program->m_key << "')");
 
+        guard.done = true;
         cache->add_program(m_program);
     }
+    std::string CLProgramBuilder::make_key() const {
+        std::stringstream key;
+        key << m_name;
+        for (auto& entry : m_defines) key << entry.first << entry.second;
+        for (auto& entry : m_functions) key << entry.first << entry.second->get_name();
+        return key.str();
+    }
+
+    bool CLProgramBuilder::build_from_binary(CLAccelerator* acc, const std::vector<unsigned char>& binary) {
+        // Plain api is used, since stale or corrupted binary is expected and must not throw
+        cl_device_id         device        = acc->get_device()();
+        const unsigned char* binary_ptr    = binary.data();
+        const std::size_t    binary_size   = binary.size();
+        cl_int               binary_status = CL_SUCCESS;
+        cl_int               status        = CL_SUCCESS;
+
+        cl_program program = clCreateProgramWithBinary(acc->get_context()(), 1, &device, &binary_size, &binary_ptr, &binary_status, &status);
+
+        if (status != CL_SUCCESS || binary_status != CL_SUCCESS) {
+            if (program) clReleaseProgram(program);
+            LOG_MSG(Status::Ok, "rebuild program '" << m_name << "', cached binary is rejected by device");
+            return false;
+        }
+
+        if (clBuildProgram(program, 1, &device, BUILD_OPTIONS, nullptr, nullptr) != CL_SUCCESS) {
+            clReleaseProgram(program);
+            LOG_MSG(Status::Ok, "rebuild program '" << m_name << "', failed to build cached binary");
+            return false;
+        }
+
+        m_program->m_program = cl::Program(program, false);
+        return true;
+    }
 
 }// namespace spla
\ No newline at end of file
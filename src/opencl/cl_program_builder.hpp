@@ -67,6 +67,9 @@ namespace spla {
         cl::Kernel                        make_kernel(const char* name) { return m_program->make_kernel(name); }
 
     private:
+        bool                      build_from_binary(CLAccelerator* acc, const std::vector<unsigned char>& binary);
+        [[nodiscard]] std::string make_key() const;
+
         ankerl::svector<std::pair<std::string, std::string>, 8> m_defines;
         ankerl::svector<std::pair<std::string, ref_ptr<Op>>, 8> m_functions;
         std::string                                             m_name;
@@ -30,12 +30,36 @@
 namespace spla {
 
     void CLProgramCache::add_program(const std::shared_ptr<CLProgram>& program) {
-        m_programs[program->get_key()] = program;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_programs[program->get_key()] = program;
+            m_building.erase(program->get_key());
+        }
+        m_built.notify_all();
         LOG_MSG(Status::Ok, "cache program '" << program->get_name() << "'");
     }
-    std::shared_ptr<CLProgram> CLProgramCache::get_program(const std::string& source) {
-        auto query = m_programs.find(source);
-        return query != m_programs.end() ? query->second : nullptr;
+    void CLProgramCache::cancel_program(const std::string& key) {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_building.erase(key);
+        }
+        m_built.notify_all();
+    }
+    std::shared_ptr<CLProgram> CLProgramCache::get_program(const std::string& key) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+
+        while (m_building.find(key) != m_building.end()) {
+            m_built.wait(lock);
+        }
+
+        auto query = m_programs.find(key);
+        if (query != m_programs.end()) {
+            return query->second;
+        }
+
+        // Not found, so caller builds it, while others wait
+        m_building.insert(key);
+        return nullptr;
     }
 
 }// namespace spla
\ No newline at end of file
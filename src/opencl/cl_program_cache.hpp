@@ -33,6 +33,8 @@
 
 #include <robin_hood.hpp>
 
+#include <condition_variable>
+#include <mutex>
 #include <string>
 
 namespace spla {
@@ -45,14 +47,23 @@ namespace spla {
     /**
      * @class CLProgramCache
      * @brief Runtime cache for compiled opencl programs
+     *
+     * Cache is shared by dispatching thread and background precompilation thread.
+     * Program requested by key is either returned from cache, or waited for if it
+     * is being built by other thread, or reserved for the caller to build it.
+     * Caller which reserved a key must then either add or cancel the program.
      */
     class CLProgramCache {
     public:
         void                       add_program(const std::shared_ptr<CLProgram>& program);
-        std::shared_ptr<CLProgram> get_program(const std::string& source);
+        void                       cancel_program(const std::string& key);
+        std::shared_ptr<CLProgram> get_program(const std::string& key);
 
     private:
         robin_hood::unordered_flat_map<std::string, std::shared_ptr<CLProgram>> m_programs;
+        robin_hood::unordered_flat_set<std::string>                             m_building;
+        std::mutex                                                              m_mutex;
+        std::condition_variable                                                 m_built;
     };
 
     /**
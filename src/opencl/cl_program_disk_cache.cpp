@@ -0,0 +1,198 @@
+/**********************************************************************************/
+/* This file is part of spla project                                              */
+/* https://github.com/SparseLinearAlgebra/spla                                    */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2023 SparseLinearAlgebra                                         */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#include "cl_program_disk_cache.hpp"
+
+#include <core/logger.hpp>
+#include <spla/library.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <system_error>
+#include <thread>
+
+namespace spla {
+
+    static const char        CACHE_MAGIC[8] = {'S', 'P', 'L', 'A', 'C', 'L', 'B', '1'};
+    static const std::string CACHE_EXT      = ".clbin";
+
+    static std::uint64_t fnv1a(const std::string& text) {
+        std::uint64_t hash = 0xcbf29ce484222325ull;
+        for (const char c : text) {
+            hash ^= std::uint64_t(static_cast<unsigned char>(c));
+            hash *= 0x100000001b3ull;
+        }
+        return hash;
+    }
+
+    static bool read_u64(std::istream& in, std::uint64_t& value) {
+        return bool(in.read(reinterpret_cast<char*>(&value), sizeof(value)));
+    }
+
+    static void write_u64(std::ostream& out, std::uint64_t value) {
+        out.write(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+
+    CLProgramDiskCache::CLProgramDiskCache(std::filesystem::path dir, std::size_t max_size)
+        : m_dir(std::move(dir)), m_max_size(max_size) {
+        std::error_code ec;
+        std::filesystem::create_directories(m_dir, ec);
+
+        if (ec) {
+            LOG_MSG(Status::Error, "failed to create program cache dir " << m_dir << ": " << ec.message());
+        }
+    }
+
+    bool CLProgramDiskCache::load(const std::string& key, std::vector<unsigned char>& binary) {
+        const std::filesystem::path path = make_path(key);
+        std::ifstream               file(path, std::ios::binary);
+
+        if (!file.is_open()) {
+            return false;
+        }
+
+        char          magic[sizeof(CACHE_MAGIC)];
+        std::uint64_t key_size    = 0;
+        std::uint64_t binary_size = 0;
+
+        if (!file.read(magic, sizeof(magic)) || !std::equal(magic, magic + sizeof(magic), CACHE_MAGIC)) return false;
+        if (!read_u64(file, key_size) || key_size != key.size()) return false;
+
+        std::string stored_key(key_size, '\0');
+        if (!file.read(stored_key.data(), std::streamsize(key_size)) || stored_key != key) return false;
+        if (!read_u64(file, binary_size) || binary_size == 0) return false;
+
+        binary.resize(binary_size);
+        if (!file.read(reinterpret_cast<char*>(binary.data()), std::streamsize(binary_size))) return false;
+
+        // Mark entry as recently used for eviction
+        std::error_code ec;
+        std::filesystem::last_write_time(path, std::filesystem::file_time_type::clock::now(), ec);
+
+        return true;
+    }
+
+    void CLProgramDiskCache::store(const std::string& key, const std::vector<unsigned char>& binary) {
+        if (binary.empty()) {
+            return;
+        }
+
+        const std::filesystem::path path = make_path(key);
+
+        std::stringstream tmp_name;
+        tmp_name << path.filename().string() << ".tmp"
+                 << std::hash<std::thread::id>()(std::this_thread::get_id())
+                 << std::chrono::steady_clock::now().time_since_epoch().count();
+        const std::filesystem::path tmp_path = m_dir / tmp_name.str();
+
+        {
+            std::ofstream file(tmp_path, std::ios::binary | std::ios::trunc);
+
+            if (!file.is_open()) {
+                LOG_MSG(Status::Error, "failed to open program cache file " << tmp_path);
+                return;
+            }
+
+            file.write(CACHE_MAGIC, sizeof(CACHE_MAGIC));
+            write_u64(file, key.size());
+            file.write(key.data(), std::streamsize(key.size()));
+            write_u64(file, binary.size());
+            file.write(reinterpret_cast<const char*>(binary.data()), std::streamsize(binary.size()));
+
+            if (!file.good()) {
+                file.close();
+                std::error_code ec;
+                std::filesystem::remove(tmp_path, ec);
+                LOG_MSG(Status::Error, "failed to write program cache file " << tmp_path);
+                return;
+            }
+        }
+
+        std::error_code ec;
+        std::filesystem::rename(tmp_path, path, ec);
+
+        if (ec) {
+            std::filesystem::remove(tmp_path, ec);
+            LOG_MSG(Status::Error, "failed to store program cache file " << path);
+            return;
+        }
+
+        evict(path);
+    }
+
+    std::filesystem::path CLProgramDiskCache::make_path(const std::string& key) const {
+        std::stringstream name;
+        name << std::hex << std::setw(16) << std::setfill('0') << fnv1a(key) << CACHE_EXT;
+        return m_dir / name.str();
+    }
+
+    void CLProgramDiskCache::evict(const std::filesystem::path& keep) {
+        struct Entry {
+            std::filesystem::path           path;
+            std::filesystem::file_time_type time;
+            std::uintmax_t                  size;
+        };
+
+        std::vector<Entry> entries;
+        std::uintmax_t     total_size = 0;
+        std::error_code    ec;
+
+        for (const auto& item : std::filesystem::directory_iterator(m_dir, ec)) {
+            if (item.path().extension() != CACHE_EXT) continue;
+
+            Entry entry;
+            entry.path = item.path();
+            entry.time = item.last_write_time(ec);
+            if (ec) continue;
+            entry.size = item.file_size(ec);
+            if (ec) continue;
+
+            total_size += entry.size;
+            entries.push_back(std::move(entry));
+        }
+
+        if (total_size <= m_max_size) {
+            return;
+        }
+
+        std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) { return a.time < b.time; });
+
+        for (const Entry& entry : entries) {
+            if (total_size <= m_max_size) break;
+            if (entry.path == keep) continue;
+
+            if (std::filesystem::remove(entry.path, ec)) {
+                total_size -= entry.size;
+                LOG_MSG(Status::Ok, "evict program cache file " << entry.path);
+            }
+        }
+    }
+
+}// namespace spla
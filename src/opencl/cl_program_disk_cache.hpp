@@ -0,0 +1,85 @@
+/**********************************************************************************/
+/* This file is part of spla project                                              */
+/* https://github.com/SparseLinearAlgebra/spla                                    */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2023 SparseLinearAlgebra                                         */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#ifndef SPLA_CL_PROGRAM_DISK_CACHE_HPP
+#define SPLA_CL_PROGRAM_DISK_CACHE_HPP
+
+#include <spla/config.hpp>
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace spla {
+
+    /**
+     * @addtogroup internal
+     * @{
+     */
+
+    /**
+     * @class CLProgramDiskCache
+     * @brief Persistent on-disk cache of compiled opencl programs binaries
+     *
+     * Each entry is a single file named by hash of the entry key, where key is a full
+     * text of device identity, build options and program source. Key is stored in the
+     * file along with the binary and compared on load, so hash collisions and entries
+     * of other devices or drivers are never loaded; those are rebuilt and overwritten.
+     *
+     * Cache size is limited: on store least recently used entries (by modification time,
+     * updated on each load) are removed until total size fits the limit.
+     * Entries are written to temporary files and renamed, so concurrent processes
+     * sharing the same directory never observe partially written entries.
+     */
+    class CLProgramDiskCache {
+    public:
+        CLProgramDiskCache(std::filesystem::path dir, std::size_t max_size);
+
+        bool load(const std::string& key, std::vector<unsigned char>& binary);
+        void store(const std::string& key, const std::vector<unsigned char>& binary);
+
+        [[nodiscard]] const std::filesystem::path& get_dir() const { return m_dir; }
+        [[nodiscard]] std::size_t                  get_max_size() const { return m_max_size; }
+
+        static constexpr std::size_t DEFAULT_MAX_SIZE = 256 * 1024 * 1024;
+
+    private:
+        [[nodiscard]] std::filesystem::path make_path(const std::string& key) const;
+        void                                evict(const std::filesystem::path& keep);
+
+        std::filesystem::path m_dir;
+        std::size_t           m_max_size;
+    };
+
+    /**
+     * @}
+     */
+
+}// namespace spla
+
+#endif//SPLA_CL_PROGRAM_DISK_CACHE_HPP
@@ -0,0 +1,113 @@
+/**********************************************************************************/
+/* This file is part of spla project                                              */
+/* https://github.com/SparseLinearAlgebra/spla                                    */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2023 SparseLinearAlgebra                                         */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#include "cl_program_precompiler.hpp"
+
+#include <opencl/cl_fill.hpp>
+#include <opencl/cl_format_coo_vec.hpp>
+#include <opencl/cl_mxv.hpp>
+#include <opencl/cl_vxm.hpp>
+#include <spla/timer.hpp>
+
+#include <exception>
+#include <functional>
+#include <vector>
+
+namespace spla {
+
+    template<typename T>
+    static void precompile_vector_helpers() {
+        cl_fill_program<T>();
+        cl_vector_format_program<T>();
+    }
+
+    template<typename T>
+    static void precompile_products(const ref_ptr<OpBinary>& op_multiply,
+                                    const ref_ptr<OpBinary>& op_add,
+                                    const ref_ptr<OpSelect>& op_select,
+                                    CLMaskMode               mask_mode) {
+        auto t_op_multiply = op_multiply.template cast_safe<TOpBinary<T, T, T>>();
+        auto t_op_add      = op_add.template cast_safe<TOpBinary<T, T, T>>();
+        auto t_op_select   = op_select.template cast_safe<TOpSelect<T>>();
+
+        Algo_vxm_masked_cl<T>().precompile(t_op_multiply, t_op_add, t_op_select, mask_mode);
+        Algo_mxv_masked_cl<T>().precompile(t_op_multiply, t_op_add, t_op_select, mask_mode);
+    }
+
+    CLProgramPrecompiler::~CLProgramPrecompiler() {
+        stop();
+    }
+
+    void CLProgramPrecompiler::start() {
+        if (is_running()) return;
+
+        m_stop.store(false);
+        m_thread = std::thread([this]() { run(); });
+    }
+    void CLProgramPrecompiler::stop() {
+        if (!is_running()) return;
+
+        m_stop.store(true);
+        m_thread.join();
+    }
+
+    void CLProgramPrecompiler::run() {
+        // Ordered by expected first use: traversals start with the products under complement mask
+        const std::vector<std::function<void()>> jobs = {
+                []() { precompile_products<T_INT>(BAND_INT, BOR_INT, EQZERO_INT, CLMaskMode::Valued); },
+                []() { precompile_vector_helpers<T_INT>(); },
+                []() { precompile_vector_helpers<T_FLOAT>(); },
+                []() { precompile_products<T_FLOAT>(MULT_FLOAT, PLUS_FLOAT, ref_ptr<OpSelect>(), CLMaskMode::None); },
+                []() { precompile_vector_helpers<T_UINT>(); },
+                []() { precompile_products<T_INT>(MULT_INT, PLUS_INT, ref_ptr<OpSelect>(), CLMaskMode::None); },
+                []() { precompile_products<T_UINT>(MULT_UINT, PLUS_UINT, ref_ptr<OpSelect>(), CLMaskMode::None); }};
+
+        Timer t;
+        t.start();
+
+        std::size_t done = 0;
+
+        for (const auto& job : jobs) {
+            if (m_stop.load()) break;
+
+            // Failed program is built again on demand, where its error is reported to the caller
+            try {
+                job();
+            } catch (const std::exception& e) {
+                LOG_MSG(Status::Error, "failed to precompile program: " << e.what());
+            } catch (...) {
+                LOG_MSG(Status::Error, "failed to precompile program");
+            }
+
+            done += 1;
+        }
+
+        t.stop();
+        LOG_MSG(Status::Ok, "precompile " << done << "/" << jobs.size() << " program groups in " << t.get_elapsed_sec() << " sec");
+    }
+
+}// namespace spla
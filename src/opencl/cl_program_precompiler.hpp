@@ -1,10 +1,10 @@
 /**********************************************************************************/
 /* This file is part of spla project                                              */
-/* https://github.com/JetBrains-Research/spla                                     */
+/* https://github.com/SparseLinearAlgebra/spla                                    */
 /**********************************************************************************/
 /* MIT License                                                                    */
 /*                                                                                */
-/* Copyright (c) 2021 JetBrains-Research                                          */
+/* Copyright (c) 2023 SparseLinearAlgebra                                         */
 /*                                                                                */
 /* Permission is hereby granted, free of charge, to any person obtaining a copy   */
 /* of this software and associated documentation files (the "Software"), to deal  */
@@ -25,37 +25,51 @@
 /* SOFTWARE.                                                                      */
 /**********************************************************************************/
 
-#include "cl_alloc_general.hpp"
+#ifndef SPLA_CL_PROGRAM_PRECOMPILER_HPP
+#define SPLA_CL_PROGRAM_PRECOMPILER_HPP
+
+#include <atomic>
+#include <thread>
 
 namespace spla {
 
-    cl::Buffer CLAllocGeneral::alloc(std::size_t size) {
-        return cl::Buffer(get_acc_cl()->get_context(), CL_MEM_READ_WRITE | CL_MEM_HOST_NO_ACCESS, size);
-    }
-    void CLAllocGeneral::alloc_paired(std::size_t size1, std::size_t size2, cl::Buffer& buffer1, cl::Buffer& buffer2) {
-        auto* cl_acc = get_acc_cl();
-
-        if (cl_acc->is_nvidia()) {
-            buffer1 = alloc(size1);
-            buffer2 = alloc(size2);
-            return;
-        }
-
-        const uint  alignment     = cl_acc->get_addr_align();
-        std::size_t offset        = aligns(size1, alignment);
-        std::size_t size          = offset + aligns(size2, alignment);
-        cl::Buffer  source_buffer = alloc(size);
-
-        std::size_t range1[2] = {0, size1};
-        buffer1               = source_buffer.createSubBuffer(CL_MEM_READ_WRITE, CL_BUFFER_CREATE_TYPE_REGION, range1);
-        std::size_t range2[2] = {offset, size2};
-        buffer2               = source_buffer.createSubBuffer(CL_MEM_READ_WRITE, CL_BUFFER_CREATE_TYPE_REGION, range2);
-    }
-    void CLAllocGeneral::free(cl::Buffer buffer) {
-        // nothing to do
-    }
-    void CLAllocGeneral::free_all() {
-        // nothing to do
-    }
+    /**
+     * @addtogroup internal
+     * @{
+     */
+
+    /**
+     * @class CLProgramPrecompiler
+     * @brief Builds programs of built-in algorithms on a background thread
+     *
+     * Programs are built for standard types (INT, UINT, FLOAT) and ops of built-in
+     * algorithms, ordered by the expected first use, so the first iterations of
+     * algorithms do not pay for runtime compilation. Built programs go to the
+     * accelerator program cache; a dispatch which needs a program being built
+     * at the moment waits for it in the cache instead of building it twice.
+     *
+     * Other programs (custom ops, other mask modes) are still compiled on demand.
+     */
+    class CLProgramPrecompiler {
+    public:
+        ~CLProgramPrecompiler();
+
+        void start();
+        void stop();
+
+        [[nodiscard]] bool is_running() const { return m_thread.joinable(); }
+
+    private:
+        void run();
+
+        std::thread       m_thread;
+        std::atomic<bool> m_stop{false};
+    };
+
+    /**
+     * @}
+     */
 
 }// namespace spla
+
+#endif//SPLA_CL_PROGRAM_PRECOMPILER_HPP
@@ -30,7 +30,7 @@
 
 #include <opencl/cl_accelerator.hpp>
 #include <opencl/cl_alloc.hpp>
-#include <opencl/cl_alloc_general.hpp>
+#include <opencl/cl_alloc_pool.hpp>
 #include <opencl/cl_counter.hpp>
 #include <opencl/cl_prefix_sum.hpp>
 #include <opencl/cl_program_builder.hpp>
@@ -39,6 +39,19 @@
 
 namespace spla {
 
+    template<typename T>
+    std::shared_ptr<CLProgram> cl_reduce_by_key_program(const ref_ptr<TOpBinary<T, T, T>>& reduce_op) {
+        CLProgramBuilder builder;
+        builder.set_name("reduce_by_key")
+                .add_type("TYPE", get_ttype<T>().template as<Type>())
+                .add_define("BLOCK_SIZE", get_acc_cl()->get_max_wgs())
+                .add_op("OP_BINARY", reduce_op.template as<OpBinary>())
+                .set_source(source_reduce_by_key)
+                .acquire();
+
+        return builder.get_program();
+    }
+
     template<typename T>
     void cl_reduce_by_key(cl::CommandQueue& queue,
                           const cl::Buffer& keys, const cl::Buffer& values, const uint size,
@@ -47,15 +60,9 @@ namespace spla {
         TIME_PROFILE_SCOPE("opencl/reduce_by_key");
 
         auto* cl_acc = get_acc_cl();
-        auto* alloc  = cl_acc->get_alloc_general();
+        auto* alloc  = cl_acc->get_alloc_pool();
 
-        CLProgramBuilder builder;
-        builder.set_name("reduce_by_key")
-                .add_type("TYPE", get_ttype<T>().template as<Type>())
-                .add_define("BLOCK_SIZE", cl_acc->get_max_wgs())
-                .add_op("OP_BINARY", reduce_op.template as<OpBinary>())
-                .set_source(source_reduce_by_key)
-                .acquire();
+        auto program = cl_reduce_by_key_program<T>(reduce_op);
 
         const uint block_size        = cl_acc->get_default_wgs();
         const uint sequential_switch = 32;
@@ -76,7 +83,7 @@ namespace spla {
             CLCounterWrapper cl_reduced_count;
             alloc->alloc_paired(sizeof(uint) * size, sizeof(T) * size, unique_keys, reduce_values);
 
-            auto kernel_sequential = builder.make_kernel("reduce_by_key_sequential");
+            auto kernel_sequential = program->make_kernel("reduce_by_key_sequential");
             kernel_sequential.setArg(0, keys);
             kernel_sequential.setArg(1, values);
             kernel_sequential.setArg(2, unique_keys);
@@ -100,7 +107,7 @@ namespace spla {
             cl::Kernel kernel_small;
 
             CL_PROFILE_BEGIN("setup-kernel", queue);
-            kernel_small = builder.make_kernel("reduce_by_key_small");
+            kernel_small = program->make_kernel("reduce_by_key_small");
             kernel_small.setArg(0, keys);
             kernel_small.setArg(1, values);
             kernel_small.setArg(2, unique_keys);
@@ -119,7 +126,7 @@ namespace spla {
         // temporary offsets allocation
         cl::Buffer offsets = tmp_alloc->alloc(sizeof(uint) * size);
 
-        auto kernel_gen_offsets = builder.make_kernel("reduce_by_key_generate_offsets");
+        auto kernel_gen_offsets = program->make_kernel("reduce_by_key_generate_offsets");
         kernel_gen_offsets.setArg(0, keys);
         kernel_gen_offsets.setArg(1, offsets);
         kernel_gen_offsets.setArg(2, size);
@@ -130,25 +137,30 @@ namespace spla {
 
         cl_exclusive_scan(queue, offsets, size, PLUS_UINT.template cast_safe<TOpBinary<uint, uint, uint>>(), tmp_alloc);
 
-        CLCounterWrapper cl_scan_last;
-        queue.enqueueCopyBuffer(offsets, cl_scan_last.buffer(), sizeof(uint) * (size - 1), 0, sizeof(uint));
-        uint scan_last = cl_scan_last.get(queue);
-
-        reduced_size = scan_last + 1;
-        alloc->alloc_paired(sizeof(uint) * reduced_size, sizeof(T) * reduced_size, unique_keys, reduce_values);
+        // groups are reduced into temporaries of keys count, so host waits only once for final size
+        cl::Buffer tmp_keys   = tmp_alloc->alloc(sizeof(uint) * size);
+        cl::Buffer tmp_values = tmp_alloc->alloc(sizeof(T) * size);
 
-        auto kernel_reduce_scalar = builder.make_kernel("reduce_by_key_scalar");
+        auto kernel_reduce_scalar = program->make_kernel("reduce_by_key_scalar");
         kernel_reduce_scalar.setArg(0, keys);
         kernel_reduce_scalar.setArg(1, values);
         kernel_reduce_scalar.setArg(2, offsets);
-        kernel_reduce_scalar.setArg(3, unique_keys);
-        kernel_reduce_scalar.setArg(4, reduce_values);
+        kernel_reduce_scalar.setArg(3, tmp_keys);
+        kernel_reduce_scalar.setArg(4, tmp_values);
         kernel_reduce_scalar.setArg(5, size);
-        kernel_reduce_scalar.setArg(6, reduced_size);
 
-        cl::NDRange reduce_naive_global(align(reduced_size, block_size));
+        cl::NDRange reduce_naive_global(align(size, block_size));
         cl::NDRange reduce_naive_local(block_size);
         queue.enqueueNDRangeKernel(kernel_reduce_scalar, cl::NDRange(), reduce_naive_global, reduce_naive_local);
+
+        CLCounterWrapper cl_scan_last;
+        queue.enqueueCopyBuffer(offsets, cl_scan_last.buffer(), sizeof(uint) * (size - 1), 0, sizeof(uint));
+        uint scan_last = cl_scan_last.get(queue);
+
+        reduced_size = scan_last + 1;
+        alloc->alloc_paired(sizeof(uint) * reduced_size, sizeof(T) * reduced_size, unique_keys, reduce_values);
+        queue.enqueueCopyBuffer(tmp_keys, unique_keys, 0, 0, sizeof(uint) * reduced_size);
+        queue.enqueueCopyBuffer(tmp_values, reduce_values, 0, 0, sizeof(T) * reduced_size);
     }
 
 }// namespace spla
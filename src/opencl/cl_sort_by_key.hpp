@@ -30,7 +30,7 @@
 
 #include <opencl/cl_accelerator.hpp>
 #include <opencl/cl_alloc.hpp>
-#include <opencl/cl_alloc_general.hpp>
+#include <opencl/cl_alloc_pool.hpp>
 #include <opencl/cl_prefix_sum.hpp>
 #include <opencl/cl_program_builder.hpp>
 #include <opencl/generated/auto_sort_bitonic.hpp>
@@ -40,6 +40,43 @@
 
 namespace spla {
 
+    template<typename T>
+    std::shared_ptr<CLProgram> cl_sort_bitonic_program(uint local_size) {
+        CLProgramBuilder builder;
+        builder.set_name("sort_bitonic")
+                .add_type("TYPE", get_ttype<T>().template as<Type>())
+                .add_define("BLOCK_SIZE", local_size)
+                .set_source(source_sort_bitonic)
+                .acquire();
+
+        return builder.get_program();
+    }
+
+    template<typename T>
+    uint cl_sort_bitonic_local_size() {
+        const uint pair_size = sizeof(uint) + sizeof(T);
+        return floor_to_pow2(get_acc_cl()->get_max_local_mem() / pair_size);
+    }
+
+    static constexpr uint CL_SORT_RADIX_BITS_COUNT = 4;
+
+    template<typename T>
+    std::shared_ptr<CLProgram> cl_sort_radix_program() {
+        const uint bits_vals = 1 << CL_SORT_RADIX_BITS_COUNT;
+        const uint bits_mask = bits_vals - 1;
+
+        CLProgramBuilder builder;
+        builder.set_name("radix_sort")
+                .add_define("BLOCK_SIZE", get_acc_cl()->get_default_wgs())
+                .add_define("BITS_VALS", bits_vals)
+                .add_define("BITS_MASK", bits_mask)
+                .add_type("TYPE", get_ttype<T>().template as<Type>())
+                .set_source(source_sort_radix)
+                .acquire();
+
+        return builder.get_program();
+    }
+
     template<typename T>
     void cl_sort_by_key_bitonic(cl::CommandQueue& queue, cl::Buffer& keys, cl::Buffer& values, uint size) {
         if (size <= 1) {
@@ -49,20 +86,14 @@ namespace spla {
 
         auto* acc = get_acc_cl();
 
-        const uint pair_size            = sizeof(uint) + sizeof(T);
-        const uint local_size           = floor_to_pow2(acc->get_max_local_mem() / pair_size);
+        const uint local_size           = cl_sort_bitonic_local_size<T>();
         const uint max_treads_per_block = std::min(acc->get_max_wgs(), local_size / 2u);
 
         assert(local_size > 2);
 
-        CLProgramBuilder builder;
-        builder.set_name("sort_bitonic")
-                .add_type("TYPE", get_ttype<T>().template as<Type>())
-                .add_define("BLOCK_SIZE", local_size)
-                .set_source(source_sort_bitonic)
-                .acquire();
+        auto program = cl_sort_bitonic_program<T>(local_size);
 
-        auto kernel_local = builder.make_kernel("bitonic_sort_local");
+        auto kernel_local = program->make_kernel("bitonic_sort_local");
         kernel_local.setArg(0, keys);
         kernel_local.setArg(1, values);
         kernel_local.setArg(2, size);
@@ -83,7 +114,7 @@ namespace spla {
         cl::NDRange step_pre_sort_local(max_treads_per_block);
         queue.enqueueNDRangeKernel(kernel_local, cl::NDRange(), step_pre_sort_global, step_pre_sort_local);
 
-        auto kernel_global = builder.make_kernel("bitonic_sort_global");
+        auto kernel_global = program->make_kernel("bitonic_sort_global");
         kernel_global.setArg(0, keys);
         kernel_global.setArg(1, values);
         kernel_global.setArg(2, size);
@@ -101,21 +132,13 @@ namespace spla {
             return;
         }
 
-        const uint BITS_COUNT = 4;
+        const uint BITS_COUNT = CL_SORT_RADIX_BITS_COUNT;
         const uint BITS_VALS  = 1 << BITS_COUNT;
-        const uint BITS_MASK  = BITS_VALS - 1;
 
         auto*      cl_acc     = get_acc_cl();
         const uint block_size = cl_acc->get_default_wgs();
 
-        CLProgramBuilder builder;
-        builder.set_name("radix_sort")
-                .add_define("BLOCK_SIZE", block_size)
-                .add_define("BITS_VALS", BITS_VALS)
-                .add_define("BITS_MASK", BITS_MASK)
-                .add_type("TYPE", get_ttype<T>().template as<Type>())
-                .set_source(source_sort_radix)
-                .acquire();
+        auto program = cl_sort_radix_program<T>();
 
         const uint n_treads_total = align(n, block_size);
         const uint n_groups       = div_up(n, block_size);
@@ -123,13 +146,13 @@ namespace spla {
 
         cl::Buffer cl_temp_keys;
         cl::Buffer cl_temp_values;
-        cl_acc->get_alloc_general()->alloc_paired(sizeof(uint) * n, sizeof(T) * n, cl_temp_keys, cl_temp_values);
+        cl_acc->get_alloc_pool()->alloc_paired(sizeof(uint) * n, sizeof(T) * n, cl_temp_keys, cl_temp_values);
 
         cl::Buffer cl_offsets     = tmp_alloc->alloc(sizeof(uint) * n);
         cl::Buffer cl_blocks_size = tmp_alloc->alloc(sizeof(uint) * n_blocks_sizes);
 
-        auto kernel_local   = builder.make_kernel("radix_sort_local");
-        auto kernel_scatter = builder.make_kernel("radix_sort_scatter");
+        auto kernel_local   = program->make_kernel("radix_sort_local");
+        auto kernel_scatter = program->make_kernel("radix_sort_scatter");
 
         const uint bits_in_max_key = static_cast<uint>(std::floor(std::log2(float(max_key)))) + 1;
         const uint bits_aligned    = align(bits_in_max_key, BITS_COUNT);
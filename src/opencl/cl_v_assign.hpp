@@ -91,7 +91,7 @@ namespace spla {
             auto*       p_cl_r_dense    = r->template get<CLDenseVec<T>>();
             const auto* p_cl_mask_dense = mask->template get<CLDenseVec<T>>();
             auto*       p_cl_acc        = get_acc_cl();
-            auto&       queue           = p_cl_acc->get_queue_default();
+            auto&       queue           = p_cl_acc->get_queue_compute();
 
             auto kernel_dense_to_dense = program->make_kernel("assign_dense_to_dense");
             kernel_dense_to_dense.setArg(0, p_cl_r_dense->Ax);
@@ -128,7 +128,7 @@ namespace spla {
             auto*       p_cl_r_dense  = r->template get<CLDenseVec<T>>();
             const auto* p_cl_mask_coo = mask->template get<CLCooVec<T>>();
             auto*       p_cl_acc      = get_acc_cl();
-            auto&       queue         = p_cl_acc->get_queue_default();
+            auto&       queue         = p_cl_acc->get_queue_compute();
 
             auto kernel_sparse_to_dense = program->make_kernel("assign_sparse_to_dense");
             kernel_sparse_to_dense.setArg(0, p_cl_r_dense->Ax);
@@ -91,7 +91,7 @@ namespace spla {
             if (!ensure_kernel(program)) return Status::CompilationError;
 
             auto* cl_acc = get_acc_cl();
-            auto& queue  = cl_acc->get_queue_default();
+            auto& queue  = cl_acc->get_queue_compute();
 
             CLCounterWrapper cl_count;
             cl_count.set(queue, 0);
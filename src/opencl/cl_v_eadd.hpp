@@ -92,7 +92,7 @@ namespace spla {
             const auto* p_cl_u   = u->template get<CLDenseVec<T>>();
             const auto* p_cl_v   = v->template get<CLDenseVec<T>>();
             auto*       p_cl_acc = get_acc_cl();
-            auto&       queue    = p_cl_acc->get_queue_default();
+            auto&       queue    = p_cl_acc->get_queue_compute();
 
             const uint n = r->get_n_rows();
 
@@ -95,15 +95,15 @@ namespace spla {
             const auto* p_cl_v   = v->template get<CLCooVec<T>>();
             auto*       p_cl_fdb = fdb->template get<CLCooVec<T>>();
             auto*       p_cl_acc = get_acc_cl();
-            auto&       queue    = p_cl_acc->get_queue_default();
+            auto&       queue    = p_cl_acc->get_queue_compute();
 
             const uint n = p_cl_v->values;
 
             if (n == 0) return Status::Ok;
 
             CLCounterWrapper cl_fdb_size;
-            cl::Buffer       cl_fdb_i(p_cl_acc->get_context(), CL_MEM_READ_WRITE | CL_MEM_HOST_NO_ACCESS, sizeof(uint) * n);
-            cl::Buffer       cl_fdb_x(p_cl_acc->get_context(), CL_MEM_READ_WRITE | CL_MEM_HOST_NO_ACCESS, sizeof(T) * n);
+            cl::Buffer       cl_fdb_i = p_cl_acc->get_alloc_pool()->alloc(sizeof(uint) * n);
+            cl::Buffer       cl_fdb_x = p_cl_acc->get_alloc_pool()->alloc(sizeof(T) * n);
 
             cl_fdb_size.set(queue, 0);
 
@@ -147,7 +147,7 @@ namespace spla {
             const auto* p_cl_v   = v->template get<CLDenseVec<T>>();
             auto*       p_cl_fdb = fdb->template get<CLDenseVec<T>>();
             auto*       p_cl_acc = get_acc_cl();
-            auto&       queue    = p_cl_acc->get_queue_default();
+            auto&       queue    = p_cl_acc->get_queue_compute();
 
             const uint n = r->get_n_rows();
 
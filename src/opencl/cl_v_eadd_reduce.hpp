@@ -0,0 +1,136 @@
+/**********************************************************************************/
+/* This file is part of spla project                                              */
+/* https://github.com/SparseLinearAlgebra/spla                                    */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2023 SparseLinearAlgebra                                         */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#ifndef SPLA_CL_V_EADD_REDUCE_HPP
+#define SPLA_CL_V_EADD_REDUCE_HPP
+
+#include <schedule/schedule_tasks.hpp>
+
+#include <core/dispatcher.hpp>
+#include <core/registry.hpp>
+#include <core/top.hpp>
+#include <core/tscalar.hpp>
+#include <core/ttype.hpp>
+#include <core/tvector.hpp>
+
+#include <opencl/cl_formats.hpp>
+#include <opencl/cl_program_builder.hpp>
+#include <opencl/cl_reduce.hpp>
+#include <opencl/generated/auto_vector_eadd_reduce.hpp>
+
+#include <sstream>
+
+namespace spla {
+
+    template<typename T>
+    class Algo_v_eadd_reduce_cl final : public RegistryAlgo {
+    public:
+        ~Algo_v_eadd_reduce_cl() override = default;
+
+        std::string get_name() override {
+            return "v_eadd_reduce";
+        }
+
+        std::string get_description() override {
+            return "parallel element-wise vector operation with reduction on opencl device";
+        }
+
+        Status execute(const DispatchContext& ctx) override {
+            return execute_dn2dn(ctx);
+        }
+
+    private:
+        Status execute_dn2dn(const DispatchContext& ctx) {
+            TIME_PROFILE_SCOPE("opencl/vector_eadd_reduce_dn2dn");
+
+            auto t = ctx.task.template cast_safe<ScheduleTask_v_eadd_reduce>();
+
+            auto r         = t->r.template cast_safe<TScalar<T>>();
+            auto s         = t->s.template cast_safe<TScalar<T>>();
+            auto u         = t->u.template cast_safe<TVector<T>>();
+            auto v         = t->v.template cast_safe<TVector<T>>();
+            auto op_elem   = t->op_elem.template cast_safe<TOpBinary<T, T, T>>();
+            auto op_reduce = t->op_reduce.template cast_safe<TOpBinary<T, T, T>>();
+
+            u->validate_rw(FormatVector::AccDense);
+            v->validate_rw(FormatVector::AccDense);
+
+            const auto* p_cl_u   = u->template get<CLDenseVec<T>>();
+            const auto* p_cl_v   = v->template get<CLDenseVec<T>>();
+            auto*       p_cl_acc = get_acc_cl();
+            auto&       queue    = p_cl_acc->get_queue_compute();
+
+            const uint n    = u->get_n_rows();
+            const T    init = s->get_value();
+
+            if (n == 0) {
+                r->get_value() = init;
+                return Status::Ok;
+            }
+
+            const uint max_block_size = 1024;
+            const uint block_size     = std::min(max_block_size, p_cl_acc->get_max_wgs());
+            const uint optimal_split  = 64;
+            const uint groups_count   = div_up_clamp(n, block_size, 1, optimal_split);
+
+            CLProgramBuilder builder;
+            builder.set_name("vector_eadd_reduce")
+                    .add_define("WARP_SIZE", p_cl_acc->get_wave_size())
+                    .add_define("BLOCK_SIZE", block_size)
+                    .add_type("TYPE", get_ttype<T>().template as<Type>())
+                    .add_op("OP_BINARY1", op_elem.template as<OpBinary>())
+                    .add_op("OP_BINARY2", op_reduce.template as<OpBinary>())
+                    .set_source(source_vector_eadd_reduce)
+                    .acquire();
+
+            cl::Buffer cl_sum_group(p_cl_acc->get_context(), CL_MEM_READ_WRITE | CL_MEM_HOST_READ_ONLY, sizeof(T) * groups_count);
+
+            auto kernel = builder.make_kernel("eadd_reduce");
+            kernel.setArg(0, p_cl_u->Ax);
+            kernel.setArg(1, p_cl_v->Ax);
+            kernel.setArg(2, cl_sum_group);
+            kernel.setArg(3, init);
+            kernel.setArg(4, n);
+
+            cl::NDRange global(block_size * groups_count);
+            cl::NDRange local(block_size);
+            queue.enqueueNDRangeKernel(kernel, cl::NDRange(), global, local);
+
+            if (groups_count == 1) {
+                queue.enqueueReadBuffer(cl_sum_group, true, 0, sizeof(T), &r->get_value());
+                return Status::Ok;
+            }
+
+            cl_reduce<T>(queue, cl_sum_group, groups_count, init, op_reduce, r->get_value());
+
+            return Status::Ok;
+        }
+    };
+
+}// namespace spla
+
+#endif//SPLA_CL_V_EADD_REDUCE_HPP
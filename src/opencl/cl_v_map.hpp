@@ -93,7 +93,7 @@ namespace spla {
             auto*       p_cl_dense_r = r->template get<CLDenseVec<T>>();
             const auto* p_cl_dense_v = v->template get<CLDenseVec<T>>();
             auto*       p_cl_acc     = get_acc_cl();
-            auto&       queue        = p_cl_acc->get_queue_default();
+            auto&       queue        = p_cl_acc->get_queue_compute();
 
             cl_map(queue, p_cl_dense_v->Ax, p_cl_dense_r->Ax, r->get_n_rows(), op);
 
@@ -115,7 +115,7 @@ namespace spla {
             auto*       p_cl_coo_r = r->template get<CLCooVec<T>>();
             const auto* p_cl_coo_v = v->template get<CLCooVec<T>>();
             auto*       p_cl_acc   = get_acc_cl();
-            auto&       queue      = p_cl_acc->get_queue_default();
+            auto&       queue      = p_cl_acc->get_queue_compute();
 
             const uint N = p_cl_coo_v->values;
 
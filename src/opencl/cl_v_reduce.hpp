@@ -92,7 +92,7 @@ namespace spla {
 
             const auto* p_cl_dense_vec = v->template get<CLDenseVec<T>>();
             auto*       p_cl_acc       = get_acc_cl();
-            auto&       queue          = p_cl_acc->get_queue_default();
+            auto&       queue          = p_cl_acc->get_queue_compute();
 
             cl_reduce<T>(queue, p_cl_dense_vec->Ax, v->get_n_rows(), s->get_value(), op_reduce, r->get_value());
 
@@ -113,7 +113,7 @@ namespace spla {
 
             const auto* p_cl_coo_vec = v->template get<CLCooVec<T>>();
             auto*       p_cl_acc     = get_acc_cl();
-            auto&       queue        = p_cl_acc->get_queue_default();
+            auto&       queue        = p_cl_acc->get_queue_compute();
 
             cl_reduce<T>(queue, p_cl_coo_vec->Ax, p_cl_coo_vec->values, s->get_value(), op_reduce, r->get_value());
 
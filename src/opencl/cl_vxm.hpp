@@ -38,16 +38,18 @@
 #include <core/ttype.hpp>
 #include <core/tvector.hpp>
 
-#include <opencl/cl_alloc_linear.hpp>
+#include <opencl/cl_alloc_pool.hpp>
 #include <opencl/cl_counter.hpp>
 #include <opencl/cl_debug.hpp>
 #include <opencl/cl_formats.hpp>
+#include <opencl/cl_mask.hpp>
+#include <opencl/cl_prefix_sum.hpp>
 #include <opencl/cl_program_builder.hpp>
-#include <opencl/cl_reduce_by_key.hpp>
 #include <opencl/cl_sort_by_key.hpp>
 #include <opencl/generated/auto_vxm.hpp>
 
 #include <algorithm>
+#include <cstdint>
 #include <sstream>
 
 namespace spla {
@@ -66,9 +68,36 @@ namespace spla {
         }
 
         Status execute(const DispatchContext& ctx) override {
+            auto t    = ctx.task.template cast_safe<ScheduleTask_vxm_masked>();
+            auto mask = t->mask.template cast_safe<TVector<T>>();
+
+            if (!cl_mask_mode(mask, t->op_select, t->get_desc_or_default(), m_mask_mode)) {
+                return Status::NotImplemented;
+            }
+            if (t->op_accum) {
+                return Status::NotImplemented;
+            }
+
             return execute_sparse(ctx);
         }
 
+        /**
+         * @brief Builds programs of product with given ops and mask mode ahead of first dispatch
+         */
+        void precompile(const ref_ptr<TOpBinary<T, T, T>>& op_multiply,
+                        const ref_ptr<TOpBinary<T, T, T>>& op_add,
+                        const ref_ptr<TOpSelect<T>>&       op_select,
+                        CLMaskMode                         mask_mode) {
+            std::shared_ptr<CLProgram> program;
+            m_mask_mode = mask_mode;
+            ensure_kernel(op_multiply, op_add, op_select, program);
+
+            // Unique keys of hash table are sorted, see execute_sparse
+            cl_sort_bitonic_program<T>(cl_sort_bitonic_local_size<T>());
+            cl_sort_radix_program<T>();
+            cl_prefix_sum_program<uint>(PLUS_UINT.template cast_safe<TOpBinary<uint, uint, uint>>());
+        }
+
     private:
         Status execute_sparse(const DispatchContext& ctx) {
             TIME_PROFILE_SCOPE("opencl/vxm/sparse");
@@ -85,98 +114,208 @@ namespace spla {
             ref_ptr<TScalar<T>>         init        = t->init.template cast_safe<TScalar<T>>();
 
             r->validate_wd(FormatVector::AccCoo);
-            mask->validate_rw(FormatVector::AccDense);
+            if (mask) mask->validate_rw(FormatVector::AccDense);
             M->validate_rw(FormatMatrix::AccCsr);
+            TIME_PROFILE_SCOPE_WORK(M->get_n_values());
             v->validate_rw(FormatVector::AccCoo);
             std::shared_ptr<CLProgram> program;
             if (!ensure_kernel(op_multiply, op_add, op_select, program)) return Status::CompilationError;
 
             auto* p_cl_r    = r->template get<CLCooVec<T>>();
-            auto* p_cl_mask = mask->template get<CLDenseVec<T>>();
+            auto* p_cl_mask = mask ? mask->template get<CLDenseVec<T>>() : nullptr;
             auto* p_cl_M    = M->template get<CLCsr<T>>();
             auto* p_cl_v    = v->template get<CLCooVec<T>>();
 
             auto* p_cl_acc    = get_acc_cl();
-            auto* p_tmp_alloc = p_cl_acc->get_alloc_tmp();
-            auto& queue       = p_cl_acc->get_queue_default();
+            auto* p_tmp_alloc = p_cl_acc->get_alloc_pool();
+            auto& queue       = p_cl_acc->get_queue_compute();
 
-            uint             prods_count;
-            CLCounterWrapper cl_prods_count;
-            CL_COUNTER_SET("init-prods-cnt", queue, cl_prods_count, 0);
+            const uint n = p_cl_v->values;
 
-            auto kernel_sparse_count = program->make_kernel("vxm_sparse_count");
-            kernel_sparse_count.setArg(0, p_cl_v->Ai);
-            kernel_sparse_count.setArg(1, p_cl_v->Ax);
-            kernel_sparse_count.setArg(2, p_cl_M->Ap);
-            kernel_sparse_count.setArg(3, p_cl_M->Aj);
-            kernel_sparse_count.setArg(4, p_cl_mask->Ax);
-            kernel_sparse_count.setArg(5, cl_prods_count.buffer());
-            kernel_sparse_count.setArg(6, p_cl_v->values);
+            if (n == 0) {
+                LOG_MSG(Status::Ok, "nothing to do");
+                set_empty(p_cl_r);
+                return Status::Ok;
+            }
 
-            uint n_groups_to_dispatch_v = div_up_clamp(p_cl_v->values, m_block_size, 1, 1024);
+            // frontier row lengths are scanned into edge offsets, which bound products count and balance collect
+            cl::Buffer cl_offsets = p_tmp_alloc->alloc((n + 1) * sizeof(uint));
+            cl::Buffer cl_stats   = p_tmp_alloc->alloc(2 * sizeof(uint));
+            uint       stats[2];
+            queue.enqueueFillBuffer(cl_stats, uint(0), 0, sizeof(stats));
 
-            cl::NDRange count_global(m_block_size * n_groups_to_dispatch_v);
-            cl::NDRange count_local(m_block_size);
-            CL_DISPATCH_PROFILED("count", queue, kernel_sparse_count, cl::NDRange(), count_global, count_local);
+            auto kernel_row_lengths = program->make_kernel("vxm_row_lengths");
+            kernel_row_lengths.setArg(0, p_cl_v->Ai);
+            kernel_row_lengths.setArg(1, p_cl_M->Ap);
+            kernel_row_lengths.setArg(2, cl_offsets);
+            kernel_row_lengths.setArg(3, cl_stats);
+            kernel_row_lengths.setArg(4, n);
 
-            CL_COUNTER_GET("copy_prods_count", queue, cl_prods_count, prods_count);
-            LOG_MSG(Status::Ok, "temporary vi * A[,*] count " << prods_count);
+            uint n_groups_to_dispatch_v = div_up_clamp(n, m_block_size, 1, 1024);
 
-            if (prods_count == 0) {
-                LOG_MSG(Status::Ok, "nothing to do");
+            cl::NDRange lengths_global(m_block_size * n_groups_to_dispatch_v);
+            cl::NDRange lengths_local(m_block_size);
+            CL_DISPATCH_PROFILED("lengths", queue, kernel_row_lengths, cl::NDRange(), lengths_global, lengths_local);
+
+            CL_PROFILE_BEGIN("scan", queue)
+            cl_exclusive_scan(queue, cl_offsets, n + 1, PLUS_UINT.template cast_safe<TOpBinary<uint, uint, uint>>(), p_tmp_alloc);
+            CL_PROFILE_END();
 
-                p_cl_r->Ai     = cl::Buffer();
-                p_cl_r->Ax     = cl::Buffer();
-                p_cl_r->values = 0;
+            queue.enqueueCopyBuffer(cl_offsets, cl_stats, n * sizeof(uint), sizeof(uint), sizeof(uint));
+            CL_READ_PROFILED("copy-stats", queue, cl_stats, true, 0, sizeof(stats), stats);
 
+            const uint max_length = stats[0];
+            const uint n_edges    = stats[1];
+            const bool balanced   = max_length >= m_block_size && std::uint64_t(max_length) * n > std::uint64_t(SKEW_FACTOR) * n_edges;
+            LOG_MSG(Status::Ok, "frontier " << n << " edges " << n_edges << " max row " << max_length << (balanced ? " balanced" : " sparse"));
+
+            if (n_edges == 0) {
+                LOG_MSG(Status::Ok, "nothing to do");
+                set_empty(p_cl_r);
                 return Status::Ok;
             }
 
-            cl::Buffer cl_prodi = p_tmp_alloc->alloc(prods_count * sizeof(uint));
-            cl::Buffer cl_prodx = p_tmp_alloc->alloc(prods_count * sizeof(T));
+            cl::Buffer cl_prodi = p_tmp_alloc->alloc(n_edges * sizeof(uint));
+            cl::Buffer cl_prodx = p_tmp_alloc->alloc(n_edges * sizeof(T));
 
             CLCounterWrapper cl_prods_offset;
             CL_COUNTER_SET("init-offsets-cnt", queue, cl_prods_offset, 0);
 
-            auto kernel_sparse_collect = program->make_kernel("vxm_sparse_collect");
-            kernel_sparse_collect.setArg(0, p_cl_v->Ai);
-            kernel_sparse_collect.setArg(1, p_cl_v->Ax);
-            kernel_sparse_collect.setArg(2, p_cl_M->Ap);
-            kernel_sparse_collect.setArg(3, p_cl_M->Aj);
-            kernel_sparse_collect.setArg(4, p_cl_M->Ax);
-            kernel_sparse_collect.setArg(5, p_cl_mask->Ax);
-            kernel_sparse_collect.setArg(6, cl_prodi);
-            kernel_sparse_collect.setArg(7, cl_prodx);
-            kernel_sparse_collect.setArg(8, cl_prods_offset.buffer());
-            kernel_sparse_collect.setArg(9, p_cl_v->values);
-
-            cl::NDRange collect_global(m_block_size * n_groups_to_dispatch_v);
-            cl::NDRange collect_local(m_block_size);
-            CL_DISPATCH_PROFILED("collect", queue, kernel_sparse_collect, cl::NDRange(), collect_global, collect_local);
-
-            CL_PROFILE_BEGIN("sort", queue)
-            const uint max_key    = r->get_n_rows() - 1;
-            const uint n_elements = prods_count;
-            cl_sort_by_key<T>(queue, cl_prodi, cl_prodx, n_elements, p_tmp_alloc, max_key);
+            if (balanced) {
+                const uint work             = n + n_edges;
+                const uint n_groups         = div_up_clamp(work, m_block_size * ITEMS_PER_THREAD, 1, 1024);
+                const uint items_per_thread = div_up(work, n_groups * m_block_size);
+
+                auto kernel_balanced_collect = program->make_kernel("vxm_balanced_collect");
+                kernel_balanced_collect.setArg(0, p_cl_v->Ai);
+                kernel_balanced_collect.setArg(1, p_cl_v->Ax);
+                kernel_balanced_collect.setArg(2, p_cl_M->Ap);
+                kernel_balanced_collect.setArg(3, p_cl_M->Aj);
+                kernel_balanced_collect.setArg(4, p_cl_M->Ax);
+                kernel_balanced_collect.setArg(5, p_cl_mask ? p_cl_mask->Ax : cl::Buffer());
+                kernel_balanced_collect.setArg(6, cl_offsets);
+                kernel_balanced_collect.setArg(7, cl_prodi);
+                kernel_balanced_collect.setArg(8, cl_prodx);
+                kernel_balanced_collect.setArg(9, cl_prods_offset.buffer());
+                kernel_balanced_collect.setArg(10, n);
+                kernel_balanced_collect.setArg(11, n_edges);
+                kernel_balanced_collect.setArg(12, items_per_thread);
+
+                cl::NDRange collect_global(m_block_size * n_groups);
+                cl::NDRange collect_local(m_block_size);
+                CL_DISPATCH_PROFILED("collect-balanced", queue, kernel_balanced_collect, cl::NDRange(), collect_global, collect_local);
+            } else {
+                auto kernel_sparse_collect = program->make_kernel("vxm_sparse_collect");
+                kernel_sparse_collect.setArg(0, p_cl_v->Ai);
+                kernel_sparse_collect.setArg(1, p_cl_v->Ax);
+                kernel_sparse_collect.setArg(2, p_cl_M->Ap);
+                kernel_sparse_collect.setArg(3, p_cl_M->Aj);
+                kernel_sparse_collect.setArg(4, p_cl_M->Ax);
+                kernel_sparse_collect.setArg(5, p_cl_mask ? p_cl_mask->Ax : cl::Buffer());
+                kernel_sparse_collect.setArg(6, cl_prodi);
+                kernel_sparse_collect.setArg(7, cl_prodx);
+                kernel_sparse_collect.setArg(8, cl_prods_offset.buffer());
+                kernel_sparse_collect.setArg(9, n);
+
+                cl::NDRange collect_global(m_block_size * n_groups_to_dispatch_v);
+                cl::NDRange collect_local(m_block_size);
+                CL_DISPATCH_PROFILED("collect", queue, kernel_sparse_collect, cl::NDRange(), collect_global, collect_local);
+            }
+
+            // products are accumulated into dense table of all rows or into hash table, so only unique keys are compacted;
+            // products count is bounded by edges count, so table is sized without reading back collect counter
+            const uint n_rows    = r->get_n_rows();
+            const uint hash_size = ceil_to_pow2(2 * n_edges);
+            const bool is_dense  = hash_size >= n_rows;
+            const uint capacity  = is_dense ? n_rows : hash_size;
+            LOG_MSG(Status::Ok, "accumulate in " << (is_dense ? "dense" : "hash") << " table of " << capacity);
+
+            cl::Buffer cl_table_keys   = p_tmp_alloc->alloc(capacity * sizeof(uint));
+            cl::Buffer cl_table_values = p_tmp_alloc->alloc(capacity * sizeof(T));
+            queue.enqueueFillBuffer(cl_table_keys, uint(0xffffffff), 0, capacity * sizeof(uint));
+
+            uint n_groups_to_dispatch_prods = div_up_clamp(n_edges, m_block_size, 1, 1024);
+
+            cl::NDRange prods_global(m_block_size * n_groups_to_dispatch_prods);
+            cl::NDRange prods_local(m_block_size);
+
+            auto kernel_table_insert = program->make_kernel("vxm_table_insert");
+            kernel_table_insert.setArg(0, cl_prodi);
+            kernel_table_insert.setArg(1, cl_prodx);
+            kernel_table_insert.setArg(2, cl_table_keys);
+            kernel_table_insert.setArg(3, cl_table_values);
+            kernel_table_insert.setArg(4, cl_prods_offset.buffer());
+            kernel_table_insert.setArg(5, capacity);
+            kernel_table_insert.setArg(6, uint(is_dense));
+            CL_DISPATCH_PROFILED("table-insert", queue, kernel_table_insert, cl::NDRange(), prods_global, prods_local);
+
+            auto kernel_table_accum = program->make_kernel("vxm_table_accum");
+            kernel_table_accum.setArg(0, cl_prodi);
+            kernel_table_accum.setArg(1, cl_prodx);
+            kernel_table_accum.setArg(2, cl_table_values);
+            kernel_table_accum.setArg(3, cl_prods_offset.buffer());
+            CL_DISPATCH_PROFILED("table-accum", queue, kernel_table_accum, cl::NDRange(), prods_global, prods_local);
+
+            cl::Buffer cl_table_offsets = p_tmp_alloc->alloc((capacity + 1) * sizeof(uint));
+
+            cl::NDRange table_global(align(capacity + 1, m_block_size));
+            cl::NDRange table_local(m_block_size);
+
+            auto kernel_table_flags = program->make_kernel("vxm_table_flags");
+            kernel_table_flags.setArg(0, cl_table_keys);
+            kernel_table_flags.setArg(1, cl_table_offsets);
+            kernel_table_flags.setArg(2, capacity);
+            CL_DISPATCH_PROFILED("table-flags", queue, kernel_table_flags, cl::NDRange(), table_global, table_local);
+
+            CL_PROFILE_BEGIN("table-scan", queue)
+            cl_exclusive_scan(queue, cl_table_offsets, capacity + 1, PLUS_UINT.template cast_safe<TOpBinary<uint, uint, uint>>(), p_tmp_alloc);
             CL_PROFILE_END();
 
-            uint       reduced_size;
-            cl::Buffer reduced_keys;
-            cl::Buffer reduced_values;
+            uint             unique_count;
+            CLCounterWrapper cl_unique_count;
+            queue.enqueueCopyBuffer(cl_table_offsets, cl_unique_count.buffer(), capacity * sizeof(uint), 0, sizeof(uint));
+            CL_COUNTER_GET("copy-unique-count", queue, cl_unique_count, unique_count);
+            LOG_MSG(Status::Ok, "unique vi * A[,*] count " << unique_count);
 
-            CL_PROFILE_BEGIN("reduce", queue)
-            cl_reduce_by_key(queue, cl_prodi, cl_prodx, prods_count, reduced_keys, reduced_values, reduced_size, op_add, p_tmp_alloc);
-            CL_PROFILE_END();
+            if (unique_count == 0) {
+                LOG_MSG(Status::Ok, "nothing to do");
+                set_empty(p_cl_r);
+                return Status::Ok;
+            }
 
-            p_cl_r->Ai     = reduced_keys;
-            p_cl_r->Ax     = reduced_values;
-            p_cl_r->values = reduced_size;
+            cl::Buffer cl_ri;
+            cl::Buffer cl_rx;
+            p_tmp_alloc->alloc_paired(unique_count * sizeof(uint), unique_count * sizeof(T), cl_ri, cl_rx);
+
+            auto kernel_table_compact = program->make_kernel("vxm_table_compact");
+            kernel_table_compact.setArg(0, cl_table_keys);
+            kernel_table_compact.setArg(1, cl_table_values);
+            kernel_table_compact.setArg(2, cl_table_offsets);
+            kernel_table_compact.setArg(3, cl_ri);
+            kernel_table_compact.setArg(4, cl_rx);
+            kernel_table_compact.setArg(5, capacity);
+            CL_DISPATCH_PROFILED("table-compact", queue, kernel_table_compact, cl::NDRange(), table_global, table_local);
+
+            // dense table is compacted in order of keys already
+            if (!is_dense) {
+                CL_PROFILE_BEGIN("sort", queue)
+                cl_sort_by_key<T>(queue, cl_ri, cl_rx, unique_count, p_tmp_alloc, n_rows - 1);
+                CL_PROFILE_END();
+            }
 
-            p_tmp_alloc->free_all();
+            p_cl_r->Ai     = cl_ri;
+            p_cl_r->Ax     = cl_rx;
+            p_cl_r->values = unique_count;
 
             return Status::Ok;
         }
 
+        static void set_empty(CLCooVec<T>* p_cl_r) {
+            p_cl_r->Ai     = cl::Buffer();
+            p_cl_r->Ax     = cl::Buffer();
+            p_cl_r->values = 0;
+        }
+
         bool ensure_kernel(const ref_ptr<TOpBinary<T, T, T>>& op_multiply,
                            const ref_ptr<TOpBinary<T, T, T>>& op_add,
                            const ref_ptr<TOpSelect<T>>&       op_select,
@@ -190,10 +329,14 @@ namespace spla {
             program_builder
                     .set_name("vxm")
                     .add_define("BLOCK_SIZE", m_block_size)
+                    .add_define("MASK_MODE", static_cast<int>(m_mask_mode))
                     .add_type("TYPE", get_ttype<T>().template as<Type>())
                     .add_op("OP_BINARY1", op_multiply.template as<OpBinary>())
-                    .add_op("OP_BINARY2", op_add.template as<OpBinary>())
-                    .add_op("OP_SELECT", op_select.template as<OpSelect>())
+                    .add_op("OP_BINARY2", op_add.template as<OpBinary>());
+            if (op_select) {
+                program_builder.add_op("OP_SELECT", op_select.template as<OpSelect>());
+            }
+            program_builder
                     .set_source(source_vxm)
                     .acquire();
 
@@ -203,8 +346,14 @@ namespace spla {
         }
 
     private:
-        uint m_block_size  = 0;
-        uint m_block_count = 0;
+        /** Frontier is collected by edges, once its longest row exceeds average row by this factor */
+        static constexpr uint SKEW_FACTOR = 8;
+        /** Target count of entries and edges consumed by single work-item of balanced collect */
+        static constexpr uint ITEMS_PER_THREAD = 8;
+
+        uint       m_block_size  = 0;
+        uint       m_block_count = 0;
+        CLMaskMode m_mask_mode   = CLMaskMode::Valued;
     };
 
 }// namespace spla
@@ -1,5 +1,5 @@
 ////////////////////////////////////////////////////////////////////
-// Copyright (c) 2021 - 2023 SparseLinearAlgebra
+// Copyright (c) 2021 - 2026 SparseLinearAlgebra
 // Autogenerated file, do not modify
 ////////////////////////////////////////////////////////////////////
 
@@ -8,6 +8,65 @@
 static const char source_mxmT_masked[] = R"(
 
 
+
+// memory bank conflict-free address and local buffer size
+#ifdef LM_NUM_MEM_BANKS
+    #define LM_ADDR(address) (address + ((address) / LM_NUM_MEM_BANKS))
+    #define LM_SIZE(size)    (size + (size) / LM_NUM_MEM_BANKS)
+#endif
+
+#define SWAP_KEYS(x, y) \
+    uint tmp1 = x;      \
+    x         = y;      \
+    y         = tmp1;
+
+#define SWAP_VALUES(x, y) \
+    TYPE tmp2 = x;        \
+    x         = y;        \
+    y         = tmp2;
+
+// nearest power of two number greater equals n
+uint ceil_to_pow2(uint n) {
+    uint r = 1;
+    while (r < n) r *= 2;
+    return r;
+}
+
+// find first element in a sorted array such x <= element
+uint lower_bound(const uint           x,
+                 uint                 first,
+                 uint                 size,
+                 __global const uint* array) {
+    while (size > 0) {
+        int step = size / 2;
+
+        if (array[first + step] < x) {
+            first = first + step + 1;
+            size -= step + 1;
+        } else {
+            size = step;
+        }
+    }
+    return first;
+}
+
+// find first element in a sorted array such x <= element
+uint lower_bound_local(const uint          x,
+                       uint                first,
+                       uint                size,
+                       __local const uint* array) {
+    while (size > 0) {
+        int step = size / 2;
+
+        if (array[first + step] < x) {
+            first = first + step + 1;
+            size -= step + 1;
+        } else {
+            size = step;
+        }
+    }
+    return first;
+}
 __kernel void mxmT_masked_csr_scalar(__global const uint* g_Ap,
                                      __global const uint* g_Aj,
                                      __global const TYPE* g_Ax,
@@ -65,4 +124,101 @@ __kernel void mxmT_masked_csr_scalar(__global const uint* g_Ap,
         }
     }
 }
+
+// work-group per row, subgroup of WARP_SIZE lanes per mask entry: lanes stride over row of B
+// and binary search its columns in row of A, which is kept in local memory if it fits;
+// lane sums start empty and are reduced with has-value flags, so init is applied once
+__kernel void mxmT_masked_csr_vector(__global const uint* g_Ap,
+                                     __global const uint* g_Aj,
+                                     __global const TYPE* g_Ax,
+                                     __global const uint* g_Bp,
+                                     __global const uint* g_Bj,
+                                     __global const TYPE* g_Bx,
+                                     __global const uint* g_maskp,
+                                     __global const uint* g_maskj,
+                                     __global const TYPE* g_maskx,
+                                     __global TYPE*       g_Rx,
+                                     const TYPE           init,
+                                     const uint           n) {
+    const uint lid    = get_local_id(0);
+    const uint lsize  = get_local_size(0);
+    const uint lane   = lid % WARP_SIZE;
+    const uint sub_id = lid / WARP_SIZE;
+    const uint n_subs = lsize / WARP_SIZE;
+
+    __local uint s_Aj[LOCAL_A_SIZE];
+    __local TYPE s_Ax[LOCAL_A_SIZE];
+    __local TYPE s_sum[BLOCK_SIZE];
+    __local uint s_has[BLOCK_SIZE];
+
+    for (uint row_id = get_group_id(0); row_id < n; row_id += get_num_groups(0)) {
+        const uint mask_start = g_maskp[row_id];
+        const uint mask_end   = g_maskp[row_id + 1];
+
+        if (mask_start == mask_end) continue;
+
+        const uint A_start  = g_Ap[row_id];
+        const uint A_size   = g_Ap[row_id + 1] - A_start;
+        const bool A_cached = A_size <= LOCAL_A_SIZE;
+
+        if (A_cached) {
+            for (uint i = lid; i < A_size; i += lsize) {
+                s_Aj[i] = g_Aj[A_start + i];
+                s_Ax[i] = g_Ax[A_start + i];
+            }
+        }
+
+        barrier(CLK_LOCAL_MEM_FENCE);
+
+        for (uint mask_base = mask_start; mask_base < mask_end; mask_base += n_subs) {
+            const uint mask_k    = mask_base + sub_id;
+            const bool is_active = mask_k < mask_end;
+            const bool is_select = is_active && OP_SELECT(g_maskx[mask_k]);
+
+            TYPE r   = init;
+            uint has = 0;
+
+            if (is_select) {
+                const uint mask_j = g_maskj[mask_k];
+                const uint B_end  = g_Bp[mask_j + 1];
+
+                for (uint B_it = g_Bp[mask_j] + lane; B_it < B_end; B_it += WARP_SIZE) {
+                    const uint B_j = g_Bj[B_it];
+
+                    if (A_cached) {
+                        const uint A_it = lower_bound_local(B_j, 0, A_size, s_Aj);
+                        if (A_it < A_size && s_Aj[A_it] == B_j) {
+                            const TYPE x = OP_BINARY1(s_Ax[A_it], g_Bx[B_it]);
+                            r            = has ? OP_BINARY2(r, x) : x;
+                            has          = 1;
+                        }
+                    } else {
+                        const uint A_it = lower_bound(B_j, A_start, A_size, g_Aj);
+                        if (A_it < A_start + A_size && g_Aj[A_it] == B_j) {
+                            const TYPE x = OP_BINARY1(g_Ax[A_it], g_Bx[B_it]);
+                            r            = has ? OP_BINARY2(r, x) : x;
+                            has          = 1;
+                        }
+                    }
+                }
+            }
+
+            s_sum[lid] = r;
+            s_has[lid] = has;
+            barrier(CLK_LOCAL_MEM_FENCE);
+
+            for (uint step = WARP_SIZE / 2; step > 0; step /= 2) {
+                if (lane < step && s_has[lid + step]) {
+                    s_sum[lid] = s_has[lid] ? OP_BINARY2(s_sum[lid], s_sum[lid + step]) : s_sum[lid + step];
+                    s_has[lid] = 1;
+                }
+                barrier(CLK_LOCAL_MEM_FENCE);
+            }
+
+            if (is_active && lane == 0) g_Rx[mask_k] = s_has[lid] ? OP_BINARY2(init, s_sum[lid]) : init;
+        }
+
+        barrier(CLK_LOCAL_MEM_FENCE);
+    }
+}
 )";
\ No newline at end of file
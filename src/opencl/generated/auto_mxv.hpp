@@ -1,5 +1,5 @@
 ////////////////////////////////////////////////////////////////////
-// Copyright (c) 2021 - 2023 SparseLinearAlgebra
+// Copyright (c) 2021 - 2026 SparseLinearAlgebra
 // Autogenerated file, do not modify
 ////////////////////////////////////////////////////////////////////
 
@@ -8,98 +8,11 @@
 static const char source_mxv[] = R"(
 
 
-void reduction_group(uint                   block_size,
-                     uint                   lid,
-                     volatile __local TYPE* s_sum) {
-    if (BLOCK_SIZE >= block_size) {
-        if (lid < (block_size / 2)) {
-            s_sum[lid] = OP_BINARY2(s_sum[lid], s_sum[lid + (block_size / 2)]);
-        }
-        if (block_size > WARP_SIZE) {
-            barrier(CLK_LOCAL_MEM_FENCE);
-        }
-    }
-}
-
-__kernel void mxv_vector(__global const uint* g_Ap,
-                         __global const uint* g_Aj,
-                         __global const TYPE* g_Ax,
-                         __global const TYPE* g_vx,
-                         __global const TYPE* g_mask,
-                         __global TYPE*       g_rx,
-                         const TYPE           init,
-                         const uint           n) {
-    const uint lid     = get_local_id(1);   // thread id in a row
-    const uint lsize   = get_local_size(1); // num threads to process row
-    const uint lgroup  = get_local_id(0);   // num of rows inside a group
-    const uint gid     = get_global_id(0);  // id of row to touch
-    const uint gstride = get_global_size(0);// step between row ids
-
-    __local TYPE s_sum[BLOCK_COUNT][BLOCK_SIZE];
-
-    for (int row_id = gid; row_id < n; row_id += gstride) {
-        if (lid == 0) {
-            g_rx[row_id] = init;
-        }
-
-        if (OP_SELECT(g_mask[row_id])) {
-            const uint start = g_Ap[row_id];
-            const uint end   = g_Ap[row_id + 1];
-
-            TYPE sum = init;
-
-            for (uint i = start + lid; i < end; i += lsize) {
-                const uint col_id = g_Aj[i];
-                sum               = OP_BINARY2(sum, OP_BINARY1(g_Ax[i], g_vx[col_id]));
-            }
-
-            s_sum[lgroup][lid] = sum;
-            barrier(CLK_LOCAL_MEM_FENCE);
-
-            reduction_group(64, lid, s_sum[lgroup]);
-            reduction_group(32, lid, s_sum[lgroup]);
-            reduction_group(16, lid, s_sum[lgroup]);
-            reduction_group(8, lid, s_sum[lgroup]);
-            reduction_group(4, lid, s_sum[lgroup]);
-            reduction_group(2, lid, s_sum[lgroup]);
-
-            if (lid == 0) {
-                g_rx[row_id] = s_sum[lgroup][0];
-            }
-        }
-    }
-}
-
-__kernel void mxv_scalar(__global const uint* g_Ap,
-                         __global const uint* g_Aj,
-                         __global const TYPE* g_Ax,
-                         __global const TYPE* g_vx,
-                         __global const TYPE* g_mask,
-                         __global TYPE*       g_rx,
-                         const TYPE           init,
-                         const uint           n,
-                         const uint           early_exit) {
-    const uint gid     = get_global_id(0);  // id of row to touch
-    const uint gstride = get_global_size(0);// step between row ids
-
-    for (uint row_id = gid; row_id < n; row_id += gstride) {
-        TYPE sum = init;
-
-        if (OP_SELECT(g_mask[row_id])) {
-            const uint start = g_Ap[row_id];
-            const uint end   = g_Ap[row_id + 1];
-
-            for (uint i = start; i < end; i += 1) {
-                const uint col_id = g_Aj[i];
-                sum               = OP_BINARY2(sum, OP_BINARY1(g_Ax[i], g_vx[col_id]));
-
-                if (early_exit && (sum != init)) break;
-            }
-        }
-
-        g_rx[row_id] = sum;
-    }
-}
+// reinterpretation of 32-bit values for compare and swap accumulation
+typedef union {
+    uint u;
+    TYPE t;
+} mxv_bits;
 
 __kernel void mxv_config(__global const TYPE* g_mask,
                          __global TYPE*       g_rx,
@@ -113,7 +26,7 @@ __kernel void mxv_config(__global const TYPE* g_mask,
     for (uint i = gid; i < n; i += gstride) {
         g_rx[i] = init;
 
-        if (OP_SELECT(g_mask[i])) {
+        if (MASK_TEST(g_mask[i])) {
             const uint id = atomic_inc(g_config_size);
             g_config[id]  = i;
         }
@@ -149,4 +62,163 @@ __kernel void mxv_config_scalar(__global const uint* g_Ap,
         g_rx[row_id] = sum;
     }
 }
+
+// CSR-Adaptive: block of several rows is streamed through local memory and reduced by thread per row,
+// block of single row is reduced by whole work-group
+__kernel void mxv_adaptive(__global const uint* g_Ap,
+                           __global const uint* g_Aj,
+                           __global const TYPE* g_Ax,
+                           __global const TYPE* g_vx,
+                           __global const TYPE* g_mask,
+                           __global TYPE*       g_rx,
+                           __global const uint* g_row_blocks,
+                           const TYPE           init,
+                           const uint           n_blocks) {
+    const uint lid   = get_local_id(0);
+    const uint lsize = get_local_size(0);
+
+    __local TYPE s_values[ADAPTIVE_BLOCK_NNZ];
+
+    for (uint block = get_group_id(0); block < n_blocks; block += get_num_groups(0)) {
+        const uint row_start = g_row_blocks[block];
+        const uint row_end   = g_row_blocks[block + 1];
+
+        if (row_end - row_start > 1) {
+            const uint first = g_Ap[row_start];
+            const uint last  = g_Ap[row_end];
+
+            for (uint i = first + lid; i < last; i += lsize) {
+                s_values[i - first] = OP_BINARY1(g_Ax[i], g_vx[g_Aj[i]]);
+            }
+
+            barrier(CLK_LOCAL_MEM_FENCE);
+
+            for (uint row_id = row_start + lid; row_id < row_end; row_id += lsize) {
+                TYPE sum = init;
+
+                if (MASK_TEST(g_mask[row_id])) {
+                    const uint end = g_Ap[row_id + 1];
+
+                    for (uint i = g_Ap[row_id]; i < end; i += 1) {
+                        sum = OP_BINARY2(sum, s_values[i - first]);
+                    }
+                }
+
+                g_rx[row_id] = sum;
+            }
+        } else {
+            // only first lane starts with init, lanes without values are left out of reduction
+            const uint start   = g_Ap[row_start];
+            const uint end     = g_Ap[row_start + 1];
+            uint       n_lanes = MASK_TEST(g_mask[row_start]) ? min(lsize, end - start) : 0;
+            TYPE       sum     = init;
+
+            if (lid < n_lanes) {
+                const TYPE first = OP_BINARY1(g_Ax[start + lid], g_vx[g_Aj[start + lid]]);
+                sum              = lid == 0 ? OP_BINARY2(init, first) : first;
+
+                for (uint i = start + lid + lsize; i < end; i += lsize) {
+                    sum = OP_BINARY2(sum, OP_BINARY1(g_Ax[i], g_vx[g_Aj[i]]));
+                }
+            }
+
+            s_values[lid] = sum;
+            barrier(CLK_LOCAL_MEM_FENCE);
+
+            n_lanes = max(n_lanes, 1u);
+
+            for (uint step = lsize / 2; step > 0; step /= 2) {
+                if (lid < step && lid + step < n_lanes) s_values[lid] = OP_BINARY2(s_values[lid], s_values[lid + step]);
+                n_lanes = min(n_lanes, step);
+                barrier(CLK_LOCAL_MEM_FENCE);
+            }
+
+            if (lid == 0) g_rx[row_start] = s_values[0];
+        }
+
+        barrier(CLK_LOCAL_MEM_FENCE);
+    }
+}
+
+void mxv_atomic_accum(__global TYPE* p, const TYPE x) {
+    volatile __global uint* p_value = (volatile __global uint*) p;
+
+    mxv_bits expected;
+    mxv_bits desired;
+    mxv_bits actual;
+    actual.u = *p_value;
+
+    do {
+        expected.u = actual.u;
+        desired.t  = OP_BINARY2(expected.t, x);
+        actual.u   = atomic_cmpxchg(p_value, expected.u, desired.u);
+    } while (actual.u != expected.u);
+}
+
+// merge-path: each work-item consumes equal number of rows and values, rows split between
+// work-items are accumulated with compare and swap into result filled with init, so partial
+// sums of split rows start empty and init is applied once
+__kernel void mxv_merge_path(__global const uint* g_Ap,
+                             __global const uint* g_Aj,
+                             __global const TYPE* g_Ax,
+                             __global const TYPE* g_vx,
+                             __global const TYPE* g_mask,
+                             __global TYPE*       g_rx,
+                             const TYPE           init,
+                             const uint           n_rows,
+                             const uint           n_values,
+                             const uint           items_per_thread) {
+    const uint gid        = get_global_id(0);
+    const uint total      = n_rows + n_values;
+    const uint diag_start = min(gid * items_per_thread, total);
+    const uint diag_end   = min(diag_start + items_per_thread, total);
+
+    uint x_min = diag_start > n_values ? diag_start - n_values : 0;
+    uint x_max = min(diag_start, n_rows);
+
+    while (x_min < x_max) {
+        const uint pivot = (x_min + x_max) / 2;
+
+        if (g_Ap[pivot + 1] <= diag_start - pivot - 1) {
+            x_min = pivot + 1;
+        } else {
+            x_max = pivot;
+        }
+    }
+
+    uint row_id  = x_min;
+    uint i       = diag_start - x_min;
+    bool is_head = row_id < n_rows && i > g_Ap[row_id];// first row started in previous work-item
+    bool is_used = row_id < n_rows && MASK_TEST(g_mask[row_id]);
+    bool has_sum = false;
+    TYPE sum     = init;
+
+    for (uint d = diag_start; d < diag_end; d++) {
+        if (i < g_Ap[row_id + 1]) {
+            if (is_used) {
+                const TYPE x = OP_BINARY1(g_Ax[i], g_vx[g_Aj[i]]);
+                sum          = has_sum ? OP_BINARY2(sum, x) : x;
+                has_sum      = true;
+            }
+            i += 1;
+        } else {
+            if (is_head) {
+                if (has_sum) mxv_atomic_accum(&g_rx[row_id], sum);
+            } else {
+                g_rx[row_id] = has_sum ? OP_BINARY2(init, sum) : init;
+            }
+
+            row_id += 1;
+            is_head = false;
+            is_used = row_id < n_rows && MASK_TEST(g_mask[row_id]);
+            has_sum = false;
+        }
+    }
+
+    // last row continues in next work-item
+    if (row_id < n_rows && has_sum) {
+        mxv_atomic_accum(&g_rx[row_id], sum);
+    }
+}
+
 )";
\ No newline at end of file
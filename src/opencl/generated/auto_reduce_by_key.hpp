@@ -1,5 +1,5 @@
 ////////////////////////////////////////////////////////////////////
-// Copyright (c) 2021 - 2023 SparseLinearAlgebra
+// Copyright (c) 2021 - 2026 SparseLinearAlgebra
 // Autogenerated file, do not modify
 ////////////////////////////////////////////////////////////////////
 
@@ -79,15 +79,15 @@ __kernel void reduce_by_key_generate_offsets(__global const uint* g_keys,
     }
 }
 
-// scalar reduction for each group of keys
+// scalar reduction for each group of keys, count of groups is taken from scanned offsets
 __kernel void reduce_by_key_scalar(__global const uint* g_keys,
                                    __global const TYPE* g_values,
                                    __global const uint* g_offsets,
                                    __global uint*       g_unique_keys,
                                    __global TYPE*       g_reduce_values,
-                                   const uint           n_keys,
-                                   const uint           n_groups) {
-    const uint gid = get_global_id(0);
+                                   const uint           n_keys) {
+    const uint gid      = get_global_id(0);
+    const uint n_groups = g_offsets[n_keys - 1] + 1;
 
     if (gid < n_groups) {
         const uint start_idx = lower_bound(gid, 0, n_keys, g_offsets);
@@ -0,0 +1,25 @@
+////////////////////////////////////////////////////////////////////
+// Copyright (c) 2021 - 2026 SparseLinearAlgebra
+// Autogenerated file, do not modify
+////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+static const char source_vector_emult[] = R"(
+
+__kernel void dense_to_dense(__global TYPE*       g_rx,
+                             __global const TYPE* g_ux,
+                             __global const TYPE* g_vx,
+                             const TYPE           fill_u,
+                             const TYPE           fill_r,
+                             const uint           n) {
+    const uint gid   = get_global_id(0);
+    const uint gsize = get_global_size(0);
+
+    for (uint i = gid; i < n; i += gsize) {
+        const TYPE x = g_ux[i];
+        g_rx[i]      = x != fill_u ? OP_BINARY(x, g_vx[i]) : fill_r;
+    }
+}
+
+)";
\ No newline at end of file
@@ -1,5 +1,5 @@
 ////////////////////////////////////////////////////////////////////
-// Copyright (c) 2021 - 2023 SparseLinearAlgebra
+// Copyright (c) 2021 - 2026 SparseLinearAlgebra
 // Autogenerated file, do not modify
 ////////////////////////////////////////////////////////////////////
 
@@ -8,31 +8,32 @@
 static const char source_vxm[] = R"(
 
 
-__kernel void vxm_sparse_count(__global const uint* g_vi,
-                               __global const TYPE* g_vx,
-                               __global const uint* g_Ap,
-                               __global const uint* g_Aj,
-                               __global const TYPE* g_mask,
-                               __global uint*       g_size,
-                               const uint           n) {
-    const uint gid     = get_global_id(0);  // id of v entry to touch
-    const uint gstride = get_global_size(0);// step between v entries
+#define VXM_EMPTY_KEY 0xffffffff
 
-    for (int idx = gid; idx < n; idx += gstride) {
-        const uint vi = g_vi[idx];
-        const TYPE vx = g_vx[idx];
+// reinterpretation of 32-bit values for compare and swap accumulation
+typedef union {
+    uint u;
+    TYPE t;
+} vxm_bits;
 
-        const uint start = g_Ap[vi];
-        const uint end   = g_Ap[vi + 1];
-
-        uint count = 0;
+// length of row of each v entry, lengths[n] is zero, so exclusive scan gives edge offsets and total
+__kernel void vxm_row_lengths(__global const uint* g_vi,
+                              __global const uint* g_Ap,
+                              __global uint*       g_lengths,
+                              __global uint*       g_max_length,
+                              const uint           n) {
+    const uint gid     = get_global_id(0);  // id of v entry to touch
+    const uint gstride = get_global_size(0);// step between v entries
 
-        for (uint i = start; i < end; i++) {
-            if (OP_SELECT(g_mask[g_Aj[i]])) count += 1;
-        }
+    for (uint idx = gid; idx < n; idx += gstride) {
+        const uint vi     = g_vi[idx];
+        const uint length = g_Ap[vi + 1] - g_Ap[vi];
 
-        atomic_add(g_size, count);
+        g_lengths[idx] = length;
+        atomic_max(g_max_length, length);
     }
+
+    if (gid == 0) g_lengths[n] = 0;
 }
 
 __kernel void vxm_sparse_collect(__global const uint* g_vi,
@@ -58,7 +59,7 @@ __kernel void vxm_sparse_collect(__global const uint* g_vi,
         uint count = 0;
 
         for (uint i = start; i < end; i++) {
-            if (OP_SELECT(g_mask[g_Aj[i]])) count += 1;
+            if (MASK_TEST(g_mask[g_Aj[i]])) count += 1;
         }
 
         uint offset = atomic_add(g_roffset, count);
@@ -66,7 +67,7 @@ __kernel void vxm_sparse_collect(__global const uint* g_vi,
         for (uint i = start; i < end; i++) {
             const uint col_id = g_Aj[i];
 
-            if (OP_SELECT(g_mask[col_id])) {
+            if (MASK_TEST(g_mask[col_id])) {
                 g_ri[offset] = col_id;
                 g_rx[offset] = OP_BINARY1(vx, g_Ax[i]);
                 offset += 1;
@@ -74,4 +75,199 @@ __kernel void vxm_sparse_collect(__global const uint* g_vi,
         }
     }
 }
+
+// find (v entry, edge) pair where merge path of v entries ends and edges crosses given diagonal
+void vxm_merge_path_search(__global const uint* g_offsets,
+                           const uint           diagonal,
+                           const uint           n,
+                           const uint           n_edges,
+                           uint*                entry,
+                           uint*                edge) {
+    uint x_min = diagonal > n_edges ? diagonal - n_edges : 0;
+    uint x_max = min(diagonal, n);
+
+    while (x_min < x_max) {
+        const uint pivot = (x_min + x_max) / 2;
+
+        if (g_offsets[pivot + 1] <= diagonal - pivot - 1) {
+            x_min = pivot + 1;
+        } else {
+            x_max = pivot;
+        }
+    }
+
+    *entry = x_min;
+    *edge  = diagonal - x_min;
+}
+
+// each work-item consumes equal number of v entries and edges, so single hub entry is split among many items
+__kernel void vxm_balanced_collect(__global const uint* g_vi,
+                                   __global const TYPE* g_vx,
+                                   __global const uint* g_Ap,
+                                   __global const uint* g_Aj,
+                                   __global const TYPE* g_Ax,
+                                   __global const TYPE* g_mask,
+                                   __global const uint* g_offsets,
+                                   __global uint*       g_ri,
+                                   __global TYPE*       g_rx,
+                                   __global uint*       g_roffset,
+                                   const uint           n,
+                                   const uint           n_edges,
+                                   const uint           items_per_thread) {
+    const uint gid        = get_global_id(0);
+    const uint total      = n + n_edges;
+    const uint diag_start = min(gid * items_per_thread, total);
+    const uint diag_end   = min(diag_start + items_per_thread, total);
+
+    uint start_entry;
+    uint start_edge;
+    vxm_merge_path_search(g_offsets, diag_start, n, n_edges, &start_entry, &start_edge);
+
+    uint count = 0;
+    uint entry = start_entry;
+    uint edge  = start_edge;
+
+    for (uint d = diag_start; d < diag_end; d++) {
+        const uint entry_end = entry < n ? g_offsets[entry + 1] : n_edges;
+
+        if (edge < entry_end) {
+            const uint i = g_Ap[g_vi[entry]] + edge - g_offsets[entry];
+            if (MASK_TEST(g_mask[g_Aj[i]])) count += 1;
+            edge += 1;
+        } else {
+            entry += 1;
+        }
+    }
+
+    if (count == 0) return;
+
+    uint offset = atomic_add(g_roffset, count);
+
+    entry = start_entry;
+    edge  = start_edge;
+
+    for (uint d = diag_start; d < diag_end; d++) {
+        const uint entry_end = entry < n ? g_offsets[entry + 1] : n_edges;
+
+        if (edge < entry_end) {
+            const uint i      = g_Ap[g_vi[entry]] + edge - g_offsets[entry];
+            const uint col_id = g_Aj[i];
+
+            if (MASK_TEST(g_mask[col_id])) {
+                g_ri[offset] = col_id;
+                g_rx[offset] = OP_BINARY1(g_vx[entry], g_Ax[i]);
+                offset += 1;
+            }
+
+            edge += 1;
+        } else {
+            entry += 1;
+        }
+    }
+}
+
+// lowbias32 integer hash
+uint vxm_hash(uint key) {
+    key ^= key >> 16;
+    key *= 0x7feb352d;
+    key ^= key >> 15;
+    key *= 0x846ca68b;
+    key ^= key >> 16;
+    return key;
+}
+
+// claim table slot of each product key, the first product claiming slot stores initial value,
+// others keep slot in product key to be accumulated by vxm_table_accum;
+// products count is read from collect counter, so host does not wait for it
+__kernel void vxm_table_insert(__global uint*       g_prodi,
+                               __global const TYPE* g_prodx,
+                               __global uint*       g_table_keys,
+                               __global TYPE*       g_table_values,
+                               __global const uint* g_n,
+                               const uint           capacity,
+                               const uint           is_dense) {
+    const uint gid     = get_global_id(0);
+    const uint gstride = get_global_size(0);
+    const uint n       = g_n[0];
+
+    for (uint idx = gid; idx < n; idx += gstride) {
+        const uint key  = g_prodi[idx];
+        uint       slot = is_dense ? key : vxm_hash(key) & (capacity - 1);
+
+        while (true) {
+            const uint prev = atomic_cmpxchg(&g_table_keys[slot], VXM_EMPTY_KEY, key);
+
+            if (prev == VXM_EMPTY_KEY) {
+                g_table_values[slot] = g_prodx[idx];
+                g_prodi[idx]         = VXM_EMPTY_KEY;
+                break;
+            }
+            if (prev == key) {
+                g_prodi[idx] = slot;
+                break;
+            }
+
+            slot = (slot + 1) & (capacity - 1);
+        }
+    }
+}
+
+// accumulate products into slots initialized by vxm_table_insert
+__kernel void vxm_table_accum(__global const uint* g_prodi,
+                              __global const TYPE* g_prodx,
+                              __global TYPE*       g_table_values,
+                              __global const uint* g_n) {
+    const uint gid     = get_global_id(0);
+    const uint gstride = get_global_size(0);
+    const uint n       = g_n[0];
+
+    for (uint idx = gid; idx < n; idx += gstride) {
+        const uint slot = g_prodi[idx];
+
+        if (slot != VXM_EMPTY_KEY) {
+            volatile __global uint* p_value = (volatile __global uint*) &g_table_values[slot];
+            const TYPE              x       = g_prodx[idx];
+
+            vxm_bits expected;
+            vxm_bits desired;
+            vxm_bits actual;
+            actual.u = *p_value;
+
+            do {
+                expected.u = actual.u;
+                desired.t  = OP_BINARY2(expected.t, x);
+                actual.u   = atomic_cmpxchg(p_value, expected.u, desired.u);
+            } while (actual.u != expected.u);
+        }
+    }
+}
+
+// flag of occupied slot, flags[capacity] is zero, so exclusive scan gives compacted offsets and count
+__kernel void vxm_table_flags(__global const uint* g_table_keys,
+                              __global uint*       g_offsets,
+                              const uint           capacity) {
+    const uint gid = get_global_id(0);
+
+    if (gid < capacity) g_offsets[gid] = g_table_keys[gid] != VXM_EMPTY_KEY ? 1 : 0;
+    if (gid == 0) g_offsets[capacity] = 0;
+}
+
+__kernel void vxm_table_compact(__global const uint* g_table_keys,
+                                __global const TYPE* g_table_values,
+                                __global const uint* g_offsets,
+                                __global uint*       g_ri,
+                                __global TYPE*       g_rx,
+                                const uint           capacity) {
+    const uint gid = get_global_id(0);
+
+    if (gid < capacity) {
+        const uint key = g_table_keys[gid];
+
+        if (key != VXM_EMPTY_KEY) {
+            const uint offset = g_offsets[gid];
+            g_ri[offset]      = key;
+            g_rx[offset]      = g_table_values[gid];
+        }
+    }
+}
 )";
\ No newline at end of file
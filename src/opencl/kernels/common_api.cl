@@ -47,4 +47,18 @@ float random_float(ulong seed) {
 
 uint fasu(float v) {
     return *((uint*) &v);
-}
\ No newline at end of file
+}
+
+// mask test selected by MASK_MODE define: 0 - valued, 1 - no mask,
+// 2 - complemented valued, 3 - structural, 4 - complemented structural
+#if defined(MASK_MODE) && MASK_MODE == 1
+    #define MASK_TEST(x) (1)
+#elif defined(MASK_MODE) && MASK_MODE == 2
+    #define MASK_TEST(x) (!OP_SELECT(x))
+#elif defined(MASK_MODE) && MASK_MODE == 3
+    #define MASK_TEST(x) ((x) != 0)
+#elif defined(MASK_MODE) && MASK_MODE == 4
+    #define MASK_TEST(x) ((x) == 0)
+#else
+    #define MASK_TEST(x) OP_SELECT(x)
+#endif
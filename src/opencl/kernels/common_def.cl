@@ -81,6 +81,7 @@ uint   get_work_dim();
 #define atomic_inc(p)               (p)[0]
 #define atomic_dec(p)               (p)[0]
 #define atomic_cmpxchg(p, cmp, val) ((p)[0] == cmp ? val : (p)[0])
+#define atomic_max(p, val)          p[0] = max(p[0], val)
 
 #define min(x, y)     (x < y ? x : y)
 #define max(x, y)     (x > y ? x : y)
@@ -0,0 +1,90 @@
+/**********************************************************************************/
+/* This file is part of spla project                                              */
+/* https://github.com/SparseLinearAlgebra/spla                                    */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2023 SparseLinearAlgebra                                         */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+#include "common_def.cl"
+
+// Order of vertices is by key, ties are broken by index; without key it is plain lower triangle
+bool tril_keep(const uint i, const uint j, __global const TYPE* g_key, const uint use_key) {
+    if (use_key) {
+        const TYPE key_i = g_key[i];
+        const TYPE key_j = g_key[j];
+        return key_j < key_i || (key_j == key_i && j < i);
+    }
+
+    return j < i;
+}
+
+__kernel void tril_count(__global const uint* g_Ap,
+                         __global const uint* g_Aj,
+                         __global const TYPE* g_key,
+                         __global uint*       g_counts,
+                         const uint           use_key,
+                         const uint           n) {
+    const uint gid   = get_global_id(0);
+    const uint gsize = get_global_size(0);
+
+    for (uint i = gid; i < n; i += gsize) {
+        const uint start = g_Ap[i];
+        const uint end   = g_Ap[i + 1];
+        uint       count = 0;
+
+        for (uint k = start; k < end; k++) {
+            if (tril_keep(i, g_Aj[k], g_key, use_key)) count += 1;
+        }
+
+        g_counts[i] = count;
+    }
+
+    if (gid == 0) g_counts[n] = 0;
+}
+
+__kernel void tril_fill(__global const uint* g_Ap,
+                        __global const uint* g_Aj,
+                        __global const TYPE* g_Ax,
+                        __global const TYPE* g_key,
+                        __global const uint* g_Rp,
+                        __global uint*       g_Rj,
+                        __global TYPE*       g_Rx,
+                        const uint           use_key,
+                        const uint           n) {
+    const uint gid   = get_global_id(0);
+    const uint gsize = get_global_size(0);
+
+    for (uint i = gid; i < n; i += gsize) {
+        const uint start  = g_Ap[i];
+        const uint end    = g_Ap[i + 1];
+        uint       offset = g_Rp[i];
+
+        for (uint k = start; k < end; k++) {
+            const uint j = g_Aj[k];
+
+            if (tril_keep(i, j, g_key, use_key)) {
+                g_Rj[offset] = j;
+                g_Rx[offset] = g_Ax[k];
+                offset += 1;
+            }
+        }
+    }
+}
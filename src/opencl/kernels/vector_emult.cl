@@ -1,10 +1,10 @@
 /**********************************************************************************/
 /* This file is part of spla project                                              */
-/* https://github.com/JetBrains-Research/spla                                     */
+/* https://github.com/SparseLinearAlgebra/spla                                    */
 /**********************************************************************************/
 /* MIT License                                                                    */
 /*                                                                                */
-/* Copyright (c) 2021 JetBrains-Research                                          */
+/* Copyright (c) 2023 SparseLinearAlgebra                                         */
 /*                                                                                */
 /* Permission is hereby granted, free of charge, to any person obtaining a copy   */
 /* of this software and associated documentation files (the "Software"), to deal  */
@@ -23,29 +23,19 @@
 /* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
 /* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
 /* SOFTWARE.                                                                      */
-/**********************************************************************************/
-
-#ifndef SPLA_CL_ALLOC_GENERAL_HPP
-#define SPLA_CL_ALLOC_GENERAL_HPP
-
-#include <opencl/cl_accelerator.hpp>
-#include <opencl/cl_alloc.hpp>
-
-namespace spla {
-
-    /**
-     * @class CLAllocGeneral
-     * @brief Wrapper for default OpenCL buffer allcoation
-     */
-    class CLAllocGeneral : public CLAlloc {
-    public:
-        ~CLAllocGeneral() override = default;
-        cl::Buffer alloc(std::size_t size) override;
-        void       alloc_paired(std::size_t size1, std::size_t size2, cl::Buffer& buffer1, cl::Buffer& buffer2);
-        void       free(cl::Buffer buffer) override;
-        void       free_all() override;
-    };
+#include "common_def.cl"
 
-}// namespace spla
+__kernel void dense_to_dense(__global TYPE*       g_rx,
+                             __global const TYPE* g_ux,
+                             __global const TYPE* g_vx,
+                             const TYPE           fill_u,
+                             const TYPE           fill_r,
+                             const uint           n) {
+    const uint gid   = get_global_id(0);
+    const uint gsize = get_global_size(0);
 
-#endif//SPLA_CL_ALLOC_GENERAL_HPP
+    for (uint i = gid; i < n; i += gsize) {
+        const TYPE x = g_ux[i];
+        g_rx[i]      = x != fill_u ? OP_BINARY(x, g_vx[i]) : fill_r;
+    }
+}
@@ -0,0 +1,341 @@
+/**********************************************************************************/
+/* This file is part of spla project                                              */
+/* https://github.com/SparseLinearAlgebra/spla                                    */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2023 SparseLinearAlgebra                                         */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#include "dispatch_tracer.hpp"
+
+#include <core/tmatrix.hpp>
+#include <core/tvector.hpp>
+#include <cpu/cpu_formats.hpp>
+#include <schedule/schedule_tasks.hpp>
+
+#include <algorithm>
+#include <cstring>
+
+namespace spla {
+
+    static thread_local DispatchTraceEvent* t_current = nullptr;
+
+    static void copy_name(char* dst, std::size_t capacity, const std::string& src) {
+        const std::size_t n = std::min(capacity - 1, src.size());
+        std::memcpy(dst, src.data(), n);
+        dst[n] = '\0';
+    }
+
+    template<typename T>
+    static bool get_values_typed(Object* object, std::uint64_t& values) {
+        if (auto* vector = dynamic_cast<TVector<T>*>(object)) {
+            values = vector->get_n_values();
+            return true;
+        }
+        if (auto* matrix = dynamic_cast<TMatrix<T>*>(object)) {
+            values = matrix->get_n_values();
+            return true;
+        }
+        return false;
+    }
+
+    static bool get_values(Object* object, std::uint64_t& values) {
+        return object &&
+               (get_values_typed<T_INT>(object, values) ||
+                get_values_typed<T_UINT>(object, values) ||
+                get_values_typed<T_FLOAT>(object, values));
+    }
+
+    template<typename T>
+    static bool get_edges_typed(Object* matrix, Object* vector, std::uint64_t& edges) {
+        auto* M = dynamic_cast<TMatrix<T>*>(matrix);
+        auto* v = dynamic_cast<TVector<T>*>(vector);
+
+        if (!M || !v) {
+            return false;
+        }
+
+        const std::uint64_t M_values = M->get_n_values();
+        const std::uint64_t v_values = v->get_n_values();
+        const std::uint64_t n_rows   = std::max<std::uint64_t>(1, v->get_n_rows());
+
+        // Exact count of traversed edges if frontier rows are available on host
+        if (v_values < n_rows && M->is_valid(FormatMatrix::CpuCsr) && v->is_valid(FormatVector::CpuCoo)) {
+            const auto* p_csr = M->template get<CpuCsr<T>>();
+            const auto* p_coo = v->template get<CpuCooVec<T>>();
+
+            edges = 0;
+            for (uint i : p_coo->Ai) {
+                edges += p_csr->Ap[i + 1] - p_csr->Ap[i];
+            }
+            return true;
+        }
+
+        edges = v_values >= n_rows ? M_values : M_values * v_values / n_rows;
+        return true;
+    }
+
+    static std::uint64_t get_edges(const ref_ptr<ScheduleTask>& task) {
+        std::uint64_t edges = 0;
+        Object*       M     = nullptr;
+        Object*       v     = nullptr;
+
+        if (auto* mxv = dynamic_cast<ScheduleTask_mxv_masked*>(task.get())) {
+            // Pull mxv scans whole matrix, so only push vxm uses frontier size
+            get_values(mxv->M.get(), edges);
+            return edges;
+        }
+        if (auto* vxm = dynamic_cast<ScheduleTask_vxm_masked*>(task.get())) {
+            M = vxm->M.get();
+            v = vxm->v.get();
+        } else {
+            return 0;
+        }
+
+        if (!get_edges_typed<T_INT>(M, v, edges) &&
+            !get_edges_typed<T_UINT>(M, v, edges)) {
+            get_edges_typed<T_FLOAT>(M, v, edges);
+        }
+
+        return edges;
+    }
+
+    static const char* format_name(bool matrix, int format) {
+        static const char* vector_names[] = {"CpuDok", "CpuDense", "CpuCoo", "AccDense", "AccCoo", "CpuBitmap"};
+        static const char* matrix_names[] = {"CpuLil", "CpuDok", "CpuCoo", "CpuCsr", "CpuCsc", "AccCoo", "AccCsr", "AccCsc"};
+
+        if (matrix) {
+            return format < static_cast<int>(FormatMatrix::Count) ? matrix_names[format] : "unknown";
+        }
+        return format < static_cast<int>(FormatVector::Count) ? vector_names[format] : "unknown";
+    }
+
+    static double get_gteps(const DispatchTraceEvent& event) {
+        return event.nano ? static_cast<double>(event.edges) / static_cast<double>(event.nano) : 0.0;
+    }
+
+    void DispatchTracer::set_enabled(bool value) {
+        if (value && !m_slots) {
+            m_slots = std::make_unique<Slot[]>(CAPACITY);
+        }
+
+        m_enabled.store(value, std::memory_order_relaxed);
+    }
+
+    void DispatchTracer::begin(DispatchTraceEvent& event, const ref_ptr<ScheduleTask>& task) {
+        // All tasks are made by library, so they share base with cached key and args
+        auto* base = static_cast<ScheduleTaskBase*>(task.get());
+
+        copy_name(event.task, DispatchTraceEvent::MAX_NAME, base->get_key_cached());
+
+        const auto& args = base->get_args_cached();
+        for (std::size_t i = 1; i < args.size(); i++) {
+            std::uint64_t values = 0;
+            if (get_values(args[i], values)) {
+                event.nnz_in += values;
+            }
+        }
+
+        event.edges      = get_edges(task);
+        event.parent     = t_current;
+        event.start_nano = since_epoch(std::chrono::steady_clock::now());
+        t_current        = &event;
+    }
+
+    void DispatchTracer::end(DispatchTraceEvent& event, const ref_ptr<ScheduleTask>& task, Status status) {
+        event.nano   = since_epoch(std::chrono::steady_clock::now()) - event.start_nano;
+        event.status = static_cast<int>(status);
+        t_current    = event.parent;
+
+        const auto& args = static_cast<ScheduleTaskBase*>(task.get())->get_args_cached();
+        if (!args.empty()) {
+            get_values(args.front(), event.nnz_out);
+        }
+
+        commit(event);
+    }
+
+    void DispatchTracer::add_conversion(bool matrix, int from, int to, std::size_t bytes, std::uint64_t nano) {
+        DispatchTraceEvent  standalone;
+        DispatchTraceEvent* event = t_current;
+
+        if (!event) {
+            event = &standalone;
+            copy_name(event->task, DispatchTraceEvent::MAX_NAME, "convert");
+            event->start_nano = since_epoch(std::chrono::steady_clock::now()) - nano;
+            event->nano       = nano;
+        }
+
+        if (event->conversions_count < DispatchTraceEvent::MAX_CONVERSIONS) {
+            auto& conversion  = event->conversions[event->conversions_count];
+            conversion.bytes  = bytes;
+            conversion.nano   = nano;
+            conversion.from   = static_cast<std::int8_t>(from);
+            conversion.to     = static_cast<std::int8_t>(to);
+            conversion.matrix = matrix;
+        }
+
+        event->conversions_count += 1;
+        event->conversions_bytes += bytes;
+        event->conversions_nano += nano;
+
+        if (event == &standalone) {
+            commit(standalone);
+        }
+    }
+
+    bool DispatchTracer::is_active() {
+        return t_current != nullptr;
+    }
+
+    void DispatchTracer::set_algo(const std::string& algo, const std::string& backend) {
+        if (t_current) {
+            // Registry key suffix is stored without leading separator
+            const std::size_t offset = std::min(backend.find_first_not_of('_'), backend.size());
+            copy_name(t_current->algo, DispatchTraceEvent::MAX_NAME, algo);
+            copy_name(t_current->backend, sizeof(t_current->backend), backend.substr(offset));
+        }
+    }
+
+    void DispatchTracer::commit(DispatchTraceEvent& event) {
+        const std::uint64_t index = m_head.fetch_add(1, std::memory_order_relaxed);
+        Slot&               slot  = m_slots[index % CAPACITY];
+
+        // Odd sequence marks slot as being written, even one as published
+        event.seq = index;
+        slot.seq.store(2 * index + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        slot.event = event;
+        slot.seq.store(2 * index + 2, std::memory_order_release);
+    }
+
+    void DispatchTracer::drain(std::vector<DispatchTraceEvent>& events) {
+        if (!m_slots) {
+            return;
+        }
+
+        const std::uint64_t head = m_head.load(std::memory_order_acquire);
+
+        if (head - m_tail > CAPACITY) {
+            m_dropped += head - m_tail - CAPACITY;
+            m_tail = head - CAPACITY;
+        }
+
+        for (; m_tail < head; m_tail++) {
+            Slot&               slot = m_slots[m_tail % CAPACITY];
+            const std::uint64_t seq  = slot.seq.load(std::memory_order_acquire);
+
+            if (seq != 2 * m_tail + 2) {
+                m_dropped += 1;
+                continue;
+            }
+
+            DispatchTraceEvent event = slot.event;
+            std::atomic_thread_fence(std::memory_order_acquire);
+
+            if (slot.seq.load(std::memory_order_relaxed) != seq) {
+                m_dropped += 1;
+                continue;
+            }
+
+            event.parent = nullptr;
+            events.push_back(event);
+        }
+    }
+
+    void DispatchTracer::write_json(const std::vector<DispatchTraceEvent>& events, std::ostream& where) {
+        where << "[";
+
+        for (std::size_t i = 0; i < events.size(); i++) {
+            const auto& event = events[i];
+
+            where << (i ? ",\n" : "\n")
+                  << "{\"seq\":" << event.seq
+                  << ",\"task\":\"" << event.task << "\""
+                  << ",\"algo\":\"" << event.algo << "\""
+                  << ",\"backend\":\"" << event.backend << "\""
+                  << ",\"status\":" << event.status
+                  << ",\"start_ns\":" << event.start_nano
+                  << ",\"time_ns\":" << event.nano
+                  << ",\"nnz_in\":" << event.nnz_in
+                  << ",\"nnz_out\":" << event.nnz_out
+                  << ",\"edges\":" << event.edges
+                  << ",\"gteps\":" << get_gteps(event)
+                  << ",\"conversions_count\":" << event.conversions_count
+                  << ",\"conversions_bytes\":" << event.conversions_bytes
+                  << ",\"conversions_ns\":" << event.conversions_nano
+                  << ",\"conversions\":[";
+
+            const int n = std::min(event.conversions_count, DispatchTraceEvent::MAX_CONVERSIONS);
+            for (int k = 0; k < n; k++) {
+                const auto& conversion = event.conversions[k];
+                where << (k ? "," : "")
+                      << "{\"from\":\"" << format_name(conversion.matrix, conversion.from) << "\""
+                      << ",\"to\":\"" << format_name(conversion.matrix, conversion.to) << "\""
+                      << ",\"bytes\":" << conversion.bytes
+                      << ",\"time_ns\":" << conversion.nano << "}";
+            }
+
+            where << "]}";
+        }
+
+        where << "\n]\n";
+    }
+
+    void DispatchTracer::write_csv(const std::vector<DispatchTraceEvent>& events, std::ostream& where) {
+        where << "seq,task,algo,backend,status,start_ns,time_ns,nnz_in,nnz_out,edges,gteps,"
+                 "conversions_count,conversions_bytes,conversions_ns,conversions\n";
+
+        for (const auto& event : events) {
+            where << event.seq << ","
+                  << event.task << ","
+                  << event.algo << ","
+                  << event.backend << ","
+                  << event.status << ","
+                  << event.start_nano << ","
+                  << event.nano << ","
+                  << event.nnz_in << ","
+                  << event.nnz_out << ","
+                  << event.edges << ","
+                  << get_gteps(event) << ","
+                  << event.conversions_count << ","
+                  << event.conversions_bytes << ","
+                  << event.conversions_nano << ",";
+
+            const int n = std::min(event.conversions_count, DispatchTraceEvent::MAX_CONVERSIONS);
+            for (int k = 0; k < n; k++) {
+                const auto& conversion = event.conversions[k];
+                where << (k ? ";" : "")
+                      << format_name(conversion.matrix, conversion.from) << ">"
+                      << format_name(conversion.matrix, conversion.to) << ":"
+                      << conversion.bytes;
+            }
+
+            where << "\n";
+        }
+    }
+
+    std::uint64_t DispatchTracer::since_epoch(std::chrono::steady_clock::time_point t) const {
+        return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(t - m_epoch).count());
+    }
+
+}// namespace spla
@@ -0,0 +1,142 @@
+/**********************************************************************************/
+/* This file is part of spla project                                              */
+/* https://github.com/SparseLinearAlgebra/spla                                    */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2023 SparseLinearAlgebra                                         */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#ifndef SPLA_DISPATCH_TRACER_HPP
+#define SPLA_DISPATCH_TRACER_HPP
+
+#include <spla/config.hpp>
+#include <spla/schedule.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace spla {
+
+    /**
+     * @addtogroup internal
+     * @{
+     */
+
+    /**
+     * @class DispatchTraceConversion
+     * @brief Single storage format conversion made by storage manager
+     */
+    struct DispatchTraceConversion {
+        std::uint64_t bytes  = 0;
+        std::uint64_t nano   = 0;
+        std::int8_t   from   = 0;
+        std::int8_t   to     = 0;
+        bool          matrix = false;
+    };
+
+    /**
+     * @class DispatchTraceEvent
+     * @brief Trace record of a single dispatched task or of a standalone conversion
+     *
+     * Trivially copyable, so it can be stored in the ring buffer without allocations.
+     */
+    struct DispatchTraceEvent {
+        static constexpr int MAX_CONVERSIONS = 8;
+        static constexpr int MAX_NAME        = 48;
+
+        char                    task[MAX_NAME]    = {};
+        char                    algo[MAX_NAME]    = {};
+        char                    backend[8]        = {};
+        std::uint64_t           seq               = 0;
+        std::uint64_t           start_nano        = 0;
+        std::uint64_t           nano              = 0;
+        std::uint64_t           nnz_in            = 0;
+        std::uint64_t           nnz_out           = 0;
+        std::uint64_t           edges             = 0;
+        std::uint64_t           conversions_bytes = 0;
+        std::uint64_t           conversions_nano  = 0;
+        int                     conversions_count = 0;
+        int                     status            = 0;
+        DispatchTraceConversion conversions[MAX_CONVERSIONS];
+        DispatchTraceEvent*     parent = nullptr;
+    };
+
+    /**
+     * @class DispatchTracer
+     * @brief Recorder of per-dispatch trace events into a fixed-size lock-free ring buffer
+     *
+     * Each dispatched task records chosen algo and backend, number of stored values
+     * of input and output containers, storage conversions triggered while task was
+     * executed and wall time. Writers reserve slot with a single atomic increment and
+     * publish it with a sequence number; oldest events are overwritten on overflow.
+     * Conversions made outside of any task (e.g. on user get/set) are recorded as standalone events.
+     * Task key and args are read from the task cache, filled on its first dispatch, so tracing
+     * allocates nothing on dispatch path once task is dispatched again.
+     */
+    class DispatchTracer final {
+    public:
+        static constexpr std::size_t CAPACITY = 1u << 14u;
+
+        void set_enabled(bool value);
+        bool is_enabled() const { return m_enabled.load(std::memory_order_relaxed); }
+
+        void begin(DispatchTraceEvent& event, const ref_ptr<ScheduleTask>& task);
+        void end(DispatchTraceEvent& event, const ref_ptr<ScheduleTask>& task, Status status);
+        void add_conversion(bool matrix, int from, int to, std::size_t bytes, std::uint64_t nano);
+        void drain(std::vector<DispatchTraceEvent>& events);
+
+        static bool is_active();
+        static void set_algo(const std::string& algo, const std::string& backend);
+        static void write_json(const std::vector<DispatchTraceEvent>& events, std::ostream& where);
+        static void write_csv(const std::vector<DispatchTraceEvent>& events, std::ostream& where);
+
+        std::uint64_t get_dropped() const { return m_dropped; }
+
+    private:
+        struct Slot {
+            std::atomic_uint64_t seq{0};
+            DispatchTraceEvent   event;
+        };
+
+        void          commit(DispatchTraceEvent& event);
+        std::uint64_t since_epoch(std::chrono::steady_clock::time_point t) const;
+
+        std::unique_ptr<Slot[]>               m_slots;
+        std::atomic_uint64_t                  m_head{0};
+        std::uint64_t                         m_tail    = 0;
+        std::uint64_t                         m_dropped = 0;
+        std::atomic_bool                      m_enabled{false};
+        std::chrono::steady_clock::time_point m_epoch = std::chrono::steady_clock::now();
+    };
+
+    /**
+     * @}
+     */
+
+}// namespace spla
+
+#endif//SPLA_DISPATCH_TRACER_HPP
@@ -0,0 +1,154 @@
+/**********************************************************************************/
+/* This file is part of spla project                                              */
+/* https://github.com/SparseLinearAlgebra/spla                                    */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2023 SparseLinearAlgebra                                         */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#include "perf_counters.hpp"
+
+#if defined(__linux__)
+    #include <linux/perf_event.h>
+    #include <sys/ioctl.h>
+    #include <sys/syscall.h>
+    #include <unistd.h>
+#endif
+
+#include <cstring>
+
+namespace spla {
+
+#if defined(__linux__)
+
+    static int perf_event_open(perf_event_attr* attr, int group_fd) {
+        // pid = 0, cpu = -1: calling thread on any cpu
+        return static_cast<int>(syscall(__NR_perf_event_open, attr, 0, -1, group_fd, 0));
+    }
+
+    static void perf_event_config(PerfCounter c, __u32& type, __u64& config) {
+        switch (c) {
+            case PerfCounter::Cycles:
+                type   = PERF_TYPE_HARDWARE;
+                config = PERF_COUNT_HW_CPU_CYCLES;
+                return;
+            case PerfCounter::Instructions:
+                type   = PERF_TYPE_HARDWARE;
+                config = PERF_COUNT_HW_INSTRUCTIONS;
+                return;
+            case PerfCounter::LlcMisses:
+                type   = PERF_TYPE_HARDWARE;
+                config = PERF_COUNT_HW_CACHE_MISSES;
+                return;
+            case PerfCounter::DtlbMisses:
+                type   = PERF_TYPE_HW_CACHE;
+                config = PERF_COUNT_HW_CACHE_DTLB |
+                         (PERF_COUNT_HW_CACHE_OP_READ << 8u) |
+                         (PERF_COUNT_HW_CACHE_RESULT_MISS << 16u);
+                return;
+            case PerfCounter::BranchMisses:
+                type   = PERF_TYPE_HARDWARE;
+                config = PERF_COUNT_HW_BRANCH_MISSES;
+                return;
+            default:
+                type   = PERF_TYPE_HARDWARE;
+                config = PERF_COUNT_HW_CPU_CYCLES;
+                return;
+        }
+    }
+
+    PerfCounterGroup::PerfCounterGroup() {
+        m_fds.fill(-1);
+        m_order.fill(-1);
+
+        for (int i = 0; i < PERF_COUNTER_COUNT; i++) {
+            perf_event_attr attr;
+            std::memset(&attr, 0, sizeof(attr));
+            attr.size           = sizeof(attr);
+            attr.disabled       = m_leader < 0 ? 1 : 0;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv     = 1;
+            attr.read_format    = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+            perf_event_config(static_cast<PerfCounter>(i), attr.type, attr.config);
+
+            const int fd = perf_event_open(&attr, m_leader);
+
+            if (fd < 0) {
+                // Without cycles there is no group to attach to
+                if (i == 0) return;
+                continue;
+            }
+
+            if (m_leader < 0) m_leader = fd;
+            m_fds[i]   = fd;
+            m_order[i] = m_n_opened++;
+        }
+
+        ioctl(m_leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+        ioctl(m_leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    }
+
+    PerfCounterGroup::~PerfCounterGroup() {
+        for (int fd : m_fds) {
+            if (fd >= 0) close(fd);
+        }
+    }
+
+    bool PerfCounterGroup::read(PerfCounterValues& values) const {
+        if (m_leader < 0) {
+            return false;
+        }
+
+        // Layout of PERF_FORMAT_GROUP read: nr, time_enabled, time_running, values[nr]
+        std::uint64_t buffer[3 + PERF_COUNTER_COUNT];
+
+        if (::read(m_leader, buffer, sizeof(buffer)) < static_cast<ssize_t>((3 + m_n_opened) * sizeof(std::uint64_t))) {
+            return false;
+        }
+
+        const std::uint64_t enabled = buffer[1];
+        const std::uint64_t running = buffer[2];
+        const double        scale   = running && running < enabled ? static_cast<double>(enabled) / static_cast<double>(running) : 1.0;
+
+        for (int i = 0; i < PERF_COUNTER_COUNT; i++) {
+            values.values[i] = m_order[i] >= 0 ? static_cast<std::uint64_t>(static_cast<double>(buffer[3 + m_order[i]]) * scale) : 0;
+        }
+
+        return true;
+    }
+
+#else
+
+    PerfCounterGroup::PerfCounterGroup() {
+        m_fds.fill(-1);
+        m_order.fill(-1);
+    }
+
+    PerfCounterGroup::~PerfCounterGroup() = default;
+
+    bool PerfCounterGroup::read(PerfCounterValues&) const {
+        return false;
+    }
+
+#endif
+
+}// namespace spla
@@ -0,0 +1,105 @@
+/**********************************************************************************/
+/* This file is part of spla project                                              */
+/* https://github.com/SparseLinearAlgebra/spla                                    */
+/**********************************************************************************/
+/* MIT License                                                                    */
+/*                                                                                */
+/* Copyright (c) 2023 SparseLinearAlgebra                                         */
+/*                                                                                */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy   */
+/* of this software and associated documentation files (the "Software"), to deal  */
+/* in the Software without restriction, including without limitation the rights   */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      */
+/* copies of the Software, and to permit persons to whom the Software is          */
+/* furnished to do so, subject to the following conditions:                       */
+/*                                                                                */
+/* The above copyright notice and this permission notice shall be included in all */
+/* copies or substantial portions of the Software.                                */
+/*                                                                                */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  */
+/* SOFTWARE.                                                                      */
+/**********************************************************************************/
+
+#ifndef SPLA_PERF_COUNTERS_HPP
+#define SPLA_PERF_COUNTERS_HPP
+
+#include <array>
+#include <cstdint>
+
+namespace spla {
+
+    /**
+     * @addtogroup internal
+     * @{
+     */
+
+    /**
+     * @class PerfCounter
+     * @brief Hardware counters sampled per profiled scope
+     */
+    enum class PerfCounter {
+        Cycles       = 0,
+        Instructions = 1,
+        LlcMisses    = 2,
+        DtlbMisses   = 3,
+        BranchMisses = 4,
+        Count        = 5
+    };
+
+    static constexpr int PERF_COUNTER_COUNT = static_cast<int>(PerfCounter::Count);
+
+    /**
+     * @class PerfCounterValues
+     * @brief Snapshot of counters; value of counter not available on host is zero
+     */
+    struct PerfCounterValues {
+        std::array<std::uint64_t, PERF_COUNTER_COUNT> values{};
+
+        std::uint64_t& operator[](PerfCounter c) { return values[static_cast<int>(c)]; }
+        std::uint64_t  operator[](PerfCounter c) const { return values[static_cast<int>(c)]; }
+    };
+
+    /**
+     * @class PerfCounterGroup
+     * @brief Group of hardware counters of calling thread opened with perf_event_open
+     *
+     * Counters are opened as a single group, so all of them are scheduled on pmu together
+     * and read with one syscall. Counters which can not be opened (missing pmu event, VM
+     * without pmu, restrictive perf_event_paranoid, non-linux host) are silently skipped;
+     * if group leader fails, group is not available and reads return false.
+     * Values are scaled by enabled/running time in case of counters multiplexing.
+     *
+     * @note Group counts events only of the thread which created it
+     */
+    class PerfCounterGroup final {
+    public:
+        PerfCounterGroup();
+        ~PerfCounterGroup();
+
+        PerfCounterGroup(const PerfCounterGroup&)            = delete;
+        PerfCounterGroup& operator=(const PerfCounterGroup&) = delete;
+
+        bool read(PerfCounterValues& values) const;
+
+        [[nodiscard]] bool is_available() const { return m_leader >= 0; }
+        [[nodiscard]] bool is_opened(PerfCounter c) const { return m_fds[static_cast<int>(c)] >= 0; }
+
+    private:
+        std::array<int, PERF_COUNTER_COUNT> m_fds;
+        std::array<int, PERF_COUNTER_COUNT> m_order;// position of counter in group read
+        int                                 m_leader   = -1;
+        int                                 m_n_opened = 0;
+    };
+
+    /**
+     * @}
+     */
+
+}// namespace spla
+
+#endif//SPLA_PERF_COUNTERS_HPP
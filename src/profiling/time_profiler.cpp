@@ -29,6 +29,9 @@
 
 #include <spla/library.hpp>
 
+#include <algorithm>
+#include <cmath>
+
 namespace spla {
 
     TimeProfilerLabel::TimeProfilerLabel(TimeProfilerLabel* in_parent, const char* in_name, const char* in_file, const char* in_function) {
@@ -45,44 +48,252 @@ namespace spla {
         Library::get()->get_time_profiler()->add_label(this);
     }
 
+    void TimeProfilerStats::add(std::uint64_t nano) {
+        min = count ? std::min(min, nano) : nano;
+        max = count ? std::max(max, nano) : nano;
+        count += 1;
+        total += nano;
+
+        int bucket = 0;
+        while (bucket + 1 < HIST_BUCKETS && (nano >> (bucket + 1)) != 0) {
+            bucket += 1;
+        }
+        hist[bucket] += 1;
+    }
+
+    void TimeProfilerStats::add_counters(const PerfCounterValues& delta) {
+        counted += 1;
+
+        for (int i = 0; i < PERF_COUNTER_COUNT; i++) {
+            counters.values[i] += delta.values[i];
+        }
+    }
+
+    void TimeProfilerStats::merge(const TimeProfilerStats& other) {
+        if (!other.count) {
+            return;
+        }
+
+        min = count ? std::min(min, other.min) : other.min;
+        max = count ? std::max(max, other.max) : other.max;
+        count += other.count;
+        total += other.total;
+        work += other.work;
+        counted += other.counted;
+
+        for (int i = 0; i < PERF_COUNTER_COUNT; i++) {
+            counters.values[i] += other.counters.values[i];
+        }
+
+        for (int i = 0; i < HIST_BUCKETS; i++) {
+            hist[i] += other.hist[i];
+        }
+    }
+
+    std::uint64_t TimeProfilerStats::percentile(double p) const {
+        const auto    target = static_cast<std::uint64_t>(std::ceil(p * static_cast<double>(count)));
+        std::uint64_t seen   = 0;
+
+        for (int i = 0; i < HIST_BUCKETS; i++) {
+            seen += hist[i];
+            if (seen >= target && seen > 0) {
+                // upper bound of bucket, but never above observed max
+                return std::min(max, (std::uint64_t(2) << i) - 1);
+            }
+        }
+
+        return max;
+    }
+
     TimeProfilerScope::TimeProfilerScope(TimeProfilerLabel* in_label) {
-        label = in_label;
-        start = end = std::chrono::steady_clock::now();
+        TimeProfiler* profiler = Library::get()->get_time_profiler();
+
+        label = profiler->is_enabled() ? in_label : nullptr;
+
+        if (label) {
+            counted = profiler->is_counters_enabled() && profiler->read_counters(counters_start);
+            start   = std::chrono::steady_clock::now();
+        }
     }
 
     TimeProfilerScope::~TimeProfilerScope() {
-        end          = std::chrono::steady_clock::now();
-        auto elapsed = end - start;
-        label->nano.store(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+        if (label) {
+            auto              elapsed  = std::chrono::steady_clock::now() - start;
+            TimeProfiler*     profiler = Library::get()->get_time_profiler();
+            PerfCounterValues delta;
+
+            if (counted && profiler->read_counters(delta)) {
+                for (int i = 0; i < PERF_COUNTER_COUNT; i++) {
+                    delta.values[i] = delta.values[i] >= counters_start.values[i] ? delta.values[i] - counters_start.values[i] : 0;
+                }
+            } else {
+                counted = false;
+            }
+
+            profiler->add_sample(label, start, std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count(),
+                                 counted ? &delta : nullptr, work);
+        }
+    }
+
+    TimeProfiler::TimeProfiler() {
+        // Ids are never reused, so thread cache cannot match profiler re-created at the same address
+        static std::atomic<std::uint64_t> s_next_instance_id{1};
+
+        m_epoch       = std::chrono::steady_clock::now();
+        m_instance_id = s_next_instance_id.fetch_add(1, std::memory_order_relaxed);
     }
 
     void TimeProfiler::add_label(TimeProfilerLabel* label) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        label->id             = static_cast<int>(m_labels_by_id.size());
         m_labels[label->name] = label;
+        m_labels_by_id.push_back(label);
+    }
+
+    void TimeProfiler::add_sample(TimeProfilerLabel* label, std::chrono::steady_clock::time_point start, std::uint64_t nano,
+                                  const PerfCounterValues* counters_delta, std::uint64_t work) {
+        TimeProfilerThread* thread = get_thread();
+
+        if (thread->stats.size() <= std::size_t(label->id)) {
+            thread->stats.resize(label->id + 1);
+        }
+
+        TimeProfilerStats& stats = thread->stats[label->id];
+        stats.add(nano);
+        stats.work += work;
+
+        if (counters_delta) {
+            stats.add_counters(*counters_delta);
+        }
+
+        if (thread->events.size() < MAX_EVENTS_PER_THREAD) {
+            auto since_epoch = std::chrono::duration_cast<std::chrono::nanoseconds>(start - m_epoch).count();
+            thread->events.push_back({label->id, static_cast<std::uint64_t>(since_epoch), nano});
+        }
+    }
+
+    bool TimeProfiler::read_counters(PerfCounterValues& values) {
+        TimeProfilerThread* thread = get_thread();
+
+        // Opened lazily on first use, so only threads which run profiled scopes pay for fds
+        if (!thread->counters) {
+            thread->counters = std::make_unique<PerfCounterGroup>();
+        }
+
+        return thread->counters->read(values);
     }
 
     void TimeProfiler::dump(std::ostream& where) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
         for (const auto& entry : m_labels) {
             const auto& name  = entry.first;
             const auto& label = entry.second;
-            const auto  value = label->nano.load();
 
-            if (value != 0) {
-                auto all      = static_cast<double>(label->nano.load()) * 1e-6;
-                auto queued   = static_cast<double>(label->queued_nano) * 1e-6;
-                auto executed = static_cast<double>(label->executed_nano) * 1e-6;
+            TimeProfilerStats stats;
+            for (const auto& thread : m_threads) {
+                if (std::size_t(label->id) < thread->stats.size()) {
+                    stats.merge(thread->stats[label->id]);
+                }
+            }
+
+            if (stats.count != 0) {
+                auto to_ms = [](std::uint64_t nano) { return static_cast<double>(nano) * 1e-6; };
+
+                where << "  - " << name
+                      << " calls: " << stats.count
+                      << " total: " << to_ms(stats.total)
+                      << " avg: " << to_ms(stats.total) / static_cast<double>(stats.count)
+                      << " min: " << to_ms(stats.min)
+                      << " p50: " << to_ms(stats.percentile(0.5))
+                      << " p99: " << to_ms(stats.percentile(0.99))
+                      << " max: " << to_ms(stats.max) << " ms";
 
-                where << "  - " << name << " " << all << " (queue: " << queued << " exec: " << executed << ") ms\n";
+                if (label->queued_nano || label->executed_nano) {
+                    where << " (queue: " << to_ms(label->queued_nano) << " exec: " << to_ms(label->executed_nano) << " ms)";
+                }
+
+                if (stats.counted != 0) {
+                    const auto& c      = stats.counters;
+                    const auto  cycles = static_cast<double>(c[PerfCounter::Cycles]);
+                    // Normalize by processed nnz if scope reported it, otherwise by calls
+                    const auto  per    = static_cast<double>(stats.work ? stats.work : stats.counted);
+                    const char* unit   = stats.work ? "/nnz" : "/call";
+
+                    where << " [ipc: " << (cycles > 0 ? static_cast<double>(c[PerfCounter::Instructions]) / cycles : 0.0)
+                          << " cycles" << unit << ": " << cycles / per
+                          << " llc-miss" << unit << ": " << static_cast<double>(c[PerfCounter::LlcMisses]) / per
+                          << " dtlb-miss" << unit << ": " << static_cast<double>(c[PerfCounter::DtlbMisses]) / per
+                          << " br-miss" << unit << ": " << static_cast<double>(c[PerfCounter::BranchMisses]) / per << "]";
+                } else if (stats.work != 0) {
+                    where << " [nnz: " << stats.work << "]";
+                }
+
+                where << "\n";
             }
         }
     }
 
     void TimeProfiler::reset() {
-        for (const auto& entry : m_labels) {
-            const auto& label = entry.second;
-            label->nano.store(0);
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        for (auto* label : m_labels_by_id) {
             label->queued_nano   = 0;
             label->executed_nano = 0;
         }
+        for (auto& thread : m_threads) {
+            thread->stats.clear();
+            thread->events.clear();
+        }
+    }
+
+    void TimeProfiler::export_trace(std::ostream& where) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        auto escape = [](const std::string& s) {
+            std::string result;
+            for (char c : s) {
+                if (c == '"' || c == '\\') result.push_back('\\');
+                result.push_back(c);
+            }
+            return result;
+        };
+
+        where << "{\"traceEvents\":[";
+
+        bool first = true;
+        for (const auto& thread : m_threads) {
+            for (const auto& event : thread->events) {
+                where << (first ? "\n" : ",\n")
+                      << "{\"name\":\"" << escape(m_labels_by_id[event.label]->name) << "\""
+                      << ",\"cat\":\"spla\",\"ph\":\"X\",\"pid\":0"
+                      << ",\"tid\":" << thread->tid
+                      << ",\"ts\":" << static_cast<double>(event.start) * 1e-3
+                      << ",\"dur\":" << static_cast<double>(event.nano) * 1e-3 << "}";
+                first = false;
+            }
+        }
+
+        where << "\n],\"displayTimeUnit\":\"ms\"}\n";
+    }
+
+    TimeProfilerThread* TimeProfiler::get_thread() {
+        // Cache is keyed by profiler instance: cached thread is owned by it and dangles once library is re-created
+        static thread_local std::uint64_t       t_instance_id = 0;
+        static thread_local TimeProfilerThread* t_thread      = nullptr;
+
+        if (t_instance_id != m_instance_id) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            auto thread   = std::make_unique<TimeProfilerThread>();
+            thread->tid   = static_cast<int>(m_threads.size());
+            t_thread      = thread.get();
+            t_instance_id = m_instance_id;
+            m_threads.push_back(std::move(thread));
+        }
+
+        return t_thread;
     }
 
-}// namespace spla
\ No newline at end of file
+}// namespace spla
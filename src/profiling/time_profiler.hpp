@@ -28,11 +28,18 @@
 #ifndef SPLA_TIME_PROFILER_HPP
 #define SPLA_TIME_PROFILER_HPP
 
+#include <profiling/perf_counters.hpp>
+
+#include <array>
 #include <atomic>
 #include <chrono>
+#include <cstdint>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <ostream>
 #include <string>
+#include <vector>
 
 namespace spla {
 
@@ -44,14 +51,62 @@ namespace spla {
     struct TimeProfilerLabel {
         TimeProfilerLabel(TimeProfilerLabel* in_parent, const char* in_name, const char* in_file, const char* in_function);
 
-        std::string          name;
-        const char*          file;
-        const char*          function;
-        int                  child_count = 0;
-        std::atomic_uint64_t nano;
-        std::uint64_t        queued_nano   = 0;
-        std::uint64_t        executed_nano = 0;
-        TimeProfilerLabel*   parent;
+        std::string        name;
+        const char*        file;
+        const char*        function;
+        int                id          = -1;
+        int                child_count = 0;
+        std::uint64_t      queued_nano   = 0;
+        std::uint64_t      executed_nano = 0;
+        TimeProfilerLabel* parent;
+    };
+
+    /**
+     * @class TimeProfilerStats
+     * @brief Aggregated durations of a single label
+     *
+     * Histogram bucket `b` counts durations in range [2^b, 2^(b+1)) nanoseconds.
+     * Counters hold sums of hardware counters deltas of `counted` samples,
+     * work holds sum of nnz processed by scopes which reported it.
+     */
+    struct TimeProfilerStats {
+        static constexpr int HIST_BUCKETS = 40;
+
+        void add(std::uint64_t nano);
+        void add_counters(const PerfCounterValues& delta);
+        void merge(const TimeProfilerStats& other);
+
+        [[nodiscard]] std::uint64_t percentile(double p) const;
+
+        std::uint64_t                           count   = 0;
+        std::uint64_t                           total   = 0;
+        std::uint64_t                           min     = 0;
+        std::uint64_t                           max     = 0;
+        std::uint64_t                           work    = 0;
+        std::uint64_t                           counted = 0;
+        PerfCounterValues                       counters;
+        std::array<std::uint64_t, HIST_BUCKETS> hist{};
+    };
+
+    /**
+     * @class TimeProfilerEvent
+     * @brief Single recorded scope for trace export
+     */
+    struct TimeProfilerEvent {
+        int           label;
+        std::uint64_t start;
+        std::uint64_t nano;
+    };
+
+    /**
+     * @class TimeProfilerThread
+     * @brief Thread-local storage of recorded durations, written without locks
+     */
+    struct TimeProfilerThread {
+        int                               tid = 0;
+        std::vector<TimeProfilerStats>    stats;
+        std::vector<TimeProfilerEvent>    events;
+        std::unique_ptr<PerfCounterGroup> counters;
     };
 
     struct TimeProfilerScope {
@@ -60,44 +115,74 @@ namespace spla {
 
         TimeProfilerLabel*                    label;
         std::chrono::steady_clock::time_point start;
-        std::chrono::steady_clock::time_point end;
+        PerfCounterValues                     counters_start;
+        bool                                  counted = false;
+        std::uint64_t                         work    = 0;
     };
 
     /**
      * @class TimeProfiler
      * @brief Scope-based time profiler to measure perf of schedule tasks execution
+     *
+     * Each thread records count, total, min, max and log2 histogram of scopes
+     * durations per label into its own storage. Storages are merged on dump.
+     * Profiler can be switched at runtime; when disabled scopes cost a single flag check.
+     * Optionally each thread opens group of hardware counters and scopes record counters deltas;
+     * if counters are not available on host, only durations are recorded.
+     *
+     * @note Dump, reset and export must not be called while other threads record scopes
      */
     class TimeProfiler final {
     public:
+        TimeProfiler();
+
         void add_label(TimeProfilerLabel* label);
+        void add_sample(TimeProfilerLabel* label, std::chrono::steady_clock::time_point start, std::uint64_t nano,
+                        const PerfCounterValues* counters_delta, std::uint64_t work);
+        bool read_counters(PerfCounterValues& values);
         void dump(std::ostream& where);
         void reset();
+        void export_trace(std::ostream& where);
+        void set_enabled(bool value) { m_enabled.store(value, std::memory_order_relaxed); }
+        bool is_enabled() const { return m_enabled.load(std::memory_order_relaxed); }
+        void set_counters_enabled(bool value) { m_counters_enabled.store(value, std::memory_order_relaxed); }
+        bool is_counters_enabled() const { return m_counters_enabled.load(std::memory_order_relaxed); }
+
+        static constexpr std::size_t MAX_EVENTS_PER_THREAD = 1u << 20u;
 
     private:
-        std::map<std::string, TimeProfilerLabel*> m_labels;
+        TimeProfilerThread* get_thread();
+
+        std::map<std::string, TimeProfilerLabel*>        m_labels;
+        std::vector<TimeProfilerLabel*>                  m_labels_by_id;
+        std::vector<std::unique_ptr<TimeProfilerThread>> m_threads;
+        std::chrono::steady_clock::time_point            m_epoch;
+        std::uint64_t                                    m_instance_id;
+        std::atomic_bool                                 m_enabled{false};
+        std::atomic_bool                                 m_counters_enabled{false};
+        std::mutex                                       m_mutex;
     };
 
     /**
      * @}
      */
 
-#ifndef SPLA_RELEASE
-    #define TIME_PROFILE_LABEL    __auto_profile_label
-    #define TIME_PROFILE_SUBLABEL __auto_profile_sublabel
-
-    #define TIME_PROFILE_SUBSCOPE(name)                                                                      \
-        static TimeProfilerLabel TIME_PROFILE_SUBLABEL(&__auto_profile_label, name, __FILE__, __FUNCTION__); \
-        TimeProfilerScope        __auto_profile_subscope(&TIME_PROFILE_SUBLABEL);
-
-    #define TIME_PROFILE_SCOPE(name)                                                        \
-        static TimeProfilerLabel TIME_PROFILE_LABEL(nullptr, name, __FILE__, __FUNCTION__); \
-        TimeProfilerScope        __auto_profile_scope(&TIME_PROFILE_LABEL);
-#else
-    #define TIME_PROFILE_LABEL
-    #define TIME_PROFILE_SUBLABEL
-    #define TIME_PROFILE_SCOPE(name)
-    #define TIME_PROFILE_SUBSCOPE(name)
-#endif
+#define TIME_PROFILE_LABEL    __auto_profile_label
+#define TIME_PROFILE_SUBLABEL __auto_profile_sublabel
+
+#define TIME_PROFILE_SUBSCOPE(name)                                                                      \
+    static TimeProfilerLabel TIME_PROFILE_SUBLABEL(&__auto_profile_label, name, __FILE__, __FUNCTION__); \
+    TimeProfilerScope        __auto_profile_subscope(&TIME_PROFILE_SUBLABEL);
+
+#define TIME_PROFILE_SCOPE(name)                                                        \
+    static TimeProfilerLabel TIME_PROFILE_LABEL(nullptr, name, __FILE__, __FUNCTION__); \
+    TimeProfilerScope        __auto_profile_scope(&TIME_PROFILE_LABEL);
+
+/** Attributes work (nnz processed) to current scope; expression is evaluated only when profiling */
+#define TIME_PROFILE_SCOPE_WORK(nnz)                                  \
+    if (__auto_profile_scope.label) {                                 \
+        __auto_profile_scope.work += static_cast<std::uint64_t>(nnz); \
+    }
 
 }// namespace spla
 
@@ -27,7 +27,9 @@
 
 #include "schedule_st.hpp"
 
+#include <core/accelerator.hpp>
 #include <core/dispatcher.hpp>
+#include <core/lazy_planner.hpp>
 
 namespace spla {
 
@@ -44,24 +46,38 @@ namespace spla {
     }
 
     Status ScheduleSingleThread::submit() {
-        Dispatcher*     g_dispatcher = Library::get()->get_dispatcher();
+        Dispatcher*     g_dispatcher  = Library::get()->get_dispatcher();
+        Accelerator*    g_accelerator = Library::get()->get_accelerator();
         DispatchContext ctx{};
 
+        // Scheduled tasks observe objects state, so pending lazy tasks go first
+        Status pending_status = Library::get()->get_lazy_planner()->sync_all();
+        if (pending_status != Status::Ok) {
+            return pending_status;
+        }
+
         ctx.schedule = ref_ptr<Schedule>(this);
 
         for (int step_id = 0; step_id < static_cast<int>(m_steps.size()); step_id++) {
             auto& step  = m_steps[step_id];
             ctx.step_id = step_id;
 
-            for (int task_id = 0; task_id < static_cast<int>(step.size()); task_id++) {
+            // Tasks of a step are independent, so accelerator may run them on different queues
+            Status status = Status::Ok;
+
+            for (int task_id = 0; task_id < static_cast<int>(step.size()) && status == Status::Ok; task_id++) {
                 auto& task  = step[task_id];
                 ctx.task    = task;
                 ctx.task_id = task_id;
 
-                auto status = g_dispatcher->dispatch(ctx);
-                if (status != Status::Ok) {
-                    return status;
-                }
+                status = g_dispatcher->dispatch(ctx);
+            }
+
+            if (g_accelerator) {
+                g_accelerator->join_tasks();
+            }
+            if (status != Status::Ok) {
+                return status;
             }
         }
 
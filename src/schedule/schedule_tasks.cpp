@@ -48,6 +48,25 @@ namespace spla {
         static ref_ptr<Descriptor> default_desc(new Descriptor);
         return desc.is_not_null() ? desc : default_desc;
     }
+    const std::string& ScheduleTaskBase::get_key_cached() {
+        cache();
+        return m_key_cached;
+    }
+    const std::vector<Object*>& ScheduleTaskBase::get_args_cached() {
+        cache();
+        return m_args_cached;
+    }
+    void ScheduleTaskBase::cache() {
+        // Args are fixed once task is filled in and dispatched, so key and args are built once per task.
+        // Raw pointers are kept, since extra references would make temporaries look alive to lazy planner.
+        if (m_is_cached) return;
+
+        m_key_cached = get_key();
+        for (const auto& arg : get_args()) {
+            m_args_cached.push_back(arg.get());
+        }
+        m_is_cached = true;
+    }
 
     std::string ScheduleTask_callback::get_name() {
         return "callback";
@@ -99,13 +118,15 @@ namespace spla {
         std::stringstream key;
         key << get_name()
             << OP_KEY(op_multiply)
-            << OP_KEY(op_add)
-            << OP_KEY(op_select);
+            << OP_KEY(op_add);
+
+        if (op_select) key << OP_KEY(op_select);
+        if (op_accum) key << OP_KEY(op_accum);
 
         return key.str();
     }
     std::vector<ref_ptr<Object>> ScheduleTask_mxv_masked::get_args() {
-        return {r.as<Object>(), mask.as<Object>(), M.as<Object>(), v.as<Object>(), op_multiply.as<Object>(), op_add.as<Object>(), op_select.as<Object>(), init.as<Object>()};
+        return {r.as<Object>(), mask.as<Object>(), M.as<Object>(), v.as<Object>(), op_multiply.as<Object>(), op_add.as<Object>(), op_select.as<Object>(), init.as<Object>(), op_accum.as<Object>(), changed.as<Object>()};
     }
 
     std::string ScheduleTask_vxm_masked::get_name() {
@@ -122,13 +143,15 @@ namespace spla {
         std::stringstream key;
         key << get_name()
             << OP_KEY(op_multiply)
-            << OP_KEY(op_add)
-            << OP_KEY(op_select);
+            << OP_KEY(op_add);
+
+        if (op_select) key << OP_KEY(op_select);
+        if (op_accum) key << OP_KEY(op_accum);
 
         return key.str();
     }
     std::vector<ref_ptr<Object>> ScheduleTask_vxm_masked::get_args() {
-        return {r.as<Object>(), mask.as<Object>(), v.as<Object>(), M.as<Object>(), op_multiply.as<Object>(), op_add.as<Object>(), op_select.as<Object>(), init.as<Object>()};
+        return {r.as<Object>(), mask.as<Object>(), v.as<Object>(), M.as<Object>(), op_multiply.as<Object>(), op_add.as<Object>(), op_select.as<Object>(), init.as<Object>(), op_accum.as<Object>(), changed.as<Object>()};
     }
 
     std::string ScheduleTask_m_reduce_by_row::get_name() {
@@ -152,6 +175,48 @@ namespace spla {
         return {r.as<Object>(), M.as<Object>(), op_reduce.as<Object>(), init.as<Object>()};
     }
 
+    std::string ScheduleTask_m_select::get_name() {
+        return "m_select";
+    }
+    std::string ScheduleTask_m_select::get_key() {
+        std::stringstream key;
+        key << get_name()
+            << TYPE_KEY(R->get_type());
+
+        return key.str();
+    }
+    std::string ScheduleTask_m_select::get_key_full() {
+        std::stringstream key;
+        key << get_name()
+            << OP_KEY(op_select);
+
+        return key.str();
+    }
+    std::vector<ref_ptr<Object>> ScheduleTask_m_select::get_args() {
+        return {R.as<Object>(), M.as<Object>(), op_select.as<Object>()};
+    }
+
+    std::string ScheduleTask_m_tril::get_name() {
+        return "m_tril";
+    }
+    std::string ScheduleTask_m_tril::get_key() {
+        std::stringstream key;
+        key << get_name()
+            << TYPE_KEY(R->get_type());
+
+        return key.str();
+    }
+    std::string ScheduleTask_m_tril::get_key_full() {
+        std::stringstream key;
+        key << get_name()
+            << TYPE_KEY(R->get_type());
+
+        return key.str();
+    }
+    std::vector<ref_ptr<Object>> ScheduleTask_m_tril::get_args() {
+        return {R.as<Object>(), M.as<Object>(), key.as<Object>()};
+    }
+
     std::string ScheduleTask_m_reduce::get_name() {
         return "m_reduce";
     }
@@ -194,6 +259,27 @@ namespace spla {
         return {r.as<Object>(), u.as<Object>(), v.as<Object>(), op.as<Object>()};
     }
 
+    std::string ScheduleTask_v_emult::get_name() {
+        return "v_emult";
+    }
+    std::string ScheduleTask_v_emult::get_key() {
+        std::stringstream key;
+        key << get_name()
+            << TYPE_KEY(r->get_type());
+
+        return key.str();
+    }
+    std::string ScheduleTask_v_emult::get_key_full() {
+        std::stringstream key;
+        key << get_name()
+            << OP_KEY(op);
+
+        return key.str();
+    }
+    std::vector<ref_ptr<Object>> ScheduleTask_v_emult::get_args() {
+        return {r.as<Object>(), u.as<Object>(), v.as<Object>(), op.as<Object>()};
+    }
+
     std::string ScheduleTask_v_eadd_fdb::get_name() {
         return "v_eadd_fdb";
     }
@@ -258,6 +344,27 @@ namespace spla {
         return {r.as<Object>(), v.as<Object>(), op.as<Object>()};
     }
 
+    std::string ScheduleTask_v_select_range::get_name() {
+        return "v_select_range";
+    }
+    std::string ScheduleTask_v_select_range::get_key() {
+        std::stringstream key;
+        key << get_name()
+            << TYPE_KEY(r->get_type());
+
+        return key.str();
+    }
+    std::string ScheduleTask_v_select_range::get_key_full() {
+        std::stringstream key;
+        key << get_name()
+            << TYPE_KEY(r->get_type());
+
+        return key.str();
+    }
+    std::vector<ref_ptr<Object>> ScheduleTask_v_select_range::get_args() {
+        return {r.as<Object>(), v.as<Object>(), lo.as<Object>(), hi.as<Object>()};
+    }
+
     std::string ScheduleTask_v_reduce::get_name() {
         return "v_reduce";
     }
@@ -279,6 +386,62 @@ namespace spla {
         return {r.as<Object>(), s.as<Object>(), v.as<Object>(), op_reduce.as<Object>()};
     }
 
+    std::string ScheduleTask_v_eadd_reduce::get_name() {
+        return "v_eadd_reduce";
+    }
+    std::string ScheduleTask_v_eadd_reduce::get_key() {
+        std::stringstream key;
+        key << get_name()
+            << TYPE_KEY(r->get_type());
+
+        return key.str();
+    }
+    std::string ScheduleTask_v_eadd_reduce::get_key_full() {
+        std::stringstream key;
+        key << get_name()
+            << OP_KEY(op_elem)
+            << OP_KEY(op_reduce);
+
+        return key.str();
+    }
+    std::vector<ref_ptr<Object>> ScheduleTask_v_eadd_reduce::get_args() {
+        return {r.as<Object>(), s.as<Object>(), u.as<Object>(), v.as<Object>(), op_elem.as<Object>(), op_reduce.as<Object>()};
+    }
+
+    std::string ScheduleTask_v_ewise_chain::get_name() {
+        return "v_ewise_chain";
+    }
+    std::string ScheduleTask_v_ewise_chain::get_key() {
+        std::stringstream key;
+        key << get_name()
+            << TYPE_KEY(u->get_type());
+
+        return key.str();
+    }
+    std::string ScheduleTask_v_ewise_chain::get_key_full() {
+        std::stringstream key;
+        key << get_name();
+
+        if (op_elem) key << OP_KEY(op_elem);
+        for (const auto& op : ops_map) key << OP_KEY(op);
+        if (op_reduce) key << OP_KEY(op_reduce);
+
+        return key.str();
+    }
+    std::vector<ref_ptr<Object>> ScheduleTask_v_ewise_chain::get_args() {
+        std::vector<ref_ptr<Object>> args;
+
+        args.push_back(op_reduce ? reduced.as<Object>() : r.as<Object>());
+        args.push_back(s.as<Object>());
+        args.push_back(u.as<Object>());
+        args.push_back(v.as<Object>());
+        args.push_back(op_elem.as<Object>());
+        for (const auto& op : ops_map) args.push_back(op.as<Object>());
+        args.push_back(op_reduce.as<Object>());
+
+        return args;
+    }
+
     std::string ScheduleTask_v_count_mf::get_name() {
         return "v_count_mf";
     }
@@ -48,13 +48,22 @@ namespace spla {
     public:
         ~ScheduleTaskBase() override = default;
 
-        void                set_label(std::string label) override;
-        const std::string&  get_label() const override;
-        ref_ptr<Descriptor> get_desc() override;
-        ref_ptr<Descriptor> get_desc_or_default() override;
+        void                        set_label(std::string label) override;
+        const std::string&          get_label() const override;
+        ref_ptr<Descriptor>         get_desc() override;
+        ref_ptr<Descriptor>         get_desc_or_default() override;
+        const std::string&          get_key_cached();
+        const std::vector<Object*>& get_args_cached();
 
         std::string         label;
         ref_ptr<Descriptor> desc;
+
+    private:
+        void cache();
+
+        std::string          m_key_cached;
+        std::vector<Object*> m_args_cached;
+        bool                 m_is_cached = false;
     };
 
     /**
@@ -117,6 +126,8 @@ namespace spla {
         ref_ptr<OpBinary> op_add;
         ref_ptr<OpSelect> op_select;
         ref_ptr<Scalar>   init;
+        ref_ptr<OpBinary> op_accum;// optional, merge result into r
+        ref_ptr<Vector>   changed; // optional, entries of r changed by accum
     };
 
     /**
@@ -140,6 +151,8 @@ namespace spla {
         ref_ptr<OpBinary> op_add;
         ref_ptr<OpSelect> op_select;
         ref_ptr<Scalar>   init;
+        ref_ptr<OpBinary> op_accum;// optional, merge result into r
+        ref_ptr<Vector>   changed; // optional, entries of r changed by accum
     };
 
     /**
@@ -161,6 +174,42 @@ namespace spla {
         ref_ptr<Scalar>   init;
     };
 
+    /**
+     * @class ScheduleTask_m_select
+     * @brief Matrix select of entries to matrix
+     */
+    class ScheduleTask_m_select final : public ScheduleTaskBase {
+    public:
+        ~ScheduleTask_m_select() override = default;
+
+        std::string                  get_name() override;
+        std::string                  get_key() override;
+        std::string                  get_key_full() override;
+        std::vector<ref_ptr<Object>> get_args() override;
+
+        ref_ptr<Matrix>   R;
+        ref_ptr<Matrix>   M;
+        ref_ptr<OpSelect> op_select;
+    };
+
+    /**
+     * @class ScheduleTask_m_tril
+     * @brief Matrix strictly lower triangle by keys order
+     */
+    class ScheduleTask_m_tril final : public ScheduleTaskBase {
+    public:
+        ~ScheduleTask_m_tril() override = default;
+
+        std::string                  get_name() override;
+        std::string                  get_key() override;
+        std::string                  get_key_full() override;
+        std::vector<ref_ptr<Object>> get_args() override;
+
+        ref_ptr<Matrix> R;
+        ref_ptr<Matrix> M;
+        ref_ptr<Vector> key;
+    };
+
     /**
      * @class ScheduleTask_m_reduce
      * @brief Matrix reduction to scalar
@@ -199,6 +248,25 @@ namespace spla {
         ref_ptr<OpBinary> op;
     };
 
+    /**
+     * @class ScheduleTask_v_emult
+     * @brief Vector ewise by structure of first vector
+     */
+    class ScheduleTask_v_emult final : public ScheduleTaskBase {
+    public:
+        ~ScheduleTask_v_emult() override = default;
+
+        std::string                  get_name() override;
+        std::string                  get_key() override;
+        std::string                  get_key_full() override;
+        std::vector<ref_ptr<Object>> get_args() override;
+
+        ref_ptr<Vector>   r;
+        ref_ptr<Vector>   u;
+        ref_ptr<Vector>   v;
+        ref_ptr<OpBinary> op;
+    };
+
     /**
      * @class ScheduleTask_v_eadd_fdb
      * @brief Vector ewise with feedback
@@ -256,6 +324,25 @@ namespace spla {
         ref_ptr<OpUnary> op;
     };
 
+    /**
+     * @class ScheduleTask_v_select_range
+     * @brief Vector select of entries by values range
+     */
+    class ScheduleTask_v_select_range final : public ScheduleTaskBase {
+    public:
+        ~ScheduleTask_v_select_range() override = default;
+
+        std::string                  get_name() override;
+        std::string                  get_key() override;
+        std::string                  get_key_full() override;
+        std::vector<ref_ptr<Object>> get_args() override;
+
+        ref_ptr<Vector> r;
+        ref_ptr<Vector> v;
+        ref_ptr<Scalar> lo;
+        ref_ptr<Scalar> hi;
+    };
+
     /**
      * @class ScheduleTask_v_reduce
      * @brief Vector reduction to scalar
@@ -275,6 +362,54 @@ namespace spla {
         ref_ptr<OpBinary> op_reduce;
     };
 
+    /**
+     * @class ScheduleTask_v_eadd_reduce
+     * @brief Vector ewise with reduction to scalar
+     */
+    class ScheduleTask_v_eadd_reduce final : public ScheduleTaskBase {
+    public:
+        ~ScheduleTask_v_eadd_reduce() override = default;
+
+        std::string                  get_name() override;
+        std::string                  get_key() override;
+        std::string                  get_key_full() override;
+        std::vector<ref_ptr<Object>> get_args() override;
+
+        ref_ptr<Scalar>   r;
+        ref_ptr<Scalar>   s;
+        ref_ptr<Vector>   u;
+        ref_ptr<Vector>   v;
+        ref_ptr<OpBinary> op_elem;
+        ref_ptr<OpBinary> op_reduce;
+    };
+
+    /**
+     * @class ScheduleTask_v_ewise_chain
+     * @brief Vector element-wise op and maps chain with optional reduction to scalar
+     *
+     * Built by lazy planner from adjacent v_eadd, v_map and v_reduce tasks,
+     * connected through temporaries. Result is `r` if `op_reduce` is null, `reduced` otherwise.
+     */
+    class ScheduleTask_v_ewise_chain final : public ScheduleTaskBase {
+    public:
+        ~ScheduleTask_v_ewise_chain() override = default;
+
+        std::string                  get_name() override;
+        std::string                  get_key() override;
+        std::string                  get_key_full() override;
+        std::vector<ref_ptr<Object>> get_args() override;
+
+        ref_ptr<Vector>               r;
+        ref_ptr<Scalar>               reduced;
+        ref_ptr<Scalar>               s;
+        ref_ptr<Vector>               u;
+        ref_ptr<Vector>               v;
+        ref_ptr<OpBinary>             op_elem;
+        std::vector<ref_ptr<OpUnary>> ops_map;
+        ref_ptr<OpBinary>             op_reduce;
+        std::vector<ref_ptr<Vector>>  temps;
+    };
+
     /**
      * @class ScheduleTask_v_count_mf
      * @brief Vector count meaningful elements
@@ -30,11 +30,16 @@
 
 #include <spla/config.hpp>
 
+#include <spla/library.hpp>
+
 #include <core/tdecoration.hpp>
+#include <profiling/dispatch_tracer.hpp>
 
 #include <algorithm>
+#include <chrono>
 #include <functional>
 #include <queue>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -66,18 +71,23 @@ namespace spla {
         void register_discard(F format, Function function);
         void register_validator_discard(F format, Function function);
         void register_converter(F from, F to, Function function);
+        /** Converter which loses values of source, taken only if source is the only valid format */
+        void register_converter_lossy(F from, F to, Function function);
 
         void validate_ctor(F format, Storage& storage);
         void validate_rw(F format, Storage& storage);
         void validate_rwd(F format, Storage& storage);
         void validate_wd(F format, Storage& storage);
 
+        [[nodiscard]] std::vector<std::pair<F, F>> get_conversions() const;
+
     private:
         std::vector<std::vector<std::pair<int, int>>> m_convert_rules;
         std::vector<Function>                         m_constructors;
         std::vector<Function>                         m_validators;
         std::vector<Function>                         m_discards;
         std::vector<Function>                         m_converters;
+        std::vector<bool>                             m_lossy;
     };
 
     template<typename T, typename F, int capacity>
@@ -115,6 +125,25 @@ namespace spla {
         const int id = static_cast<int>(m_converters.size());
         m_convert_rules[i].push_back({j, id});
         m_converters.push_back(std::move(function));
+        m_lossy.push_back(false);
+    }
+    template<typename T, typename F, int capacity>
+    void StorageManager<T, F, capacity>::register_converter_lossy(F from, F to, StorageManager::Function function) {
+        register_converter(from, to, std::move(function));
+        m_lossy.back() = true;
+    }
+
+    template<typename T, typename F, int capacity>
+    std::vector<std::pair<F, F>> StorageManager<T, F, capacity>::get_conversions() const {
+        std::vector<std::pair<F, F>> conversions;
+
+        for (int i = 0; i < capacity; i++) {
+            for (const auto& rule : m_convert_rules[i]) {
+                conversions.emplace_back(static_cast<F>(i), static_cast<F>(rule.first));
+            }
+        }
+
+        return conversions;
     }
 
     template<typename T, typename F, int capacity>
@@ -147,12 +176,14 @@ namespace spla {
 
         std::array<int, capacity> reached;
         std::queue<int>           queue;
+        int                       n_valid = 0;
         reached.fill(infinity);
 
         for (int i = 0; i < capacity; ++i) {
             if (storage.is_valid_i(i)) {
                 reached[i] = source;
                 queue.push(i);
+                n_valid += 1;
             }
         }
 
@@ -161,6 +192,9 @@ namespace spla {
             queue.pop();
 
             for (const auto& target_format : m_convert_rules[u]) {
+                if (m_lossy[target_format.second] && (n_valid > 1 || reached[u] != source)) {
+                    continue;
+                }
                 if (reached[target_format.first] == infinity) {
                     reached[target_format.first] = u;
                     queue.push(target_format.first);
@@ -176,10 +210,14 @@ namespace spla {
             current = reached[current];
         }
 
+        DispatchTracer* tracer = Library::get()->get_dispatch_tracer();
+        const bool      trace  = tracer->is_enabled();
+
         for (auto iter = path.rbegin(); iter != path.rend(); ++iter) {
             std::pair<int, int> from_to          = *iter;
             auto                search_predicate = [from_to](const std::pair<int, int>& rule) { return rule.first == from_to.second; };
             auto                rule             = std::find_if(m_convert_rules[from_to.first].begin(), m_convert_rules[from_to.first].end(), search_predicate);
+            auto                start            = trace ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point();
 
             if (storage.get_ref_i(from_to.second).is_null()) {
                 m_constructors[from_to.second](storage);
@@ -187,6 +225,14 @@ namespace spla {
 
             m_converters[rule->second](storage);
             storage.validate(static_cast<F>(from_to.second));
+
+            if (trace) {
+                auto elapsed = std::chrono::steady_clock::now() - start;
+                tracer->add_conversion(std::is_same<F, FormatMatrix>::value,
+                                       from_to.first, from_to.second,
+                                       storage.get_ptr_i(from_to.second)->get_mem_size(),
+                                       std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+            }
         }
     }
     template<typename T, typename F, int capacity>
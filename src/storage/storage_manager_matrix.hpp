@@ -89,6 +89,12 @@ namespace spla {
             cpu_dok_clear(*dok);
             cpu_csr_to_dok(s.get_n_rows(), *csr, *dok);
         });
+        manager.register_converter(FormatMatrix::CpuCsr, FormatMatrix::CpuLil, [](Storage& s) {
+            auto* csr = s.template get<CpuCsr<T>>();
+            auto* lil = s.template get<CpuLil<T>>();
+            cpu_lil_resize(s.get_n_rows(), *lil);
+            cpu_csr_to_lil(s.get_n_rows(), *csr, *lil);
+        });
 
 #if defined(SPLA_BUILD_OPENCL)
         manager.register_constructor(FormatMatrix::AccCsr, [](Storage& s) {
@@ -102,11 +108,10 @@ namespace spla {
         });
 
         manager.register_converter(FormatMatrix::AccCsr, FormatMatrix::CpuCsr, [](Storage& s) {
-            auto* cl_acc  = get_acc_cl();
             auto* cl_csr  = s.template get<CLCsr<T>>();
             auto* cpu_csr = s.template get<CpuCsr<T>>();
             cpu_csr_resize(s.get_n_rows(), cl_csr->values, *cpu_csr);
-            cl_csr_read(s.get_n_rows(), cl_csr->values, cpu_csr->Ap.data(), cpu_csr->Aj.data(), cpu_csr->Ax.data(), *cl_csr, cl_acc->get_queue_default());
+            cl_csr_read(s.get_n_rows(), cl_csr->values, cpu_csr->Ap.data(), cpu_csr->Aj.data(), cpu_csr->Ax.data(), *cl_csr);
         });
 #endif
     }
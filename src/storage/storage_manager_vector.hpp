@@ -30,6 +30,7 @@
 
 #include <storage/storage_manager.hpp>
 
+#include <cpu/cpu_format_bitmap_vec.hpp>
 #include <cpu/cpu_format_coo_vec.hpp>
 #include <cpu/cpu_format_dense_vec.hpp>
 #include <cpu/cpu_format_dok_vec.hpp>
@@ -61,6 +62,10 @@ namespace spla {
             s.get_ref(FormatVector::CpuDense) = make_ref<CpuDenseVec<T>>();
             cpu_dense_vec_resize(s.get_n_rows(), *s.template get<CpuDenseVec<T>>());
         });
+        manager.register_constructor(FormatVector::CpuBitmap, [](Storage& s) {
+            s.get_ref(FormatVector::CpuBitmap) = make_ref<CpuBitmapVec<T>>();
+            cpu_bitmap_vec_resize(s.get_n_rows(), *s.template get<CpuBitmapVec<T>>());
+        });
 
         manager.register_validator_discard(FormatVector::CpuDok, [](Storage& s) {
             cpu_dok_vec_clear(*s.template get<CpuDokVec<T>>());
@@ -71,6 +76,9 @@ namespace spla {
         manager.register_validator(FormatVector::CpuDense, [](Storage& s) {
             cpu_dense_vec_fill(s.get_fill_value(), *s.template get<CpuDenseVec<T>>());
         });
+        manager.register_validator_discard(FormatVector::CpuBitmap, [](Storage& s) {
+            cpu_bitmap_vec_clear(*s.template get<CpuBitmapVec<T>>());
+        });
 
         manager.register_converter(FormatVector::CpuDok, FormatVector::CpuCoo, [](Storage& s) {
             auto* dok = s.template get<CpuDokVec<T>>();
@@ -96,6 +104,30 @@ namespace spla {
             cpu_dok_vec_clear(*dok);
             cpu_dense_vec_to_dok(s.get_n_rows(), s.get_fill_value(), *dense, *dok);
         });
+        manager.register_converter(FormatVector::CpuDense, FormatVector::CpuBitmap, [](Storage& s) {
+            auto* dense  = s.template get<CpuDenseVec<T>>();
+            auto* bitmap = s.template get<CpuBitmapVec<T>>();
+            cpu_bitmap_vec_clear(*bitmap);
+            cpu_dense_vec_to_bitmap(s.get_n_rows(), s.get_fill_value(), *dense, *bitmap);
+        });
+        manager.register_converter(FormatVector::CpuCoo, FormatVector::CpuBitmap, [](Storage& s) {
+            auto* coo    = s.template get<CpuCooVec<T>>();
+            auto* bitmap = s.template get<CpuBitmapVec<T>>();
+            cpu_bitmap_vec_clear(*bitmap);
+            cpu_coo_vec_to_bitmap(s.get_fill_value(), *coo, *bitmap);
+        });
+        manager.register_converter_lossy(FormatVector::CpuBitmap, FormatVector::CpuDense, [](Storage& s) {
+            auto* bitmap = s.template get<CpuBitmapVec<T>>();
+            auto* dense  = s.template get<CpuDenseVec<T>>();
+            cpu_dense_vec_fill(s.get_fill_value(), *dense);
+            cpu_bitmap_vec_to_dense(s.get_n_rows(), *bitmap, *dense);
+        });
+        manager.register_converter_lossy(FormatVector::CpuBitmap, FormatVector::CpuCoo, [](Storage& s) {
+            auto* bitmap = s.template get<CpuBitmapVec<T>>();
+            auto* coo    = s.template get<CpuCooVec<T>>();
+            cpu_coo_vec_resize(bitmap->values, *coo);
+            cpu_bitmap_vec_to_coo(s.get_n_rows(), *bitmap, *coo);
+        });
 
 
 #if defined(SPLA_BUILD_OPENCL)
@@ -123,10 +155,9 @@ namespace spla {
             cl_dense_vec_init(s.get_n_rows(), cpu_dense->Ax.data(), *cl_dense);
         });
         manager.register_converter(FormatVector::AccDense, FormatVector::CpuDense, [](Storage& s) {
-            auto* cl_acc    = get_acc_cl();
             auto* cl_dense  = s.template get<CLDenseVec<T>>();
             auto* cpu_dense = s.template get<CpuDenseVec<T>>();
-            cl_dense_vec_read(s.get_n_rows(), cpu_dense->Ax.data(), *cl_dense, cl_acc->get_queue_default());
+            cl_dense_vec_read(s.get_n_rows(), cpu_dense->Ax.data(), *cl_dense);
         });
         manager.register_converter(FormatVector::CpuCoo, FormatVector::AccCoo, [](Storage& s) {
             auto* cpu_coo = s.template get<CpuCooVec<T>>();
@@ -134,23 +165,22 @@ namespace spla {
             cl_coo_vec_init(cpu_coo->values, cpu_coo->Ai.data(), cpu_coo->Ax.data(), *cl_coo);
         });
         manager.register_converter(FormatVector::AccCoo, FormatVector::CpuCoo, [](Storage& s) {
-            auto* cl_acc  = get_acc_cl();
             auto* cl_coo  = s.template get<CLCooVec<T>>();
             auto* cpu_coo = s.template get<CpuCooVec<T>>();
             cpu_coo_vec_resize(cl_coo->values, *cpu_coo);
-            cl_coo_vec_read(cl_coo->values, cpu_coo->Ai.data(), cpu_coo->Ax.data(), *cl_coo, cl_acc->get_queue_default());
+            cl_coo_vec_read(cl_coo->values, cpu_coo->Ai.data(), cpu_coo->Ax.data(), *cl_coo);
         });
         manager.register_converter(FormatVector::AccCoo, FormatVector::AccDense, [](Storage& s) {
             auto* cl_acc   = get_acc_cl();
             auto* cl_coo   = s.template get<CLCooVec<T>>();
             auto* cl_dense = s.template get<CLDenseVec<T>>();
-            cl_coo_vec_to_dense(s.get_n_rows(), s.get_fill_value(), *cl_coo, *cl_dense, cl_acc->get_queue_default());
+            cl_coo_vec_to_dense(s.get_n_rows(), s.get_fill_value(), *cl_coo, *cl_dense, cl_acc->get_queue_compute());
         });
         manager.register_converter(FormatVector::AccDense, FormatVector::AccCoo, [](Storage& s) {
             auto* cl_acc   = get_acc_cl();
             auto* cl_dense = s.template get<CLDenseVec<T>>();
             auto* cl_coo   = s.template get<CLCooVec<T>>();
-            cl_dense_vec_to_coo(s.get_n_rows(), s.get_fill_value(), *cl_dense, *cl_coo, cl_acc->get_queue_default());
+            cl_dense_vec_to_coo(s.get_n_rows(), s.get_fill_value(), *cl_dense, *cl_coo, cl_acc->get_queue_compute());
         });
 #endif
     }
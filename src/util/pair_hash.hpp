@@ -41,7 +41,9 @@ namespace spla {
     public:
         template<typename T, typename U>
         std::size_t operator()(const std::pair<T, U>& x) const {
-            return std::hash<T>()(x.first) ^ std::hash<U>()(x.second);
+            // Plain xor maps (i, j) and (j, i) to same value, what overflows map for symmetric matrices
+            const std::size_t h = std::hash<T>()(x.first);
+            return h ^ (std::hash<U>()(x.second) + 0x9e3779b9 + (h << 6) + (h >> 2));
         }
     };
 
@@ -29,6 +29,11 @@
 
 #include <spla.hpp>
 
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
 TEST(library, default_log) {
     spla::Library::get()->set_default_callback();
     spla::Library::get()->finalize();
@@ -56,4 +61,215 @@ TEST(library, default_types) {
     std::cout << "Type " << spla::FLOAT->get_description() << " id=" << spla::FLOAT->get_id() << std::endl;
 }
 
+TEST(library, time_profile_trace) {
+    const spla::uint N = 100;
+    auto             v = spla::Vector::make(N, spla::INT);
+    auto             r = spla::Scalar::make_int(0);
+    auto             s = spla::Scalar::make_int(0);
+
+    v->fill_with(spla::Scalar::make_int(1));
+
+    spla::Library::get()->time_profile_enable(true);
+    spla::Library::get()->time_profile_reset();
+
+    for (int i = 0; i < 4; i++) {
+        spla::exec_v_reduce(r, s, v, spla::PLUS_INT);
+    }
+
+    const std::string path = "time_profile_trace.json";
+    EXPECT_EQ(spla::Library::get()->time_profile_export_trace(path), spla::Status::Ok);
+    spla::Library::get()->time_profile_dump();
+
+    std::ifstream     file(path);
+    std::stringstream content;
+    content << file.rdbuf();
+
+    EXPECT_NE(content.str().find("\"traceEvents\""), std::string::npos);
+    EXPECT_NE(content.str().find("vector_reduce"), std::string::npos);
+
+    std::remove(path.c_str());
+}
+
+TEST(library, dispatch_trace) {
+    const spla::uint N = 64;
+    auto             M = spla::Matrix::make(N, N, spla::INT);
+    auto             v = spla::Vector::make(N, spla::INT);
+    auto             r = spla::Vector::make(N, spla::INT);
+
+    for (spla::uint i = 0; i < N; i++) {
+        M->set_int(i, (i + 1) % N, 1);
+        M->set_int(i, (i + 7) % N, 1);
+    }
+    v->set_int(0, 1);
+    v->set_int(5, 1);
+
+    spla::Library::get()->dispatch_trace_enable(true);
+    std::string json;
+    spla::Library::get()->dispatch_trace_drain_json(json);
+
+    EXPECT_EQ(spla::exec_vxm_masked(r, spla::ref_ptr<spla::Vector>(), v, M, spla::MULT_INT, spla::PLUS_INT,
+                                    spla::NQZERO_INT, spla::Scalar::make_int(0)),
+              spla::Status::Ok);
+
+    EXPECT_EQ(spla::Library::get()->dispatch_trace_drain_json(json), spla::Status::Ok);
+    EXPECT_NE(json.find("\"task\":\"vxm_masked"), std::string::npos);
+    EXPECT_NE(json.find("\"nnz_in\":" + std::to_string(2 * N + 2)), std::string::npos);
+    EXPECT_NE(json.find("\"edges\":4"), std::string::npos);
+    EXPECT_NE(json.find("\"to\":\"CpuCoo\""), std::string::npos);
+
+    std::string csv;
+    EXPECT_EQ(spla::exec_vxm_masked(r, spla::ref_ptr<spla::Vector>(), v, M, spla::MULT_INT, spla::PLUS_INT,
+                                    spla::NQZERO_INT, spla::Scalar::make_int(0)),
+              spla::Status::Ok);
+    EXPECT_EQ(spla::Library::get()->dispatch_trace_drain_csv(csv), spla::Status::Ok);
+    EXPECT_EQ(csv.find("seq,task,algo"), 0u);
+    EXPECT_NE(csv.find("vxm_masked"), std::string::npos);
+
+    spla::Library::get()->dispatch_trace_enable(false);
+    spla::Library::get()->dispatch_trace_drain_csv(csv);
+}
+
+TEST(library, time_profile_counters) {
+    const spla::uint N = 128;
+    auto             M = spla::Matrix::make(N, N, spla::INT);
+    auto             v = spla::Vector::make(N, spla::INT);
+    auto             r = spla::Vector::make(N, spla::INT);
+
+    for (spla::uint i = 0; i < N; i++) {
+        M->set_int(i, (i * 3) % N, 1);
+        v->set_int(i, 1);
+    }
+
+    spla::Library::get()->time_profile_enable(true);
+    spla::Library::get()->time_profile_reset();
+    EXPECT_EQ(spla::Library::get()->time_profile_enable_counters(true), spla::Status::Ok);
+    EXPECT_TRUE(spla::Library::get()->is_set_time_profile_counters());
+
+    // Must work the same way regardless of counters availability on host
+    for (int i = 0; i < 4; i++) {
+        EXPECT_EQ(spla::exec_mxv_masked(r, spla::ref_ptr<spla::Vector>(), M, v, spla::MULT_INT, spla::PLUS_INT,
+                                        spla::NQZERO_INT, spla::Scalar::make_int(0)),
+                  spla::Status::Ok);
+    }
+
+    spla::Library::get()->time_profile_dump();
+    EXPECT_EQ(spla::Library::get()->time_profile_enable_counters(false), spla::Status::Ok);
+}
+
+static std::size_t count_files(const std::filesystem::path& dir) {
+    std::size_t count = 0;
+    for (const auto& entry : std::filesystem::directory_iterator(dir)) {
+        count += entry.path().extension() == ".clbin" ? 1 : 0;
+    }
+    return count;
+}
+
+TEST(library, program_cache) {
+    const std::filesystem::path dir = std::filesystem::temp_directory_path() / "spla_test_program_cache";
+    std::filesystem::remove_all(dir);
+
+    spla::Library* library = spla::Library::get();
+
+    if (library->set_accelerator(spla::AcceleratorType::OpenCL) != spla::Status::Ok) {
+        GTEST_SKIP() << "no acceleration to cache programs of";
+    }
+
+    const spla::uint N = 1000;
+    auto             v = spla::Vector::make(N, spla::INT);
+    auto             r = spla::Scalar::make_int(0);
+    auto             s = spla::Scalar::make_int(0);
+
+    v->fill_with(spla::Scalar::make_int(2));
+
+    // First run builds programs from sources and stores binaries
+    EXPECT_EQ(library->set_program_cache(dir.string()), spla::Status::Ok);
+    EXPECT_EQ(spla::exec_v_reduce(r, s, v, spla::PLUS_INT), spla::Status::Ok);
+    EXPECT_EQ(r->as_int(), int(2 * N));
+
+    const std::size_t n_stored = count_files(dir);
+    EXPECT_GT(n_stored, 0u);
+
+    // Fresh accelerator has empty runtime cache, so programs are loaded from disk
+    library->set_accelerator(spla::AcceleratorType::OpenCL);
+    EXPECT_EQ(library->set_program_cache(dir.string()), spla::Status::Ok);
+
+    auto v2 = spla::Vector::make(N, spla::INT);
+    v2->fill_with(spla::Scalar::make_int(3));
+    EXPECT_EQ(spla::exec_v_reduce(r, s, v2, spla::PLUS_INT), spla::Status::Ok);
+    EXPECT_EQ(r->as_int(), int(3 * N));
+    EXPECT_EQ(count_files(dir), n_stored);
+
+    // With tiny limit only recently stored entry is kept
+    EXPECT_EQ(library->set_program_cache(dir.string(), 1), spla::Status::Ok);
+    EXPECT_EQ(spla::exec_v_reduce(r, s, v2, spla::MAX_INT), spla::Status::Ok);
+    EXPECT_EQ(r->as_int(), 3);
+    EXPECT_EQ(count_files(dir), 1u);
+
+    EXPECT_EQ(library->set_program_cache(""), spla::Status::Ok);
+    library->finalize();
+    std::filesystem::remove_all(dir);
+}
+
+TEST(library, precompile) {
+    spla::Library* library = spla::Library::get();
+
+    if (library->set_accelerator(spla::AcceleratorType::OpenCL) != spla::Status::Ok) {
+        GTEST_SKIP() << "no acceleration to precompile programs for";
+    }
+
+    EXPECT_EQ(library->set_precompile(true), spla::Status::Ok);
+
+    // Path graph, so distances from the first vertex are known
+    const spla::uint N = 64;
+    auto             A = spla::Matrix::make(N, N, spla::INT);
+    auto             v = spla::Vector::make(N, spla::INT);
+
+    for (spla::uint i = 0; i + 1 < N; i++) {
+        A->set_int(i, i + 1, 1);
+        A->set_int(i + 1, i, 1);
+    }
+
+    // Programs being precompiled are waited for, others are built on demand
+    EXPECT_EQ(spla::bfs(v, A, 0), spla::Status::Ok);
+
+    for (spla::uint i = 0; i < N; i++) {
+        int value = 0;
+        v->get_int(i, value);
+        EXPECT_EQ(value, int(i + 1));
+    }
+
+    // Precompilation must be stopped safely even if not finished yet
+    library->finalize();
+}
+
+TEST(library, mem_pool) {
+    spla::Library* library = spla::Library::get();
+
+    if (library->set_accelerator(spla::AcceleratorType::OpenCL) != spla::Status::Ok) {
+        GTEST_SKIP() << "no acceleration to allocate device memory of";
+    }
+
+    const spla::uint N = 1000;
+    auto             r = spla::Scalar::make_int(0);
+    auto             s = spla::Scalar::make_int(0);
+
+    std::size_t bytes_live   = 0;
+    std::size_t bytes_cached = 0;
+    double      hit_rate     = 0.0;
+
+    // Same sized buffers of released vectors are served from the pool
+    for (int i = 0; i < 4; i++) {
+        auto v = spla::Vector::make(N, spla::INT);
+        v->fill_with(spla::Scalar::make_int(i));
+        EXPECT_EQ(spla::exec_v_reduce(r, s, v, spla::PLUS_INT), spla::Status::Ok);
+        EXPECT_EQ(r->as_int(), int(i * N));
+
+        EXPECT_EQ(library->get_mem_stats(bytes_live, bytes_cached, hit_rate), spla::Status::Ok);
+        EXPECT_GE(bytes_live, N * sizeof(int));
+    }
+
+    EXPECT_EQ(library->set_mem_cache_limit(0), spla::Status::Ok);
+    library->finalize();
+}
+
 SPLA_GTEST_MAIN
\ No newline at end of file
@@ -139,6 +139,121 @@ TEST(matrix, reduce_by_row) {
         ivec->get_int(i, actual);
         EXPECT_EQ(expected, actual);
     }
+
+    auto desc = spla::Descriptor::make();
+    desc->set_struct_only(true);
+    spla::exec_m_reduce_by_row(ivec, imat, spla::PLUS_INT, iinit, desc);
+
+    for (spla::uint i = 0; i < M; i += 1) {
+        int actual;
+        ivec->get_int(i, actual);
+        EXPECT_EQ(int(K), actual);
+    }
+}
+
+TEST(matrix, select) {
+    const spla::uint M = 10000, N = 20000, K = 8;
+
+    auto imat = spla::Matrix::make(M, N, spla::INT);
+    auto rmat = spla::Matrix::make(M, N, spla::INT);
+    auto ivec = spla::Vector::make(M, spla::INT);
+    auto zero = spla::Scalar::make_int(0);
+
+    for (spla::uint i = 0; i < M; i += 1) {
+        for (spla::uint k = 0; k < K; k++) {
+            imat->set_int(i, (i * K + k) % N, int(k));
+        }
+    }
+
+    spla::exec_m_select(rmat, imat, spla::GTZERO_INT);
+    spla::exec_m_reduce_by_row(ivec, rmat, spla::PLUS_INT, zero);
+
+    for (spla::uint i = 0; i < M; i += 1) {
+        int actual;
+        ivec->get_int(i, actual);
+        EXPECT_EQ(int(K * (K - 1) / 2), actual);
+
+        int x;
+        rmat->get_int(i, (i * K) % N, x);
+        EXPECT_EQ(0, x);
+        rmat->get_int(i, (i * K + 1) % N, x);
+        EXPECT_EQ(1, x);
+    }
+
+    auto desc = spla::Descriptor::make();
+    desc->set_struct_only(true);
+    spla::exec_m_reduce_by_row(ivec, rmat, spla::PLUS_INT, zero, desc);
+
+    for (spla::uint i = 0; i < M; i += 1) {
+        int actual;
+        ivec->get_int(i, actual);
+        EXPECT_EQ(int(K - 1), actual);
+    }
+}
+
+TEST(matrix, tril) {
+    const spla::uint N = 1000, K = 4;
+
+    auto imat = spla::Matrix::make(N, N, spla::INT);
+    auto rmat = spla::Matrix::make(N, N, spla::INT);
+    auto omat = spla::Matrix::make(N, N, spla::INT);
+    auto ikey = spla::Vector::make(N, spla::INT);
+    auto ivec = spla::Vector::make(N, spla::INT);
+    auto zero = spla::Scalar::make_int(0);
+
+    // symmetric graph: ring with K next neighbours and hub 0 connected to all
+    for (spla::uint i = 0; i < N; i += 1) {
+        for (spla::uint k = 1; k <= K; k++) {
+            imat->set_int(i, (i + k) % N, 1);
+            imat->set_int((i + k) % N, i, 1);
+        }
+        if (i != 0) {
+            imat->set_int(0, i, 1);
+            imat->set_int(i, 0, 1);
+        }
+    }
+
+    spla::exec_m_tril(rmat, imat, spla::ref_ptr<spla::Vector>());
+
+    for (spla::uint i = 0; i < N; i += 1) {
+        for (spla::uint k = 1; k <= K; k++) {
+            const spla::uint j = (i + k) % N;
+            int              x, y;
+            rmat->get_int(i, j, x);
+            rmat->get_int(j, i, y);
+            EXPECT_EQ(j < i ? 1 : 0, x);
+            EXPECT_EQ(i < j ? 1 : 0, y);
+        }
+    }
+
+    // order by decreasing degree, so hub keeps no neighbours
+    for (spla::uint i = 0; i < N; i += 1) {
+        ikey->set_int(i, i == 0 ? -int(N) : -int(2 * K + 1));
+    }
+
+    spla::exec_m_tril(omat, imat, ikey);
+    spla::exec_m_reduce_by_row(ivec, omat, spla::PLUS_INT, zero);
+
+    int hub_count;
+    ivec->get_int(0, hub_count);
+    EXPECT_EQ(0, hub_count);
+
+    for (spla::uint i = 1; i < N; i += 1) {
+        int x, y;
+        omat->get_int(i, 0, x);
+        omat->get_int(0, i, y);
+        EXPECT_EQ(1, x);
+        EXPECT_EQ(0, y);
+
+        for (spla::uint k = 1; k <= K; k++) {
+            const spla::uint j = (i + k) % N;
+            if (j == 0) continue;
+            omat->get_int(i, j, x);
+            omat->get_int(j, i, y);
+            EXPECT_EQ(j < i ? 1 : 0, x);
+            EXPECT_EQ(i < j ? 1 : 0, y);
+        }
+    }
 }
 
 TEST(matrix, reduce) {
@@ -160,4 +275,95 @@ TEST(matrix, reduce) {
     EXPECT_EQ(ir->as_int(), M * K * 2);
 }
 
+TEST(matrix, generate_rmat) {
+    spla::GraphGenerator gen1(42);
+    spla::GraphGenerator gen2(42);
+
+    gen1.set_n_threads(1);
+    gen2.set_n_threads(4);
+    EXPECT_TRUE(gen1.generate_rmat(14, 8));
+    EXPECT_TRUE(gen2.generate_rmat(14, 8));
+
+    // Reproducible from seed regardless of threads count
+    EXPECT_EQ(gen1.get_n_rows(), 1u << 14u);
+    EXPECT_EQ(gen1.get_Ai(), gen2.get_Ai());
+    EXPECT_EQ(gen1.get_Aj(), gen2.get_Aj());
+    EXPECT_GT(gen1.get_n_values(), std::size_t(1u << 14u));
+
+    const auto& Ai = gen1.get_Ai();
+    const auto& Aj = gen1.get_Aj();
+
+    for (std::size_t k = 0; k < gen1.get_n_values(); k++) {
+        EXPECT_NE(Ai[k], Aj[k]);
+        if (k > 0) {
+            EXPECT_TRUE(Ai[k - 1] < Ai[k] || (Ai[k - 1] == Ai[k] && Aj[k - 1] < Aj[k]));
+        }
+    }
+
+    spla::GraphGenerator gen3(43);
+    EXPECT_TRUE(gen3.generate_rmat(14, 8));
+    EXPECT_NE(gen1.get_Aj(), gen3.get_Aj());
+}
+
+TEST(matrix, generate_uniform_fill) {
+    const spla::uint     N = 1000;
+    spla::GraphGenerator gen(7);
+
+    EXPECT_TRUE(gen.generate_uniform(N, 4000));
+
+    auto M = spla::Matrix::make(N, N, spla::INT);
+    EXPECT_EQ(gen.fill(M, true), spla::Status::Ok);
+
+    const auto& Ai = gen.get_Ai();
+    const auto& Aj = gen.get_Aj();
+
+    for (std::size_t k = 0; k < gen.get_n_values(); k++) {
+        int w, w_back;
+        M->get_int(Ai[k], Aj[k], w);
+        M->get_int(Aj[k], Ai[k], w_back);
+        EXPECT_GE(w, 1);
+        EXPECT_LE(w, 255);
+        EXPECT_EQ(w, w_back);
+    }
+
+    auto r = spla::Scalar::make_int(0);
+    spla::exec_m_reduce(r, spla::Scalar::make_int(0), M, spla::PLUS_INT);
+    EXPECT_GT(r->as_int(), int(gen.get_n_values()));
+
+    auto ones    = spla::Vector::make(N, spla::INT);
+    auto degrees = spla::Vector::make(N, spla::INT);
+    auto zero    = spla::Scalar::make_int(0);
+    ones->set_fill_value(spla::Scalar::make_int(1));
+    spla::exec_mxv_masked(degrees, spla::ref_ptr<spla::Vector>(), M, ones, spla::SECOND_INT, spla::PLUS_INT, spla::ref_ptr<spla::OpSelect>(), zero);
+    spla::exec_v_reduce(r, zero, degrees, spla::PLUS_INT);
+    EXPECT_EQ(r->as_int(), int(gen.get_n_values()));
+
+    auto M_small = spla::Matrix::make(N - 1, N - 1, spla::INT);
+    EXPECT_EQ(gen.fill(M_small), spla::Status::InvalidArgument);
+}
+
+TEST(matrix, generate_grid) {
+    const spla::uint     X = 7, Y = 5, Z = 3;
+    spla::GraphGenerator gen;
+
+    EXPECT_TRUE(gen.generate_grid(X, Y));
+    EXPECT_EQ(gen.get_n_rows(), X * Y);
+    EXPECT_EQ(gen.get_n_values(), std::size_t(2 * ((X - 1) * Y + X * (Y - 1))));
+
+    EXPECT_TRUE(gen.generate_grid(X, Y, Z));
+    EXPECT_EQ(gen.get_n_rows(), X * Y * Z);
+    EXPECT_EQ(gen.get_n_values(), std::size_t(2 * ((X - 1) * Y * Z + X * (Y - 1) * Z + X * Y * (Z - 1))));
+
+    auto M = spla::Matrix::make(X * Y * Z, X * Y * Z, spla::FLOAT);
+    auto r = spla::Vector::make(X * Y * Z, spla::FLOAT);
+    EXPECT_EQ(gen.fill(M), spla::Status::Ok);
+    spla::exec_m_reduce_by_row(r, M, spla::PLUS_FLOAT, spla::Scalar::make_float(0.0f));
+
+    float corner, center;
+    r->get_float(0, corner);
+    r->get_float(1 + X * (1 + Y * 1), center);
+    EXPECT_EQ(corner, 3.0f);
+    EXPECT_EQ(center, 6.0f);
+}
+
 SPLA_GTEST_MAIN_WITH_FINALIZE
\ No newline at end of file
@@ -139,5 +139,54 @@ TEST(mxmT_masked, perf_zero) {
     }
 }
 
+TEST(mxmT_masked, dense_rows_init) {
+    // Average degree is above half of wave, so on device mask entries are reduced by subgroups;
+    // expected values follow scalar merge: init plus matched products, init for not selected
+    const int M = 40, N = 200, K = 30;
+    const int INIT = 7;
+
+    auto R    = spla::Matrix::make(M, K, spla::INT);
+    auto mask = spla::Matrix::make(M, K, spla::INT);
+    auto A    = spla::Matrix::make(M, N, spla::INT);
+    auto B    = spla::Matrix::make(K, N, spla::INT);
+    auto init = spla::Scalar::make_int(INIT);
+
+    auto a = [](int i, int j) { return (i + j) % 4 != 0 ? (i + j) % 3 + 1 : 0; };
+    auto b = [](int k, int j) { return (j * 3 + k) % 5 < 2 ? (j + k) % 2 + 1 : 0; };
+
+    for (int i = 0; i < M; i++) {
+        for (int j = 0; j < N; j++) {
+            if (a(i, j)) A->set_int(i, j, a(i, j));
+        }
+    }
+    for (int k = 0; k < K; k++) {
+        for (int j = 0; j < N; j++) {
+            if (b(k, j)) B->set_int(k, j, b(k, j));
+        }
+    }
+    for (int i = 0; i < M; i++) {
+        for (int k = 0; k < K; k++) {
+            mask->set_int(i, k, (i + k) % 3);
+        }
+    }
+
+    EXPECT_EQ(spla::exec_mxmT_masked(R, mask, A, B, spla::MULT_INT, spla::PLUS_INT, spla::GTZERO_INT, init), spla::Status::Ok);
+
+    for (int i = 0; i < M; i++) {
+        for (int k = 0; k < K; k++) {
+            int expected = INIT;
+
+            if ((i + k) % 3 > 0) {
+                for (int j = 0; j < N; j++) {
+                    expected += a(i, j) * b(k, j);
+                }
+            }
+
+            int v;
+            R->get_int(i, k, v);
+            EXPECT_EQ(v, expected);
+        }
+    }
+}
 
 SPLA_GTEST_MAIN_WITH_FINALIZE_PLATFORM(1)
\ No newline at end of file
@@ -27,6 +27,8 @@
 
 #include "test_common.hpp"
 
+#include <algorithm>
+#include <functional>
 #include <iostream>
 #include <spla.hpp>
 
@@ -88,6 +90,151 @@ TEST(mxv_masked, naive) {
     EXPECT_EQ(r, 1);
 }
 
+TEST(mxv_masked, mask_modes) {
+    const int N = 500;
+    const int K = 8;
+    const int S = 3;
+
+    std::vector<int> sums(N, 0);
+    std::vector<int> mask_values(N, 0);
+
+    auto iM    = spla::Matrix::make(N, N, spla::INT);
+    auto iv    = spla::Vector::make(N, spla::INT);
+    auto ir    = spla::Vector::make(N, spla::INT);
+    auto iinit = spla::Scalar::make_int(0);
+
+    for (int i = 0; i < N; i++) {
+        iv->set_int(i, i % 5);
+
+        for (int k = 0; k < K; k++) {
+            const int j = (i * 7 + k * 13) % N;
+            iM->set_int(i, j, 1);
+        }
+    }
+    for (int i = 0; i < N; i++) {
+        for (int k = 0; k < K; k++) {
+            sums[i] += (((i * 7 + k * 13) % N) % 5);
+        }
+    }
+
+    auto check = [&](const spla::ref_ptr<spla::Vector>& mask,
+                     const spla::ref_ptr<spla::OpSelect>& op_select,
+                     bool structure, bool complement,
+                     const std::function<bool(int)>& selected) {
+        auto desc = spla::Descriptor::make();
+        desc->set_mask_structure(structure);
+        desc->set_mask_complement(complement);
+
+        EXPECT_EQ(spla::exec_mxv_masked(ir, mask, iM, iv, spla::MULT_INT, spla::PLUS_INT, op_select, iinit, desc), spla::Status::Ok);
+
+        for (int i = 0; i < N; i++) {
+            int r;
+            ir->get_int(i, r);
+            EXPECT_EQ(r, selected(i) ? sums[i] : 0);
+        }
+    };
+
+    auto imask = spla::Vector::make(N, spla::INT);
+
+    for (int i = 0; i < N; i += S) {
+        mask_values[i] = i % 2;
+        imask->set_int(i, mask_values[i]);
+    }
+
+    auto stored   = [&](int i) { return mask_values[i] != 0; };
+    auto unstored = [&](int i) { return mask_values[i] == 0; };
+
+    check(spla::ref_ptr<spla::Vector>(), spla::ref_ptr<spla::OpSelect>(), false, false, [](int) { return true; });
+
+    imask->set_format(spla::FormatVector::CpuCoo);
+    check(imask, spla::NQZERO_INT, false, false, stored);
+    check(imask, spla::ref_ptr<spla::OpSelect>(), false, false, stored);
+    check(imask, spla::EQZERO_INT, true, true, unstored);
+
+    imask->set_format(spla::FormatVector::CpuDense);
+    check(imask, spla::NQZERO_INT, false, true, unstored);
+    check(imask, spla::EQZERO_INT, false, false, unstored);
+}
+
+TEST(mxv_masked, accum_changed) {
+    const int N = 300;
+    const int K = 6;
+
+    std::vector<int> expected(N);
+    std::vector<int> sums(N, 0);
+
+    auto iM      = spla::Matrix::make(N, N, spla::INT);
+    auto iv      = spla::Vector::make(N, spla::INT);
+    auto ir      = spla::Vector::make(N, spla::INT);
+    auto changed = spla::Vector::make(N, spla::INT);
+    auto iinit   = spla::Scalar::make_int(0);
+
+    for (int i = 0; i < N; i++) {
+        iv->set_int(i, 1);
+        ir->set_int(i, i % 10);
+
+        for (int k = 0; k < K; k++) {
+            iM->set_int(i, (i + k * 17) % N, (i + k) % 3);
+            sums[i] += (i + k) % 3;
+        }
+
+        expected[i] = std::max(i % 10, sums[i]);
+    }
+
+    EXPECT_EQ(spla::exec_mxv_masked_accum(ir, spla::ref_ptr<spla::Vector>(), iM, iv, spla::MULT_INT, spla::PLUS_INT,
+                                          spla::ref_ptr<spla::OpSelect>(), iinit, spla::MAX_INT, changed),
+              spla::Status::Ok);
+
+    for (int i = 0; i < N; i++) {
+        int r, c;
+        ir->get_int(i, r);
+        changed->get_int(i, c);
+        EXPECT_EQ(r, expected[i]);
+        EXPECT_EQ(c, expected[i] != i % 10 ? expected[i] : 0);
+    }
+}
+
+TEST(mxv_masked, accum_init_matches_vxm) {
+    const int N    = 64;
+    const int R    = 10;
+    const int INIT = 100;
+
+    auto iM     = spla::Matrix::make(N, N, spla::INT);
+    auto iMT    = spla::Matrix::make(N, N, spla::INT);
+    auto iv     = spla::Vector::make(N, spla::INT);
+    auto ir_mxv = spla::Vector::make(N, spla::INT);
+    auto ir_vxm = spla::Vector::make(N, spla::INT);
+    auto iinit  = spla::Scalar::make_int(INIT);
+
+    std::vector<int> expected(N, R);
+
+    // Odd rows are empty, even rows hold a single product of 1
+    for (int i = 0; i < N; i++) {
+        iv->set_int(i, 1);
+        ir_mxv->set_int(i, R);
+        ir_vxm->set_int(i, R);
+
+        if (i % 2 == 0) {
+            iM->set_int(i, (i * 7) % N, 1);
+            iMT->set_int((i * 7) % N, i, 1);
+            expected[i] = R + INIT + 1;
+        }
+    }
+
+    spla::exec_mxv_masked_accum(ir_mxv, spla::ref_ptr<spla::Vector>(), iM, iv, spla::MULT_INT, spla::PLUS_INT,
+                                spla::ref_ptr<spla::OpSelect>(), iinit, spla::PLUS_INT);
+    spla::exec_vxm_masked_accum(ir_vxm, spla::ref_ptr<spla::Vector>(), iv, iMT, spla::MULT_INT, spla::PLUS_INT,
+                                spla::ref_ptr<spla::OpSelect>(), iinit, spla::PLUS_INT);
+
+    for (int i = 0; i < N; i++) {
+        int r_mxv, r_vxm;
+        ir_mxv->get_int(i, r_mxv);
+        ir_vxm->get_int(i, r_vxm);
+        EXPECT_EQ(r_mxv, expected[i]);
+        EXPECT_EQ(r_vxm, expected[i]);
+    }
+}
+
 TEST(mxv_masked, perf) {
     const int N     = 1000000;
     const int K     = 256;
@@ -129,4 +276,48 @@ TEST(mxv_masked, perf) {
     std::cout << std::endl;
 }
 
+TEST(mxv_masked, hub_row_init) {
+    // Hub row longer than adaptive block is reduced by whole work-group; once it dominates
+    // matrix, values are split evenly between work-items. Either way init is applied once.
+    const int INIT = 5;
+
+    auto check = [&](int N, int hub_degree, int degree) {
+        std::vector<int> sums(N, INIT);
+
+        auto iM    = spla::Matrix::make(N, N, spla::INT);
+        auto iv    = spla::Vector::make(N, spla::INT);
+        auto ir    = spla::Vector::make(N, spla::INT);
+        auto imask = spla::Vector::make(N, spla::INT);
+        auto iinit = spla::Scalar::make_int(INIT);
+
+        for (int i = 0; i < N; i++) {
+            iv->set_int(i, i % 3 + 1);
+            if (i % 3 != 1) imask->set_int(i, 1);
+        }
+        for (int k = 0; k < hub_degree; k++) {
+            const int j = (k * 7 + 1) % N;
+            iM->set_int(0, j, 1);
+            sums[0] += j % 3 + 1;
+        }
+        for (int i = 1; i < N; i++) {
+            for (int k = 0; k < degree; k++) {
+                const int j = (i * 11 + k * 13) % N;
+                iM->set_int(i, j, 2);
+                sums[i] += 2 * (j % 3 + 1);
+            }
+        }
+
+        EXPECT_EQ(spla::exec_mxv_masked(ir, imask, iM, iv, spla::MULT_INT, spla::PLUS_INT, spla::NQZERO_INT, iinit), spla::Status::Ok);
+
+        for (int i = 0; i < N; i++) {
+            int r;
+            ir->get_int(i, r);
+            EXPECT_EQ(r, i % 3 != 1 ? sums[i] : INIT);
+        }
+    };
+
+    check(60000, 1500, 8);
+    check(4000, 3000, 1);
+}
+
 SPLA_GTEST_MAIN_WITH_FINALIZE_PLATFORM(1)
\ No newline at end of file
@@ -37,4 +37,40 @@ TEST(schedule, task_callback) {
     schedule->submit();
 }
 
+TEST(schedule, independent_tasks) {
+    const spla::uint N = 10000;
+
+    // Extra queues are used only with acceleration, tasks results must not depend on it
+    spla::Library::get()->set_queues_count(3);
+
+    auto u = spla::Vector::make(N, spla::INT);
+    auto v = spla::Vector::make(N, spla::INT);
+    auto a = spla::Vector::make(N, spla::INT);
+    auto b = spla::Vector::make(N, spla::INT);
+    auto c = spla::Vector::make(N, spla::INT);
+    auto r = spla::Scalar::make_int(0);
+    auto s = spla::Scalar::make_int(0);
+
+    for (spla::uint i = 0; i < N; i++) {
+        u->set_int(i, 1);
+        v->set_int(i, 2);
+    }
+
+    spla::ref_ptr<spla::ScheduleTask> task_a, task_b, task_c, task_r;
+    spla::exec_v_eadd(a, u, u, spla::PLUS_INT, spla::ref_ptr<spla::Descriptor>(), &task_a);
+    spla::exec_v_eadd(b, v, v, spla::PLUS_INT, spla::ref_ptr<spla::Descriptor>(), &task_b);
+    spla::exec_v_eadd(c, a, b, spla::PLUS_INT, spla::ref_ptr<spla::Descriptor>(), &task_c);
+    spla::exec_v_reduce(r, s, c, spla::PLUS_INT, spla::ref_ptr<spla::Descriptor>(), &task_r);
+
+    // Last task of the first step shares arguments with previous ones, so must be ordered after them
+    spla::ref_ptr<spla::Schedule> schedule = spla::make_schedule();
+    schedule->step_tasks({task_a, task_b, task_c});
+    schedule->step_task(task_r);
+    EXPECT_EQ(schedule->submit(), spla::Status::Ok);
+
+    EXPECT_EQ(r->as_int(), int(6 * N));
+
+    spla::Library::get()->set_queues_count(1);
+}
+
 SPLA_GTEST_MAIN_WITH_FINALIZE
\ No newline at end of file
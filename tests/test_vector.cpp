@@ -214,6 +214,315 @@ TEST(vector, eadd_sub_pow2) {
     }
 }
 
+TEST(vector, eadd_reduce_sub_pow2) {
+    const spla::uint N = 100000;
+    auto             u = spla::Vector::make(N, spla::INT);
+    auto             v = spla::Vector::make(N, spla::INT);
+    auto             r = spla::Scalar::make_int(0);
+    auto             s = spla::Scalar::make_int(0);
+
+    int expected = 0;
+
+    for (spla::uint i = 0; i < N; i += 1) {
+        const int x = int(i % 7);
+        const int y = int(i % 5);
+        u->set_int(i, x);
+        v->set_int(i, y);
+        expected += (x - y) * (x - y);
+    }
+
+    spla::exec_v_eadd_reduce(r, s, u, v, spla::MINUS_POW2_INT, spla::PLUS_INT);
+
+    EXPECT_EQ(expected, r->as_int());
+}
+
+TEST(vector, eadd_reduce_dot_tail) {
+    const spla::uint N = 1003;
+    auto             u = spla::Vector::make(N, spla::FLOAT);
+    auto             v = spla::Vector::make(N, spla::FLOAT);
+    auto             r = spla::Scalar::make_float(0.0f);
+    auto             s = spla::Scalar::make_float(0.5f);
+
+    double expected = 0.5;
+
+    for (spla::uint i = 0; i < N; i += 1) {
+        u->set_float(i, float(i % 7) * 0.25f);
+        v->set_float(i, float(i % 5));
+        expected += double(i % 7) * 0.25 * double(i % 5);
+    }
+
+    spla::exec_v_eadd_reduce(r, s, u, v, spla::MULT_FLOAT, spla::PLUS_FLOAT);
+
+    EXPECT_NEAR(expected, r->as_float(), 1e-3);
+}
+
+TEST(vector, eadd_reduce_bitmap_dot) {
+    const spla::uint N = 100000;
+    const spla::uint S = 7;
+    auto             u = spla::Vector::make(N, spla::INT);
+    auto             v = spla::Vector::make(N, spla::INT);
+    auto             r = spla::Scalar::make_int(0);
+    auto             s = spla::Scalar::make_int(10);
+
+    int expected = 10;
+
+    for (spla::uint i = 0; i < N; i += 1) {
+        v->set_int(i, int(i % 13));
+        if (i % S == 0) {
+            u->set_int(i, 1);
+            expected += int(i % 13);
+        }
+    }
+
+    u->set_format(spla::FormatVector::CpuBitmap);
+    spla::exec_v_eadd_reduce(r, s, u, v, spla::MULT_INT, spla::PLUS_INT);
+
+    EXPECT_EQ(expected, r->as_int());
+}
+
+TEST(vector, eadd_sparse) {
+    const spla::uint N   = 100000;
+    auto             inf = spla::Scalar::make_float(1000.0f);
+    auto             u   = spla::Vector::make(N, spla::FLOAT);
+    auto             v   = spla::Vector::make(N, spla::FLOAT);
+    auto             r   = spla::Vector::make(N, spla::FLOAT);
+
+    u->set_fill_value(inf);
+    v->set_fill_value(inf);
+    r->set_fill_value(inf);
+
+    for (spla::uint i = 0; i < N; i += 1) {
+        if (i % 3 == 0) u->set_float(i, float(i % 11));
+        if (i % 5 == 0) v->set_float(i, float(i % 7));
+    }
+
+    u->set_format(spla::FormatVector::CpuCoo);
+    v->set_format(spla::FormatVector::CpuCoo);
+    spla::exec_v_eadd(r, u, v, spla::MIN_FLOAT);
+
+    for (spla::uint i = 0; i < N; i += 1) {
+        float expected = 1000.0f;
+        float actual;
+        if (i % 3 == 0) expected = std::min(expected, float(i % 11));
+        if (i % 5 == 0) expected = std::min(expected, float(i % 7));
+        r->get_float(i, actual);
+        EXPECT_EQ(expected, actual);
+    }
+}
+
+TEST(vector, emult) {
+    const spla::uint N = 100000;
+    auto             u = spla::Vector::make(N, spla::INT);
+    auto             v = spla::Vector::make(N, spla::INT);
+    auto             r = spla::Vector::make(N, spla::INT);
+    auto             c = spla::Scalar::make_int(0);
+
+    auto and_not = spla::OpBinary::make_int(
+            "test_and_not",
+            "(int a, int b) { return a & ~b; }",
+            [](int a, int b) { return a & ~b; });
+
+    int expected_count = 0;
+
+    for (spla::uint i = 0; i < N; i += 1) {
+        v->set_int(i, int(i % 4));
+        if (i % 3 == 0) {
+            u->set_int(i, 3);
+            if (i % 4 != 3) expected_count += 1;
+        }
+    }
+
+    for (auto format : {spla::FormatVector::CpuCoo, spla::FormatVector::CpuDense}) {
+        u->set_format(format);
+        spla::exec_v_emult(r, u, v, and_not);
+        spla::exec_v_count_mf(c, r);
+
+        EXPECT_EQ(expected_count, c->as_int());
+
+        for (spla::uint i = 0; i < N; i += 1) {
+            const int expected = i % 3 == 0 ? 3 & ~int(i % 4) : 0;
+            int       actual;
+            r->get_int(i, actual);
+            EXPECT_EQ(expected, actual);
+        }
+    }
+}
+
+TEST(vector, select_range) {
+    const spla::uint N  = 100000;
+    auto             lo = spla::Scalar::make_float(10.0f);
+    auto             hi = spla::Scalar::make_float(20.0f);
+    auto             v  = spla::Vector::make(N, spla::FLOAT);
+    auto             r  = spla::Vector::make(N, spla::FLOAT);
+    auto             c  = spla::Scalar::make_int(0);
+
+    int expected_count = 0;
+
+    for (spla::uint i = 0; i < N; i += 1) {
+        const float x = float(i % 31);
+        if (i % 2 == 0) v->set_float(i, x);
+        if (i % 2 == 0 && x >= 10.0f && x < 20.0f) expected_count += 1;
+    }
+
+    for (auto format : {spla::FormatVector::CpuCoo, spla::FormatVector::CpuDense}) {
+        v->set_format(format);
+        spla::exec_v_select_range(r, v, lo, hi);
+        spla::exec_v_count_mf(c, r);
+
+        EXPECT_EQ(expected_count, c->as_int());
+
+        for (spla::uint i = 0; i < N; i += 1) {
+            const float x        = float(i % 31);
+            const float expected = (i % 2 == 0 && x >= 10.0f && x < 20.0f) ? x : 0.0f;
+            float       actual;
+            r->get_float(i, actual);
+            EXPECT_EQ(expected, actual);
+        }
+    }
+}
+
+TEST(vector, lazy_eadd_reduce) {
+    const spla::uint N = 10000;
+    auto             u = spla::Vector::make(N, spla::INT);
+    auto             v = spla::Vector::make(N, spla::INT);
+    auto             w = spla::Vector::make(N, spla::INT);
+    auto             r = spla::Scalar::make_int(0);
+    auto             s = spla::Scalar::make_int(0);
+
+    int expected = 0;
+
+    for (spla::uint i = 0; i < N; i += 1) {
+        u->set_int(i, int(i % 3));
+        v->set_int(i, int(i % 4));
+        expected += (int(i % 3) - int(i % 4)) * (int(i % 3) - int(i % 4));
+    }
+
+    spla::Library::get()->set_lazy_execution(true);
+
+    {
+        // temporary is held only by pending tasks, so eadd and reduce are fused
+        auto t = spla::Vector::make(N, spla::INT);
+        spla::exec_v_eadd(t, u, v, spla::MINUS_POW2_INT);
+        spla::exec_v_reduce(r, s, t, spla::PLUS_INT);
+    }
+
+    EXPECT_EQ(expected, r->as_int());
+
+    // pending eadd must observe u before it is modified
+    spla::exec_v_eadd(w, u, v, spla::PLUS_INT);
+    u->set_int(1, 100);
+
+    int actual;
+    w->get_int(1, actual);
+    EXPECT_EQ(2, actual);
+
+    EXPECT_EQ(spla::Status::Ok, spla::Library::get()->set_lazy_execution(false));
+}
+
+TEST(vector, lazy_ewise_chain) {
+    const spla::uint N = 1000;
+    auto             u = spla::Vector::make(N, spla::INT);
+    auto             v = spla::Vector::make(N, spla::INT);
+    auto             w = spla::Vector::make(N, spla::INT);
+    auto             p = spla::Vector::make(N, spla::INT);
+    auto             r = spla::Scalar::make_int(0);
+    auto             q = spla::Scalar::make_int(0);
+    auto             s = spla::Scalar::make_int(0);
+
+    auto inc = spla::OpUnary::make_int("inc", "(int x) { return x + 1; }", [](int x) { return x + 1; });
+    auto dbl = spla::OpUnary::make_int("dbl", "(int x) { return x * 2; }", [](int x) { return x * 2; });
+
+    int expected_r = 0;
+    int expected_q = 0;
+
+    for (spla::uint i = 0; i < N; i += 1) {
+        u->set_int(i, int(i % 3));
+        v->set_int(i, int(i % 4));
+        expected_r += (int(i % 3) - int(i % 4) + 1) * 2;
+        if (i % 5 == 0) {
+            p->set_int(i, int(i % 7));
+            expected_q += int(i % 7) + 1;
+        }
+    }
+    u->set_format(spla::FormatVector::CpuDense);
+    v->set_format(spla::FormatVector::CpuDense);
+
+    std::string csv;
+    spla::Library::get()->dispatch_trace_enable(true);
+    spla::Library::get()->dispatch_trace_drain_csv(csv);
+    spla::Library::get()->set_lazy_execution(true);
+
+    {
+        // eadd, two maps and reduce over temporaries run as a single chain
+        auto t1 = spla::Vector::make(N, spla::INT);
+        auto t2 = spla::Vector::make(N, spla::INT);
+        auto t3 = spla::Vector::make(N, spla::INT);
+        spla::exec_v_eadd(t1, u, v, spla::MINUS_INT);
+        spla::exec_v_map(t2, t1, inc);
+        spla::exec_v_map(t3, t2, dbl);
+        spla::exec_v_reduce(r, s, t3, spla::PLUS_INT);
+
+        // chain into user vector keeps its result
+        auto t4 = spla::Vector::make(N, spla::INT);
+        spla::exec_v_map(t4, u, inc);
+        spla::exec_v_map(w, t4, dbl);
+
+        // sparse input maps only stored entries, as unfused tasks do
+        auto t5 = spla::Vector::make(N, spla::INT);
+        spla::exec_v_map(t5, p, inc);
+        spla::exec_v_reduce(q, s, t5, spla::PLUS_INT);
+    }
+
+    EXPECT_EQ(expected_r, r->as_int());
+    EXPECT_EQ(expected_q, q->as_int());
+
+    for (spla::uint i = 0; i < N; i += 1) {
+        int actual;
+        w->get_int(i, actual);
+        EXPECT_EQ((int(i % 3) + 1) * 2, actual);
+    }
+
+    EXPECT_EQ(spla::Status::Ok, spla::Library::get()->set_lazy_execution(false));
+    EXPECT_EQ(spla::Status::Ok, spla::Library::get()->dispatch_trace_drain_csv(csv));
+    EXPECT_NE(csv.find("v_ewise_chain"), std::string::npos);
+    spla::Library::get()->dispatch_trace_enable(false);
+
+    // Sparse inputs, also valid as dense or not, give same result as eager tasks
+    auto eadd_map_reduce = [&](bool lazy, bool with_dense) {
+        const spla::uint M  = 100;
+        auto             su = spla::Vector::make(M, spla::INT);
+        auto             sv = spla::Vector::make(M, spla::INT);
+        auto             sr = spla::Scalar::make_int(0);
+
+        for (spla::uint i = 0; i < 10; i++) {
+            su->set_int(i * 10, 1);
+            sv->set_int(i * 10 + 5, 2);
+        }
+        su->set_format(spla::FormatVector::CpuCoo);
+        sv->set_format(spla::FormatVector::CpuCoo);
+        if (with_dense) {
+            su->set_format(spla::FormatVector::CpuDense);
+            sv->set_format(spla::FormatVector::CpuDense);
+        }
+
+        spla::Library::get()->set_lazy_execution(lazy);
+        {
+            auto t1 = spla::Vector::make(M, spla::INT);
+            auto t2 = spla::Vector::make(M, spla::INT);
+            spla::exec_v_eadd(t1, su, sv, spla::PLUS_INT);
+            spla::exec_v_map(t2, t1, inc);
+            spla::exec_v_reduce(sr, s, t2, spla::PLUS_INT);
+        }
+        const int result = sr->as_int();
+        spla::Library::get()->set_lazy_execution(false);
+
+        return result;
+    };
+
+    EXPECT_EQ(eadd_map_reduce(false, false), eadd_map_reduce(true, false));
+    EXPECT_EQ(eadd_map_reduce(false, true), eadd_map_reduce(true, true));
+}
+
 TEST(vector, eadd_fdb_min) {
     const spla::uint N    = 20;
     const spla::uint K    = 8;
@@ -444,6 +753,29 @@ TEST(vector, fill_value) {
     }
 }
 
+TEST(vector, bitmap_format) {
+    const int N = 10000;
+    const int S = 3;
+
+    auto v     = spla::Vector::make(N, spla::INT);
+    auto count = spla::Scalar::make_uint(0);
+
+    for (int i = 0; i < N; i++) {
+        if (i % S == 0) v->set_int(i, 1);
+    }
+
+    v->set_format(spla::FormatVector::CpuBitmap);
+    spla::exec_v_count_mf(count, v);
+
+    EXPECT_EQ(count->as_uint(), spla::uint((N + S - 1) / S));
+
+    for (int i = 0; i < N; i++) {
+        int r;
+        v->get_int(i, r);
+        EXPECT_EQ(r, (i % S == 0 ? 1 : 0));
+    }
+}
+
 TEST(vector, map) {
     const spla::uint N = 100000;
     auto             v = spla::Vector::make(N, spla::FLOAT);
@@ -28,6 +28,7 @@
 #include "test_common.hpp"
 
 #include <iostream>
+#include <limits>
 #include <spla.hpp>
 
 TEST(vxm_masked, naive) {
@@ -186,4 +187,262 @@ TEST(vxm_masked, perf_and_or) {
     std::cout << std::endl;
 }
 
+TEST(vxm_masked, mask_modes) {
+    const int N = 500;
+    const int K = 8;
+    const int S = 3;
+
+    std::vector<int> sums(N, 0);
+
+    auto iM    = spla::Matrix::make(N, N, spla::INT);
+    auto iv    = spla::Vector::make(N, spla::INT);
+    auto ir    = spla::Vector::make(N, spla::INT);
+    auto imask = spla::Vector::make(N, spla::INT);
+    auto iinit = spla::Scalar::make_int(0);
+
+    for (int i = 0; i < N; i += 2) {
+        iv->set_int(i, 1);
+
+        for (int k = 0; k < K; k++) {
+            const int j = (i * 7 + k * 13) % N;
+            iM->set_int(i, j, i % 4 + 1);
+            sums[j] += i % 4 + 1;
+        }
+    }
+    for (int i = 0; i < N; i += S) {
+        imask->set_int(i, 1);
+    }
+
+    auto check = [&](const spla::ref_ptr<spla::Vector>& mask, bool structure, bool complement, bool with_mask) {
+        auto desc = spla::Descriptor::make();
+        desc->set_mask_structure(structure);
+        desc->set_mask_complement(complement);
+
+        EXPECT_EQ(spla::exec_vxm_masked(ir, mask, iv, iM, spla::MULT_INT, spla::PLUS_INT, spla::NQZERO_INT, iinit, desc), spla::Status::Ok);
+
+        for (int i = 0; i < N; i++) {
+            const bool selected = !with_mask || ((i % S == 0) != complement);
+            int        r;
+            ir->get_int(i, r);
+            EXPECT_EQ(r, selected ? sums[i] : 0);
+        }
+    };
+
+    check(spla::ref_ptr<spla::Vector>(), false, false, false);
+
+    imask->set_format(spla::FormatVector::CpuCoo);
+    check(imask, true, false, true);
+    check(imask, true, true, true);
+    check(imask, false, true, true);
+}
+
+TEST(vxm_masked, accum_changed) {
+    const int   N   = 300;
+    const int   K   = 6;
+    const float inf = std::numeric_limits<float>::max();
+
+    std::vector<float> expected(N, inf);
+
+    auto iM       = spla::Matrix::make(N, N, spla::FLOAT);
+    auto iv       = spla::Vector::make(N, spla::FLOAT);
+    auto ir       = spla::Vector::make(N, spla::FLOAT);
+    auto changed  = spla::Vector::make(N, spla::FLOAT);
+    auto inf_init = spla::Scalar::make_float(inf);
+
+    ir->set_fill_value(inf_init);
+    iv->set_fill_value(inf_init);
+    changed->set_fill_value(inf_init);
+
+    for (int i = 0; i < N; i++) {
+        if (i % 4 == 0) {
+            ir->set_float(i, 2.0f);
+            expected[i] = 2.0f;
+        }
+    }
+    for (int i = 0; i < N; i += 3) {
+        iv->set_float(i, 0.0f);
+
+        for (int k = 0; k < K; k++) {
+            const int   j = (i + k * 17) % N;
+            const float w = float((i + k) % 4);
+            iM->set_float(i, j, w);
+            expected[j] = std::min(expected[j], w);
+        }
+    }
+
+    EXPECT_EQ(spla::exec_vxm_masked_accum(ir, spla::ref_ptr<spla::Vector>(), iv, iM, spla::PLUS_FLOAT, spla::MIN_FLOAT,
+                                          spla::ref_ptr<spla::OpSelect>(), inf_init, spla::MIN_FLOAT, changed),
+              spla::Status::Ok);
+
+    for (int i = 0; i < N; i++) {
+        const float prev = (i % 4 == 0) ? 2.0f : inf;
+        float       r, c;
+        ir->get_float(i, r);
+        changed->get_float(i, c);
+        EXPECT_EQ(r, expected[i]);
+        EXPECT_EQ(c, expected[i] != prev ? expected[i] : inf);
+    }
+}
+
+TEST(vxm_masked, bitmap_and_or) {
+    const int N = 1000;
+    const int K = 7;
+    const int W = 16;
+    const int S = 5;
+
+    std::vector<int> result(N, 0);
+
+    auto ir    = spla::Vector::make(N, spla::INT);
+    auto imask = spla::Vector::make(N, spla::INT);
+    auto iv    = spla::Vector::make(N, spla::INT);
+    auto iM    = spla::Matrix::make(N, N, spla::INT);
+    auto iinit = spla::Scalar::make_int(0);
+    auto icnt  = spla::Scalar::make_uint(0);
+
+    for (int i = 0; i < N; i++) {
+        if (i % S) imask->set_int(i, 1);
+
+        if ((i % K) == 0) {
+            iv->set_int(i, 1);
+
+            for (int w = 0; w < W; w++) {
+                const int j = (i + w) % N;
+                iM->set_int(i, j, 1);
+                result[j] = 1;
+            }
+        }
+    }
+
+    imask->set_format(spla::FormatVector::CpuBitmap);
+    iv->set_format(spla::FormatVector::CpuBitmap);
+
+    spla::exec_vxm_masked(ir, imask, iv, iM, spla::BAND_INT, spla::BOR_INT, spla::EQZERO_INT, iinit);
+    spla::exec_v_count_mf(icnt, ir);
+
+    spla::uint expected_count = 0;
+
+    for (int i = 0; i < N; i++) {
+        int r;
+        ir->get_int(i, r);
+        EXPECT_EQ(r, (i % S ? 0 : result[i]));
+        expected_count += (i % S ? 0 : result[i]);
+    }
+
+    EXPECT_EQ(icnt->as_uint(), expected_count);
+}
+
+TEST(vxm_masked, bitmap_cached_mask_keeps_values) {
+    const int N = 4;
+
+    auto ir    = spla::Vector::make(N, spla::INT);
+    auto imask = spla::Vector::make(N, spla::INT);
+    auto iv    = spla::Vector::make(N, spla::INT);
+    auto iout  = spla::Vector::make(N, spla::INT);
+    auto iM    = spla::Matrix::make(N, N, spla::INT);
+    auto iinit = spla::Scalar::make_int(0);
+    auto ival  = spla::Scalar::make_int(3);
+    auto desc  = spla::Descriptor::make();
+
+    desc->set_struct_only(true);
+
+    ir->set_int(0, 7);
+    ir->set_int(1, 5);
+    imask->set_int(2, 1);
+    iv->set_int(0, 7);
+    iM->set_int(0, 1, 5);
+
+    // Structural masks cache a bitmap of r, mask and v, which must not replace their values
+    spla::exec_vxm_masked(iout, ir, iv, iM, spla::BAND_INT, spla::BOR_INT, spla::NQZERO_INT, iinit, desc);
+    spla::exec_vxm_masked(iout, imask, iv, iM, spla::BAND_INT, spla::BOR_INT, spla::NQZERO_INT, iinit, desc);
+    spla::exec_vxm_masked(iout, iv, iv, iM, spla::BAND_INT, spla::BOR_INT, spla::NQZERO_INT, iinit, desc);
+
+    spla::exec_v_assign_masked(ir, imask, ival, spla::SECOND_INT, spla::NQZERO_INT);
+    spla::exec_vxm_masked(iout, ir, iv, iM, spla::BAND_INT, spla::BOR_INT, spla::EQZERO_INT, iinit);
+
+    const int expected_r[N]   = {7, 5, 3, 0};
+    const int expected_out[N] = {0, 0, 0, 0};
+
+    for (int i = 0; i < N; i++) {
+        int r, out;
+        ir->get_int(i, r);
+        iout->get_int(i, out);
+        EXPECT_EQ(r, expected_r[i]);
+        EXPECT_EQ(out, expected_out[i]);
+    }
+
+    spla::exec_vxm_masked(iout, imask, iv, iM, spla::BAND_INT, spla::BOR_INT, spla::EQZERO_INT, iinit);
+
+    int out;
+    iout->get_int(1, out);
+    EXPECT_EQ(out, 7 & 5);
+}
+
+TEST(vxm_masked, structural_mask_then_operand) {
+    const int N = 100;
+
+    auto iv    = spla::Vector::make(N, spla::INT);
+    auto ir    = spla::Vector::make(N, spla::INT);
+    auto iM    = spla::Matrix::make(N, N, spla::INT);
+    auto iI    = spla::Matrix::make(N, N, spla::INT);
+    auto iinit = spla::Scalar::make_int(0);
+    auto desc  = spla::Descriptor::make();
+
+    for (int i = 0; i < N; i++) {
+        iM->set_int(i, (i + 1) % N, 1);
+        iI->set_int(i, i, 1);
+    }
+    iv->fill_with(spla::Scalar::make_int(5));
+
+    // Structural mask caches bitmap of v next to its values, later reads must not go through bitmap
+    desc->set_mask_structure(true);
+    EXPECT_EQ(spla::exec_mxv_masked(ir, iv, iM, iv, spla::MULT_INT, spla::PLUS_INT, spla::NQZERO_INT, iinit, desc), spla::Status::Ok);
+    EXPECT_EQ(spla::exec_vxm_masked(ir, spla::ref_ptr<spla::Vector>(), iv, iI, spla::MULT_INT, spla::PLUS_INT, spla::NQZERO_INT, iinit), spla::Status::Ok);
+
+    for (int i = 0; i < N; i++) {
+        int r;
+        ir->get_int(i, r);
+        EXPECT_EQ(r, 5);
+    }
+}
+
+TEST(vxm_masked, hub_frontier) {
+    // Frontier of single hub row and many short rows is collected by edges; products of
+    // large graph are accumulated in hash table, of small graph in dense table of all rows
+    auto check = [](int N, int hub_degree) {
+        const int n_short = N / 40;
+
+        std::vector<int> sums(N, 0);
+
+        auto iM    = spla::Matrix::make(N, N, spla::INT);
+        auto iv    = spla::Vector::make(N, spla::INT);
+        auto ir    = spla::Vector::make(N, spla::INT);
+        auto iinit = spla::Scalar::make_int(0);
+
+        iv->set_int(0, 3);
+        for (int k = 0; k < hub_degree; k++) {
+            const int j = (k * 7 + 1) % N;
+            iM->set_int(0, j, k % 5 + 1);
+            sums[j] += 3 * (k % 5 + 1);
+        }
+        for (int s = 1; s <= n_short; s++) {
+            const int i = s * 37 % N;
+            const int j = (s * 13) % N;
+            iv->set_int(i, s % 3 + 1);
+            iM->set_int(i, j, 2);
+            sums[j] += 2 * (s % 3 + 1);
+        }
+
+        EXPECT_EQ(spla::exec_vxm_masked(ir, spla::ref_ptr<spla::Vector>(), iv, iM, spla::MULT_INT, spla::PLUS_INT, spla::NQZERO_INT, iinit), spla::Status::Ok);
+
+        for (int j = 0; j < N; j++) {
+            int r;
+            ir->get_int(j, r);
+            EXPECT_EQ(r, sums[j]);
+        }
+    };
+
+    check(40000, 4000);
+    check(2000, 1500);
+}
+
 SPLA_GTEST_MAIN_WITH_FINALIZE_PLATFORM(1)
\ No newline at end of file